@@ -0,0 +1,25 @@
+#--------------------------------------------------------
+#
+# Pro file for Android and Windows builds with Qt Creator
+#
+#--------------------------------------------------------
+
+QT += core multimedia
+QMAKE_CXXFLAGS += -std=c++11
+
+TEMPLATE = app
+TARGET = sdrangelsrv
+INCLUDEPATH += $$PWD/../sdrbase
+INCLUDEPATH += $$PWD/../sdrsrv
+INCLUDEPATH += $$PWD/../logging
+
+CONFIG(Release):build_subdir = release
+CONFIG(Debug):build_subdir = debug
+
+SOURCES += main.cpp
+LIBS += -L../sdrsrv/$${build_subdir} -lsdrsrv
+LIBS += -L../sdrbase/$${build_subdir} -lsdrbase
+LIBS += -L../logging/$${build_subdir} -llogging
+
+CONFIG += console
+CONFIG -= app_bundle
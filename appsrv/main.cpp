@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QCoreApplication>
+#include <QTimer>
+
+#include <csignal>
+
+#include "loggerwithfile.h"
+#include "mainparser.h"
+#include "maincore.h"
+
+static volatile std::sig_atomic_t caughtSignal = 0;
+
+static void sigHandler(int sig)
+{
+    caughtSignal = sig; // only async-signal-safe operations here
+}
+
+static void checkSignal()
+{
+    if (caughtSignal)
+    {
+        qInfo("checkSignal: caught signal %d: quit", (int) caughtSignal);
+        QCoreApplication::quit();
+    }
+}
+
+static int runQtApplication(int argc, char* argv[], qtwebapp::LoggerWithFile *logger)
+{
+    QCoreApplication a(argc, argv);
+
+    QCoreApplication::setOrganizationName("f4exb");
+    QCoreApplication::setApplicationName("SDRangel");
+    QCoreApplication::setApplicationVersion("3.8.4");
+
+    std::signal(SIGINT, sigHandler);
+    std::signal(SIGTERM, sigHandler);
+    QTimer signalTimer; // the signal is acted upon in the event loop
+    QObject::connect(&signalTimer, &QTimer::timeout, checkSignal);
+    signalTimer.start(200);
+
+    MainParser parser;
+    parser.parse(a);
+
+    MainCore m(logger, parser, &a);
+
+    return a.exec();
+}
+
+int main(int argc, char* argv[])
+{
+    qtwebapp::LoggerWithFile *logger = new qtwebapp::LoggerWithFile(qApp);
+    logger->installMsgHandler();
+    int res = runQtApplication(argc, argv, logger);
+    qWarning("SDRangel server quit.");
+    return res;
+}
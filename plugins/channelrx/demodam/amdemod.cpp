@@ -79,35 +79,17 @@ AMDemod::~AMDemod()
 
 void AMDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool firstOfBurst __attribute__((unused)))
 {
-	Complex ci;
-
 	m_settingsMutex.lock();
 
-	for (SampleVector::const_iterator it = begin; it != end; ++it)
-	{
-		//Complex c(it->real() / 32768.0, it->imag() / 32768.0);
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
-
-		if (m_interpolatorDistance < 1.0f) // interpolate
-		{
-            processOneSample(ci);
+	m_mixerBuffer.resize(end - begin);
+	m_nco.mix(begin, end, m_mixerBuffer.data());
 
-		    while (m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(ci);
-            }
+	m_resampledBuffer.resize(m_interpolator.getResampleBlockSize(m_mixerBuffer.size()));
+	int nbResampled = m_interpolator.resampleBlock(m_mixerBuffer.data(), m_mixerBuffer.size(), m_resampledBuffer.data());
 
-            m_interpolatorDistanceRemain += m_interpolatorDistance;
-		}
-		else // decimate
-		{
-	        if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
-	        {
-	            processOneSample(ci);
-	            m_interpolatorDistanceRemain += m_interpolatorDistance;
-	        }
-		}
+	for (int i = 0; i < nbResampled; i++)
+	{
+		processOneSample(m_resampledBuffer[i]);
 	}
 
 	if (m_audioBufferFill > 0)
@@ -218,8 +200,8 @@ void AMDemod::applySettings(const AMDemodSettings& settings, bool force)
     {
         m_settingsMutex.lock();
         m_interpolator.create(16, settings.m_inputSampleRate, settings.m_rfBandwidth / 2.2f);
-        m_interpolatorDistanceRemain = 0;
         m_interpolatorDistance = (Real) settings.m_inputSampleRate / (Real) settings.m_audioSampleRate;
+        m_interpolator.setResampleRatio(m_interpolatorDistance);
         m_bandpass.create(301, settings.m_audioSampleRate, 300.0, settings.m_rfBandwidth / 2.0f);
         m_settingsMutex.unlock();
     }
@@ -236,5 +218,10 @@ void AMDemod::applySettings(const AMDemodSettings& settings, bool force)
         m_udpBufferAudio->setPort(settings.m_udpPort);
     }
 
+    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
+    {
+        DSPEngine::instance()->addAudioSink(&m_audioFifo, settings.m_audioDeviceName);
+    }
+
     m_settings = settings;
 }
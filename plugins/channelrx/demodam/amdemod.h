@@ -125,9 +125,10 @@ private:
     AMDemodSettings m_settings;
 
 	NCO m_nco;
+	std::vector<Complex> m_mixerBuffer; //!< input samples shifted by the NCO
+	std::vector<Complex> m_resampledBuffer; //!< channel samples resampled to the audio rate
 	Interpolator m_interpolator;
 	Real m_interpolatorDistance;
-	Real m_interpolatorDistanceRemain;
 
 	Real m_squelchLevel;
 	uint32_t m_squelchCount;
@@ -29,6 +29,7 @@
 #include "util/simpleserializer.h"
 #include "util/db.h"
 #include "gui/basicchannelsettingsdialog.h"
+#include "gui/audioselectdialog.h"
 #include "dsp/dspengine.h"
 #include "mainwindow.h"
 
@@ -180,6 +181,19 @@ void AMDemodGUI::onMenuDialogCalled(const QPoint &p)
     applySettings();
 }
 
+void AMDemodGUI::audioSelect()
+{
+    qDebug("AMDemodGUI::audioSelect");
+    AudioSelectDialog audioSelect(m_settings.m_audioDeviceName);
+    audioSelect.exec();
+
+    if (audioSelect.hasChanged())
+    {
+        m_settings.m_audioDeviceName = audioSelect.getDeviceName();
+        applySettings();
+    }
+}
+
 AMDemodGUI::AMDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel, QWidget* parent) :
 	RollupWidget(parent),
 	ui(new Ui::AMDemodGUI),
@@ -194,6 +208,8 @@ AMDemodGUI::AMDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, BasebandS
 	setAttribute(Qt::WA_DeleteOnClose, true);
 	connect(this, SIGNAL(widgetRolled(QWidget*,bool)), this, SLOT(onWidgetRolled(QWidget*,bool)));
     connect(this, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(onMenuDialogCalled(const QPoint &)));
+    ui->audioMute->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(ui->audioMute, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(audioSelect()));
 
 	m_amDemod = (AMDemod*) rxChannel; //new AMDemod(m_deviceUISet->m_deviceSourceAPI);
 
@@ -65,6 +65,7 @@ private:
 	void enterEvent(QEvent*);
 
 private slots:
+	void audioSelect();
 	void on_deltaFrequency_changed(qint64 value);
 	void on_bandpassEnable_toggled(bool checked);
 	void on_rfBW_valueChanged(int value);
@@ -42,6 +42,7 @@ void AMDemodSettings::resetToDefaults()
     m_udpPort = 9999;
     m_rgbColor = QColor(255, 255, 0).rgb();
     m_title = "AM Demodulator";
+    m_audioDeviceName = AudioDeviceManager::m_defaultDeviceName;
 }
 
 QByteArray AMDemodSettings::serialize() const
@@ -59,6 +60,7 @@ QByteArray AMDemodSettings::serialize() const
     s.writeU32(7, m_rgbColor);
     s.writeBool(8, m_bandpassEnable);
     s.writeString(9, m_title);
+    s.writeString(10, m_audioDeviceName);
     return s.final();
 }
 
@@ -94,6 +96,7 @@ bool AMDemodSettings::deserialize(const QByteArray& data)
         d.readU32(7, &m_rgbColor);
         d.readBool(8, &m_bandpassEnable, false);
         d.readString(9, &m_title, "AM Demodulator");
+        d.readString(10, &m_audioDeviceName, AudioDeviceManager::m_defaultDeviceName);
 
         return true;
     }
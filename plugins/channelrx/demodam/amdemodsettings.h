@@ -36,6 +36,7 @@ struct AMDemodSettings
     quint16 m_udpPort;
     quint32 m_rgbColor;
     QString m_title;
+    QString m_audioDeviceName;
     Serializable *m_channelMarker;
 
     AMDemodSettings();
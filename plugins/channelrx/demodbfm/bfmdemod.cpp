@@ -119,10 +119,12 @@ void BFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 	m_settingsMutex.lock();
 
-	for (SampleVector::const_iterator it = begin; it != end; ++it)
+	m_mixerBuffer.resize(end - begin);
+	m_nco.mix(begin, end, m_mixerBuffer.data());
+
+	for (std::vector<Complex>::const_iterator it = m_mixerBuffer.begin(); it != m_mixerBuffer.end(); ++it)
 	{
-		Complex c(it->real() / 32768.0f, it->imag() / 32768.0f);
-		c *= m_nco.nextIQ();
+		Complex c = *it / 32768.0f;
 
 		rf_out = m_rfFilter->runFilt(c, &rf); // filter RF before demod
 
@@ -466,5 +468,10 @@ void BFMDemod::applySettings(const BFMDemodSettings& settings, bool force)
         m_udpBufferAudio->setPort(settings.m_udpPort);
     }
 
+    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
+    {
+        DSPEngine::instance()->addAudioSink(&m_audioFifo, settings.m_audioDeviceName);
+    }
+
     m_settings = settings;
 }
@@ -166,6 +166,7 @@ private:
     int m_absoluteFrequencyOffset;
 
 	NCO m_nco;
+	std::vector<Complex> m_mixerBuffer; //!< input samples shifted by the NCO
 	Interpolator m_interpolator; //!< Interpolator between fixed demod bandwidth and audio bandwidth (rational)
 	Real m_interpolatorDistance;
 	Real m_interpolatorDistanceRemain;
@@ -36,6 +36,7 @@
 #include "util/simpleserializer.h"
 #include "util/db.h"
 #include "gui/basicchannelsettingsdialog.h"
+#include "gui/audioselectdialog.h"
 #include "mainwindow.h"
 
 #include "bfmdemodsettings.h"
@@ -323,6 +324,19 @@ void BFMDemodGUI::onMenuDialogCalled(const QPoint &p)
     applySettings();
 }
 
+void BFMDemodGUI::audioSelect()
+{
+    qDebug("BFMDemodGUI::audioSelect");
+    AudioSelectDialog audioSelect(m_settings.m_audioDeviceName);
+    audioSelect.exec();
+
+    if (audioSelect.hasChanged())
+    {
+        m_settings.m_audioDeviceName = audioSelect.getDeviceName();
+        applySettings();
+    }
+}
+
 BFMDemodGUI::BFMDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel, QWidget* parent) :
 	RollupWidget(parent),
 	ui(new Ui::BFMDemodGUI),
@@ -334,6 +348,8 @@ BFMDemodGUI::BFMDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, Baseban
 	m_rate(625000)
 {
 	ui->setupUi(this);
+	ui->audioStereo->setContextMenuPolicy(Qt::CustomContextMenu);
+	connect(ui->audioStereo, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(audioSelect()));
     ui->deltaFrequencyLabel->setText(QString("%1f").arg(QChar(0x94, 0x03)));
     ui->deltaFrequency->setColorMapper(ColorMapper(ColorMapper::GrayGold));
     ui->deltaFrequency->setValueRange(false, 7, -9999999, 9999999);
@@ -101,6 +101,7 @@ private:
     }
 
 private slots:
+	void audioSelect();
 	void on_deltaFrequency_changed(qint64 value);
 	void on_rfBW_valueChanged(int value);
 	void on_afBW_valueChanged(int value);
@@ -52,6 +52,7 @@ void BFMDemodSettings::resetToDefaults()
     m_udpPort = 9999;
     m_rgbColor = QColor(80, 120, 228).rgb();
     m_title = "Broadcast FM Demod";
+    m_audioDeviceName = AudioDeviceManager::m_defaultDeviceName;
 }
 
 QByteArray BFMDemodSettings::serialize() const
@@ -77,6 +78,7 @@ QByteArray BFMDemodSettings::serialize() const
 
     s.writeString(12, m_title);
 
+    s.writeString(13, m_audioDeviceName);
     return s.final();
 }
 
@@ -124,6 +126,7 @@ bool BFMDemodSettings::deserialize(const QByteArray& data)
         }
 
         d.readString(12, &m_title, "Broadcast FM Demod");
+        d.readString(13, &m_audioDeviceName, AudioDeviceManager::m_defaultDeviceName);
 
         return true;
     }
@@ -37,6 +37,7 @@ struct BFMDemodSettings
     quint16 m_udpPort;
     quint32 m_rgbColor;
     QString m_title;
+    QString m_audioDeviceName;
 
     Serializable *m_channelMarker;
     Serializable *m_spectrumGUI;
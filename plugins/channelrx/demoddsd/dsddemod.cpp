@@ -42,7 +42,6 @@ DSDDemod::DSDDemod(DeviceSourceAPI *deviceAPI) :
 	m_deviceAPI(deviceAPI),
 	m_absoluteFrequencyOffset(0),
     m_interpolatorDistance(0.0f),
-    m_interpolatorDistanceRemain(0.0f),
     m_sampleCount(0),
     m_squelchCount(0),
     m_squelchGate(0),
@@ -115,125 +114,128 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 	m_dsdDecoder.enableMbelib(!DSPEngine::instance()->hasDVSerialSupport()); // disable mbelib if DV serial support is present and activated else enable it
 
-	for (SampleVector::const_iterator it = begin; it != end; ++it)
+	m_mixerBuffer.resize(end - begin);
+	m_nco.mix(begin, end, m_mixerBuffer.data());
+
+	m_resampledBuffer.resize(m_interpolator.getResampleBlockSize(m_mixerBuffer.size()));
+	int nbResampled = m_interpolator.resampleBlock(m_mixerBuffer.data(), m_mixerBuffer.size(), m_resampledBuffer.data());
+
+	for (int i = 0; i < nbResampled; i++)
 	{
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+		ci = m_resampledBuffer[i];
 
-        if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
-        {
-            qint16 sample, delayedSample;
+        qint16 sample, delayedSample;
 
-            Real magsq = ((ci.real()*ci.real() +  ci.imag()*ci.imag()))  / (1<<30);
-            m_movingAverage.feed(magsq);
+        Real magsq = ((ci.real()*ci.real() +  ci.imag()*ci.imag()))  / (1<<30);
+        m_movingAverage.feed(magsq);
 
-            m_magsqSum += magsq;
+        m_magsqSum += magsq;
 
-            if (magsq > m_magsqPeak)
-            {
-                m_magsqPeak = magsq;
-            }
+        if (magsq > m_magsqPeak)
+        {
+            m_magsqPeak = magsq;
+        }
 
-            m_magsqCount++;
+        m_magsqCount++;
 
-            Real demod = 32768.0f * m_phaseDiscri.phaseDiscriminator(ci) * m_settings.m_demodGain;
-            m_sampleCount++;
+        Real demod = 32768.0f * m_phaseDiscri.phaseDiscriminator(ci) * m_settings.m_demodGain;
+        m_sampleCount++;
 
-            // AF processing
+        // AF processing
 
-            if (m_movingAverage.average() > m_squelchLevel)
+        if (m_movingAverage.average() > m_squelchLevel)
+        {
+            if (m_squelchGate > 0)
             {
-                if (m_squelchGate > 0)
-                {
-                    if (m_squelchCount < m_squelchGate) {
-                        m_squelchCount++;
-                    }
-
-                    m_squelchOpen = m_squelchCount == m_squelchGate;
+                if (m_squelchCount < m_squelchGate) {
+                    m_squelchCount++;
                 }
-                else
-                {
-                    m_squelchOpen = true;
-                }
-            }
-            else
-            {
-                m_squelchCount = 0;
-                m_squelchOpen = false;
-            }
 
-            if (m_squelchOpen)
-            {
-                sample = demod;
+                m_squelchOpen = m_squelchCount == m_squelchGate;
             }
             else
             {
-                sample = 0;
+                m_squelchOpen = true;
             }
+        }
+        else
+        {
+            m_squelchCount = 0;
+            m_squelchOpen = false;
+        }
 
-            m_dsdDecoder.pushSample(sample);
+        if (m_squelchOpen)
+        {
+            sample = demod;
+        }
+        else
+        {
+            sample = 0;
+        }
 
-            if (m_settings.m_enableCosineFiltering) { // show actual input to FSK demod
-            	sample = m_dsdDecoder.getFilteredSample();
-            }
+        m_dsdDecoder.pushSample(sample);
 
-            if (m_sampleBufferIndex < (1<<17)) {
-                m_sampleBufferIndex++;
-            } else {
-                m_sampleBufferIndex = 0;
-            }
+        if (m_settings.m_enableCosineFiltering) { // show actual input to FSK demod
+        	sample = m_dsdDecoder.getFilteredSample();
+        }
 
-            m_sampleBuffer[m_sampleBufferIndex] = sample;
+        if (m_sampleBufferIndex < (1<<17)) {
+            m_sampleBufferIndex++;
+        } else {
+            m_sampleBufferIndex = 0;
+        }
 
-            if (m_sampleBufferIndex < samplesPerSymbol) {
-                delayedSample = m_sampleBuffer[(1<<17) - samplesPerSymbol + m_sampleBufferIndex]; // wrap
-            } else {
-                delayedSample = m_sampleBuffer[m_sampleBufferIndex - samplesPerSymbol];
-            }
+        m_sampleBuffer[m_sampleBufferIndex] = sample;
 
-            if (m_settings.m_syncOrConstellation)
-            {
-                Sample s(sample, m_dsdDecoder.getSymbolSyncSample());
-                m_scopeSampleBuffer.push_back(s);
-            }
-            else
-            {
-                Sample s(sample, delayedSample); // I=signal, Q=signal delayed by 20 samples (2400 baud: lowest rate)
-                m_scopeSampleBuffer.push_back(s);
-            }
+        if (m_sampleBufferIndex < samplesPerSymbol) {
+            delayedSample = m_sampleBuffer[(1<<17) - samplesPerSymbol + m_sampleBufferIndex]; // wrap
+        } else {
+            delayedSample = m_sampleBuffer[m_sampleBufferIndex - samplesPerSymbol];
+        }
 
-            if (DSPEngine::instance()->hasDVSerialSupport())
+        if (m_settings.m_syncOrConstellation)
+        {
+            Sample s(sample, m_dsdDecoder.getSymbolSyncSample());
+            m_scopeSampleBuffer.push_back(s);
+        }
+        else
+        {
+            Sample s(sample, delayedSample); // I=signal, Q=signal delayed by 20 samples (2400 baud: lowest rate)
+            m_scopeSampleBuffer.push_back(s);
+        }
+
+        if (DSPEngine::instance()->hasDVSerialSupport())
+        {
+            if ((m_settings.m_slot1On) && m_dsdDecoder.mbeDVReady1())
             {
-                if ((m_settings.m_slot1On) && m_dsdDecoder.mbeDVReady1())
+                if (!m_settings.m_audioMute)
                 {
-                    if (!m_settings.m_audioMute)
-                    {
-                        DSPEngine::instance()->pushMbeFrame(
-                                m_dsdDecoder.getMbeDVFrame1(),
-                                m_dsdDecoder.getMbeRateIndex(),
-                                m_settings.m_volume * 10.0,
-                                m_settings.m_tdmaStereo ? 1 : 3, // left or both channels
-                                &m_audioFifo1);
-                    }
-
-                    m_dsdDecoder.resetMbeDV1();
+                    DSPEngine::instance()->pushMbeFrame(
+                            m_dsdDecoder.getMbeDVFrame1(),
+                            m_dsdDecoder.getMbeRateIndex(),
+                            m_settings.m_volume * 10.0,
+                            m_settings.m_tdmaStereo ? 1 : 3, // left or both channels
+                            &m_audioFifo1);
                 }
 
-                if ((m_settings.m_slot2On) && m_dsdDecoder.mbeDVReady2())
+                m_dsdDecoder.resetMbeDV1();
+            }
+
+            if ((m_settings.m_slot2On) && m_dsdDecoder.mbeDVReady2())
+            {
+                if (!m_settings.m_audioMute)
                 {
-                    if (!m_settings.m_audioMute)
-                    {
-                        DSPEngine::instance()->pushMbeFrame(
-                                m_dsdDecoder.getMbeDVFrame2(),
-                                m_dsdDecoder.getMbeRateIndex(),
-                                m_settings.m_volume * 10.0,
-                                m_settings.m_tdmaStereo ? 2 : 3, // right or both channels
-                                &m_audioFifo2);
-                    }
-
-                    m_dsdDecoder.resetMbeDV2();
+                    DSPEngine::instance()->pushMbeFrame(
+                            m_dsdDecoder.getMbeDVFrame2(),
+                            m_dsdDecoder.getMbeRateIndex(),
+                            m_settings.m_volume * 10.0,
+                            m_settings.m_tdmaStereo ? 2 : 3, // right or both channels
+                            &m_audioFifo2);
                 }
+
+                m_dsdDecoder.resetMbeDV2();
             }
+        }
 
 //            if (DSPEngine::instance()->hasDVSerialSupport() && m_dsdDecoder.mbeDVReady1())
 //            {
@@ -245,8 +247,6 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 //                m_dsdDecoder.resetMbeDV1();
 //            }
 
-            m_interpolatorDistanceRemain += m_interpolatorDistance;
-        }
 	}
 
 	if (!DSPEngine::instance()->hasDVSerialSupport())
@@ -402,8 +402,8 @@ void DSDDemod::applySettings(DSDDemodSettings& settings, bool force)
     {
         m_settingsMutex.lock();
         m_interpolator.create(16, settings.m_inputSampleRate, (settings.m_rfBandwidth) / 2.2);
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorDistance =  (Real) settings.m_inputSampleRate / (Real) settings.m_audioSampleRate;
+        m_interpolatorDistance = (Real) settings.m_inputSampleRate / (Real) settings.m_audioSampleRate;
+        m_interpolator.setResampleRatio(m_interpolatorDistance);
         m_phaseDiscri.setFMScaling((float) settings.m_rfBandwidth / (float) settings.m_fmDeviation);
         m_settingsMutex.unlock();
     }
@@ -465,5 +465,11 @@ void DSDDemod::applySettings(DSDDemodSettings& settings, bool force)
         m_audioFifo2.setCopyToUDP(settings.m_slot2On && !settings.m_slot1On && settings.m_udpCopyAudio);
     }
 
+    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
+    {
+        DSPEngine::instance()->addAudioSink(&m_audioFifo1, settings.m_audioDeviceName);
+        DSPEngine::instance()->addAudioSink(&m_audioFifo2, settings.m_audioDeviceName);
+    }
+
     m_settings = settings;
 }
@@ -32,6 +32,7 @@
 #include "util/simpleserializer.h"
 #include "util/db.h"
 #include "gui/basicchannelsettingsdialog.h"
+#include "gui/audioselectdialog.h"
 #include "dsp/dspengine.h"
 #include "mainwindow.h"
 
@@ -241,6 +242,19 @@ void DSDDemodGUI::onMenuDialogCalled(const QPoint &p)
     applySettings();
 }
 
+void DSDDemodGUI::audioSelect()
+{
+    qDebug("DSDDemodGUI::audioSelect");
+    AudioSelectDialog audioSelect(m_settings.m_audioDeviceName);
+    audioSelect.exec();
+
+    if (audioSelect.hasChanged())
+    {
+        m_settings.m_audioDeviceName = audioSelect.getDeviceName();
+        applySettings();
+    }
+}
+
 DSDDemodGUI::DSDDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel, QWidget* parent) :
 	RollupWidget(parent),
 	ui(new Ui::DSDDemodGUI),
@@ -259,6 +273,8 @@ DSDDemodGUI::DSDDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, Baseban
 {
 	ui->setupUi(this);
 	setAttribute(Qt::WA_DeleteOnClose, true);
+	ui->audioMute->setContextMenuPolicy(Qt::CustomContextMenu);
+	connect(ui->audioMute, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(audioSelect()));
 
 	connect(this, SIGNAL(widgetRolled(QWidget*,bool)), this, SLOT(onWidgetRolled(QWidget*,bool)));
     connect(this, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(onMenuDialogCalled(const QPoint &)));
@@ -110,6 +110,7 @@ private:
 	void enterEvent(QEvent*);
 
 private slots:
+    void audioSelect();
     void formatStatusText();
     void on_deltaFrequency_changed(qint64 value);
     void on_rfBW_valueChanged(int index);
@@ -257,10 +257,12 @@ void LoRaDemod::feed(const SampleVector::const_iterator& begin, const SampleVect
 
 	m_settingsMutex.lock();
 
-	for(SampleVector::const_iterator it = begin; it < end; ++it)
+	m_mixerBuffer.resize(end - begin);
+	m_nco.mix(begin, end, m_mixerBuffer.data());
+
+	for (std::vector<Complex>::const_iterator it = m_mixerBuffer.begin(); it < m_mixerBuffer.end(); ++it)
 	{
-		Complex c(it->real() / 32768.0f, it->imag() / 32768.0f);
-		c *= m_nco.nextIQ();
+		Complex c = *it / 32768.0f;
 
 		if(m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
 		{
@@ -136,6 +136,7 @@ private:
 	short* finetune;
 
 	NCO m_nco;
+	std::vector<Complex> m_mixerBuffer; //!< input samples shifted by the NCO
 	Interpolator m_interpolator;
 	Real m_sampleDistanceRemain;
 
@@ -129,161 +129,161 @@ void NFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 	m_settingsMutex.lock();
 
-	for (SampleVector::const_iterator it = begin; it != end; ++it)
+	m_mixerBuffer.resize(end - begin);
+	m_nco.mix(begin, end, m_mixerBuffer.data());
+
+	m_resampledBuffer.resize(m_interpolator.getResampleBlockSize(m_mixerBuffer.size()));
+	int nbResampled = m_interpolator.resampleBlock(m_mixerBuffer.data(), m_mixerBuffer.size(), m_resampledBuffer.data());
+
+	for (int i = 0; i < nbResampled; i++)
 	{
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+		ci = m_resampledBuffer[i];
 
-        if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
-        {
+        qint16 sample;
 
-            qint16 sample;
+        double magsqRaw; // = ci.real()*ci.real() + c.imag()*c.imag();
+        Real deviation;
 
-            double magsqRaw; // = ci.real()*ci.real() + c.imag()*c.imag();
-            Real deviation;
+        Real demod = m_phaseDiscri.phaseDiscriminatorDelta(ci, magsqRaw, deviation);
 
-            Real demod = m_phaseDiscri.phaseDiscriminatorDelta(ci, magsqRaw, deviation);
+        Real magsq = magsqRaw / (1<<30);
+        m_movingAverage.feed(magsq);
+        m_magsqSum += magsq;
 
-            Real magsq = magsqRaw / (1<<30);
-            m_movingAverage.feed(magsq);
-            m_magsqSum += magsq;
+        if (magsq > m_magsqPeak)
+        {
+            m_magsqPeak = magsq;
+        }
 
-            if (magsq > m_magsqPeak)
-            {
-                m_magsqPeak = magsq;
-            }
+        m_magsqCount++;
+        m_sampleCount++;
 
-            m_magsqCount++;
-            m_sampleCount++;
+        // AF processing
 
-            // AF processing
+        if (m_settings.m_deltaSquelch)
+        {
+            if (m_afSquelch.analyze(demod)) {
+                m_afSquelchOpen = m_afSquelch.evaluate() ? m_squelchGate + 480 : 0;
+            }
 
-            if (m_settings.m_deltaSquelch)
+            if (m_afSquelchOpen)
             {
-                if (m_afSquelch.analyze(demod)) {
-                    m_afSquelchOpen = m_afSquelch.evaluate() ? m_squelchGate + 480 : 0;
-                }
-
-                if (m_afSquelchOpen)
+                if (m_squelchCount < m_squelchGate + 480)
                 {
-                    if (m_squelchCount < m_squelchGate + 480)
-                    {
-                        m_squelchCount++;
-                    }
+                    m_squelchCount++;
                 }
-                else
+            }
+            else
+            {
+                if (m_squelchCount > 0)
                 {
-                    if (m_squelchCount > 0)
-                    {
-                        m_squelchCount--;
-                    }
+                    m_squelchCount--;
                 }
             }
-            else
+        }
+        else
+        {
+            if (m_movingAverage.average() < m_squelchLevel)
             {
-                if (m_movingAverage.average() < m_squelchLevel)
+                if (m_squelchCount > 0)
                 {
-                    if (m_squelchCount > 0)
-                    {
-                        m_squelchCount--;
-                    }
+                    m_squelchCount--;
                 }
-                else
+            }
+            else
+            {
+                if (m_squelchCount < m_squelchGate + 480)
                 {
-                    if (m_squelchCount < m_squelchGate + 480)
-                    {
-                        m_squelchCount++;
-                    }
+                    m_squelchCount++;
                 }
             }
+        }
 
-            m_squelchOpen = (m_squelchCount > m_squelchGate);
+        m_squelchOpen = (m_squelchCount > m_squelchGate);
 
-            if ((m_squelchOpen) && !m_settings.m_audioMute)
+        if ((m_squelchOpen) && !m_settings.m_audioMute)
+        {
+            if (m_settings.m_ctcssOn)
             {
-                if (m_settings.m_ctcssOn)
-                {
-                    Real ctcss_sample = m_lowpass.filter(demod);
+                Real ctcss_sample = m_lowpass.filter(demod);
 
-                    if ((m_sampleCount & 7) == 7) // decimate 48k -> 6k
+                if ((m_sampleCount & 7) == 7) // decimate 48k -> 6k
+                {
+                    if (m_ctcssDetector.analyze(&ctcss_sample))
                     {
-                        if (m_ctcssDetector.analyze(&ctcss_sample))
-                        {
-                            int maxToneIndex;
+                        int maxToneIndex;
 
-                            if (m_ctcssDetector.getDetectedTone(maxToneIndex))
+                        if (m_ctcssDetector.getDetectedTone(maxToneIndex))
+                        {
+                            if (maxToneIndex+1 != m_ctcssIndex)
                             {
-                                if (maxToneIndex+1 != m_ctcssIndex)
-                                {
-                                    if (getMessageQueueToGUI()) {
-                                        MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(m_ctcssDetector.getToneSet()[maxToneIndex]);
-                                        getMessageQueueToGUI()->push(msg);
-                                    }
-                                    m_ctcssIndex = maxToneIndex+1;
+                                if (getMessageQueueToGUI()) {
+                                    MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(m_ctcssDetector.getToneSet()[maxToneIndex]);
+                                    getMessageQueueToGUI()->push(msg);
                                 }
+                                m_ctcssIndex = maxToneIndex+1;
                             }
-                            else
+                        }
+                        else
+                        {
+                            if (m_ctcssIndex != 0)
                             {
-                                if (m_ctcssIndex != 0)
-                                {
-                                    if (getMessageQueueToGUI()) {
-                                        MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(0);
-                                        getMessageQueueToGUI()->push(msg);
-                                    }
-                                    m_ctcssIndex = 0;
+                                if (getMessageQueueToGUI()) {
+                                    MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(0);
+                                    getMessageQueueToGUI()->push(msg);
                                 }
+                                m_ctcssIndex = 0;
                             }
                         }
                     }
                 }
+            }
 
-                if (m_settings.m_ctcssOn && m_ctcssIndexSelected && (m_ctcssIndexSelected != m_ctcssIndex))
-                {
-                    sample = 0;
-                    if (m_settings.m_copyAudioToUDP) m_udpBufferAudio->write(0);
-                }
-                else
-                {
-                    demod = m_bandpass.filter(demod);
-                    Real squelchFactor = StepFunctions::smootherstep((Real) (m_squelchCount - m_squelchGate) / 480.0f);
-                    sample = demod * m_settings.m_volume * squelchFactor;
-                    if (m_settings.m_copyAudioToUDP) m_udpBufferAudio->write(demod * 5.0f * squelchFactor);
-                }
+            if (m_settings.m_ctcssOn && m_ctcssIndexSelected && (m_ctcssIndexSelected != m_ctcssIndex))
+            {
+                sample = 0;
+                if (m_settings.m_copyAudioToUDP) m_udpBufferAudio->write(0);
             }
             else
             {
-                if (m_ctcssIndex != 0)
-                {
-                    if (getMessageQueueToGUI()) {
-                        MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(0);
-                        getMessageQueueToGUI()->push(msg);
-                    }
-
-                    m_ctcssIndex = 0;
+                demod = m_bandpass.filter(demod);
+                Real squelchFactor = StepFunctions::smootherstep((Real) (m_squelchCount - m_squelchGate) / 480.0f);
+                sample = demod * m_settings.m_volume * squelchFactor;
+                if (m_settings.m_copyAudioToUDP) m_udpBufferAudio->write(demod * 5.0f * squelchFactor);
+            }
+        }
+        else
+        {
+            if (m_ctcssIndex != 0)
+            {
+                if (getMessageQueueToGUI()) {
+                    MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(0);
+                    getMessageQueueToGUI()->push(msg);
                 }
 
-                sample = 0;
-                if (m_settings.m_copyAudioToUDP) m_udpBufferAudio->write(0);
+                m_ctcssIndex = 0;
             }
 
-            m_audioBuffer[m_audioBufferFill].l = sample;
-            m_audioBuffer[m_audioBufferFill].r = sample;
-            ++m_audioBufferFill;
+            sample = 0;
+            if (m_settings.m_copyAudioToUDP) m_udpBufferAudio->write(0);
+        }
 
-            if (m_audioBufferFill >= m_audioBuffer.size())
-            {
-                uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 10);
+        m_audioBuffer[m_audioBufferFill].l = sample;
+        m_audioBuffer[m_audioBufferFill].r = sample;
+        ++m_audioBufferFill;
 
-                if (res != m_audioBufferFill)
-                {
-                    qDebug("NFMDemod::feed: %u/%u audio samples written", res, m_audioBufferFill);
-                }
+        if (m_audioBufferFill >= m_audioBuffer.size())
+        {
+            uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 10);
 
-                m_audioBufferFill = 0;
+            if (res != m_audioBufferFill)
+            {
+                qDebug("NFMDemod::feed: %u/%u audio samples written", res, m_audioBufferFill);
             }
 
-            m_interpolatorDistanceRemain += m_interpolatorDistance;
+            m_audioBufferFill = 0;
         }
+
 	}
 
 	if (m_audioBufferFill > 0)
@@ -392,8 +392,8 @@ void NFMDemod::applySettings(const NFMDemodSettings& settings, bool force)
     {
         m_settingsMutex.lock();
         m_interpolator.create(16, settings.m_inputSampleRate, settings.m_rfBandwidth / 2.2);
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorDistance =  (Real) settings.m_inputSampleRate / (Real) settings.m_audioSampleRate;
+        m_interpolatorDistance = (Real) settings.m_inputSampleRate / (Real) settings.m_audioSampleRate;
+        m_interpolator.setResampleRatio(m_interpolatorDistance);
         m_settingsMutex.unlock();
     }
 
@@ -448,5 +448,10 @@ void NFMDemod::applySettings(const NFMDemodSettings& settings, bool force)
         setSelectedCtcssIndex(settings.m_ctcssIndex);
     }
 
+    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
+    {
+        DSPEngine::instance()->addAudioSink(&m_audioFifo, settings.m_audioDeviceName);
+    }
+
     m_settings = settings;
 }
@@ -160,9 +160,10 @@ private:
 	int m_absoluteFrequencyOffset;
 
 	NCO m_nco;
+	std::vector<Complex> m_mixerBuffer; //!< input samples shifted by the NCO
+	std::vector<Complex> m_resampledBuffer; //!< channel samples resampled to the audio rate
 	Interpolator m_interpolator;
 	Real m_interpolatorDistance;
-	Real m_interpolatorDistanceRemain;
 	Lowpass<Real> m_lowpass;
 	Bandpass<Real> m_bandpass;
 	CTCSSDetector m_ctcssDetector;
@@ -12,6 +12,7 @@
 #include "util/simpleserializer.h"
 #include "util/db.h"
 #include "gui/basicchannelsettingsdialog.h"
+#include "gui/audioselectdialog.h"
 #include "dsp/dspengine.h"
 #include "mainwindow.h"
 #include "nfmdemod.h"
@@ -233,6 +234,19 @@ void NFMDemodGUI::onMenuDialogCalled(const QPoint &p)
     applySettings();
 }
 
+void NFMDemodGUI::audioSelect()
+{
+    qDebug("NFMDemodGUI::audioSelect");
+    AudioSelectDialog audioSelect(m_settings.m_audioDeviceName);
+    audioSelect.exec();
+
+    if (audioSelect.hasChanged())
+    {
+        m_settings.m_audioDeviceName = audioSelect.getDeviceName();
+        applySettings();
+    }
+}
+
 NFMDemodGUI::NFMDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel, QWidget* parent) :
 	RollupWidget(parent),
 	ui(new Ui::NFMDemodGUI),
@@ -246,6 +260,8 @@ NFMDemodGUI::NFMDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, Baseban
 {
 	ui->setupUi(this);
 	setAttribute(Qt::WA_DeleteOnClose, true);
+	ui->audioMute->setContextMenuPolicy(Qt::CustomContextMenu);
+	connect(ui->audioMute, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(audioSelect()));
 
 	connect(this, SIGNAL(widgetRolled(QWidget*,bool)), this, SLOT(onWidgetRolled(QWidget*,bool)));
     connect(this, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(onMenuDialogCalled(const QPoint &)));
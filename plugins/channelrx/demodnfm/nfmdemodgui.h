@@ -68,6 +68,7 @@ private:
 	void enterEvent(QEvent*);
 
 private slots:
+	void audioSelect();
 	void on_deltaFrequency_changed(qint64 value);
 	void on_rfBW_currentIndexChanged(int index);
 	void on_afBW_valueChanged(int value);
@@ -56,6 +56,7 @@ void NFMDemodSettings::resetToDefaults()
     m_udpPort = 9999;
     m_rgbColor = QColor(255, 0, 0).rgb();
     m_title = "NFM Demodulator";
+    m_audioDeviceName = AudioDeviceManager::m_defaultDeviceName;
 }
 
 QByteArray NFMDemodSettings::serialize() const
@@ -79,6 +80,7 @@ QByteArray NFMDemodSettings::serialize() const
 
     s.writeString(14, m_title);
 
+    s.writeString(15, m_audioDeviceName);
     return s.final();
 }
 
@@ -121,6 +123,7 @@ bool NFMDemodSettings::deserialize(const QByteArray& data)
         d.readS32(11, &m_squelchGate, 5);
         d.readBool(12, &m_deltaSquelch, false);
         d.readString(14, &m_title, "NFM Demodulator");
+        d.readString(15, &m_audioDeviceName, AudioDeviceManager::m_defaultDeviceName);
 
         return true;
     }
@@ -45,6 +45,7 @@ struct NFMDemodSettings
     uint16_t m_udpPort;
     quint32 m_rgbColor;
     QString m_title;
+    QString m_audioDeviceName;
 
     Serializable *m_channelMarker;
 
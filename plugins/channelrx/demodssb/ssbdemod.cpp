@@ -65,7 +65,8 @@ SSBDemod::SSBDemod(DeviceSourceAPI *deviceAPI) :
 	m_audioSampleRate = DSPEngine::instance()->getAudioSampleRate();
 
 	m_interpolator.create(16, m_sampleRate, 5000);
-	m_sampleDistanceRemain = (Real) m_sampleRate / m_audioSampleRate;
+	m_interpolatorDistance = (Real) m_sampleRate / (Real) m_audioSampleRate;
+	m_interpolator.setResampleRatio(m_interpolatorDistance);
 
 	m_audioBuffer.resize(1<<9);
 	m_audioBufferFill = 0;
@@ -141,7 +142,6 @@ void SSBDemod::configure(MessageQueue* messageQueue,
 
 void SSBDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly __attribute__((unused)))
 {
-	Complex ci;
 	fftfilt::cmplx *sideband;
 	int n_out;
 
@@ -150,110 +150,111 @@ void SSBDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 	int decim = 1<<(m_spanLog2 - 1);
 	unsigned char decim_mask = decim - 1; // counter LSB bit mask for decimation by 2^(m_scaleLog2 - 1)
 
-	for(SampleVector::const_iterator it = begin; it < end; ++it)
+	m_mixerBuffer.resize(end - begin);
+	Complex *mixed = m_mixerBuffer.data();
+
+	for(SampleVector::const_iterator it = begin; it < end; ++it, ++mixed)
 	{
-		//Complex c(it->real() / 32768.0, it->imag() / 32768.0);
 		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+		*mixed = c * m_nco.nextIQ();
+	}
 
-		if(m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
-		{
-			if (m_dsb)
-			{
-				n_out = DSBFilter->runDSB(ci, &sideband);
-			}
-			else
-			{
-				n_out = SSBFilter->runSSB(ci, &sideband, m_usb);
-			}
+	m_decimatedBuffer.resize(m_interpolator.getResampleBlockSize(m_mixerBuffer.size()));
+	int nbDecimated = m_interpolator.resampleBlock(m_mixerBuffer.data(), m_mixerBuffer.size(), m_decimatedBuffer.data());
 
-			m_sampleDistanceRemain += (Real)m_sampleRate / m_audioSampleRate;
-		}
-		else
-		{
-			n_out = 0;
-		}
+	// filter the whole decimated block at once
+	if (m_dsb)
+	{
+		m_sidebandBuffer.resize(DSBFilter->getBlockOutputSize(nbDecimated));
+		n_out = DSBFilter->runDSBBlock(m_decimatedBuffer.data(), nbDecimated, m_sidebandBuffer.data());
+	}
+	else
+	{
+		m_sidebandBuffer.resize(SSBFilter->getBlockOutputSize(nbDecimated));
+		n_out = SSBFilter->runSSBBlock(m_decimatedBuffer.data(), nbDecimated, m_sidebandBuffer.data(), m_usb);
+	}
 
-		for (int i = 0; i < n_out; i++)
-		{
-			// Downsample by 2^(m_scaleLog2 - 1) for SSB band spectrum display
-			// smart decimation with bit gain using float arithmetic (23 bits significand)
+	sideband = m_sidebandBuffer.data();
 
-			m_sum += sideband[i];
+	for (int i = 0; i < n_out; i++)
+	{
+		// Downsample by 2^(m_scaleLog2 - 1) for SSB band spectrum display
+		// smart decimation with bit gain using float arithmetic (23 bits significand)
 
-			if (!(m_undersampleCount++ & decim_mask))
-			{
-				Real avgr = m_sum.real() / decim;
-				Real avgi = m_sum.imag() / decim;
-				m_magsq = (avgr * avgr + avgi * avgi) / (1<<30);
+		m_sum += sideband[i];
 
-                m_magsqSum += m_magsq;
+		if (!(m_undersampleCount++ & decim_mask))
+		{
+			Real avgr = m_sum.real() / decim;
+			Real avgi = m_sum.imag() / decim;
+			m_magsq = (avgr * avgr + avgi * avgi) / (1<<30);
 
-                if (m_magsq > m_magsqPeak)
-                {
-                    m_magsqPeak = m_magsq;
-                }
+            m_magsqSum += m_magsq;
 
-                m_magsqCount++;
+            if (m_magsq > m_magsqPeak)
+            {
+                m_magsqPeak = m_magsq;
+            }
 
-				if (!m_dsb & !m_usb)
-				{ // invert spectrum for LSB
-					m_sampleBuffer.push_back(Sample(avgi, avgr));
-				}
-				else
-				{
-					m_sampleBuffer.push_back(Sample(avgr, avgi));
-				}
+            m_magsqCount++;
 
-                m_sum.real(0.0);
-                m_sum.imag(0.0);
+			if (!m_dsb & !m_usb)
+			{ // invert spectrum for LSB
+				m_sampleBuffer.push_back(Sample(avgi, avgr));
 			}
-
-            double agcVal = m_agcActive ? m_agc.feedAndGetValue(sideband[i]) : 10.0; // 10.0 for 3276.8, 1.0 for 327.68
-            m_audioActive = agcVal != 0.0;
-
-			if (m_audioMute)
+			else
 			{
-				m_audioBuffer[m_audioBufferFill].r = 0;
-				m_audioBuffer[m_audioBufferFill].l = 0;
+				m_sampleBuffer.push_back(Sample(avgr, avgi));
 			}
-			else
+
+            m_sum.real(0.0);
+            m_sum.imag(0.0);
+		}
+
+        double agcVal = m_agcActive ? m_agc.feedAndGetValue(sideband[i]) : 10.0; // 10.0 for 3276.8, 1.0 for 327.68
+        m_audioActive = agcVal != 0.0;
+
+		if (m_audioMute)
+		{
+			m_audioBuffer[m_audioBufferFill].r = 0;
+			m_audioBuffer[m_audioBufferFill].l = 0;
+		}
+		else
+		{
+			if (m_audioBinaual)
 			{
-				if (m_audioBinaual)
+				if (m_audioFlipChannels)
 				{
-					if (m_audioFlipChannels)
-					{
-						m_audioBuffer[m_audioBufferFill].r = (qint16)(sideband[i].imag() * m_volume * agcVal);
-						m_audioBuffer[m_audioBufferFill].l = (qint16)(sideband[i].real() * m_volume * agcVal);
-					}
-					else
-					{
-						m_audioBuffer[m_audioBufferFill].r = (qint16)(sideband[i].real() * m_volume * agcVal);
-						m_audioBuffer[m_audioBufferFill].l = (qint16)(sideband[i].imag() * m_volume * agcVal);
-					}
+					m_audioBuffer[m_audioBufferFill].r = (qint16)(sideband[i].imag() * m_volume * agcVal);
+					m_audioBuffer[m_audioBufferFill].l = (qint16)(sideband[i].real() * m_volume * agcVal);
 				}
 				else
 				{
-					Real demod = (sideband[i].real() + sideband[i].imag()) * 0.7;
-					qint16 sample = (qint16)(demod * m_volume * agcVal);
-					m_audioBuffer[m_audioBufferFill].l = sample;
-					m_audioBuffer[m_audioBufferFill].r = sample;
+					m_audioBuffer[m_audioBufferFill].r = (qint16)(sideband[i].real() * m_volume * agcVal);
+					m_audioBuffer[m_audioBufferFill].l = (qint16)(sideband[i].imag() * m_volume * agcVal);
 				}
 			}
-
-			++m_audioBufferFill;
-
-			if (m_audioBufferFill >= m_audioBuffer.size())
+			else
 			{
-				uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 1);
+				Real demod = (sideband[i].real() + sideband[i].imag()) * 0.7;
+				qint16 sample = (qint16)(demod * m_volume * agcVal);
+				m_audioBuffer[m_audioBufferFill].l = sample;
+				m_audioBuffer[m_audioBufferFill].r = sample;
+			}
+		}
 
-				if (res != m_audioBufferFill)
-				{
-					qDebug("lost %u samples", m_audioBufferFill - res);
-				}
+		++m_audioBufferFill;
+
+		if (m_audioBufferFill >= m_audioBuffer.size())
+		{
+			uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill, 1);
 
-				m_audioBufferFill = 0;
+			if (res != m_audioBufferFill)
+			{
+				qDebug("lost %u samples", m_audioBufferFill - res);
 			}
+
+			m_audioBufferFill = 0;
 		}
 	}
 
@@ -292,7 +293,8 @@ bool SSBDemod::handleMessage(const Message& cmd)
 		m_sampleRate = notif.getSampleRate();
 		m_nco.setFreq(-notif.getFrequencyOffset(), m_sampleRate);
 		m_interpolator.create(16, m_sampleRate, m_Bandwidth);
-		m_sampleDistanceRemain = m_sampleRate / m_audioSampleRate;
+		m_interpolatorDistance = (Real) m_sampleRate / (Real) m_audioSampleRate;
+		m_interpolator.setResampleRatio(m_interpolatorDistance);
 
 		m_settingsMutex.unlock();
 
@@ -395,6 +397,8 @@ void SSBDemod::applySettings(const SSBDemodSettings& settings, bool force)
 
         m_settingsMutex.lock();
         m_interpolator.create(16, m_sampleRate, band * 2.0f);
+        m_interpolatorDistance = (Real) m_sampleRate / (Real) m_audioSampleRate;
+        m_interpolator.setResampleRatio(m_interpolatorDistance);
         SSBFilter->create_filter(m_LowCutoff / (float) m_audioSampleRate, m_Bandwidth / (float) m_audioSampleRate);
         DSBFilter->create_dsb_filter((2.0f * m_Bandwidth) / (float) m_audioSampleRate);
         m_settingsMutex.unlock();
@@ -466,6 +470,11 @@ void SSBDemod::applySettings(const SSBDemodSettings& settings, bool force)
     m_audioMute = settings.m_audioMute;
     m_agcActive = settings.m_agc;
 
+    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
+    {
+        DSPEngine::instance()->addAudioSink(&m_audioFifo, settings.m_audioDeviceName);
+    }
+
     m_settings = settings;
 }
 
@@ -257,9 +257,12 @@ private:
 
 	NCOF m_nco;
 	Interpolator m_interpolator;
-	Real m_sampleDistanceRemain;
+	Real m_interpolatorDistance;
 	fftfilt* SSBFilter;
 	fftfilt* DSBFilter;
+	std::vector<Complex> m_mixerBuffer;         //!< input samples shifted by the NCO
+	std::vector<Complex> m_decimatedBuffer;     //!< channel samples decimated to the audio rate
+	std::vector<fftfilt::cmplx> m_sidebandBuffer; //!< sideband filter output
 
 	BasebandSampleSink* m_sampleSink;
 	SampleVector m_sampleBuffer;
@@ -9,6 +9,7 @@
 #include "ui_ssbdemodgui.h"
 #include "dsp/spectrumvis.h"
 #include "gui/glspectrum.h"
+#include "gui/audioselectdialog.h"
 #include "plugin/pluginapi.h"
 #include "util/simpleserializer.h"
 #include "util/db.h"
@@ -191,6 +192,19 @@ void SSBDemodGUI::onWidgetRolled(QWidget* widget __attribute__((unused)), bool r
 {
 }
 
+void SSBDemodGUI::audioSelect()
+{
+    qDebug("SSBDemodGUI::audioSelect");
+    AudioSelectDialog audioSelect(m_settings.m_audioDeviceName);
+    audioSelect.exec();
+
+    if (audioSelect.hasChanged())
+    {
+        m_settings.m_audioDeviceName = audioSelect.getDeviceName();
+        applySettings();
+    }
+}
+
 SSBDemodGUI::SSBDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel, QWidget* parent) :
 	RollupWidget(parent),
 	ui(new Ui::SSBDemodGUI),
@@ -207,6 +221,8 @@ SSBDemodGUI::SSBDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, Baseban
 	ui->setupUi(this);
 	setAttribute(Qt::WA_DeleteOnClose, true);
 	connect(this, SIGNAL(widgetRolled(QWidget*,bool)), this, SLOT(onWidgetRolled(QWidget*,bool)));
+	ui->audioMute->setContextMenuPolicy(Qt::CustomContextMenu);
+	connect(ui->audioMute, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(audioSelect()));
 
 	m_spectrumVis = new SpectrumVis(ui->glSpectrum);
 	m_ssbDemod = (SSBDemod*) rxChannel; //new SSBDemod(m_deviceUISet->m_deviceSourceAPI);
@@ -75,6 +75,7 @@ private:
 	void enterEvent(QEvent*);
 
 private slots:
+	void audioSelect();
 	void on_deltaFrequency_changed(qint64 value);
 	void on_audioBinaural_toggled(bool binaural);
 	void on_audioFlipChannels_toggled(bool flip);
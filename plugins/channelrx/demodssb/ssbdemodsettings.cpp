@@ -48,6 +48,7 @@ void SSBDemodSettings::resetToDefaults()
     m_audioSampleRate = DSPEngine::instance()->getAudioSampleRate();
     m_rgbColor = QColor(0, 255, 0).rgb();
     m_title = "SSB Demodulator";
+    m_audioDeviceName = AudioDeviceManager::m_defaultDeviceName;
 }
 
 QByteArray SSBDemodSettings::serialize() const
@@ -74,6 +75,7 @@ QByteArray SSBDemodSettings::serialize() const
     s.writeBool(15, m_agcClamping);
     s.writeString(16, m_title);
 
+    s.writeString(17, m_audioDeviceName);
     return s.final();
 }
 
@@ -117,6 +119,7 @@ bool SSBDemodSettings::deserialize(const QByteArray& data)
         d.readS32(14, &m_agcThresholdGate, 4);
         d.readBool(15, &m_agcClamping, false);
         d.readString(16, &m_title, "SSB Demodulator");
+        d.readString(17, &m_audioDeviceName, AudioDeviceManager::m_defaultDeviceName);
 
         return true;
     }
@@ -95,11 +95,12 @@ void WFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 	m_settingsMutex.lock();
 
-	for (SampleVector::const_iterator it = begin; it != end; ++it)
+	m_mixerBuffer.resize(end - begin);
+	m_nco.mix(begin, end, m_mixerBuffer.data());
+
+	for (std::vector<Complex>::const_iterator it = m_mixerBuffer.begin(); it != m_mixerBuffer.end(); ++it)
 	{
-		//Complex c(it->real() / 32768.0f, it->imag() / 32768.0f);
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+		Complex c = *it;
 
 		rf_out = m_rfFilter->runFilt(c, &rf); // filter RF before demod
 
@@ -303,5 +304,10 @@ void WFMDemod::applySettings(const WFMDemodSettings& settings, bool force)
         m_squelchLevel *= m_squelchLevel;
     }
 
+    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
+    {
+        DSPEngine::instance()->addAudioSink(&m_audioFifo, settings.m_audioDeviceName);
+    }
+
     m_settings = settings;
 }
@@ -13,6 +13,7 @@
 #include "util/simpleserializer.h"
 #include "util/db.h"
 #include "gui/basicchannelsettingsdialog.h"
+#include "gui/audioselectdialog.h"
 #include "mainwindow.h"
 
 #include "wfmdemod.h"
@@ -154,6 +155,19 @@ void WFMDemodGUI::onMenuDialogCalled(const QPoint &p)
     applySettings();
 }
 
+void WFMDemodGUI::audioSelect()
+{
+    qDebug("WFMDemodGUI::audioSelect");
+    AudioSelectDialog audioSelect(m_settings.m_audioDeviceName);
+    audioSelect.exec();
+
+    if (audioSelect.hasChanged())
+    {
+        m_settings.m_audioDeviceName = audioSelect.getDeviceName();
+        applySettings();
+    }
+}
+
 WFMDemodGUI::WFMDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, BasebandSampleSink *rxChannel, QWidget* parent) :
 	RollupWidget(parent),
 	ui(new Ui::WFMDemodGUI),
@@ -167,6 +181,8 @@ WFMDemodGUI::WFMDemodGUI(PluginAPI* pluginAPI, DeviceUISet *deviceUISet, Baseban
 	setAttribute(Qt::WA_DeleteOnClose, true);
 	connect(this, SIGNAL(widgetRolled(QWidget*,bool)), this, SLOT(onWidgetRolled(QWidget*,bool)));
     connect(this, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(onMenuDialogCalled(const QPoint &)));
+    ui->audioMute->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(ui->audioMute, SIGNAL(customContextMenuRequested(const QPoint &)), this, SLOT(audioSelect()));
 
 	m_wfmDemod = (WFMDemod*) rxChannel; //new WFMDemod(m_deviceUISet->m_deviceSourceAPI);
 
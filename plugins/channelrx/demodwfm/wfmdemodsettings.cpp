@@ -49,6 +49,7 @@ void WFMDemodSettings::resetToDefaults()
     m_udpPort = 9999;
     m_rgbColor = QColor(0, 0, 255).rgb();
     m_title = "WFM Demodulator";
+    m_audioDeviceName = AudioDeviceManager::m_defaultDeviceName;
 }
 
 QByteArray WFMDemodSettings::serialize() const
@@ -66,6 +67,7 @@ QByteArray WFMDemodSettings::serialize() const
         s.writeBlob(11, m_channelMarker->serialize());
     }
 
+    s.writeString(12, m_audioDeviceName);
     return s.final();
 }
 
@@ -104,6 +106,8 @@ bool WFMDemodSettings::deserialize(const QByteArray& data)
             m_channelMarker->deserialize(bytetmp);
         }
 
+        d.readString(12, &m_audioDeviceName, AudioDeviceManager::m_defaultDeviceName);
+
         return true;
     }
     else
@@ -35,6 +35,7 @@ struct WFMDemodSettings
     quint16 m_udpPort;
     quint32 m_rgbColor;
     QString m_title;
+    QString m_audioDeviceName;
 
     Serializable *m_channelMarker;
 
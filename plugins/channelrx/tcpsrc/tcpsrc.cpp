@@ -98,10 +98,12 @@ void TCPSrc::feed(const SampleVector::const_iterator& begin, const SampleVector:
 	//int rescale = 32768 * (1 << m_boost);
 	int rescale = (1 << m_volume);
 
-	for(SampleVector::const_iterator it = begin; it < end; ++it) {
-		//Complex c(it->real() / 32768.0f, it->imag() / 32768.0f);
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+	m_mixerBuffer.resize(end - begin);
+	m_nco.mix(begin, end, m_mixerBuffer.data());
+	std::vector<Complex>::const_iterator mixed = m_mixerBuffer.begin();
+
+	for(SampleVector::const_iterator it = begin; it < end; ++it, ++mixed) {
+		Complex c = *mixed;
 
 		if(m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
 		{
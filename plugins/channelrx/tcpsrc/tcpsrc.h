@@ -180,6 +180,7 @@ protected:
 	Complex m_last, m_this;
 
 	NCO m_nco;
+	std::vector<Complex> m_mixerBuffer; //!< input samples shifted by the NCO
 	Interpolator m_interpolator;
 	Real m_sampleDistanceRemain;
 	fftfilt* TCPFilter;
@@ -131,10 +131,12 @@ void UDPSrc::feed(const SampleVector::const_iterator& begin, const SampleVector:
 	m_sampleBuffer.clear();
 	m_settingsMutex.lock();
 
-	for(SampleVector::const_iterator it = begin; it < end; ++it)
+	m_mixerBuffer.resize(end - begin);
+	m_nco.mix(begin, end, m_mixerBuffer.data());
+
+	for (std::vector<Complex>::const_iterator it = m_mixerBuffer.begin(); it < m_mixerBuffer.end(); ++it)
 	{
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+		Complex c = *it;
 
 		if(m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
 		{
@@ -514,12 +516,13 @@ void UDPSrc::applySettings(const UDPSrcSettings& settings, bool force)
         m_outMovingAverage.resize(settings.m_outputSampleRate * 0.01, 1e-10); // 10 ms
     }
 
-    if ((settings.m_audioActive != m_settings.m_audioActive) || force)
+    if ((settings.m_audioActive != m_settings.m_audioActive)
+        || (settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
     {
         if (settings.m_audioActive)
         {
             m_audioBufferFill = 0;
-            DSPEngine::instance()->addAudioSink(&m_audioFifo);
+            DSPEngine::instance()->addAudioSink(&m_audioFifo, settings.m_audioDeviceName);
         }
         else
         {
@@ -93,6 +93,7 @@ private:
 	void enterEvent(QEvent*);
 
 private slots:
+	void audioSelect();
 	void on_deltaFrequency_changed(qint64 value);
 	void on_sampleFormat_currentIndexChanged(int index);
 	void on_sampleRate_textEdited(const QString& arg1);
@@ -50,6 +50,7 @@ void UDPSrcSettings::resetToDefaults()
     m_audioPort = 9998;
     m_rgbColor = QColor(225, 25, 99).rgb();
     m_title = "UDP Sample Source";
+    m_audioDeviceName = AudioDeviceManager::m_defaultDeviceName;
 }
 
 QByteArray UDPSrcSettings::serialize() const
@@ -79,6 +80,7 @@ QByteArray UDPSrcSettings::serialize() const
     s.writeBool(18, m_agc);
     s.writeString(19, m_title);
 
+    s.writeString(20, m_audioDeviceName);
     return s.final();
 
 }
@@ -134,6 +136,7 @@ bool UDPSrcSettings::deserialize(const QByteArray& data)
         d.readS32(17, &m_squelchGate, 5);
         d.readBool(18, &m_agc, false);
         d.readString(19, &m_title, "UDP Sample Source");
+        d.readString(20, &m_audioDeviceName, AudioDeviceManager::m_defaultDeviceName);
 
         return true;
     }
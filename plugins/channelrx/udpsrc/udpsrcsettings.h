@@ -61,6 +61,7 @@ struct UDPSrcSettings
     uint16_t m_audioPort;
 
     QString m_title;
+    QString m_audioDeviceName;
 
     Serializable *m_channelMarker;
     Serializable *m_spectrumGUI;
@@ -19,6 +19,7 @@
 #include <QTime>
 #include <QDebug>
 #include <QMutexLocker>
+#include <algorithm>
 #include <stdio.h>
 #include <complex.h>
 #include <dsp/upchannelizer.h>
@@ -97,9 +98,31 @@ void AMMod::pull(Sample& sample)
 		return;
 	}
 
-	Complex ci;
-
 	m_settingsMutex.lock();
+	pullOne(sample);
+	m_settingsMutex.unlock();
+}
+
+void AMMod::pullBlock(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    if (m_settings.m_channelMute)
+    {
+        std::fill(begin, begin + nbSamples, Sample());
+        return;
+    }
+
+    m_settingsMutex.lock();
+
+    for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+        pullOne(*begin);
+    }
+
+    m_settingsMutex.unlock();
+}
+
+void AMMod::pullOne(Sample& sample)
+{
+	Complex ci;
 
     if (m_interpolatorDistance > 1.0f) // decimate
     {
@@ -122,8 +145,6 @@ void AMMod::pull(Sample& sample)
 
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
 
-    m_settingsMutex.unlock();
-
     Real magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
 	magsq /= (1<<30);
 	m_movingAverage.feed(magsq);
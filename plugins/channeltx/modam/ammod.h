@@ -230,6 +230,7 @@ public:
     ~AMMod();
 
     virtual void pull(Sample& sample);
+    virtual void pullBlock(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples);
     virtual void start();
     virtual void stop();
@@ -304,6 +305,7 @@ private:
     void applySettings(const AMModSettings& settings, bool force = false);
     void pullAF(Real& sample);
     void calculateLevel(Real& sample);
+    void pullOne(Sample& sample); //!< modulate one sample with the settings lock held
     void modulateSample();
     void openFileStream();
     void seekFileStream(int seekPercentage);
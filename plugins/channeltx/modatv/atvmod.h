@@ -396,6 +396,7 @@ public:
     ~ATVMod();
 
     virtual void pull(Sample& sample);
+    virtual void pullBlock(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples); // this is used for video signal actually
     virtual void start();
     virtual void stop();
@@ -554,6 +555,7 @@ private:
     static const int m_cameraFPSTestNbFrames; //!< number of frames for camera FPS test
 
     void applySettings(const ATVModSettings& settings, bool force = false);
+    void pullOne(Sample& sample); //!< modulate one sample with the settings lock held
     void pullFinalize(Complex& ci, Sample& sample);
     void pullVideo(Real& sample);
     void calculateLevel(Real& sample);
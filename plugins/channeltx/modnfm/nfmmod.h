@@ -232,6 +232,7 @@ public:
     ~NFMMod();
 
     virtual void pull(Sample& sample);
+    virtual void pullBlock(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples);
     virtual void start();
     virtual void stop();
@@ -310,6 +311,7 @@ private:
     void applySettings(const NFMModSettings& settings, bool force = false);
     void pullAF(Real& sample);
     void calculateLevel(Real& sample);
+    void pullOne(Sample& sample); //!< modulate one sample with the settings lock held
     void modulateSample();
     void openFileStream();
     void seekFileStream(int seekPercentage);
@@ -19,6 +19,7 @@
 #include <QTime>
 #include <QDebug>
 #include <QMutexLocker>
+#include <algorithm>
 #include <stdio.h>
 #include <complex.h>
 #include <dsp/upchannelizer.h>
@@ -131,9 +132,25 @@ SSBMod::~SSBMod()
 
 void SSBMod::pull(Sample& sample)
 {
-	Complex ci;
-
 	m_settingsMutex.lock();
+	pullOne(sample);
+	m_settingsMutex.unlock();
+}
+
+void SSBMod::pullBlock(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    m_settingsMutex.lock();
+
+    for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+        pullOne(*begin);
+    }
+
+    m_settingsMutex.unlock();
+}
+
+void SSBMod::pullOne(Sample& sample)
+{
+	Complex ci;
 
     if (m_interpolatorDistance > 1.0f) // decimate
     {
@@ -157,8 +174,6 @@ void SSBMod::pull(Sample& sample)
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
     ci *= 29204.0f; //scaling at -1 dB to account for possible filter overshoot
 
-    m_settingsMutex.unlock();
-
     Real magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
 	magsq /= (1<<30);
 	m_movingAverage.feed(magsq);
@@ -233,6 +233,7 @@ public:
     void setSpectrumSampleSink(BasebandSampleSink* sampleSink) { m_sampleSink = sampleSink; }
 
     virtual void pull(Sample& sample);
+    virtual void pullBlock(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples);
     virtual void start();
     virtual void stop();
@@ -321,6 +322,7 @@ private:
     void applySettings(const SSBModSettings& settings, bool force = false);
     void pullAF(Complex& sample);
     void calculateLevel(Complex& sample);
+    void pullOne(Sample& sample); //!< modulate one sample with the settings lock held
     void modulateSample();
     void openFileStream();
     void seekFileStream(int seekPercentage);
@@ -231,6 +231,7 @@ public:
     ~WFMMod();
 
     virtual void pull(Sample& sample);
+    virtual void pullBlock(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples);
     virtual void start();
     virtual void stop();
@@ -309,6 +310,7 @@ private:
     static const int m_levelNbSamples;
 
     void applySettings(const WFMModSettings& settings, bool force = false);
+    void pullOne(Sample& sample); //!< modulate one sample with the settings lock held
     void pullAF(Complex& sample);
     void calculateLevel(const Real& sample);
     void openFileStream();
@@ -16,6 +16,8 @@
 
 #include <QDebug>
 
+#include <algorithm>
+
 #include "device/devicesinkapi.h"
 #include "dsp/upchannelizer.h"
 #include "dsp/threadedbasebandsamplesource.h"
@@ -99,10 +101,33 @@ void UDPSink::pull(Sample& sample)
         return;
     }
 
-    Complex ci;
+    m_settingsMutex.lock();
+    pullOne(sample);
+    m_settingsMutex.unlock();
+}
+
+void UDPSink::pullBlock(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    if (m_settings.m_channelMute)
+    {
+        std::fill(begin, begin + nbSamples, Sample());
+        initSquelch(false);
+        return;
+    }
 
     m_settingsMutex.lock();
 
+    for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+        pullOne(*begin);
+    }
+
+    m_settingsMutex.unlock();
+}
+
+void UDPSink::pullOne(Sample& sample)
+{
+    Complex ci;
+
     if (m_interpolatorDistance > 1.0f) // decimate
     {
         modulateSample();
@@ -124,8 +149,6 @@ void UDPSink::pull(Sample& sample)
 
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
 
-    m_settingsMutex.unlock();
-
     double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
     magsq /= (1<<30);
     m_movingAverage.feed(magsq);
@@ -94,6 +94,7 @@ public:
     virtual void start();
     virtual void stop();
     virtual void pull(Sample& sample);
+    virtual void pullBlock(SampleVector::iterator begin, unsigned int nbSamples);
     virtual bool handleMessage(const Message& cmd);
 
     virtual int getDeltaFrequency() const { return m_absoluteFrequencyOffset; }
@@ -211,6 +212,7 @@ private:
     static const int m_ssbFftLen = 1024;
 
     void applySettings(const UDPSinkSettings& settings, bool force = false);
+    void pullOne(Sample& sample); //!< modulate one sample with the settings lock held
     void modulateSample();
     void calculateLevel(Real sample);
     void calculateLevel(Complex sample);
@@ -136,6 +136,7 @@ bool BladerfOutput::start()
 	applySettings(m_settings, true);
 
 	m_bladerfThread->setLog2Interpolation(m_settings.m_log2Interp);
+	m_bladerfThread->setFcPos((int) m_settings.m_fcPos);
 
     m_bladerfThread->startWork();
 
@@ -296,6 +297,15 @@ bool BladerfOutput::applySettings(const BladeRFOutputSettings& settings, bool fo
         }
     }
 
+    if ((m_settings.m_fcPos != settings.m_fcPos) || force)
+    {
+        if (m_bladerfThread != 0)
+        {
+            m_bladerfThread->setFcPos((int) settings.m_fcPos);
+            qDebug() << "BladerfOutput::applySettings: set fc pos (enum) to " << (int) settings.m_fcPos;
+        }
+    }
+
 	if ((m_settings.m_vga1 != settings.m_vga1) || force)
 	{
 		if (m_dev != 0)
@@ -432,11 +442,22 @@ bool BladerfOutput::applySettings(const BladeRFOutputSettings& settings, bool fo
 		forwardChange = true;
 	}
 
+	quint64 deviceCenterFrequency = settings.m_centerFrequency;
+
+	if (settings.m_log2Interp != 0)
+	{
+		if (settings.m_fcPos == BladeRFOutputSettings::FC_POS_INFRA) {
+			deviceCenterFrequency += settings.m_devSampleRate / 4;
+		} else if (settings.m_fcPos == BladeRFOutputSettings::FC_POS_SUPRA) {
+			deviceCenterFrequency -= settings.m_devSampleRate / 4;
+		}
+	}
+
 	if (m_dev != NULL)
 	{
-		if (bladerf_set_frequency( m_dev, BLADERF_MODULE_TX, settings.m_centerFrequency ) != 0)
+		if (bladerf_set_frequency( m_dev, BLADERF_MODULE_TX, deviceCenterFrequency ) != 0)
 		{
-			qDebug("BladerfOutput::applySettings: bladerf_set_frequency(%lld) failed", settings.m_centerFrequency);
+			qDebug("BladerfOutput::applySettings: bladerf_set_frequency(%lld) failed", deviceCenterFrequency);
 		}
 	}
 
@@ -454,6 +475,7 @@ bool BladerfOutput::applySettings(const BladeRFOutputSettings& settings, bool fo
     m_settings.m_vga1 = settings.m_vga1;
     m_settings.m_devSampleRate = settings.m_devSampleRate;
     m_settings.m_log2Interp = settings.m_log2Interp;
+    m_settings.m_fcPos = settings.m_fcPos;
 
 	if (forwardChange)
 	{
@@ -463,6 +485,7 @@ bool BladerfOutput::applySettings(const BladeRFOutputSettings& settings, bool fo
 	}
 
 	qDebug() << "BladerfOutput::applySettings: center freq: " << m_settings.m_centerFrequency << " Hz"
+			<< " device center freq: " << deviceCenterFrequency << " Hz"
 			<< " device sample rate: " << m_settings.m_devSampleRate << "S/s"
 			<< " baseband sample rate: " << m_settings.m_devSampleRate/(1<<m_settings.m_log2Interp) << "S/s"
 			<< " BW: " << m_settings.m_bandwidth << "Hz";
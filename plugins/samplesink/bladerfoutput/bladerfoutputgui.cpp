@@ -182,6 +182,8 @@ void BladerfOutputGui::displaySettings()
 
 	ui->interp->setCurrentIndex(m_settings.m_log2Interp);
 
+	ui->fcPos->setCurrentIndex((int) m_settings.m_fcPos);
+
 	ui->vga1Text->setText(tr("%1dB").arg(m_settings.m_vga1));
 	ui->vga1->setValue(m_settings.m_vga1);
 
@@ -224,6 +226,19 @@ void BladerfOutputGui::on_interp_currentIndexChanged(int index)
 	sendSettings();
 }
 
+void BladerfOutputGui::on_fcPos_currentIndexChanged(int index)
+{
+	if (index == 0) {
+		m_settings.m_fcPos = BladeRFOutputSettings::FC_POS_INFRA;
+	} else if (index == 1) {
+		m_settings.m_fcPos = BladeRFOutputSettings::FC_POS_SUPRA;
+	} else {
+		m_settings.m_fcPos = BladeRFOutputSettings::FC_POS_CENTER;
+	}
+
+	sendSettings();
+}
+
 void BladerfOutputGui::on_vga1_valueChanged(int value)
 {
 	if ((value < BLADERF_TXVGA1_GAIN_MIN) || (value > BLADERF_TXVGA1_GAIN_MAX))
@@ -32,6 +32,7 @@ void BladeRFOutputSettings::resetToDefaults()
 	m_vga2 = 20;
 	m_bandwidth = 1500000;
 	m_log2Interp = 0;
+	m_fcPos = FC_POS_CENTER;
 	m_xb200 = false;
 	m_xb200Path = BLADERF_XB200_MIX;
 	m_xb200Filter = BLADERF_XB200_AUTO_1DB;
@@ -49,6 +50,7 @@ QByteArray BladeRFOutputSettings::serialize() const
 	s.writeBool(6, m_xb200);
 	s.writeS32(7, (int) m_xb200Path);
 	s.writeS32(8, (int) m_xb200Filter);
+	s.writeS32(9, (int) m_fcPos);
 
 	return s.final();
 }
@@ -77,6 +79,8 @@ bool BladeRFOutputSettings::deserialize(const QByteArray& data)
 		m_xb200Path = (bladerf_xb200_path) intval;
 		d.readS32(8, &intval);
 		m_xb200Filter = (bladerf_xb200_filter) intval;
+		d.readS32(9, &intval, (int) FC_POS_CENTER);
+		m_fcPos = (intval < 0) || (intval > (int) FC_POS_CENTER) ? FC_POS_CENTER : (fcPos_t) intval;
 
 		return true;
 	}
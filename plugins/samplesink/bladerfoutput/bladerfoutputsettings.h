@@ -21,12 +21,19 @@
 #include <libbladeRF.h>
 
 struct BladeRFOutputSettings {
+	typedef enum {
+		FC_POS_INFRA = 0,
+		FC_POS_SUPRA,
+		FC_POS_CENTER
+	} fcPos_t;
+
 	quint64 m_centerFrequency;
 	qint32 m_devSampleRate;
 	qint32 m_vga1;
 	qint32 m_vga2;
 	qint32 m_bandwidth;
 	quint32 m_log2Interp;
+	fcPos_t m_fcPos;
 	bool m_xb200;
 	bladerf_xb200_path m_xb200Path;
 	bladerf_xb200_filter m_xb200Filter;
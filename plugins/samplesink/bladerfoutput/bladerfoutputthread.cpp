@@ -55,6 +55,11 @@ void BladerfOutputThread::setLog2Interpolation(unsigned int log2_interp)
 	m_log2Interp = log2_interp;
 }
 
+void BladerfOutputThread::setFcPos(int fcPos)
+{
+	m_fcPos = fcPos;
+}
+
 void BladerfOutputThread::run()
 {
 	int res;
@@ -81,7 +86,7 @@ void BladerfOutputThread::callback(qint16* buf, qint32 len)
 {
     SampleVector::iterator beginRead;
     m_sampleFifo->readAdvance(beginRead, len/(1<<m_log2Interp));
-    beginRead -= len;
+    beginRead -= len/(1<<m_log2Interp);
 
     if (m_log2Interp == 0)
 	{
@@ -89,28 +94,83 @@ void BladerfOutputThread::callback(qint16* buf, qint32 len)
 	}
 	else
 	{
-        switch (m_log2Interp)
+        if (m_fcPos == 0) // Infra
+        {
+            switch (m_log2Interp)
+            {
+            case 1:
+                m_interpolators.interpolate2_inf(&beginRead, buf, len*2);
+                break;
+            case 2:
+                m_interpolators.interpolate4_inf(&beginRead, buf, len*2);
+                break;
+            case 3:
+                m_interpolators.interpolate8_inf(&beginRead, buf, len*2);
+                break;
+            case 4:
+                m_interpolators.interpolate16_inf(&beginRead, buf, len*2);
+                break;
+            case 5:
+                m_interpolators.interpolate32_inf(&beginRead, buf, len*2);
+                break;
+            case 6:
+                m_interpolators.interpolate64_inf(&beginRead, buf, len*2);
+                break;
+            default:
+                break;
+            }
+        }
+        else if (m_fcPos == 1) // Supra
+        {
+            switch (m_log2Interp)
+            {
+            case 1:
+                m_interpolators.interpolate2_sup(&beginRead, buf, len*2);
+                break;
+            case 2:
+                m_interpolators.interpolate4_sup(&beginRead, buf, len*2);
+                break;
+            case 3:
+                m_interpolators.interpolate8_sup(&beginRead, buf, len*2);
+                break;
+            case 4:
+                m_interpolators.interpolate16_sup(&beginRead, buf, len*2);
+                break;
+            case 5:
+                m_interpolators.interpolate32_sup(&beginRead, buf, len*2);
+                break;
+            case 6:
+                m_interpolators.interpolate64_sup(&beginRead, buf, len*2);
+                break;
+            default:
+                break;
+            }
+        }
+        else // Center
         {
-        case 1:
-            m_interpolators.interpolate2_cen(&beginRead, buf, len*2);
-            break;
-        case 2:
-            m_interpolators.interpolate4_cen(&beginRead, buf, len*2);
-            break;
-        case 3:
-            m_interpolators.interpolate8_cen(&beginRead, buf, len*2);
-            break;
-        case 4:
-            m_interpolators.interpolate16_cen(&beginRead, buf, len*2);
-            break;
-        case 5:
-            m_interpolators.interpolate32_cen(&beginRead, buf, len*2);
-            break;
-        case 6:
-            m_interpolators.interpolate64_cen(&beginRead, buf, len*2);
-            break;
-        default:
-            break;
+            switch (m_log2Interp)
+            {
+            case 1:
+                m_interpolators.interpolate2_cen(&beginRead, buf, len*2);
+                break;
+            case 2:
+                m_interpolators.interpolate4_cen(&beginRead, buf, len*2);
+                break;
+            case 3:
+                m_interpolators.interpolate8_cen(&beginRead, buf, len*2);
+                break;
+            case 4:
+                m_interpolators.interpolate16_cen(&beginRead, buf, len*2);
+                break;
+            case 5:
+                m_interpolators.interpolate32_cen(&beginRead, buf, len*2);
+                break;
+            case 6:
+                m_interpolators.interpolate64_cen(&beginRead, buf, len*2);
+                break;
+            default:
+                break;
+            }
         }
 	}
 }
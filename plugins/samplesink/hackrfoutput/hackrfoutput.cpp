@@ -119,6 +119,7 @@ bool HackRFOutput::start()
 
 	applySettings(m_settings, true);
 	m_hackRFThread->setLog2Interpolation(m_settings.m_log2Interp);
+	m_hackRFThread->setFcPos((int) m_settings.m_fcPos);
 
 	m_hackRFThread->startWork();
 
@@ -292,13 +293,38 @@ bool HackRFOutput::applySettings(const HackRFOutputSettings& settings, bool forc
 		}
 	}
 
+	if ((m_settings.m_fcPos != settings.m_fcPos) || force)
+	{
+		if (m_hackRFThread != 0)
+		{
+			m_hackRFThread->setFcPos((int) settings.m_fcPos);
+			qDebug() << "HackRFOutput: set fc pos (enum) to " << (int) settings.m_fcPos;
+		}
+	}
+
 	if (force || (m_settings.m_centerFrequency != settings.m_centerFrequency) ||
-			(m_settings.m_LOppmTenths != settings.m_LOppmTenths))
+			(m_settings.m_LOppmTenths != settings.m_LOppmTenths) ||
+			(m_settings.m_fcPos != settings.m_fcPos) ||
+			(m_settings.m_log2Interp != settings.m_log2Interp) ||
+			(m_settings.m_devSampleRate != settings.m_devSampleRate))
 	{
+		quint64 deviceCenterFrequency = settings.m_centerFrequency;
+
+		if (settings.m_log2Interp != 0)
+		{
+			if (settings.m_fcPos == HackRFOutputSettings::FC_POS_INFRA) {
+				deviceCenterFrequency += settings.m_devSampleRate / 4;
+			} else if (settings.m_fcPos == HackRFOutputSettings::FC_POS_SUPRA) {
+				deviceCenterFrequency -= settings.m_devSampleRate / 4;
+			}
+		}
+
 		if (m_dev != 0)
 		{
-			setCenterFrequency(settings.m_centerFrequency, settings.m_LOppmTenths);
-			qDebug() << "HackRFOutput::applySettings: center freq: " << settings.m_centerFrequency << " Hz LOppm: " << settings.m_LOppmTenths;
+			setCenterFrequency(deviceCenterFrequency, settings.m_LOppmTenths);
+			qDebug() << "HackRFOutput::applySettings: center freq: " << settings.m_centerFrequency << " Hz"
+					<< " device center freq: " << deviceCenterFrequency << " Hz"
+					<< " LOppm: " << settings.m_LOppmTenths;
 		}
 
 		forwardChange = true;
@@ -380,6 +406,7 @@ bool HackRFOutput::applySettings(const HackRFOutputSettings& settings, bool forc
 
     m_settings.m_devSampleRate = settings.m_devSampleRate;
     m_settings.m_log2Interp = settings.m_log2Interp;
+    m_settings.m_fcPos = settings.m_fcPos;
     m_settings.m_centerFrequency = settings.m_centerFrequency;
     m_settings.m_LOppmTenths = settings.m_LOppmTenths;
     m_settings.m_vgaGain = settings.m_vgaGain;
@@ -200,6 +200,8 @@ void HackRFOutputGui::displaySettings()
 
 	ui->interp->setCurrentIndex(m_settings.m_log2Interp);
 
+	ui->fcPos->setCurrentIndex((int) m_settings.m_fcPos);
+
 	ui->lnaExt->setChecked(m_settings.m_lnaExt);
 	ui->txvgaGainText->setText(tr("%1dB").arg(m_settings.m_vgaGain));
 	ui->txvga->setValue(m_settings.m_vgaGain);
@@ -286,6 +288,19 @@ void HackRFOutputGui::on_interp_currentIndexChanged(int index)
 	sendSettings();
 }
 
+void HackRFOutputGui::on_fcPos_currentIndexChanged(int index)
+{
+	if (index == 0) {
+		m_settings.m_fcPos = HackRFOutputSettings::FC_POS_INFRA;
+	} else if (index == 1) {
+		m_settings.m_fcPos = HackRFOutputSettings::FC_POS_SUPRA;
+	} else {
+		m_settings.m_fcPos = HackRFOutputSettings::FC_POS_CENTER;
+	}
+
+	sendSettings();
+}
+
 void HackRFOutputGui::on_txvga_valueChanged(int value)
 {
 	if ((value < 0) || (value > 47))
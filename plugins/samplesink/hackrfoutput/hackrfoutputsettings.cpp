@@ -31,6 +31,7 @@ void HackRFOutputSettings::resetToDefaults()
 	m_LOppmTenths = 0;
 	m_biasT = false;
 	m_log2Interp = 0;
+	m_fcPos = FC_POS_CENTER;
 	m_lnaExt = false;
 	m_vgaGain = 22;
 	m_bandwidth = 1750000;
@@ -48,6 +49,7 @@ QByteArray HackRFOutputSettings::serialize() const
 	s.writeU32(6, m_vgaGain);
 	s.writeU32(7, m_bandwidth);
 	s.writeU64(8, m_devSampleRate);
+	s.writeS32(9, (int) m_fcPos);
 
 	return s.final();
 }
@@ -64,6 +66,8 @@ bool HackRFOutputSettings::deserialize(const QByteArray& data)
 
 	if (d.getVersion() == 1)
 	{
+		int intval;
+
 		d.readS32(1, &m_LOppmTenths, 0);
 		d.readBool(3, &m_biasT, false);
 		d.readU32(4, &m_log2Interp, 0);
@@ -71,6 +75,8 @@ bool HackRFOutputSettings::deserialize(const QByteArray& data)
 		d.readU32(6, &m_vgaGain, 30);
 		d.readU32(7, &m_bandwidth, 1750000);
 		d.readU64(8, &m_devSampleRate, 2400000);
+		d.readS32(9, &intval, (int) FC_POS_CENTER);
+		m_fcPos = (intval < 0) || (intval > (int) FC_POS_CENTER) ? FC_POS_CENTER : (fcPos_t) intval;
 
 		return true;
 	}
@@ -27,7 +27,8 @@ HackRFOutputThread::HackRFOutputThread(hackrf_device* dev, SampleSourceFifo* sam
 	m_running(false),
 	m_dev(dev),
 	m_sampleFifo(sampleFifo),
-	m_log2Interp(0)
+	m_log2Interp(0),
+	m_fcPos(0)
 {
 }
 
@@ -58,6 +59,11 @@ void HackRFOutputThread::setLog2Interpolation(unsigned int log2Interp)
 	m_log2Interp = log2Interp;
 }
 
+void HackRFOutputThread::setFcPos(int fcPos)
+{
+	m_fcPos = fcPos;
+}
+
 void HackRFOutputThread::run()
 {
 	hackrf_error rc;
@@ -113,7 +119,7 @@ void HackRFOutputThread::callback(qint8* buf, qint32 len)
 {
     SampleVector::iterator beginRead;
     m_sampleFifo->readAdvance(beginRead, len/(2*(1<<m_log2Interp)));
-    beginRead -= len/2;
+    beginRead -= len/(2*(1<<m_log2Interp));
 
 	if (m_log2Interp == 0)
 	{
@@ -121,28 +127,83 @@ void HackRFOutputThread::callback(qint8* buf, qint32 len)
 	}
 	else
 	{
-        switch (m_log2Interp)
+        if (m_fcPos == 0) // Infra
+        {
+            switch (m_log2Interp)
+            {
+            case 1:
+                m_interpolators.interpolate2_inf(&beginRead, buf, len);
+                break;
+            case 2:
+                m_interpolators.interpolate4_inf(&beginRead, buf, len);
+                break;
+            case 3:
+                m_interpolators.interpolate8_inf(&beginRead, buf, len);
+                break;
+            case 4:
+                m_interpolators.interpolate16_inf(&beginRead, buf, len);
+                break;
+            case 5:
+                m_interpolators.interpolate32_inf(&beginRead, buf, len);
+                break;
+            case 6:
+                m_interpolators.interpolate64_inf(&beginRead, buf, len);
+                break;
+            default:
+                break;
+            }
+        }
+        else if (m_fcPos == 1) // Supra
+        {
+            switch (m_log2Interp)
+            {
+            case 1:
+                m_interpolators.interpolate2_sup(&beginRead, buf, len);
+                break;
+            case 2:
+                m_interpolators.interpolate4_sup(&beginRead, buf, len);
+                break;
+            case 3:
+                m_interpolators.interpolate8_sup(&beginRead, buf, len);
+                break;
+            case 4:
+                m_interpolators.interpolate16_sup(&beginRead, buf, len);
+                break;
+            case 5:
+                m_interpolators.interpolate32_sup(&beginRead, buf, len);
+                break;
+            case 6:
+                m_interpolators.interpolate64_sup(&beginRead, buf, len);
+                break;
+            default:
+                break;
+            }
+        }
+        else // Center
         {
-        case 1:
-            m_interpolators.interpolate2_cen(&beginRead, buf, len);
-            break;
-        case 2:
-            m_interpolators.interpolate4_cen(&beginRead, buf, len);
-            break;
-        case 3:
-            m_interpolators.interpolate8_cen(&beginRead, buf, len);
-            break;
-        case 4:
-            m_interpolators.interpolate16_cen(&beginRead, buf, len);
-            break;
-        case 5:
-            m_interpolators.interpolate32_cen(&beginRead, buf, len);
-            break;
-        case 6:
-            m_interpolators.interpolate64_cen(&beginRead, buf, len);
-            break;
-        default:
-            break;
+            switch (m_log2Interp)
+            {
+            case 1:
+                m_interpolators.interpolate2_cen(&beginRead, buf, len);
+                break;
+            case 2:
+                m_interpolators.interpolate4_cen(&beginRead, buf, len);
+                break;
+            case 3:
+                m_interpolators.interpolate8_cen(&beginRead, buf, len);
+                break;
+            case 4:
+                m_interpolators.interpolate16_cen(&beginRead, buf, len);
+                break;
+            case 5:
+                m_interpolators.interpolate32_cen(&beginRead, buf, len);
+                break;
+            case 6:
+                m_interpolators.interpolate64_cen(&beginRead, buf, len);
+                break;
+            default:
+                break;
+            }
         }
 	}
 }
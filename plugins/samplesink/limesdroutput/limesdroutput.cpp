@@ -369,6 +369,7 @@ bool LimeSDROutput::start()
     }
 
     m_limeSDROutputThread->setLog2Interpolation(m_settings.m_log2SoftInterp);
+    m_limeSDROutputThread->setFcPos((int) m_settings.m_fcPos);
 
     m_limeSDROutputThread->startWork();
 
@@ -782,6 +783,15 @@ bool LimeSDROutput::applySettings(const LimeSDROutputSettings& settings, bool fo
         }
     }
 
+    if ((m_settings.m_fcPos != settings.m_fcPos) || force)
+    {
+        if (m_limeSDROutputThread != 0)
+        {
+            m_limeSDROutputThread->setFcPos((int) settings.m_fcPos);
+            qDebug() << "LimeSDROutput::applySettings: set fc pos (enum) to " << (int) settings.m_fcPos;
+        }
+    }
+
     if ((m_settings.m_antennaPath != settings.m_antennaPath) || force)
     {
         if (m_deviceShared.m_deviceParams->getDevice() != 0 && m_channelAcquired)
@@ -802,8 +812,22 @@ bool LimeSDROutput::applySettings(const LimeSDROutputSettings& settings, bool fo
         }
     }
 
-    if ((m_settings.m_centerFrequency != settings.m_centerFrequency) || force)
+    if ((m_settings.m_centerFrequency != settings.m_centerFrequency)
+        || (m_settings.m_fcPos != settings.m_fcPos)
+        || (m_settings.m_log2SoftInterp != settings.m_log2SoftInterp)
+        || (m_settings.m_devSampleRate != settings.m_devSampleRate) || force)
     {
+        uint64_t deviceCenterFrequency = settings.m_centerFrequency;
+
+        if (settings.m_log2SoftInterp != 0)
+        {
+            if (settings.m_fcPos == LimeSDROutputSettings::FC_POS_INFRA) {
+                deviceCenterFrequency += settings.m_devSampleRate / 4;
+            } else if (settings.m_fcPos == LimeSDROutputSettings::FC_POS_SUPRA) {
+                deviceCenterFrequency -= settings.m_devSampleRate / 4;
+            }
+        }
+
         forwardChangeTxDSP = true;
 
         if (m_deviceShared.m_deviceParams->getDevice() != 0 && m_channelAcquired)
@@ -811,15 +835,15 @@ bool LimeSDROutput::applySettings(const LimeSDROutputSettings& settings, bool fo
             if (LMS_SetLOFrequency(m_deviceShared.m_deviceParams->getDevice(),
                     LMS_CH_TX,
                     m_deviceShared.m_channel, // same for both channels anyway but switches antenna port automatically
-                    settings.m_centerFrequency) < 0)
+                    deviceCenterFrequency) < 0)
             {
-                qCritical("LimeSDROutput::applySettings: could not set frequency to %lu", settings.m_centerFrequency);
+                qCritical("LimeSDROutput::applySettings: could not set frequency to %lu", deviceCenterFrequency);
             }
             else
             {
                 doCalibration = true;
                 m_deviceShared.m_centerFrequency = settings.m_centerFrequency; // for buddies
-                qDebug("LimeSDROutput::applySettings: frequency set to %lu", settings.m_centerFrequency);
+                qDebug("LimeSDROutput::applySettings: frequency set to %lu (device %lu)", settings.m_centerFrequency, deviceCenterFrequency);
             }
         }
     }
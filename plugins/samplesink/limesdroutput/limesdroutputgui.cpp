@@ -278,6 +278,7 @@ void LimeSDROutputGUI::displaySettings()
 
     ui->hwInterp->setCurrentIndex(m_settings.m_log2HardInterp);
     ui->swInterp->setCurrentIndex(m_settings.m_log2SoftInterp);
+    ui->fcPos->setCurrentIndex((int) m_settings.m_fcPos);
 
     updateDACRate();
 
@@ -453,6 +454,19 @@ void LimeSDROutputGUI::on_swInterp_currentIndexChanged(int index)
     sendSettings();
 }
 
+void LimeSDROutputGUI::on_fcPos_currentIndexChanged(int index)
+{
+    if (index == 0) {
+        m_settings.m_fcPos = LimeSDROutputSettings::FC_POS_INFRA;
+    } else if (index == 1) {
+        m_settings.m_fcPos = LimeSDROutputSettings::FC_POS_SUPRA;
+    } else {
+        m_settings.m_fcPos = LimeSDROutputSettings::FC_POS_CENTER;
+    }
+
+    sendSettings();
+}
+
 void LimeSDROutputGUI::on_lpf_changed(quint64 value)
 {
     m_settings.m_lpfBW = value * 1000;
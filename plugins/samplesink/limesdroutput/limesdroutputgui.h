@@ -85,6 +85,7 @@ private slots:
     void on_sampleRate_changed(quint64 value);
     void on_hwInterp_currentIndexChanged(int index);
     void on_swInterp_currentIndexChanged(int index);
+    void on_fcPos_currentIndexChanged(int index);
     void on_lpf_changed(quint64 value);
     void on_lpFIREnable_toggled(bool checked);
     void on_lpFIR_changed(quint64 value);
@@ -29,6 +29,7 @@ void LimeSDROutputSettings::resetToDefaults()
     m_devSampleRate = 5000000;
     m_log2HardInterp = 3;
     m_log2SoftInterp = 0;
+    m_fcPos = FC_POS_CENTER;
     m_lpfBW = 5.5e6f;
     m_lpfFIREnable = false;
     m_lpfFIRBW = 2.5e6f;
@@ -56,6 +57,7 @@ QByteArray LimeSDROutputSettings::serialize() const
     s.writeS32(13, (int) m_antennaPath);
     s.writeBool(14, m_extClock);
     s.writeU32(15, m_extClockFreq);
+    s.writeS32(16, (int) m_fcPos);
 
     return s.final();
 }
@@ -87,6 +89,8 @@ bool LimeSDROutputSettings::deserialize(const QByteArray& data)
         m_antennaPath = (PathRFE) intval;
         d.readBool(14, &m_extClock, false);
         d.readU32(15, &m_extClockFreq, 10000000);
+        d.readS32(16, &intval, (int) FC_POS_CENTER);
+        m_fcPos = (intval < 0) || (intval > (int) FC_POS_CENTER) ? FC_POS_CENTER : (fcPos_t) intval;
 
         return true;
     }
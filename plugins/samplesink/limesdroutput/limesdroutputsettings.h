@@ -45,6 +45,7 @@ struct LimeSDROutputSettings
     uint32_t m_log2HardInterp;
     // channel settings
     uint32_t m_log2SoftInterp;
+    fcPos_t  m_fcPos;        //!< Position of the Tx band relative to the device center frequency with soft interpolation
     float    m_lpfBW;        //!< LMS amalog lowpass filter bandwidth (Hz)
     bool     m_lpfFIREnable; //!< Enable LMS digital lowpass FIR filters
     float    m_lpfFIRBW;     //!< LMS digital lowpass FIR filters bandwidth (Hz)
@@ -78,6 +78,7 @@ bool PlutoSDROutput::start()
     }
 
     m_plutoSDROutputThread->setLog2Interpolation(m_settings.m_log2Interp);
+    m_plutoSDROutputThread->setFcPos((int) m_settings.m_fcPos);
     m_plutoSDROutputThread->startWork();
 
     m_deviceShared.m_thread = m_plutoSDROutputThread;
@@ -336,6 +337,15 @@ bool PlutoSDROutput::applySettings(const PlutoSDROutputSettings& settings, bool
         forwardChangeOwnDSP = true;
     }
 
+    if ((m_settings.m_fcPos != settings.m_fcPos) || force)
+    {
+        if (m_plutoSDROutputThread != 0)
+        {
+            m_plutoSDROutputThread->setFcPos((int) settings.m_fcPos);
+            qDebug() << "PlutoSDROutput::applySettings: set fc pos (enum) to " << (int) settings.m_fcPos;
+        }
+    }
+
     if ((m_settings.m_LOppmTenths != settings.m_LOppmTenths) || force)
     {
         plutoBox->setLOPPMTenths(settings.m_LOppmTenths);
@@ -347,11 +357,24 @@ bool PlutoSDROutput::applySettings(const PlutoSDROutputSettings& settings, bool
 
     if (force || (m_settings.m_centerFrequency != settings.m_centerFrequency)
         || (m_settings.m_transverterMode != settings.m_transverterMode)
-        || (m_settings.m_transverterDeltaFrequency != settings.m_transverterDeltaFrequency))
+        || (m_settings.m_transverterDeltaFrequency != settings.m_transverterDeltaFrequency)
+        || (m_settings.m_fcPos != settings.m_fcPos)
+        || (m_settings.m_log2Interp != settings.m_log2Interp)
+        || (m_settings.m_devSampleRate != settings.m_devSampleRate))
 
     {
         qint64 deviceCenterFrequency = settings.m_centerFrequency;
         deviceCenterFrequency -= settings.m_transverterMode ? settings.m_transverterDeltaFrequency : 0;
+
+        if (settings.m_log2Interp != 0)
+        {
+            if (settings.m_fcPos == PlutoSDROutputSettings::FC_POS_INFRA) {
+                deviceCenterFrequency += settings.m_devSampleRate / 4;
+            } else if (settings.m_fcPos == PlutoSDROutputSettings::FC_POS_SUPRA) {
+                deviceCenterFrequency -= settings.m_devSampleRate / 4;
+            }
+        }
+
         deviceCenterFrequency = deviceCenterFrequency < 0 ? 0 : deviceCenterFrequency;
 
 
@@ -187,6 +187,19 @@ void PlutoSDROutputGUI::on_swInterp_currentIndexChanged(int index)
     sendSettings();
 }
 
+void PlutoSDROutputGUI::on_fcPos_currentIndexChanged(int index)
+{
+    if (index == 0) {
+        m_settings.m_fcPos = PlutoSDROutputSettings::FC_POS_INFRA;
+    } else if (index == 1) {
+        m_settings.m_fcPos = PlutoSDROutputSettings::FC_POS_SUPRA;
+    } else {
+        m_settings.m_fcPos = PlutoSDROutputSettings::FC_POS_CENTER;
+    }
+
+    sendSettings();
+}
+
 void PlutoSDROutputGUI::on_sampleRate_changed(quint64 value)
 {
     m_settings.m_devSampleRate = value;
@@ -262,6 +275,8 @@ void PlutoSDROutputGUI::displaySettings()
 
     ui->swInterp->setCurrentIndex(m_settings.m_log2Interp);
 
+    ui->fcPos->setCurrentIndex((int) m_settings.m_fcPos);
+
     ui->lpf->setValue(m_settings.m_lpfBW / 1000);
 
     ui->lpFIREnable->setChecked(m_settings.m_lpfFIREnable);
@@ -79,6 +79,7 @@ private slots:
     void on_centerFrequency_changed(quint64 value);
     void on_loPPM_valueChanged(int value);
     void on_swInterp_currentIndexChanged(int index);
+    void on_fcPos_currentIndexChanged(int index);
     void on_sampleRate_changed(quint64 value);
     void on_lpf_changed(quint64 value);
     void on_lpFIREnable_toggled(bool checked);
@@ -29,6 +29,7 @@ void PlutoSDROutputSettings::resetToDefaults()
 	m_centerFrequency = 435000 * 1000;
 	m_LOppmTenths = 0;
 	m_log2Interp = 0;
+	m_fcPos = FC_POS_CENTER;
 	m_devSampleRate = 2500 * 1000;
 	m_lpfBW = 1500000;
 	m_lpfFIREnable = false;
@@ -56,6 +57,7 @@ QByteArray PlutoSDROutputSettings::serialize() const
     s.writeS32(14, (int) m_antennaPath);
     s.writeBool(15, m_transverterMode);
     s.writeS64(16, m_transverterDeltaFrequency);
+    s.writeS32(17, (int) m_fcPos);
 
 	return s.final();
 }
@@ -97,6 +99,8 @@ bool PlutoSDROutputSettings::deserialize(const QByteArray& data)
         }
         d.readBool(15, &m_transverterMode, false);
         d.readS64(16, &m_transverterDeltaFrequency, 0);
+        d.readS32(17, &intval, (int) FC_POS_CENTER);
+        m_fcPos = (intval < 0) || (intval > (int) FC_POS_CENTER) ? FC_POS_CENTER : (fcPos_t) intval;
 
 		return true;
 	}
@@ -21,6 +21,12 @@
 #include <stdint.h>
 
 struct PlutoSDROutputSettings {
+    typedef enum {
+        FC_POS_INFRA = 0,
+        FC_POS_SUPRA,
+        FC_POS_CENTER
+    } fcPos_t;
+
     enum RFPath
     {
         RFPATH_A = 0,
@@ -39,6 +45,7 @@ struct PlutoSDROutputSettings {
     int     m_lpfFIRGain;         //!< digital lowpass FIR filter gain (dB)
     // individual channel settings
     quint32 m_log2Interp;
+    fcPos_t m_fcPos;
     quint32 m_lpfBW;              //!< analog lowpass filter bandwidth (Hz)
     qint32  m_att;                //!< "hardware" attenuation in dB fourths
     RFPath  m_antennaPath;
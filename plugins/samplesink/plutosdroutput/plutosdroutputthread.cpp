@@ -27,7 +27,8 @@ PlutoSDROutputThread::PlutoSDROutputThread(uint32_t blocksizeSamples, DevicePlut
     m_plutoBox(plutoBox),
     m_blockSizeSamples(blocksizeSamples),
     m_sampleFifo(sampleFifo),
-    m_log2Interp(0)
+    m_log2Interp(0),
+    m_fcPos(0)
 {
     m_buf = new qint16[blocksizeSamples*2];
 //    m_bufConv = new qint16[blocksizeSamples*(sizeof(Sample)/sizeof(qint16))];
@@ -63,6 +64,11 @@ void PlutoSDROutputThread::setLog2Interpolation(unsigned int log2_interp)
     m_log2Interp = log2_interp;
 }
 
+void PlutoSDROutputThread::setFcPos(int fcPos)
+{
+    m_fcPos = fcPos;
+}
+
 void PlutoSDROutputThread::run()
 {
     std::ptrdiff_t p_inc = m_plutoBox->txBufferStep();
@@ -119,7 +125,7 @@ void PlutoSDROutputThread::convert(qint16* buf, qint32 len)
     // pull samples from baseband generator
     SampleVector::iterator beginRead;
     m_sampleFifo->readAdvance(beginRead, len/(2*(1<<m_log2Interp)));
-    beginRead -= len/2;
+    beginRead -= len/(2*(1<<m_log2Interp));
 
     if (m_log2Interp == 0)
     {
@@ -127,28 +133,83 @@ void PlutoSDROutputThread::convert(qint16* buf, qint32 len)
     }
     else
     {
-        switch (m_log2Interp)
+        if (m_fcPos == 0) // Infra
+        {
+            switch (m_log2Interp)
+            {
+            case 1:
+                m_interpolators.interpolate2_inf(&beginRead, buf, len);
+                break;
+            case 2:
+                m_interpolators.interpolate4_inf(&beginRead, buf, len);
+                break;
+            case 3:
+                m_interpolators.interpolate8_inf(&beginRead, buf, len);
+                break;
+            case 4:
+                m_interpolators.interpolate16_inf(&beginRead, buf, len);
+                break;
+            case 5:
+                m_interpolators.interpolate32_inf(&beginRead, buf, len);
+                break;
+            case 6:
+                m_interpolators.interpolate64_inf(&beginRead, buf, len);
+                break;
+            default:
+                break;
+            }
+        }
+        else if (m_fcPos == 1) // Supra
+        {
+            switch (m_log2Interp)
+            {
+            case 1:
+                m_interpolators.interpolate2_sup(&beginRead, buf, len);
+                break;
+            case 2:
+                m_interpolators.interpolate4_sup(&beginRead, buf, len);
+                break;
+            case 3:
+                m_interpolators.interpolate8_sup(&beginRead, buf, len);
+                break;
+            case 4:
+                m_interpolators.interpolate16_sup(&beginRead, buf, len);
+                break;
+            case 5:
+                m_interpolators.interpolate32_sup(&beginRead, buf, len);
+                break;
+            case 6:
+                m_interpolators.interpolate64_sup(&beginRead, buf, len);
+                break;
+            default:
+                break;
+            }
+        }
+        else // Center
         {
-        case 1:
-            m_interpolators.interpolate2_cen(&beginRead, buf, len);
-            break;
-        case 2:
-            m_interpolators.interpolate4_cen(&beginRead, buf, len);
-            break;
-        case 3:
-            m_interpolators.interpolate8_cen(&beginRead, buf, len);
-            break;
-        case 4:
-            m_interpolators.interpolate16_cen(&beginRead, buf, len);
-            break;
-        case 5:
-            m_interpolators.interpolate32_cen(&beginRead, buf, len);
-            break;
-        case 6:
-            m_interpolators.interpolate64_cen(&beginRead, buf, len);
-            break;
-        default:
-            break;
+            switch (m_log2Interp)
+            {
+            case 1:
+                m_interpolators.interpolate2_cen(&beginRead, buf, len);
+                break;
+            case 2:
+                m_interpolators.interpolate4_cen(&beginRead, buf, len);
+                break;
+            case 3:
+                m_interpolators.interpolate8_cen(&beginRead, buf, len);
+                break;
+            case 4:
+                m_interpolators.interpolate16_cen(&beginRead, buf, len);
+                break;
+            case 5:
+                m_interpolators.interpolate32_cen(&beginRead, buf, len);
+                break;
+            case 6:
+                m_interpolators.interpolate64_cen(&beginRead, buf, len);
+                break;
+            default:
+                break;
+            }
         }
     }
 }
@@ -40,6 +40,7 @@ public:
     virtual void setDeviceSampleRate(int sampleRate __attribute__((unused))) {}
     virtual bool isRunning() { return m_running; }
     void setLog2Interpolation(unsigned int log2_interp);
+    void setFcPos(int fcPos);
 
 private:
     QMutex m_startWaitMutex;
@@ -54,6 +55,8 @@ private:
 
     unsigned int m_log2Interp; // soft interpolation
 
+    int m_fcPos;
+
     Interpolators<qint16, SDR_SAMP_SZ, 12> m_interpolators;
 
     void run();
@@ -359,6 +359,63 @@ void UDPSocket::SendDataGram( const void *buffer, int bufferLen, const string &f
 
 }
 
+int UDPSocket::SendDataGrams( const void * const *buffers, int bufferLen, int count,
+    const sockaddr_in& destAddr ) throw(CSocketException)
+{
+    int sent = 0;
+
+#ifdef __linux__
+    static const int maxBatch = 64;
+    struct mmsghdr msgs[maxBatch];
+    struct iovec iovecs[maxBatch];
+
+    while (sent < count)
+    {
+        int batch = count - sent < maxBatch ? count - sent : maxBatch;
+
+        for (int i = 0; i < batch; i++)
+        {
+            iovecs[i].iov_base = (void *) buffers[sent + i];
+            iovecs[i].iov_len = bufferLen;
+            memset(&msgs[i].msg_hdr, 0, sizeof(struct msghdr));
+            msgs[i].msg_hdr.msg_name = (void *) &destAddr;
+            msgs[i].msg_hdr.msg_namelen = sizeof(destAddr);
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int nbSent = sendmmsg(m_sockDesc, msgs, batch, 0);
+
+        if (nbSent < 0)
+        {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            throw CSocketException("Send failed (sendmmsg())", true);
+        }
+
+        sent += nbSent;
+    }
+#else
+    for (; sent < count; sent++)
+    {
+        if (sendto(m_sockDesc, (void *) buffers[sent], bufferLen, 0, (sockaddr *) &destAddr, sizeof(destAddr)) != bufferLen)
+        {
+            throw CSocketException("Send failed (sendto())", true);
+        }
+    }
+#endif
+
+    return sent;
+}
+
+void UDPSocket::ResolveAddr( const string &foreignAddress, unsigned short foreignPort, sockaddr_in& destAddr )
+    throw(CSocketException)
+{
+    FillAddr(foreignAddress, foreignPort, destAddr);
+}
+
 int UDPSocket::RecvDataGram( void *buffer, int bufferLen, string &sourceAddress, unsigned short &sourcePort )
     throw(CSocketException)
 {
@@ -296,6 +296,28 @@ public:
     void SendDataGram(const void *buffer, int bufferLen, const string &foreignAddress,
         unsigned short foreignPort) throw(CSocketException);
 
+  /**
+   *   Send the given buffers as UDP datagrams to the specified destination
+   *   in as few system calls as possible (sendmmsg on Linux)
+   *   @param buffers array of pointers to the datagrams
+   *   @param bufferLen number of bytes of each datagram
+   *   @param count number of datagrams
+   *   @param destAddr destination as returned by ResolveAddr
+   *   @return number of datagrams sent
+   *   @exception SocketException thrown if unable to send datagrams
+   */
+    int SendDataGrams(const void * const *buffers, int bufferLen, int count,
+        const sockaddr_in& destAddr) throw(CSocketException);
+
+  /**
+   *   Resolve the address (IP address or name) and port once for SendDataGrams
+   *   @param foreignAddress address (IP address or name) to send to
+   *   @param foreignPort port number to send to
+   *   @param destAddr resolved destination
+   *   @exception SocketException thrown if unable to resolve the address
+   */
+    static void ResolveAddr(const string &foreignAddress, unsigned short foreignPort, sockaddr_in& destAddr) throw(CSocketException);
+
     /**
      *   Read read up to bufferLen bytes data from this socket.  The given buffer
      *   is where the data will be placed
@@ -40,6 +40,7 @@
 #include "device/devicesinkapi.h"
 #include "device/deviceuiset.h"
 #include "sdrdaemonsinkgui.h"
+#include "udpsinkfec.h"
 
 SDRdaemonSinkGui::SDRdaemonSinkGui(DeviceUISet *deviceUISet, QWidget* parent) :
 	QWidget(parent),
@@ -173,8 +174,11 @@ bool SDRdaemonSinkGui::handleMessage(const Message& message)
 {
 	if (SDRdaemonSinkOutput::MsgReportSDRdaemonSinkStreamTiming::match(message))
 	{
-		m_samplesCount = ((SDRdaemonSinkOutput::MsgReportSDRdaemonSinkStreamTiming&)message).getSamplesCount();
+		const SDRdaemonSinkOutput::MsgReportSDRdaemonSinkStreamTiming& report = (const SDRdaemonSinkOutput::MsgReportSDRdaemonSinkStreamTiming&) message;
+		m_samplesCount = report.getSamplesCount();
 		updateWithStreamTime();
+		ui->sendRateText->setText(tr("%1M").arg(report.getSendRate() / 1e6, 0, 'f', 2));
+		ui->sendQueueText->setText(tr("%1").arg(report.getQueueDepth()));
 		return true;
 	}
 	else
@@ -219,7 +223,7 @@ void SDRdaemonSinkGui::updateSampleRateAndFrequency()
 
 void SDRdaemonSinkGui::updateTxDelayTooltip()
 {
-    double delay = ((127*127*m_settings.m_txDelay) / m_settings.m_sampleRate)/(128 + m_settings.m_nbFECBlocks);
+    double delay = ((UDPSinkFEC::getSamplesPerBlock(m_settings.m_udpSize, m_settings.m_sampleBits)*127*m_settings.m_txDelay) / m_settings.m_sampleRate)/(128 + m_settings.m_nbFECBlocks);
     ui->txDelayText->setToolTip(tr("%1 us").arg(QString::number(delay*1e6, 'f', 0)));
 }
 
@@ -237,6 +241,18 @@ void SDRdaemonSinkGui::displaySettings()
     QString s1 = QString::number(m_settings.m_nbFECBlocks, 'f', 0);
     ui->nominalNbBlocksText->setText(tr("%1/%2").arg(s0).arg(s1));
 
+    int udpSizeIndex = ui->udpSize->findText(QString::number(m_settings.m_udpSize));
+
+    if (udpSizeIndex < 0) // size not in the presets
+    {
+        ui->udpSize->addItem(QString::number(m_settings.m_udpSize));
+        udpSizeIndex = ui->udpSize->count() - 1;
+    }
+
+    ui->udpSize->setCurrentIndex(udpSizeIndex);
+    ui->sampleBits->setCurrentIndex(m_settings.m_sampleBits == 8 ? 2 : m_settings.m_sampleBits == 12 ? 1 : 0);
+    ui->compress->setChecked(m_settings.m_compress);
+
     ui->address->setText(m_settings.m_address);
     ui->dataPort->setText(tr("%1").arg(m_settings.m_dataPort));
     ui->controlPort->setText(tr("%1").arg(m_settings.m_controlPort));
@@ -424,6 +440,34 @@ void SDRdaemonSinkGui::on_nbFECBlocks_valueChanged(int value)
     sendSettings();
 }
 
+void SDRdaemonSinkGui::on_udpSize_currentIndexChanged(int index)
+{
+    if (index < 0) {
+        return;
+    }
+
+    m_settings.m_udpSize = ui->udpSize->itemText(index).toInt();
+    updateTxDelayTooltip();
+    sendSettings();
+}
+
+void SDRdaemonSinkGui::on_sampleBits_currentIndexChanged(int index)
+{
+    if (index < 0) {
+        return;
+    }
+
+    m_settings.m_sampleBits = ui->sampleBits->itemText(index).toInt();
+    updateTxDelayTooltip();
+    sendSettings();
+}
+
+void SDRdaemonSinkGui::on_compress_toggled(bool checked)
+{
+    m_settings.m_compress = checked;
+    sendSettings();
+}
+
 void SDRdaemonSinkGui::on_address_returnPressed()
 {
     m_settings.m_address = ui->address->text();
@@ -102,6 +102,9 @@ private slots:
     void on_interp_currentIndexChanged(int index);
     void on_txDelay_valueChanged(int value);
     void on_nbFECBlocks_valueChanged(int value);
+    void on_udpSize_currentIndexChanged(int index);
+    void on_sampleBits_currentIndexChanged(int index);
+    void on_compress_toggled(bool checked);
     void on_address_returnPressed();
     void on_dataPort_returnPressed();
     void on_controlPort_returnPressed();
@@ -18,6 +18,9 @@
 #include <errno.h>
 #include <QDebug>
 
+#include "SWGDeviceReport.h"
+#include "SWGSDRdaemonSinkReport.h"
+
 #include "util/simpleserializer.h"
 #include "dsp/dspcommands.h"
 #include "dsp/dspengine.h"
@@ -70,10 +73,13 @@ bool SDRdaemonSinkOutput::start()
 	m_sdrDaemonSinkThread->setCenterFrequency(m_settings.m_centerFrequency);
 	m_sdrDaemonSinkThread->setSamplerate(m_settings.m_sampleRate);
 	m_sdrDaemonSinkThread->setNbBlocksFEC(m_settings.m_nbFECBlocks);
+	m_sdrDaemonSinkThread->setUDPSize(m_settings.m_udpSize);
+	m_sdrDaemonSinkThread->setSampleBits(m_settings.m_sampleBits);
+	m_sdrDaemonSinkThread->setCompression(m_settings.m_compress);
 	m_sdrDaemonSinkThread->connectTimer(m_masterTimer);
 	m_sdrDaemonSinkThread->startWork();
 
-    double delay = ((127*127*m_settings.m_txDelay) / m_settings.m_sampleRate)/(128 + m_settings.m_nbFECBlocks);
+    double delay = ((UDPSinkFEC::getSamplesPerBlock(m_settings.m_udpSize, m_settings.m_sampleBits)*127*m_settings.m_txDelay) / m_settings.m_sampleRate)/(128 + m_settings.m_nbFECBlocks);
     m_sdrDaemonSinkThread->setTxDelay((int) (delay*1e6));
 
 	mutexLocker.unlock();
@@ -151,7 +157,10 @@ bool SDRdaemonSinkOutput::handleMessage(const Message& message)
 
 		if (m_sdrDaemonSinkThread != 0 && getMessageQueueToGUI())
 		{
-			report = MsgReportSDRdaemonSinkStreamTiming::create(m_sdrDaemonSinkThread->getSamplesCount());
+			report = MsgReportSDRdaemonSinkStreamTiming::create(
+			        m_sdrDaemonSinkThread->getSamplesCount(),
+			        m_sdrDaemonSinkThread->getSendRate(),
+			        m_sdrDaemonSinkThread->getQueueDepth());
 			getMessageQueueToGUI()->push(report);
 		}
 
@@ -234,6 +243,40 @@ void SDRdaemonSinkOutput::applySettings(const SDRdaemonSinkSettings& settings, b
         changeTxDelay = true;
     }
 
+    if (force || (m_settings.m_udpSize != settings.m_udpSize))
+    {
+        m_settings.m_udpSize = UDPSinkFEC::validUDPSize(settings.m_udpSize);
+
+        if (m_sdrDaemonSinkThread != 0)
+        {
+            m_sdrDaemonSinkThread->setUDPSize(m_settings.m_udpSize);
+        }
+
+        changeTxDelay = true;
+    }
+
+    if (force || (m_settings.m_sampleBits != settings.m_sampleBits))
+    {
+        m_settings.m_sampleBits = IQCodec::isValidBits(settings.m_sampleBits) ? settings.m_sampleBits : 16;
+
+        if (m_sdrDaemonSinkThread != 0)
+        {
+            m_sdrDaemonSinkThread->setSampleBits(m_settings.m_sampleBits);
+        }
+
+        changeTxDelay = true;
+    }
+
+    if (force || (m_settings.m_compress != settings.m_compress))
+    {
+        m_settings.m_compress = settings.m_compress;
+
+        if (m_sdrDaemonSinkThread != 0)
+        {
+            m_sdrDaemonSinkThread->setCompression(m_settings.m_compress);
+        }
+    }
+
     if (force || (m_settings.m_txDelay != settings.m_txDelay))
     {
         m_settings.m_txDelay = settings.m_txDelay;
@@ -242,13 +285,13 @@ void SDRdaemonSinkOutput::applySettings(const SDRdaemonSinkSettings& settings, b
 
     if (changeTxDelay)
     {
-        double delay = ((127*127*m_settings.m_txDelay) / m_settings.m_sampleRate)/(128 + m_settings.m_nbFECBlocks);
+        double delay = ((UDPSinkFEC::getSamplesPerBlock(m_settings.m_udpSize, m_settings.m_sampleBits)*127*m_settings.m_txDelay) / m_settings.m_sampleRate)/(128 + m_settings.m_nbFECBlocks);
         qDebug("SDRdaemonSinkOutput::applySettings: Tx delay: %f us", delay*1e6);
 
         if (m_sdrDaemonSinkThread != 0)
         {
             // delay is calculated as a fraction of the nominal UDP block process time
-            // frame size: 127 * 127 samples
+            // frame size: 127 blocks of samples per block samples (127 for 512 bytes blocks)
             // divided by sample rate gives the frame process time
             // divided by the number of actual blocks including FEC blocks gives the block (i.e. UDP block) process time
             m_sdrDaemonSinkThread->setTxDelay((int) (delay*1e6));
@@ -257,13 +300,16 @@ void SDRdaemonSinkOutput::applySettings(const SDRdaemonSinkSettings& settings, b
 
     mutexLocker.unlock();
 
-    qDebug("SDRdaemonSinkOutput::applySettings: %s m_centerFrequency: %llu m_sampleRate: %llu m_log2Interp: %d m_txDelay: %f m_nbFECBlocks: %d",
+    qDebug("SDRdaemonSinkOutput::applySettings: %s m_centerFrequency: %llu m_sampleRate: %llu m_log2Interp: %d m_txDelay: %f m_nbFECBlocks: %d m_udpSize: %d m_sampleBits: %d m_compress: %s",
             forwardChange ? "forward change" : "",
             m_settings.m_centerFrequency,
             m_settings.m_sampleRate,
             m_settings.m_log2Interp,
             m_settings.m_txDelay,
-            m_settings.m_nbFECBlocks);
+            m_settings.m_nbFECBlocks,
+            m_settings.m_udpSize,
+            m_settings.m_sampleBits,
+            m_settings.m_compress ? "on" : "off");
 
     if (forwardChange)
     {
@@ -272,3 +318,31 @@ void SDRdaemonSinkOutput::applySettings(const SDRdaemonSinkSettings& settings, b
     }
 
 }
+
+int SDRdaemonSinkOutput::webapiReportGet(
+        Swagger::SWGDeviceReport& response,
+        QString& errorMessage __attribute__((unused)))
+{
+    webapiFormatDeviceReport(response);
+    return 200;
+}
+
+void SDRdaemonSinkOutput::webapiFormatDeviceReport(Swagger::SWGDeviceReport& response)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    Swagger::SWGSDRdaemonSinkReport *report = response.getSdrDaemonSinkReport();
+
+    report->setQueueSize(UDPSINKFEC_NBTXROWS);
+    report->setUdpSize(UDPSinkFEC::validUDPSize(m_settings.m_udpSize));
+
+    if (m_sdrDaemonSinkThread != 0)
+    {
+        report->setSendRate(m_sdrDaemonSinkThread->getSendRate());
+        report->setQueueDepth(m_sdrDaemonSinkThread->getQueueDepth());
+    }
+    else
+    {
+        report->setSendRate(0);
+        report->setQueueDepth(0);
+    }
+}
@@ -117,18 +117,24 @@ public:
 
 	public:
 		std::size_t getSamplesCount() const { return m_samplesCount; }
+		int getSendRate() const { return m_sendRate; }
+		int getQueueDepth() const { return m_queueDepth; }
 
-		static MsgReportSDRdaemonSinkStreamTiming* create(std::size_t samplesCount)
+		static MsgReportSDRdaemonSinkStreamTiming* create(std::size_t samplesCount, int sendRate, int queueDepth)
 		{
-			return new MsgReportSDRdaemonSinkStreamTiming(samplesCount);
+			return new MsgReportSDRdaemonSinkStreamTiming(samplesCount, sendRate, queueDepth);
 		}
 
 	protected:
 		std::size_t m_samplesCount;
+		int m_sendRate;   //!< achieved UDP send rate in bytes per second
+		int m_queueDepth; //!< frames waiting for or in transmission
 
-		MsgReportSDRdaemonSinkStreamTiming(std::size_t samplesCount) :
+		MsgReportSDRdaemonSinkStreamTiming(std::size_t samplesCount, int sendRate, int queueDepth) :
 			Message(),
-			m_samplesCount(samplesCount)
+			m_samplesCount(samplesCount),
+			m_sendRate(sendRate),
+			m_queueDepth(queueDepth)
 		{ }
 	};
 
@@ -146,6 +152,10 @@ public:
 
 	virtual bool handleMessage(const Message& message);
 
+	virtual int webapiReportGet(
+	        Swagger::SWGDeviceReport& response,
+	        QString& errorMessage);
+
 private:
     DeviceSinkAPI *m_deviceAPI;
 	QMutex m_mutex;
@@ -156,6 +166,7 @@ private:
 	const QTimer& m_masterTimer;
 
 	void applySettings(const SDRdaemonSinkSettings& settings, bool force = false);
+	void webapiFormatDeviceReport(Swagger::SWGDeviceReport& response);
 };
 
 #endif // INCLUDE_SDRDAEMONSINKOUTPUT_H
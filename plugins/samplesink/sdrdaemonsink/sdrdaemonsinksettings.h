@@ -25,6 +25,9 @@ struct SDRdaemonSinkSettings {
     quint32 m_log2Interp;
     float   m_txDelay;
     quint32 m_nbFECBlocks;
+    quint32 m_udpSize;           //!< UDP block size in bytes
+    quint32 m_sampleBits;        //!< Bits per I or Q value on the link: 16, 12 or 8
+    bool    m_compress;          //!< Lossless compression of the frames
     QString m_address;
     quint16 m_dataPort;
     quint16 m_controlPort;
@@ -50,12 +50,17 @@ public:
 	void setSamplerate(int samplerate);
     void setNbBlocksFEC(uint32_t nbBlocksFEC) { m_udpSinkFEC.setNbBlocksFEC(nbBlocksFEC); };
     void setTxDelay(uint32_t txDelay) { m_udpSinkFEC.setTxDelay(txDelay); };
+    void setUDPSize(uint32_t udpSize) { m_udpSinkFEC.setUDPSize(udpSize); }
+    void setSampleBits(uint32_t sampleBits) { m_udpSinkFEC.setSampleBits(sampleBits); }
+    void setCompression(bool compress) { m_udpSinkFEC.setCompression(compress); }
     void setRemoteAddress(const QString& address, uint16_t port) { m_udpSinkFEC.setRemoteAddress(address, port); }
 
     bool isRunning() const { return m_running; }
 
     std::size_t getSamplesCount() const { return m_samplesCount; }
     void setSamplesCount(int samplesCount) { m_samplesCount = samplesCount; }
+    int getSendRate() const { return m_udpSinkFEC.getSendRate(); }
+    int getQueueDepth() const { return m_udpSinkFEC.getQueueDepth(); }
     void setChunkCorrection(int chunkCorrection) { m_chunkCorrection = chunkCorrection; }
 
 	void connectTimer(const QTimer& timer);
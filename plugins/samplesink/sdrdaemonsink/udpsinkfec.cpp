@@ -18,6 +18,7 @@
 
 #include <sys/time.h>
 #include <unistd.h>
+#include <algorithm>
 #include <boost/crc.hpp>
 #include <boost/cstdint.hpp>
 
@@ -30,19 +31,29 @@ MESSAGE_CLASS_DEFINITION(UDPSinkFECWorker::MsgConfigureRemoteAddress, Message)
 UDPSinkFEC::UDPSinkFEC() :
     m_centerFrequency(100000),
     m_sampleRate(48000),
-    m_sampleBytes(1),
-    m_sampleBits(8),
+    m_sampleBitsRequested(16),
+    m_sampleBits(16),
+    m_compressRequested(false),
+    m_compress(false),
     m_nbSamples(0),
     m_nbBlocksFEC(0),
     m_txDelay(0),
+    m_udpSizeRequested(m_udpSizeDefault),
+    m_udpSize(m_udpSizeDefault),
     m_txBlockIndex(0),
     m_txBlocksIndex(0),
     m_frameCount(0),
     m_sampleIndex(0)
 {
     m_currentMetaFEC.init();
-    m_bufMeta = new uint8_t[m_udpSize];
-    m_buf = new uint8_t[m_udpSize];
+    m_samplesPerBlock = getSamplesPerBlock(m_udpSize);
+    m_bufMeta = new uint8_t[m_udpSizeMax];
+    m_buf = new uint8_t[m_udpSizeMax];
+
+    for (int i = 0; i < UDPSINKFEC_NBTXROWS; i++) {
+        m_txBlocks[i] = new SuperBlock[256];
+    }
+
     m_udpThread = new QThread();
     m_udpWorker = new UDPSinkFECWorker();
 
@@ -59,6 +70,10 @@ UDPSinkFEC::~UDPSinkFEC()
     m_udpWorker->stop();
     m_udpThread->wait();
 
+    for (int i = 0; i < UDPSINKFEC_NBTXROWS; i++) {
+        delete[] m_txBlocks[i];
+    }
+
     delete[] m_buf;
     delete[] m_bufMeta;
     delete m_udpWorker;
@@ -77,12 +92,47 @@ void UDPSinkFEC::setNbBlocksFEC(uint32_t nbBlocksFEC)
     m_nbBlocksFEC = nbBlocksFEC;
 }
 
+void UDPSinkFEC::setUDPSize(uint32_t udpSize)
+{
+    m_udpSizeRequested = validUDPSize(udpSize);
+    qDebug() << "UDPSinkFEC::setUDPSize: udpSize: " << m_udpSizeRequested;
+}
+
+void UDPSinkFEC::setSampleBits(uint8_t sampleBits)
+{
+    if (IQCodec::isValidBits(sampleBits))
+    {
+        qDebug() << "UDPSinkFEC::setSampleBits: sampleBits: " << (int) sampleBits;
+        m_sampleBitsRequested = sampleBits;
+    }
+    else
+    {
+        qWarning("UDPSinkFEC::setSampleBits: unsupported number of bits: %d", (int) sampleBits);
+    }
+}
+
+void UDPSinkFEC::setCompression(bool compress)
+{
+    qDebug() << "UDPSinkFEC::setCompression: compress: " << compress;
+    m_compressRequested = compress;
+}
+
 void UDPSinkFEC::setRemoteAddress(const QString& address, uint16_t port)
 {
     qDebug() << "UDPSinkFEC::setRemoteAddress: address: " << address << " port: " << port;
     m_udpWorker->setRemoteAddress(address, port);
 }
 
+int UDPSinkFEC::getSendRate() const
+{
+    return m_udpWorker->getSendRate();
+}
+
+int UDPSinkFEC::getQueueDepth() const
+{
+    return m_udpWorker->getFramesPending();
+}
+
 void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunkSize)
 {
     //qDebug("UDPSinkFEC::write(: %u samples", sampleChunkSize);
@@ -100,10 +150,18 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
 
             gettimeofday(&tv, 0);
 
+            // block size and coding changes are applied on frame boundaries only
+            m_udpSize = m_udpSizeRequested;
+            m_sampleBits = m_sampleBitsRequested;
+            m_compress = m_compressRequested;
+            m_samplesPerBlock = getSamplesPerBlock(m_udpSize, m_sampleBits);
+
             // create meta data TODO: semaphore
             metaData.m_centerFrequency = m_centerFrequency;
             metaData.m_sampleRate = m_sampleRate;
-            metaData.m_sampleBytes = m_sampleBytes;
+            metaData.m_sampleBytes = sizeof(FixReal)
+                    | MetaDataFEC::m_indPacked
+                    | (m_compress ? MetaDataFEC::m_indCompressed : 0);
             metaData.m_sampleBits = m_sampleBits;
             metaData.m_nbOriginalBlocks = m_nbOriginalBlocks;
             metaData.m_nbFECBlocks = m_nbBlocksFEC;
@@ -114,6 +172,7 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
             crc32.process_bytes(&metaData, 20);
 
             metaData.m_crc32 = crc32.checksum();
+            metaData.m_udpSize = m_udpSize;
 
             memset((void *) &m_superBlock, 0, m_udpSize);
 
@@ -128,10 +187,12 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
                         << ":" << metaData.m_sampleRate
                         << ":" << (int) (metaData.m_sampleBytes & 0xF)
                         << ":" << (int) metaData.m_sampleBits
+                        << ":" << (metaData.m_sampleBytes & MetaDataFEC::m_indCompressed ? "C" : "U")
                         << "|" << (int) metaData.m_nbOriginalBlocks
                         << ":" << (int) metaData.m_nbFECBlocks
                         << "|" << metaData.m_tv_sec
                         << ":" << metaData.m_tv_usec
+                        << "|" << metaData.m_udpSize
                         << "|";
 
                 m_currentMetaFEC = metaData;
@@ -141,9 +202,9 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
             m_txBlockIndex = 1; // next Tx block with data
         }
 
-        if (m_sampleIndex + inRemainingSamples < samplesPerBlock) // there is still room in the current super block
+        if (m_sampleIndex + inRemainingSamples < (int) m_samplesPerBlock) // there is still room in the current super block
         {
-            memcpy((void *) &m_superBlock.protectedBlock.m_samples[m_sampleIndex],
+            memcpy((void *) &m_blockSamples[m_sampleIndex],
                     (const void *) &(*it),
                     inRemainingSamples * sizeof(Sample));
             m_sampleIndex += inRemainingSamples;
@@ -151,12 +212,18 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
         }
         else // complete super block and initiate the next if not end of frame
         {
-            memcpy((void *) &m_superBlock.protectedBlock.m_samples[m_sampleIndex],
+            memcpy((void *) &m_blockSamples[m_sampleIndex],
                     (const void *) &(*it),
-                    (samplesPerBlock - m_sampleIndex) * sizeof(Sample));
-            it += samplesPerBlock - m_sampleIndex;
+                    (m_samplesPerBlock - m_sampleIndex) * sizeof(Sample));
+            it += m_samplesPerBlock - m_sampleIndex;
             m_sampleIndex = 0;
 
+            // pack to the link sample size and clear the bytes left over after the last sample
+            int packedBytes = m_samplesPerBlock * IQCodec::getBytesPerSample(m_sampleBits);
+            uint8_t *protectedBlock = (uint8_t *) &m_superBlock.protectedBlock;
+            IQCodec::pack((const int16_t *) m_blockSamples, m_samplesPerBlock, m_sampleBits, protectedBlock);
+            memset((void *) &protectedBlock[packedBytes], 0, m_udpSize - sizeof(Header) - packedBytes);
+
             m_superBlock.header.frameIndex = m_frameCount;
             m_superBlock.header.blockIndex = m_txBlockIndex;
             m_txBlocks[m_txBlocksIndex][m_txBlockIndex] =  m_superBlock;
@@ -166,13 +233,13 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
                 int nbBlocksFEC = m_nbBlocksFEC;
                 int txDelay = m_txDelay;
 
-                // TODO: send blocks
                 //qDebug("UDPSinkFEC::write: push frame to worker: %u", m_frameCount);
-                m_udpWorker->pushTxFrame(m_txBlocks[m_txBlocksIndex], nbBlocksFEC, txDelay, m_frameCount);
-                //m_txThread = new std::thread(transmitUDP, this, m_txBlocks[m_txBlocksIndex], m_frameCount, nbBlocksFEC, txDelay, m_cm256Valid);
-                //transmitUDP(this, m_txBlocks[m_txBlocksIndex], m_frameCount, m_nbBlocksFEC, m_txDelay, m_cm256Valid);
+                m_udpWorker->pushTxFrame(m_txBlocks[m_txBlocksIndex], nbBlocksFEC, txDelay, m_frameCount, m_udpSize, m_sampleBits, m_compress);
+
+                // the next row must not be still in the hands of the worker
+                m_udpWorker->waitFramesPending(UDPSINKFEC_NBTXROWS - 1);
 
-                m_txBlocksIndex = (m_txBlocksIndex + 1) % 4;
+                m_txBlocksIndex = (m_txBlocksIndex + 1) % UDPSINKFEC_NBTXROWS;
                 m_txBlockIndex = 0;
                 m_frameCount++;
             }
@@ -185,42 +252,79 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
 }
 
 UDPSinkFECWorker::UDPSinkFECWorker() :
-        m_running(false),
-        m_remotePort(9090)
+        m_running(true),
+        m_framesPending(0),
+        m_sendRate(0),
+        m_remotePort(9090),
+        m_destAddrValid(false),
+        m_paceTokens(0.0),
+        m_paceLastNs(0),
+        m_rateStartNs(0),
+        m_rateBytes(0)
 {
     m_cm256Valid = m_cm256.isInitialized();
-    connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()), Qt::DirectConnection);
+    m_fecBlocks = new uint8_t[256 * sizeof(UDPSinkFEC::ProtectedBlock)];
+    m_frameIQ = new int16_t[(UDPSinkFEC::m_nbOriginalBlocks - 1) * 4 * UDPSinkFEC::samplesPerBlockMax];
+    m_frameCompressed = new uint8_t[(UDPSinkFEC::m_nbOriginalBlocks - 1) * sizeof(UDPSinkFEC::ProtectedBlock)];
+    memset((void *) &m_destAddr, 0, sizeof(sockaddr_in));
+    m_paceTimer.start();
 }
 
 UDPSinkFECWorker::~UDPSinkFECWorker()
 {
-    disconnect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
     m_inputMessageQueue.clear();
+    delete[] m_fecBlocks;
+    delete[] m_frameIQ;
+    delete[] m_frameCompressed;
 }
 
 void UDPSinkFECWorker::pushTxFrame(UDPSinkFEC::SuperBlock *txBlocks,
     uint32_t nbBlocksFEC,
     uint32_t txDelay,
-    uint16_t frameIndex)
+    uint16_t frameIndex,
+    uint32_t udpSize,
+    uint32_t sampleBits,
+    bool compress)
 {
     //qDebug("UDPSinkFECWorker::pushTxFrame. %d", m_inputMessageQueue.size());
-    m_inputMessageQueue.push(MsgUDPFECEncodeAndSend::create(txBlocks, nbBlocksFEC, txDelay, frameIndex));
+    m_framesPending.fetchAndAddOrdered(1);
+    m_inputMessageQueue.push(MsgUDPFECEncodeAndSend::create(txBlocks, nbBlocksFEC, txDelay, frameIndex, udpSize, sampleBits, compress), false);
+    QMutexLocker mutexLocker(&m_frameMutex);
+    m_frameQueued.wakeOne();
 }
 
 void UDPSinkFECWorker::setRemoteAddress(const QString& address, uint16_t port)
 {
-    m_inputMessageQueue.push(MsgConfigureRemoteAddress::create(address, port));
+    m_inputMessageQueue.push(MsgConfigureRemoteAddress::create(address, port), false);
+    QMutexLocker mutexLocker(&m_frameMutex);
+    m_frameQueued.wakeOne();
 }
 
-void UDPSinkFECWorker::process()
+void UDPSinkFECWorker::waitFramesPending(int maxPending)
 {
-    m_running  = true;
+    QMutexLocker mutexLocker(&m_frameMutex);
 
+    // time out regularly so that a stopped worker cannot hang the caller
+    while (m_running && (m_framesPending.load() > maxPending)) {
+        m_frameSent.wait(&m_frameMutex, 100);
+    }
+}
+
+void UDPSinkFECWorker::process()
+{
     qDebug("UDPSinkFECWorker::process: started");
 
     while (m_running)
     {
-        usleep(250000);
+        m_frameMutex.lock();
+
+        if (m_running && (m_inputMessageQueue.size() == 0)) {
+            m_frameQueued.wait(&m_frameMutex, 250);
+        }
+
+        m_frameMutex.unlock();
+        handleInputMessages();
+        updateSendRate(0); // let the measured rate decay when nothing is sent
     }
 
     qDebug("UDPSinkFECWorker::process: stopped");
@@ -229,7 +333,10 @@ void UDPSinkFECWorker::process()
 
 void UDPSinkFECWorker::stop()
 {
+    QMutexLocker mutexLocker(&m_frameMutex);
     m_running = false;
+    m_frameQueued.wakeAll();
+    m_frameSent.wakeAll();
 }
 
 void UDPSinkFECWorker::handleInputMessages()
@@ -241,7 +348,16 @@ void UDPSinkFECWorker::handleInputMessages()
         if (MsgUDPFECEncodeAndSend::match(*message))
         {
             MsgUDPFECEncodeAndSend *sendMsg = (MsgUDPFECEncodeAndSend *) message;
-            encodeAndTransmit(sendMsg->getTxBlocks(), sendMsg->getFrameIndex(), sendMsg->getNbBlocsFEC(), sendMsg->getTxDelay());
+            encodeAndTransmit(sendMsg->getTxBlocks(),
+                    sendMsg->getFrameIndex(),
+                    sendMsg->getNbBlocsFEC(),
+                    sendMsg->getTxDelay(),
+                    sendMsg->getUDPSize(),
+                    sendMsg->getSampleBits(),
+                    sendMsg->getCompress());
+            m_framesPending.fetchAndAddOrdered(-1);
+            QMutexLocker mutexLocker(&m_frameMutex);
+            m_frameSent.wakeAll();
         }
         else if (MsgConfigureRemoteAddress::match(*message))
         {
@@ -249,32 +365,99 @@ void UDPSinkFECWorker::handleInputMessages()
             MsgConfigureRemoteAddress *addressMsg = (MsgConfigureRemoteAddress *) message;
             m_remoteAddress = addressMsg->getAddress();
             m_remotePort = addressMsg->getPort();
+
+            try
+            {
+                UDPSocket::ResolveAddr(m_remoteAddress.toStdString(), m_remotePort, m_destAddr);
+                m_destAddrValid = true;
+            }
+            catch (CSocketException& e)
+            {
+                qWarning("UDPSinkFECWorker::handleInputMessages: cannot resolve %s: %s", qPrintable(m_remoteAddress), e.what());
+                m_destAddrValid = false;
+            }
         }
 
         delete message;
     }
 }
 
-void UDPSinkFECWorker::encodeAndTransmit(UDPSinkFEC::SuperBlock *txBlockx, uint16_t frameIndex, uint32_t nbBlocksFEC, uint32_t txDelay)
+/**
+ * Compress the data blocks of the frame in place. The compressed stream fills the first data blocks
+ * and the remaining original blocks are cleared. These are not sent but as the receiver knows they
+ * are zero they still take part in the FEC code and the recovery capability is unchanged.
+ * Returns the number of original blocks to send including the meta data block.
+ */
+uint32_t UDPSinkFECWorker::compressFrame(UDPSinkFEC::SuperBlock *txBlockx, uint32_t udpSize, uint32_t sampleBits)
+{
+    int blockBytes = udpSize - sizeof(UDPSinkFEC::Header);
+    int nbDataBlocks = UDPSinkFEC::m_nbOriginalBlocks - 1;
+    int samplesPerBlock = UDPSinkFEC::getSamplesPerBlock(udpSize, sampleBits);
+
+    for (int i = 0; i < nbDataBlocks; i++)
+    {
+        IQCodec::unpack((const uint8_t *) &txBlockx[i + 1].protectedBlock,
+                samplesPerBlock,
+                sampleBits,
+                &m_frameIQ[2 * i * samplesPerBlock]);
+    }
+
+    // at least one block must be saved else the frame is sent as is
+    int nbBytes = IQCodec::compress(m_frameIQ,
+            nbDataBlocks * samplesPerBlock,
+            sampleBits,
+            m_frameCompressed,
+            (nbDataBlocks - 1) * blockBytes);
+
+    if (nbBytes < 0) {
+        return UDPSinkFEC::m_nbOriginalBlocks;
+    }
+
+    int nbCompressedBlocks = (nbBytes + blockBytes - 1) / blockBytes;
+    memset((void *) &m_frameCompressed[nbBytes], 0, nbCompressedBlocks * blockBytes - nbBytes);
+
+    for (int i = 0; i < nbDataBlocks; i++)
+    {
+        if (i < nbCompressedBlocks) {
+            memcpy((void *) &txBlockx[i + 1].protectedBlock, (const void *) &m_frameCompressed[i * blockBytes], blockBytes);
+        } else {
+            memset((void *) &txBlockx[i + 1].protectedBlock, 0, blockBytes);
+        }
+    }
+
+    return 1 + nbCompressedBlocks;
+}
+
+void UDPSinkFECWorker::encodeAndTransmit(
+        UDPSinkFEC::SuperBlock *txBlockx,
+        uint16_t frameIndex,
+        uint32_t nbBlocksFEC,
+        uint32_t txDelay,
+        uint32_t udpSize,
+        uint32_t sampleBits,
+        bool compress)
 {
     CM256::cm256_encoder_params cm256Params;  //!< Main interface with CM256 encoder
     CM256::cm256_block descriptorBlocks[256]; //!< Pointers to data for CM256 encoder
-    UDPSinkFEC::ProtectedBlock fecBlocks[256];   //!< FEC data
+    const void *datagrams[256];               //!< Datagrams to send in order
+    int nbDatagrams = 0;
+    int blockBytes = udpSize - sizeof(UDPSinkFEC::Header); //!< only this part of the protected blocks is sent
+    uint32_t nbBlocksSent = compress ? compressFrame(txBlockx, udpSize, sampleBits) : UDPSinkFEC::m_nbOriginalBlocks;
+    uint8_t filler = nbBlocksSent < UDPSinkFEC::m_nbOriginalBlocks ? nbBlocksSent : 0;
 
     if ((nbBlocksFEC == 0) || !m_cm256Valid)
     {
 //        qDebug("UDPSinkFECWorker::encodeAndTransmit: transmit frame without FEC to %s:%d", m_remoteAddress.toStdString().c_str(), m_remotePort);
 
-        for (unsigned int i = 0; i < UDPSinkFEC::m_nbOriginalBlocks; i++)
+        for (unsigned int i = 0; i < nbBlocksSent; i++)
         {
-            m_socket.SendDataGram((const void *) &txBlockx[i], (int) UDPSinkFEC::m_udpSize, m_remoteAddress.toStdString(), (uint32_t) m_remotePort);
-            //m_udpSocket->writeDatagram((const char *) &txBlockx[i], (int) UDPSinkFEC::m_udpSize, m_remoteAddress, m_remotePort);
-            usleep(txDelay);
+            txBlockx[i].header.filler = filler;
+            datagrams[nbDatagrams++] = (const void *) &txBlockx[i];
         }
     }
     else
     {
-        cm256Params.BlockBytes = sizeof(UDPSinkFEC::ProtectedBlock);
+        cm256Params.BlockBytes = blockBytes;
         cm256Params.OriginalCount = UDPSinkFEC::m_nbOriginalBlocks;
         cm256Params.RecoveryCount = nbBlocksFEC;
 
@@ -283,17 +466,18 @@ void UDPSinkFECWorker::encodeAndTransmit(UDPSinkFEC::SuperBlock *txBlockx, uint1
         for (int i = 0; i < cm256Params.OriginalCount + cm256Params.RecoveryCount; ++i)
         {
             if (i >= cm256Params.OriginalCount) {
-                memset((void *) &txBlockx[i].protectedBlock, 0, sizeof(UDPSinkFEC::ProtectedBlock));
+                memset((void *) &txBlockx[i].protectedBlock, 0, blockBytes);
             }
 
             txBlockx[i].header.frameIndex = frameIndex;
             txBlockx[i].header.blockIndex = i;
+            txBlockx[i].header.filler = filler;
             descriptorBlocks[i].Block = (void *) &(txBlockx[i].protectedBlock);
             descriptorBlocks[i].Index = txBlockx[i].header.blockIndex;
         }
 
         // Encode FEC blocks
-        if (m_cm256.cm256_encode(cm256Params, descriptorBlocks, fecBlocks))
+        if (m_cm256.cm256_encode(cm256Params, descriptorBlocks, m_fecBlocks))
         {
             qDebug("UDPSinkFECWorker::encodeAndTransmit: CM256 encode failed. No transmission.");
             return;
@@ -302,7 +486,7 @@ void UDPSinkFECWorker::encodeAndTransmit(UDPSinkFEC::SuperBlock *txBlockx, uint1
         // Merge FEC with data to transmit
         for (int i = 0; i < cm256Params.RecoveryCount; i++)
         {
-            txBlockx[i + cm256Params.OriginalCount].protectedBlock = fecBlocks[i];
+            memcpy((void *) &txBlockx[i + cm256Params.OriginalCount].protectedBlock, (const void *) &m_fecBlocks[i * blockBytes], blockBytes);
         }
 
         // Transmit all blocks
@@ -311,28 +495,80 @@ void UDPSinkFECWorker::encodeAndTransmit(UDPSinkFEC::SuperBlock *txBlockx, uint1
 
         for (int i = 0; i < cm256Params.OriginalCount + cm256Params.RecoveryCount; i++)
         {
+            if ((i >= (int) nbBlocksSent) && (i < cm256Params.OriginalCount)) { // cleared by compression
+                continue;
+            }
 #ifdef SDRDAEMON_PUNCTURE
             if (i == SDRDAEMON_PUNCTURE) {
                 continue;
             }
 #endif
-//            std::cerr << "UDPSinkFEC::transmitUDP:"
-//                  << " i: " << i
-//                  << " frameIndex: " << (int) m_txBlocks[i].header.frameIndex
-//                  << " blockIndex: " << (int) m_txBlocks[i].header.blockIndex
-//                  << " i.q:";
-//
-//            for (int j = 0; j < 10; j++)
-//            {
-//                std::cerr << " " << (int) m_txBlocks[i].protectedBlock.m_samples[j].m_real
-//                        << "." << (int) m_txBlocks[i].protectedBlock.m_samples[j].m_imag;
-//            }
-//
-//            std::cerr << std::endl;
-
-            m_socket.SendDataGram((const void *) &txBlockx[i], (int) UDPSinkFEC::m_udpSize, m_remoteAddress.toStdString(), (uint32_t) m_remotePort);
-            //m_udpSocket->writeDatagram((const char *) &txBlockx[i], (int) UDPSinkFEC::m_udpSize, m_remoteAddress, m_remotePort);
-            usleep(txDelay);
+            datagrams[nbDatagrams++] = (const void *) &txBlockx[i];
+        }
+    }
+
+    transmitPaced(datagrams, nbDatagrams, udpSize, txDelay);
+}
+
+/**
+ * Send the datagrams in batches at the average rate of one datagram every txDelay microseconds.
+ * A token bucket holding at most one burst of datagrams replaces the former sleep after each
+ * datagram so that the system call and the sleep granularity are paid once per batch only.
+ * A null txDelay sends the frame as fast as possible.
+ */
+void UDPSinkFECWorker::transmitPaced(const void * const *datagrams, int nbDatagrams, uint32_t udpSize, uint32_t txDelay)
+{
+    if (!m_destAddrValid) {
+        return;
+    }
+
+    int burst = std::max(1, (int) (UDPSINKFEC_PACEBURSTBYTES / udpSize));
+    int sent = 0;
+
+    while ((sent < nbDatagrams) && m_running)
+    {
+        int batch = std::min(nbDatagrams - sent, burst);
+
+        if (txDelay > 0)
+        {
+            qint64 nowNs = m_paceTimer.nsecsElapsed();
+            m_paceTokens += (nowNs - m_paceLastNs) / (txDelay * 1000.0);
+            m_paceTokens = std::min(m_paceTokens, (double) burst); // idle time does not build up credit beyond one burst
+            m_paceLastNs = nowNs;
+
+            if (m_paceTokens < batch)
+            {
+                usleep((useconds_t) ((batch - m_paceTokens) * txDelay));
+                continue;
+            }
+
+            m_paceTokens -= batch;
+        }
+
+        try
+        {
+            m_socket.SendDataGrams(&datagrams[sent], (int) udpSize, batch, m_destAddr);
+        }
+        catch (CSocketException& e)
+        {
+            qDebug("UDPSinkFECWorker::transmitPaced: %s", e.what());
         }
+
+        sent += batch;
+        updateSendRate(batch * udpSize);
+    }
+}
+
+void UDPSinkFECWorker::updateSendRate(int nbBytes)
+{
+    qint64 nowNs = m_paceTimer.nsecsElapsed();
+    qint64 windowNs = nowNs - m_rateStartNs;
+    m_rateBytes += nbBytes;
+
+    if (windowNs >= 1000000000LL) // one second measurement window
+    {
+        m_sendRate.store((int) ((m_rateBytes * 1000000000LL) / windowNs));
+        m_rateStartNs = nowNs;
+        m_rateBytes = 0;
     }
 }
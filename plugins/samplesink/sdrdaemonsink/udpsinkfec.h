@@ -24,6 +24,10 @@
 #include <QHostAddress>
 #include <QString>
 #include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QAtomicInt>
 
 #include "cm256.h"
 
@@ -31,16 +35,21 @@
 #include "util/CRC64.h"
 #include "util/messagequeue.h"
 #include "util/message.h"
+#include "util/iqcodec.h"
 
 #include "UDPSocket.h"
 
+#define UDPSINKFEC_NBTXROWS 4              //!< Number of frame rows in the Tx ring shared with the worker
+#define UDPSINKFEC_PACEBURSTBYTES 65536    //!< Largest burst of bytes sent in one go by the rate pacer
+
 class UDPSinkFECWorker;
 
 class UDPSinkFEC : public QObject
 {
     Q_OBJECT
 public:
-    static const uint32_t m_udpSize = 512;          //!< Size of UDP block in number of bytes
+    static const uint32_t m_udpSizeDefault = 512;   //!< Default size of UDP block in number of bytes
+    static const uint32_t m_udpSizeMax = 8972;      //!< Largest UDP block: payload of a 9000 bytes jumbo frame
     static const uint32_t m_nbOriginalBlocks = 128; //!< Number of original blocks in a protected block sequence
 #pragma pack(push, 1)
     struct MetaDataFEC
@@ -54,10 +63,15 @@ public:
         uint32_t m_tv_sec;            //!< 16 seconds of timestamp at start time of super-frame processing
         uint32_t m_tv_usec;           //!< 20 microseconds of timestamp at start time of super-frame processing
         uint32_t m_crc32;             //!< 24 CRC32 of the above
+        uint16_t m_udpSize;           //!< 26 UDP block size in bytes. Not in CRC for compatibility. 0 from older senders means 512
+
+        static const uint8_t m_indPacked = 0x20;     //!< Indicator: I and Q values are packed on m_sampleBits bits. Else raw 16 bits
+        static const uint8_t m_indCompressed = 0x10; //!< Indicator: frames may be compressed. See Header::filler
 
         bool operator==(const MetaDataFEC& rhs)
         {
-            return (memcmp((const void *) this, (const void *) &rhs, 12) == 0); // Only the 12 first bytes are relevant
+            return (memcmp((const void *) this, (const void *) &rhs, 12) == 0) // Only the 12 first bytes are relevant
+                && (m_udpSize == rhs.m_udpSize);
         }
 
         void init()
@@ -71,14 +85,14 @@ public:
     {
         uint16_t frameIndex;
         uint8_t  blockIndex;
-        uint8_t  filler;
+        uint8_t  filler;     //!< Number of original blocks sent when the frame is compressed else 0
     };
 
-    static const int samplesPerBlock = (m_udpSize - sizeof(Header)) / sizeof(Sample);
+    static const int samplesPerBlockMax = (m_udpSizeMax - sizeof(Header)) / sizeof(Sample);
 
     struct ProtectedBlock
     {
-        Sample m_samples[samplesPerBlock];
+        Sample m_samples[samplesPerBlockMax]; //!< only the first getSamplesPerBlock(udpSize) are sent
     };
 
     struct SuperBlock
@@ -115,12 +129,32 @@ public:
     /** Set sample rate given in Hz */
     void setSampleRate(uint32_t sampleRate) { m_sampleRate = sampleRate; }
 
-    void setSampleBytes(uint8_t sampleBytes) { m_sampleBytes = (sampleBytes & 0x0F) + (m_sampleBytes & 0xF0); }
-    void setSampleBits(uint8_t sampleBits) { m_sampleBits = sampleBits; }
+    void setSampleBits(uint8_t sampleBits); //!< Bits per I or Q value on the link: 16, 12 or 8. Applies from the next frame
+    void setCompression(bool compress);     //!< Compress the frames losslessly. Applies from the next frame
 
     void setNbBlocksFEC(uint32_t nbBlocksFEC);
     void setTxDelay(uint32_t txDelay);
     void setRemoteAddress(const QString& address, uint16_t port);
+    void setUDPSize(uint32_t udpSize); //!< Applies from the next frame
+
+    /** Clamp to the supported range keeping a whole number of samples after the header */
+    static uint32_t validUDPSize(uint32_t udpSize)
+    {
+        udpSize = udpSize < m_udpSizeDefault ? m_udpSizeDefault : udpSize > m_udpSizeMax ? m_udpSizeMax : udpSize;
+        return udpSize - ((udpSize - sizeof(Header)) % sizeof(Sample));
+    }
+
+    /** Number of I/Q samples carried by a data block of the given UDP block size and bits per I or Q value */
+    static uint32_t getSamplesPerBlock(uint32_t udpSize, uint32_t sampleBits = 16)
+    {
+        return (udpSize - sizeof(Header)) / IQCodec::getBytesPerSample(sampleBits);
+    }
+
+    /** Achieved send rate in bytes per second measured by the worker */
+    int getSendRate() const;
+
+    /** Number of frames queued to the worker or being transmitted */
+    int getQueueDepth() const;
 
     /** Return true if the stream is OK, return false if there is an error. */
     operator bool() const
@@ -133,8 +167,10 @@ private:
 
     uint32_t     m_centerFrequency;   //!< center frequency in kHz
     uint32_t     m_sampleRate;        //!< sample rate in Hz
-    uint8_t      m_sampleBytes;       //!< number of bytes per sample
-    uint8_t      m_sampleBits;        //!< number of effective bits per sample
+    uint8_t      m_sampleBitsRequested; //!< bits per I or Q value on the link to use from the next frame
+    uint8_t      m_sampleBits;        //!< bits per I or Q value on the link of the current frame
+    bool         m_compressRequested; //!< compression to use from the next frame
+    bool         m_compress;          //!< compression of the current frame
     uint32_t     m_nbSamples;         //!< total number of samples sent int the last frame
 
     QHostAddress m_ownAddress;
@@ -146,8 +182,12 @@ private:
     MetaDataFEC m_currentMetaFEC;        //!< Meta data for current frame
     uint32_t m_nbBlocksFEC;              //!< Variable number of FEC blocks
     uint32_t m_txDelay;                  //!< Delay in microseconds (usleep) between each sending of an UDP datagram
-    SuperBlock m_txBlocks[4][256];       //!< UDP blocks to send with original data + FEC
+    uint32_t m_udpSizeRequested;         //!< UDP block size to use from the next frame
+    uint32_t m_udpSize;                  //!< UDP block size of the current frame
+    uint32_t m_samplesPerBlock;          //!< I/Q samples per data block of the current frame
+    SuperBlock *m_txBlocks[UDPSINKFEC_NBTXROWS]; //!< UDP blocks to send with original data + FEC. 256 blocks per row
     SuperBlock m_superBlock;             //!< current super block being built
+    Sample m_blockSamples[2*samplesPerBlockMax]; //!< samples of the current super block before packing
     int m_txBlockIndex;                  //!< Current index in blocks to transmit in the Tx row
     int m_txBlocksIndex;                 //!< Current index of Tx blocks row
     uint16_t m_frameCount;               //!< transmission frame count
@@ -170,14 +210,20 @@ public:
         uint32_t getNbBlocsFEC() const { return m_nbBlocksFEC; }
         uint32_t getTxDelay() const { return m_txDelay; }
         uint16_t getFrameIndex() const { return m_frameIndex; }
+        uint32_t getUDPSize() const { return m_udpSize; }
+        uint32_t getSampleBits() const { return m_sampleBits; }
+        bool getCompress() const { return m_compress; }
 
         static MsgUDPFECEncodeAndSend* create(
                 UDPSinkFEC::SuperBlock *txBlocks,
                 uint32_t nbBlocksFEC,
                 uint32_t txDelay,
-                uint16_t frameIndex)
+                uint16_t frameIndex,
+                uint32_t udpSize,
+                uint32_t sampleBits,
+                bool compress)
         {
-            return new MsgUDPFECEncodeAndSend(txBlocks, nbBlocksFEC, txDelay, frameIndex);
+            return new MsgUDPFECEncodeAndSend(txBlocks, nbBlocksFEC, txDelay, frameIndex, udpSize, sampleBits, compress);
         }
 
     private:
@@ -185,16 +231,25 @@ public:
         uint32_t m_nbBlocksFEC;
         uint32_t m_txDelay;
         uint16_t m_frameIndex;
+        uint32_t m_udpSize;
+        uint32_t m_sampleBits;
+        bool m_compress;
 
         MsgUDPFECEncodeAndSend(
                 UDPSinkFEC::SuperBlock *txBlocks,
                 uint32_t nbBlocksFEC,
                 uint32_t txDelay,
-                uint16_t frameIndex) :
+                uint16_t frameIndex,
+                uint32_t udpSize,
+                uint32_t sampleBits,
+                bool compress) :
             m_txBlockx(txBlocks),
             m_nbBlocksFEC(nbBlocksFEC),
             m_txDelay(txDelay),
-            m_frameIndex(frameIndex)
+            m_frameIndex(frameIndex),
+            m_udpSize(udpSize),
+            m_sampleBits(sampleBits),
+            m_compress(compress)
         {}
     };
 
@@ -226,9 +281,15 @@ public:
     void pushTxFrame(UDPSinkFEC::SuperBlock *txBlocks,
         uint32_t nbBlocksFEC,
         uint32_t txDelay,
-        uint16_t frameIndex);
+        uint16_t frameIndex,
+        uint32_t udpSize,
+        uint32_t sampleBits,
+        bool compress);
     void setRemoteAddress(const QString& address, uint16_t port);
     void stop();
+    void waitFramesPending(int maxPending); //!< Block the caller until no more than maxPending frames are queued or in transmission
+    int getFramesPending() const { return m_framesPending.load(); }
+    int getSendRate() const { return m_sendRate.load(); }
 
     MessageQueue m_inputMessageQueue;    //!< Queue for asynchronous inbound communication
 
@@ -238,18 +299,34 @@ signals:
 public slots:
     void process();
 
-private slots:
-    void handleInputMessages();
-
 private:
-    void encodeAndTransmit(UDPSinkFEC::SuperBlock *txBlockx, uint16_t frameIndex, uint32_t nbBlocksFEC, uint32_t txDelay);
-
-    bool m_running;
+    void handleInputMessages();
+    void encodeAndTransmit(UDPSinkFEC::SuperBlock *txBlockx, uint16_t frameIndex, uint32_t nbBlocksFEC, uint32_t txDelay, uint32_t udpSize, uint32_t sampleBits, bool compress);
+    uint32_t compressFrame(UDPSinkFEC::SuperBlock *txBlockx, uint32_t udpSize, uint32_t sampleBits);
+    void transmitPaced(const void * const *datagrams, int nbDatagrams, uint32_t udpSize, uint32_t txDelay);
+    void updateSendRate(int nbBytes);
+
+    volatile bool m_running;
+    QMutex m_frameMutex;                 //!< Protects the waits on the two conditions below
+    QWaitCondition m_frameQueued;        //!< Signaled when a message is pushed to the worker
+    QWaitCondition m_frameSent;          //!< Signaled when the worker has finished with a frame
+    QAtomicInt m_framesPending;          //!< Frames pushed and not yet transmitted
+    QAtomicInt m_sendRate;               //!< Achieved send rate in bytes per second
     CM256 m_cm256;                       //!< CM256 library object
     bool m_cm256Valid;                   //!< true if CM256 library is initialized correctly
+    uint8_t *m_fecBlocks;                //!< FEC data output of the encoder. Blocks are packed end to end.
+    int16_t *m_frameIQ;                  //!< Unpacked I/Q values of a frame to compress
+    uint8_t *m_frameCompressed;          //!< Compressed frame. Blocks are packed end to end.
     UDPSocket    m_socket;
     QString      m_remoteAddress;
     uint16_t     m_remotePort;
+    sockaddr_in  m_destAddr;             //!< Remote address resolved once per configuration change
+    bool         m_destAddrValid;
+    QElapsedTimer m_paceTimer;           //!< Time base of the pacer and rate measurement
+    double       m_paceTokens;           //!< Token bucket level in number of datagrams
+    qint64       m_paceLastNs;           //!< Last token bucket refill time
+    qint64       m_rateStartNs;          //!< Start of the current rate measurement window
+    qint64       m_rateBytes;            //!< Bytes sent in the current rate measurement window
 };
 
 
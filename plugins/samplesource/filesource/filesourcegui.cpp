@@ -48,6 +48,7 @@ FileSourceGui::FileSourceGui(DeviceUISet *deviceUISet, QWidget* parent) :
 	m_recordLength(0),
 	m_startingTimeStamp(0),
 	m_samplesCount(0),
+	m_speedUp(0.0f),
 	m_tickCount(0),
 	m_enableNavTime(false),
 	m_lastEngineState((DSPDeviceSourceEngine::State)-1)
@@ -176,7 +177,16 @@ bool FileSourceGui::handleMessage(const Message& message)
 	else if (FileSourceInput::MsgReportFileSourceStreamTiming::match(message))
 	{
 		m_samplesCount = ((FileSourceInput::MsgReportFileSourceStreamTiming&)message).getSamplesCount();
+		m_speedUp = ((FileSourceInput::MsgReportFileSourceStreamTiming&)message).getSpeedUp();
 		updateWithStreamTime();
+
+		if (m_settings.m_fastReplay
+			&& ((FileSourceInput::MsgReportFileSourceStreamTiming&)message).getReplayEnded()
+			&& ui->play->isChecked())
+		{
+			ui->play->setChecked(false); // fast replay has reached the end of the file
+		}
+
 		return true;
 	}
 	else
@@ -194,10 +204,15 @@ void FileSourceGui::updateSampleRateAndFrequency()
 
 void FileSourceGui::displaySettings()
 {
+	ui->fastReplay->blockSignals(true);
+	ui->fastReplay->setChecked(m_settings.m_fastReplay);
+	ui->fastReplay->blockSignals(false);
 }
 
 void FileSourceGui::sendSettings()
 {
+	FileSourceInput::MsgConfigureFileSourceFastReplay* message = FileSourceInput::MsgConfigureFileSourceFastReplay::create(m_settings.m_fastReplay);
+	m_sampleSource->getInputMessageQueue()->push(message);
 }
 
 void FileSourceGui::on_playLoop_toggled(bool checked __attribute__((unused)))
@@ -259,6 +274,12 @@ void FileSourceGui::on_play_toggled(bool checked)
 	m_enableNavTime = !checked;
 }
 
+void FileSourceGui::on_fastReplay_toggled(bool checked)
+{
+	m_settings.m_fastReplay = checked;
+	sendSettings();
+}
+
 void FileSourceGui::on_navTimeSlider_valueChanged(int value)
 {
 	if (m_enableNavTime && ((value >= 0) && (value <= 100)))
@@ -327,6 +348,7 @@ void FileSourceGui::updateWithStreamTime()
 	QString s_timems = t.toString("hh:mm:ss.zzz");
 	QString s_time = t.toString("hh:mm:ss");
 	ui->relTimeText->setText(s_timems);
+	ui->speedUpText->setText(tr("x%1").arg(QString::number(m_speedUp, 'f', 1)));
 
     quint64 startingTimeStampMsec = (quint64) m_startingTimeStamp * 1000LL;
 	QDateTime dt = QDateTime::fromMSecsSinceEpoch(startingTimeStampMsec);
@@ -65,6 +65,7 @@ private:
 	quint32 m_recordLength;
 	std::time_t m_startingTimeStamp;
 	int m_samplesCount;
+	float m_speedUp;
 	std::size_t m_tickCount;
 	bool m_enableNavTime;
     int m_deviceSampleRate;
@@ -86,6 +87,7 @@ private slots:
 	void on_startStop_toggled(bool checked);
 	void on_playLoop_toggled(bool checked);
 	void on_play_toggled(bool checked);
+	void on_fastReplay_toggled(bool checked);
 	void on_navTimeSlider_valueChanged(int value);
 	void on_showFileDialog_clicked(bool checked);
     void updateStatus();
@@ -32,25 +32,29 @@ MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgConfigureFileSource, Message)
 MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgConfigureFileSourceName, Message)
 MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgConfigureFileSourceWork, Message)
 MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgConfigureFileSourceSeek, Message)
+MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgConfigureFileSourceFastReplay, Message)
 MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgConfigureFileSourceStreamTiming, Message)
 MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgReportFileSourceAcquisition, Message)
 MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgReportFileSourceStreamData, Message)
 MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgReportFileSourceStreamTiming, Message)
 
 FileSourceInput::Settings::Settings() :
-	m_fileName("./test.sdriq")
+	m_fileName("./test.sdriq"),
+	m_fastReplay(false)
 {
 }
 
 void FileSourceInput::Settings::resetToDefaults()
 {
 	m_fileName = "./test.sdriq";
+	m_fastReplay = false;
 }
 
 QByteArray FileSourceInput::Settings::serialize() const
 {
 	SimpleSerializer s(1);
 	s.writeString(1, m_fileName);
+	s.writeBool(2, m_fastReplay);
 	return s.final();
 }
 
@@ -65,6 +69,7 @@ bool FileSourceInput::Settings::deserialize(const QByteArray& data)
 
 	if(d.getVersion() == 1) {
 		d.readString(1, &m_fileName, "./test.sdriq");
+		d.readBool(2, &m_fastReplay, false);
 		return true;
 	} else {
 		resetToDefaults();
@@ -172,6 +177,7 @@ bool FileSourceInput::start()
 	}
 
 	m_fileSourceThread->setSamplerate(m_sampleRate);
+	m_fileSourceThread->setFastReplay(m_settings.m_fastReplay);
 	m_fileSourceThread->connectTimer(m_masterTimer);
 	m_fileSourceThread->startWork();
 	m_deviceDescription = "FileSource";
@@ -270,13 +276,27 @@ bool FileSourceInput::handleMessage(const Message& message)
 
 		return true;
 	}
+	else if (MsgConfigureFileSourceFastReplay::match(message))
+	{
+		MsgConfigureFileSourceFastReplay& conf = (MsgConfigureFileSourceFastReplay&) message;
+		m_settings.m_fastReplay = conf.getFastReplay();
+
+		if (m_fileSourceThread != 0) {
+			m_fileSourceThread->setFastReplay(m_settings.m_fastReplay);
+		}
+
+		return true;
+	}
 	else if (MsgConfigureFileSourceStreamTiming::match(message))
 	{
 		MsgReportFileSourceStreamTiming *report;
 
 		if (m_fileSourceThread != 0)
 		{
-			report = MsgReportFileSourceStreamTiming::create(m_fileSourceThread->getSamplesCount());
+			report = MsgReportFileSourceStreamTiming::create(
+					m_fileSourceThread->getSamplesCount(),
+					m_fileSourceThread->getSpeedUp(),
+					m_fileSourceThread->getFastReplay() && m_fileSourceThread->getReplayEnded());
 
 			if (getMessageQueueToGUI()) {
                 getMessageQueueToGUI()->push(report);
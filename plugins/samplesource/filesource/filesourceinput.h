@@ -31,6 +31,7 @@ class FileSourceInput : public DeviceSampleSource {
 public:
 	struct Settings {
 		QString m_fileName;
+		bool m_fastReplay; //!< Replay as fast as possible instead of in real time
 
 		Settings();
 		void resetToDefaults();
@@ -98,6 +99,26 @@ public:
 		{ }
 	};
 
+	class MsgConfigureFileSourceFastReplay : public Message {
+		MESSAGE_CLASS_DECLARATION
+
+	public:
+		bool getFastReplay() const { return m_fastReplay; }
+
+		static MsgConfigureFileSourceFastReplay* create(bool fastReplay)
+		{
+			return new MsgConfigureFileSourceFastReplay(fastReplay);
+		}
+
+	private:
+		bool m_fastReplay;
+
+		MsgConfigureFileSourceFastReplay(bool fastReplay) :
+			Message(),
+			m_fastReplay(fastReplay)
+		{ }
+	};
+
 	class MsgConfigureFileSourceStreamTiming : public Message {
 		MESSAGE_CLASS_DECLARATION
 
@@ -195,18 +216,24 @@ public:
 
 	public:
 		std::size_t getSamplesCount() const { return m_samplesCount; }
+		float getSpeedUp() const { return m_speedUp; }
+		bool getReplayEnded() const { return m_replayEnded; }
 
-		static MsgReportFileSourceStreamTiming* create(std::size_t samplesCount)
+		static MsgReportFileSourceStreamTiming* create(std::size_t samplesCount, float speedUp, bool replayEnded)
 		{
-			return new MsgReportFileSourceStreamTiming(samplesCount);
+			return new MsgReportFileSourceStreamTiming(samplesCount, speedUp, replayEnded);
 		}
 
 	protected:
 		std::size_t m_samplesCount;
+		float m_speedUp;     //!< achieved replay speed relative to real time
+		bool m_replayEnded;  //!< true when a fast replay has reached the end of the file
 
-		MsgReportFileSourceStreamTiming(std::size_t samplesCount) :
+		MsgReportFileSourceStreamTiming(std::size_t samplesCount, float speedUp, bool replayEnded) :
 			Message(),
-			m_samplesCount(samplesCount)
+			m_samplesCount(samplesCount),
+			m_speedUp(speedUp),
+			m_replayEnded(replayEnded)
 		{ }
 	};
 
@@ -33,6 +33,10 @@ FileSourceThread::FileSourceThread(std::ifstream *samplesStream, SampleSinkFifo*
 	m_sampleFifo(sampleFifo),
 	m_samplesCount(0),
     m_samplerate(0),
+    m_fastReplay(false),
+    m_replayEnded(false),
+    m_speedUp(0.0f),
+    m_speedUpSamples(0),
     m_throttlems(FILESOURCE_THROTTLE_MS),
     m_throttleToggle(false)
 {
@@ -59,6 +63,9 @@ void FileSourceThread::startWork()
         qDebug() << "FileSourceThread::startWork: file stream open, starting...";
         m_startWaitMutex.lock();
         m_elapsedTimer.start();
+        m_speedUpTimer.start();
+        m_speedUpSamples = 0;
+        m_replayEnded = false;
         start();
         while(!m_running)
             m_startWaiter.wait(&m_startWaitMutex, 100);
@@ -99,6 +106,23 @@ void FileSourceThread::setSamplerate(int samplerate)
 	//m_samplerate = samplerate;
 }
 
+void FileSourceThread::setFastReplay(bool fastReplay)
+{
+	qDebug() << "FileSourceThread::setFastReplay: " << fastReplay;
+
+	// the FIFO has a single producer: either the timer ticks or the replay loop
+	if (m_running)
+	{
+		stopWork();
+		m_fastReplay = fastReplay;
+		startWork();
+	}
+	else
+	{
+		m_fastReplay = fastReplay;
+	}
+}
+
 void FileSourceThread::setBuffer(std::size_t chunksize)
 {
     if (chunksize > m_bufsize)
@@ -128,9 +152,13 @@ void FileSourceThread::run()
 	m_running = true;
 	m_startWaiter.wakeAll();
 
-	while(m_running) // actual work is in the tick() function
+	while(m_running)
 	{
-		sleep(1);
+		if (m_fastReplay) {
+			replayChunk();
+		} else {
+			msleep(100); // actual work is in the tick() function
+		}
 	}
 
 	m_running = false;
@@ -142,9 +170,56 @@ void FileSourceThread::connectTimer(const QTimer& timer)
 	connect(&timer, SIGNAL(timeout()), this, SLOT(tick()));
 }
 
+/**
+ * Fast replay: push the next chunk as soon as the FIFO can take it. Waiting for room instead of
+ * writing anyway applies back pressure from the consumers so that no sample is dropped.
+ * Replay stops at the end of the file.
+ */
+void FileSourceThread::replayChunk()
+{
+	if ((m_chunksize == 0) || (m_sampleFifo->size() - m_sampleFifo->fill() < m_chunksize / 4))
+	{
+		usleep(1000);
+		return;
+	}
+
+	m_ifstream->read(reinterpret_cast<char*>(m_buf), m_chunksize);
+
+	if (m_ifstream->eof())
+	{
+		m_sampleFifo->write(m_buf, m_ifstream->gcount());
+		updateSpeedUp(m_ifstream->gcount() / 4, true);
+		m_ifstream->clear();
+		m_ifstream->seekg(sizeof(FileRecord::Header), std::ios::beg);
+		m_samplesCount = 0;
+		m_replayEnded = true;
+		m_running = false;
+		qDebug("FileSourceThread::replayChunk: end of file. Speed up: %.1f", m_speedUp);
+	}
+	else
+	{
+		m_sampleFifo->write(m_buf, m_chunksize);
+		m_samplesCount += m_chunksize / 4;
+		updateSpeedUp(m_chunksize / 4);
+	}
+}
+
+void FileSourceThread::updateSpeedUp(std::size_t nbSamples, bool endOfReplay)
+{
+	m_speedUpSamples += nbSamples;
+	qint64 elapsedms = m_speedUpTimer.elapsed();
+
+	if (((elapsedms >= 1000) || (endOfReplay && (elapsedms > 0))) && (m_samplerate > 0))
+	{
+		m_speedUp = (m_speedUpSamples * 1000.0f) / (elapsedms * (float) m_samplerate);
+		m_speedUpSamples = 0;
+		m_speedUpTimer.restart();
+	}
+}
+
 void FileSourceThread::tick()
 {
-	if (m_running)
+	if (m_running && !m_fastReplay)
 	{
         qint64 throttlems = m_elapsedTimer.restart();
 
@@ -173,6 +248,7 @@ void FileSourceThread::tick()
         {
             m_sampleFifo->write(m_buf, m_chunksize);
     		m_samplesCount += m_chunksize / 4;
+            updateSpeedUp(m_chunksize / 4);
         }
 	}
 }
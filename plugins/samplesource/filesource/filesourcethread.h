@@ -46,6 +46,10 @@ public:
 	bool isRunning() const { return m_running; }
 	std::size_t getSamplesCount() const { return m_samplesCount; }
 	void setSamplesCount(int samplesCount) { m_samplesCount = samplesCount; }
+	void setFastReplay(bool fastReplay); //!< Replay as fast as the consumers take the samples instead of in real time
+	bool getFastReplay() const { return m_fastReplay; }
+	float getSpeedUp() const { return m_speedUp; } //!< Achieved replay speed relative to real time
+	bool getReplayEnded() const { return m_replayEnded; } //!< Fast replay has reached the end of the file
 
 	void connectTimer(const QTimer& timer);
 
@@ -62,11 +66,18 @@ private:
 	std::size_t m_samplesCount;
 
 	int m_samplerate;
+    bool m_fastReplay;
+    bool m_replayEnded;
+    float m_speedUp;
+    std::size_t m_speedUpSamples;  //!< Samples replayed since the start of the speed measurement period
+    QElapsedTimer m_speedUpTimer;  //!< Speed measurement period timer
     int m_throttlems;
     QElapsedTimer m_elapsedTimer;
     bool m_throttleToggle;
 
 	void run();
+	void replayChunk();
+	void updateSpeedUp(std::size_t nbSamples, bool endOfReplay = false);
 	//void decimate1(SampleVector::iterator* it, const qint16* buf, qint32 len);
 	//void callback(const qint16* buf, qint32 len);
 private slots:
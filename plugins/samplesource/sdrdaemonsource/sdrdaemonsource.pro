@@ -42,14 +42,16 @@ sdrdaemonsourcegui.cpp\
 sdrdaemonsourceinput.cpp\
 sdrdaemonsourcesettings.cpp\
 sdrdaemonsourceplugin.cpp\
-sdrdaemonsourceudphandler.cpp
+sdrdaemonsourceudphandler.cpp\
+sdrdaemonsourceudpreceiver.cpp
 
 HEADERS += sdrdaemonsourcebuffer.h\
 sdrdaemonsourcegui.h\
 sdrdaemonsourceinput.h\
 sdrdaemonsourcesettings.h\
 sdrdaemonsourceplugin.h\
-sdrdaemonsourceudphandler.h
+sdrdaemonsourceudphandler.h\
+sdrdaemonsourceudpreceiver.h
 
 FORMS += sdrdaemonsourcegui.ui
 
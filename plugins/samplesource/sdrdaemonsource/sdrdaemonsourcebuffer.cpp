@@ -28,6 +28,15 @@ const int SDRdaemonSourceBuffer::m_sampleSize = 2;
 const int SDRdaemonSourceBuffer::m_iqSampleSize = 2 * m_sampleSize;
 
 SDRdaemonSourceBuffer::SDRdaemonSourceBuffer(uint32_t throttlems) :
+        m_udpSize(0),
+        m_blockSize(0),
+        m_sampleBits(16),
+        m_compress(false),
+        m_samplesPerBlock(0),
+        m_frameSize(0),
+        m_frames(0),
+        m_slotsBlocks(0),
+        m_framesNbBytes(0),
         m_decoderIndexHead(nbDecoderSlots/2),
         m_frameHead(0),
         m_curNbBlocks(0),
@@ -48,12 +57,10 @@ SDRdaemonSourceBuffer::SDRdaemonSourceBuffer(uint32_t throttlems) :
 	    m_balCorrLimit(0)
 {
 	m_currentMeta.init();
-	m_framesNbBytes = nbDecoderSlots * sizeof(BufferFrame);
-	m_wrDeltaEstimate = m_framesNbBytes / 2;
+	resize(m_udpPayloadSize, m_sampleBits, m_compress);
 	m_tvOut_sec = 0;
 	m_tvOut_usec = 0;
 	m_readNbBytes = 1;
-    m_paramsCM256.BlockBytes = sizeof(ProtectedBlock); // never changes
     m_paramsCM256.OriginalCount = m_nbOriginalBlocks;  // never changes
 
     if (!m_cm256.isInitialized()) {
@@ -69,6 +76,45 @@ SDRdaemonSourceBuffer::~SDRdaemonSourceBuffer()
 	if (m_readBuffer) {
 		delete[] m_readBuffer;
 	}
+
+	delete[] m_slotsBlocks;
+	delete[] m_frames;
+}
+
+void SDRdaemonSourceBuffer::resize(int udpSize, int sampleBits, bool compress)
+{
+    m_udpSize = udpSize;
+    m_blockSize = udpSize - sizeof(Header);
+    m_sampleBits = sampleBits;
+    m_compress = compress;
+    m_samplesPerBlock = m_blockSize / IQCodec::getBytesPerSample(m_sampleBits);
+    m_frameSize = (m_nbOriginalBlocks - 1) * m_samplesPerBlock * sizeof(Sample);
+    m_framesNbBytes = nbDecoderSlots * m_frameSize;
+    m_paramsCM256.BlockBytes = m_blockSize;
+
+    // block zero, recovery blocks and when the samples need a conversion the original data blocks
+    int slotBlocks = 1 + m_nbOriginalBlocks + (isCoded() ? m_nbOriginalBlocks - 1 : 0);
+
+    delete[] m_frames;
+    m_frames = new uint8_t[m_framesNbBytes];
+    delete[] m_slotsBlocks;
+    m_slotsBlocks = new uint8_t[nbDecoderSlots * slotBlocks * m_blockSize];
+
+    for (int i = 0; i < nbDecoderSlots; i++)
+    {
+        m_decoderSlots[i].m_blockZero = &m_slotsBlocks[i * slotBlocks * m_blockSize];
+        m_decoderSlots[i].m_recoveryBlocks = m_decoderSlots[i].m_blockZero + m_blockSize;
+        m_decoderSlots[i].m_codedBlocks = isCoded() ? m_decoderSlots[i].m_recoveryBlocks + m_nbOriginalBlocks * m_blockSize : 0;
+    }
+
+    m_frameHead = -1; // restart from the initial state
+    m_readIndex = 0;
+    m_wrDeltaEstimate = m_framesNbBytes / 2;
+    m_currentMeta.init(); // forces the new meta processing of the next frame
+    initDecodeAllSlots();
+
+    qDebug("SDRdaemonSourceBuffer::resize: UDP block size: %d sample bits: %d compress: %s frames buffer: %d bytes",
+            m_udpSize, m_sampleBits, m_compress ? "on" : "off", m_framesNbBytes);
 }
 
 void SDRdaemonSourceBuffer::initDecodeAllSlots()
@@ -78,10 +124,12 @@ void SDRdaemonSourceBuffer::initDecodeAllSlots()
         m_decoderSlots[i].m_blockCount = 0;
         m_decoderSlots[i].m_originalCount = 0;
         m_decoderSlots[i].m_recoveryCount = 0;
+        m_decoderSlots[i].m_nbSentBlocks = m_nbOriginalBlocks;
         m_decoderSlots[i].m_decoded = false;
+        m_decoderSlots[i].m_converted = false;
         m_decoderSlots[i].m_metaRetrieved = false;
         resetOriginalBlocks(i);
-        memset((void *) m_decoderSlots[i].m_recoveryBlocks, 0, m_nbOriginalBlocks * sizeof(ProtectedBlock));
+        memset((void *) m_decoderSlots[i].m_recoveryBlocks, 0, m_nbOriginalBlocks * m_blockSize);
     }
 }
 
@@ -114,16 +162,71 @@ void SDRdaemonSourceBuffer::initDecodeSlot(int slotIndex)
     m_decoderSlots[slotIndex].m_blockCount = 0;
     m_decoderSlots[slotIndex].m_originalCount = 0;
     m_decoderSlots[slotIndex].m_recoveryCount = 0;
+    m_decoderSlots[slotIndex].m_nbSentBlocks = m_nbOriginalBlocks;
     m_decoderSlots[slotIndex].m_decoded = false;
+    m_decoderSlots[slotIndex].m_converted = false;
     m_decoderSlots[slotIndex].m_metaRetrieved = false;
 
     resetOriginalBlocks(slotIndex);
-    memset((void *) m_decoderSlots[slotIndex].m_recoveryBlocks, 0, m_nbOriginalBlocks * sizeof(ProtectedBlock));
+    memset((void *) m_decoderSlots[slotIndex].m_recoveryBlocks, 0, m_nbOriginalBlocks * m_blockSize);
+}
+
+/**
+ * A compressing sender does not send the original blocks after the compressed data. They are known
+ * to be zero so they are accounted as received and take part in the FEC decoding like the others.
+ */
+void SDRdaemonSourceBuffer::skipUnsentBlocks(int slotIndex, int nbSentBlocks)
+{
+    DecoderSlot& slot = m_decoderSlots[slotIndex];
+
+    for (int blockIndex = nbSentBlocks; blockIndex < m_nbOriginalBlocks; blockIndex++)
+    {
+        slot.m_cm256DescriptorBlocks[slot.m_blockCount].Index = blockIndex;
+        slot.m_cm256DescriptorBlocks[slot.m_blockCount].Block = (void *) getOriginalBlock(slotIndex, blockIndex);
+        slot.m_blockCount++;
+        slot.m_originalCount++;
+    }
+
+    slot.m_nbSentBlocks = nbSentBlocks;
+}
+
+/**
+ * Restore the 16 bit samples of a frame in the samples buffer from the packed or compressed original blocks.
+ * A compressed frame cannot be partially restored so it is left blank if incomplete.
+ */
+void SDRdaemonSourceBuffer::convertSlot(int slotIndex)
+{
+    DecoderSlot& slot = m_decoderSlots[slotIndex];
+
+    if (slot.m_converted || !isCoded()) {
+        return;
+    }
+
+    int16_t *iq = (int16_t *) &m_frames[slotIndex * m_frameSize];
+    int nbSamples = (m_nbOriginalBlocks - 1) * m_samplesPerBlock;
+
+    if (slot.m_nbSentBlocks < m_nbOriginalBlocks) // compressed
+    {
+        if (slot.m_decoded
+            && !IQCodec::decompress(slot.m_codedBlocks, (slot.m_nbSentBlocks - 1) * m_blockSize, nbSamples, m_sampleBits, iq))
+        {
+            qDebug("SDRdaemonSourceBuffer::convertSlot: corrupt compressed frame");
+            memset((void *) iq, 0, m_frameSize);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < m_nbOriginalBlocks - 1; i++) {
+            IQCodec::unpack(&slot.m_codedBlocks[i * m_blockSize], m_samplesPerBlock, m_sampleBits, &iq[2 * i * m_samplesPerBlock]);
+        }
+    }
+
+    slot.m_converted = true;
 }
 
 void SDRdaemonSourceBuffer::initReadIndex()
 {
-    m_readIndex = ((m_decoderIndexHead + (nbDecoderSlots/2)) % nbDecoderSlots) * sizeof(BufferFrame);
+    m_readIndex = ((m_decoderIndexHead + (nbDecoderSlots/2)) % nbDecoderSlots) * m_frameSize;
     m_wrDeltaEstimate = m_framesNbBytes / 2;
     m_nbReads = 0;
     m_nbWrites = 0;
@@ -134,19 +237,19 @@ void SDRdaemonSourceBuffer::rwCorrectionEstimate(int slotIndex)
 	if (m_nbReads >= 40) // check every ~1s as tick is ~50ms
 	{
 		int targetPivotSlot = (slotIndex + (nbDecoderSlots/2))  % nbDecoderSlots; // slot at half buffer opposite of current write slot
-		int targetPivotIndex = targetPivotSlot * sizeof(BufferFrame);             // buffer index corresponding to start of above slot
-		int normalizedReadIndex = (m_readIndex < targetPivotIndex ? m_readIndex + nbDecoderSlots * sizeof(BufferFrame) :  m_readIndex)
-				- (targetPivotSlot * sizeof(BufferFrame)); // normalize read index so it is positive and zero at start of pivot slot
+		int targetPivotIndex = targetPivotSlot * m_frameSize;                     // buffer index corresponding to start of above slot
+		int normalizedReadIndex = (m_readIndex < targetPivotIndex ? m_readIndex + nbDecoderSlots * m_frameSize :  m_readIndex)
+				- (targetPivotSlot * m_frameSize); // normalize read index so it is positive and zero at start of pivot slot
 		int dBytes;
-        int rwDelta = (m_nbReads * m_readNbBytes) - (m_nbWrites * sizeof(BufferFrame));
+        int rwDelta = (m_nbReads * m_readNbBytes) - (m_nbWrites * m_frameSize);
 
-		if (normalizedReadIndex < (nbDecoderSlots/ 2) * (int) sizeof(BufferFrame)) // read leads
+		if (normalizedReadIndex < (nbDecoderSlots/ 2) * m_frameSize) // read leads
 		{
 			dBytes = - normalizedReadIndex - rwDelta;
 		}
 		else // read lags
 		{
-			dBytes = (nbDecoderSlots * sizeof(BufferFrame)) - normalizedReadIndex - rwDelta;
+			dBytes = (nbDecoderSlots * m_frameSize) - normalizedReadIndex - rwDelta;
 		}
 
         m_balCorrection = (m_balCorrection / 4) + (dBytes / (int) (m_iqSampleSize * m_nbReads)); // correction is in number of samples. Alpha = 0.25
@@ -164,11 +267,11 @@ void SDRdaemonSourceBuffer::rwCorrectionEstimate(int slotIndex)
 
 void SDRdaemonSourceBuffer::checkSlotData(int slotIndex)
 {
-    int pseudoWriteIndex = slotIndex * sizeof(BufferFrame);
+    int pseudoWriteIndex = slotIndex * m_frameSize;
     m_wrDeltaEstimate = pseudoWriteIndex - m_readIndex;
     m_nbWrites++;
 
-    int rwDelayBytes = (m_wrDeltaEstimate > 0 ? m_wrDeltaEstimate : sizeof(BufferFrame) * nbDecoderSlots + m_wrDeltaEstimate);
+    int rwDelayBytes = (m_wrDeltaEstimate > 0 ? m_wrDeltaEstimate : m_frameSize * nbDecoderSlots + m_wrDeltaEstimate);
     int sampleRate = m_currentMeta.m_sampleRate;
 
     if (sampleRate > 0)
@@ -187,10 +290,27 @@ void SDRdaemonSourceBuffer::checkSlotData(int slotIndex)
     }
 }
 
-void SDRdaemonSourceBuffer::writeData(char *array)
+bool SDRdaemonSourceBuffer::isValidUDPSize(int udpSize)
+{
+    return (udpSize >= m_udpPayloadSize) && (udpSize <= m_udpPayloadSizeMax) && ((udpSize - sizeof(Header)) % sizeof(Sample) == 0);
+}
+
+void SDRdaemonSourceBuffer::writeData(char *array, int length)
 {
-    SuperBlock *superBlock = (SuperBlock *) array;
-    int frameIndex = superBlock->header.frameIndex;
+    if (length != m_udpSize) // the sender changed the block size
+    {
+        if (!isValidUDPSize(length))
+        {
+            qDebug("SDRdaemonSourceBuffer::writeData: discard datagram of invalid size: %d", length);
+            return;
+        }
+
+        resize(length, m_sampleBits, m_compress);
+    }
+
+    Header *header = (Header *) array;
+    uint8_t *protectedBlock = (uint8_t *) &array[sizeof(Header)];
+    int frameIndex = header->frameIndex;
     int decoderIndex = frameIndex % nbDecoderSlots;
 
     // frame break
@@ -204,6 +324,7 @@ void SDRdaemonSourceBuffer::writeData(char *array)
     }
     else if (m_frameHead != frameIndex) // frame break => new frame starts
     {
+        convertSlot(m_decoderIndexHead);   // previous frame if it could not be decoded
         m_decoderIndexHead = decoderIndex; // new decoder slot head
         m_frameHead = frameIndex;          // new frame head
         checkSlotData(decoderIndex);       // check slot before re-init
@@ -213,9 +334,13 @@ void SDRdaemonSourceBuffer::writeData(char *array)
 
     // Block processing
 
+    if ((m_decoderSlots[decoderIndex].m_blockCount == 0) && (header->filler > 1) && (header->filler < m_nbOriginalBlocks)) {
+        skipUnsentBlocks(decoderIndex, header->filler); // first block of a compressed frame
+    }
+
     if (m_decoderSlots[decoderIndex].m_blockCount < m_nbOriginalBlocks) // not enough blocks to decode -> store data
     {
-        int blockIndex = superBlock->header.blockIndex;
+        int blockIndex = header->blockIndex;
         int blockCount = m_decoderSlots[decoderIndex].m_blockCount;
         int recoveryCount = m_decoderSlots[decoderIndex].m_recoveryCount;
         m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[blockCount].Index = blockIndex;
@@ -227,13 +352,14 @@ void SDRdaemonSourceBuffer::writeData(char *array)
 
         if (blockIndex < m_nbOriginalBlocks) // original data
         {
-            m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[blockCount].Block = (void *) storeOriginalBlock(decoderIndex, blockIndex, superBlock->protectedBlock);
+            m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[blockCount].Block = (void *) storeOriginalBlock(decoderIndex, blockIndex, protectedBlock);
             m_decoderSlots[decoderIndex].m_originalCount++;
         }
         else // recovery data
         {
-            m_decoderSlots[decoderIndex].m_recoveryBlocks[recoveryCount] = superBlock->protectedBlock;
-            m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[blockCount].Block = (void *) &m_decoderSlots[decoderIndex].m_recoveryBlocks[recoveryCount];
+            uint8_t *recoveryBlock = getRecoveryBlock(decoderIndex, recoveryCount);
+            memcpy((void *) recoveryBlock, (const void *) protectedBlock, m_blockSize);
+            m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[blockCount].Block = (void *) recoveryBlock;
             m_decoderSlots[decoderIndex].m_recoveryCount++;
         }
     }
@@ -246,7 +372,7 @@ void SDRdaemonSourceBuffer::writeData(char *array)
 
         if (m_cm256_OK && (m_decoderSlots[decoderIndex].m_recoveryCount > 0)) // recovery data used => need to decode FEC
         {
-            m_paramsCM256.BlockBytes = sizeof(ProtectedBlock); // never changes
+            m_paramsCM256.BlockBytes = m_blockSize;            // changes only with the UDP block size
             m_paramsCM256.OriginalCount = m_nbOriginalBlocks;  // never changes
 
             if (m_decoderSlots[decoderIndex].m_metaRetrieved) {
@@ -271,7 +397,7 @@ void SDRdaemonSourceBuffer::writeData(char *array)
                 {
                     int recoveryIndex = m_nbOriginalBlocks - m_decoderSlots[decoderIndex].m_recoveryCount + ir;
                     int blockIndex = m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[recoveryIndex].Index;
-                    ProtectedBlock *recoveredBlock = (ProtectedBlock *) m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[recoveryIndex].Block;
+                    uint8_t *recoveredBlock = (uint8_t *) m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[recoveryIndex].Block;
 
                     if (blockIndex == 0) // first block with meta
                     {
@@ -291,7 +417,7 @@ void SDRdaemonSourceBuffer::writeData(char *array)
                         }
                     }
 
-                    storeOriginalBlock(decoderIndex, blockIndex, *recoveredBlock);
+                    storeOriginalBlock(decoderIndex, blockIndex, recoveredBlock);
 
                     qDebug() << "SDRdaemonSourceBuffer::writeData: recovered block #" << blockIndex;
                 } // restore missing blocks
@@ -304,7 +430,28 @@ void SDRdaemonSourceBuffer::writeData(char *array)
 
             if (!(*metaData == m_currentMeta))
             {
+                int metaSampleBits = (metaData->m_sampleBytes & MetaDataFEC::m_indPacked) ? metaData->m_sampleBits : 16;
+                bool metaCompress = (metaData->m_sampleBytes & MetaDataFEC::m_indCompressed) != 0;
+
+                if (!IQCodec::isValidBits(metaSampleBits))
+                {
+                    qWarning("SDRdaemonSourceBuffer::writeData: unsupported sample bits %d. Assume 16", metaSampleBits);
+                    metaSampleBits = 16;
+                }
+
+                if ((metaSampleBits != m_sampleBits) || (metaCompress != m_compress)) // the sender changed the samples coding
+                {
+                    printMeta("SDRdaemonSourceBuffer::writeData: new coding", metaData);
+                    resize(m_udpSize, metaSampleBits, metaCompress);
+                    return;
+                }
+
                 int sampleRate =  metaData->m_sampleRate;
+                int metaUDPSize = metaData->m_udpSize == 0 ? m_udpPayloadSize : metaData->m_udpSize;
+
+                if (metaUDPSize != m_udpSize) {
+                    qWarning("SDRdaemonSourceBuffer::writeData: meta data UDP block size %d differs from received size %d", metaUDPSize, m_udpSize);
+                }
 
                 if (sampleRate > 0) {
                     m_bufferLenSec = (float) m_framesNbBytes / (float) (sampleRate * m_iqSampleSize);
@@ -317,6 +464,8 @@ void SDRdaemonSourceBuffer::writeData(char *array)
 
             m_currentMeta = *metaData; // renew current meta
         } // check block 0
+
+        convertSlot(decoderIndex);
     } // decode
 }
 
@@ -395,14 +544,14 @@ void SDRdaemonSourceBuffer::writeData0(char *array __attribute__((unused)), uint
 
 uint8_t *SDRdaemonSourceBuffer::readData(int32_t length)
 {
-    uint8_t *buffer = (uint8_t *) m_frames;
+    uint8_t *buffer = m_frames;
     uint32_t readIndex = m_readIndex;
 
     m_nbReads++;
 
     // SEGFAULT FIX: arbitratily truncate so that it does not exceed buffer length
-    if (length > framesSize) {
-        length = framesSize;
+    if (length > m_framesNbBytes) {
+        length = m_framesNbBytes;
     }
 
     if (m_readIndex + length < m_framesNbBytes) // ends before buffer bound
@@ -442,9 +591,11 @@ void SDRdaemonSourceBuffer::printMeta(const QString& header, MetaDataFEC *metaDa
             << ":" << metaData->m_sampleRate
             << ":" << (int) (metaData->m_sampleBytes & 0xF)
             << ":" << (int) metaData->m_sampleBits
+            << ":" << (metaData->m_sampleBytes & MetaDataFEC::m_indCompressed ? "C" : "U")
             << ":" << (int) metaData->m_nbOriginalBlocks
             << ":" << (int) metaData->m_nbFECBlocks
             << "|" << metaData->m_tv_sec
             << ":" << metaData->m_tv_usec
+            << "|" << metaData->m_udpSize
             << "|";
 }
@@ -22,9 +22,11 @@
 #include <cstdlib>
 #include "cm256.h"
 #include "util/movingaverage.h"
+#include "util/iqcodec.h"
 
 
-#define SDRDAEMONSOURCE_UDPSIZE 512               // UDP payload size
+#define SDRDAEMONSOURCE_UDPSIZE 512               // default UDP payload size
+#define SDRDAEMONSOURCE_UDPSIZEMAX 8972           // largest UDP payload size: 9000 bytes jumbo frame
 #define SDRDAEMONSOURCE_NBORIGINALBLOCKS 128      // number of sample blocks per frame excluding FEC blocks
 #define SDRDAEMONSOURCE_NBDECODERSLOTS 16         // power of two sub multiple of uint16_t size. A too large one is superfluous.
 
@@ -43,10 +45,15 @@ public:
         uint32_t m_tv_sec;            //!< 16 seconds of timestamp at start time of super-frame processing
         uint32_t m_tv_usec;           //!< 20 microseconds of timestamp at start time of super-frame processing
         uint32_t m_crc32;             //!< 24 CRC32 of the above
+        uint16_t m_udpSize;           //!< 26 UDP block size in bytes. Not in CRC for compatibility. 0 from older senders means 512
+
+        static const uint8_t m_indPacked = 0x20;     //!< Indicator: I and Q values are packed on m_sampleBits bits. Else raw 16 bits
+        static const uint8_t m_indCompressed = 0x10; //!< Indicator: frames may be compressed. See Header::filler
 
         bool operator==(const MetaDataFEC& rhs)
         {
-            return (memcmp((const void *) this, (const void *) &rhs, 12) == 0); // Only the 12 first bytes are relevant
+            return (memcmp((const void *) this, (const void *) &rhs, 12) == 0) // Only the 12 first bytes are relevant
+                && (m_udpSize == rhs.m_udpSize);
         }
 
         void init()
@@ -65,34 +72,25 @@ public:
     {
         uint16_t frameIndex;
         uint8_t  blockIndex;
-        uint8_t  filler;
-    };
-
-    static const int samplesPerBlock = (SDRDAEMONSOURCE_UDPSIZE - sizeof(Header)) / sizeof(Sample);
-    static const int framesSize = SDRDAEMONSOURCE_NBDECODERSLOTS * (SDRDAEMONSOURCE_NBORIGINALBLOCKS - 1) * (SDRDAEMONSOURCE_UDPSIZE - sizeof(Header));
-
-    struct ProtectedBlock
-    {
-        Sample samples[samplesPerBlock];
+        uint8_t  filler;     //!< Number of original blocks sent when the frame is compressed else 0
     };
 
-    struct SuperBlock
-    {
-        Header         header;
-        ProtectedBlock protectedBlock;
-    };
 #pragma pack(pop)
 
 	SDRdaemonSourceBuffer(uint32_t throttlems);
 	~SDRdaemonSourceBuffer();
 
 	// R/W operations
-	void writeData(char *array); //!< Write data into buffer.
+	void writeData(char *array, int length); //!< Write data into buffer. The block size follows the datagram length.
     void writeData0(char *array, uint32_t length); //!< Write data into buffer.
 	uint8_t *readData(int32_t length);            //!< Read data from buffer
 
 	// meta data
 	const MetaDataFEC& getCurrentMeta() const { return m_currentMeta; }
+	int getUDPSize() const { return m_udpSize; }
+	static bool isValidUDPSize(int udpSize);
+	int getSampleBits() const { return m_sampleBits; }   //!< Bits per I or Q value on the link
+	bool getCompress() const { return m_compress; }      //!< Frames may be compressed
 
 	// samples timestamp
 	uint32_t getTVOutSec() const { return m_tvOut_sec; }
@@ -157,6 +155,7 @@ public:
     }
 
     static const int m_udpPayloadSize = SDRDAEMONSOURCE_UDPSIZE;
+    static const int m_udpPayloadSizeMax = SDRDAEMONSOURCE_UDPSIZEMAX;
     static const int m_nbOriginalBlocks = SDRDAEMONSOURCE_NBORIGINALBLOCKS;
 	static const int m_sampleSize;
 	static const int m_iqSampleSize;
@@ -164,30 +163,32 @@ public:
 private:
     static const int nbDecoderSlots = SDRDAEMONSOURCE_NBDECODERSLOTS;
 
-#pragma pack(push, 1)
-    struct BufferFrame
-    {
-        ProtectedBlock  m_blocks[m_nbOriginalBlocks - 1];
-    };
-#pragma pack(pop)
-
     struct DecoderSlot
     {
-        ProtectedBlock       m_blockZero;                                 //!< First block of a frame. Has meta data.
-        ProtectedBlock       m_originalBlocks[m_nbOriginalBlocks];        //!< Original blocks retrieved directly or by later FEC
-        ProtectedBlock       m_recoveryBlocks[m_nbOriginalBlocks];        //!< Recovery blocks (FEC blocks) with max size
+        uint8_t             *m_blockZero;                                 //!< First block of a frame. Has meta data.
+        uint8_t             *m_recoveryBlocks;                            //!< Recovery blocks (FEC blocks) with max count
+        uint8_t             *m_codedBlocks;                               //!< Original blocks as received when samples are packed or compressed
         CM256::cm256_block   m_cm256DescriptorBlocks[m_nbOriginalBlocks]; //!< CM256 decoder descriptors (block addresses and block indexes)
         int                  m_blockCount;         //!< number of blocks received for this frame
         int                  m_originalCount;      //!< number of original blocks received
         int                  m_recoveryCount;      //!< number of recovery blocks received
+        int                  m_nbSentBlocks;       //!< number of original blocks sent by a compressing sender else 128
         bool                 m_decoded;            //!< true if decoded
+        bool                 m_converted;          //!< true if the samples of the frame have been restored in the samples buffer
         bool                 m_metaRetrieved;      //!< true if meta data (block zero) was retrieved
     };
 
     MetaDataFEC          m_currentMeta;          //!< Stored current meta data
     CM256::cm256_encoder_params m_paramsCM256;          //!< CM256 decoder parameters block
     DecoderSlot          m_decoderSlots[nbDecoderSlots]; //!< CM256 decoding control/buffer slots
-    BufferFrame          m_frames[nbDecoderSlots];       //!< Samples buffer
+    int                  m_udpSize;              //!< UDP block size in bytes
+    int                  m_blockSize;            //!< protected block size in bytes (UDP block without header)
+    int                  m_sampleBits;           //!< bits per I or Q value on the link
+    bool                 m_compress;             //!< frames may be compressed
+    int                  m_samplesPerBlock;      //!< number of I/Q samples in a data block
+    int                  m_frameSize;            //!< number of samples bytes in a frame (original blocks but block zero)
+    uint8_t             *m_frames;               //!< Samples buffer: nbDecoderSlots frames
+    uint8_t             *m_slotsBlocks;          //!< Storage of the block zero and recovery blocks of all decoder slots
     int                  m_framesNbBytes;                //!< Number of bytes in samples buffer
     int                  m_decoderIndexHead;     //!< index of the current head frame slot in decoding slots
     int                  m_frameHead;            //!< index of the current head frame sent
@@ -220,50 +221,59 @@ private:
     CM256    m_cm256;         //!< CM256 library
     bool     m_cm256_OK;      //!< CM256 library initialized OK
 
-    inline ProtectedBlock* storeOriginalBlock(int slotIndex, int blockIndex, const ProtectedBlock& protectedBlock)
+    /** Packed or compressed data needs a conversion to the samples buffer else it is stored there directly */
+    inline bool isCoded() const { return (m_sampleBits != 16) || m_compress; }
+
+    inline uint8_t* getOriginalBlock(int slotIndex, int blockIndex)
     {
         if (blockIndex == 0) {
-            // m_decoderSlots[slotIndex].m_originalBlocks[0] = protectedBlock;
-            // return &m_decoderSlots[slotIndex].m_originalBlocks[0];
-            m_decoderSlots[slotIndex].m_blockZero = protectedBlock;
-            return &m_decoderSlots[slotIndex].m_blockZero;
+            return m_decoderSlots[slotIndex].m_blockZero;
+        } else if (isCoded()) {
+            return &m_decoderSlots[slotIndex].m_codedBlocks[(blockIndex - 1) * m_blockSize];
         } else {
-            // m_decoderSlots[slotIndex].m_originalBlocks[blockIndex] = protectedBlock;
-            // return &m_decoderSlots[slotIndex].m_originalBlocks[blockIndex];
-            m_frames[slotIndex].m_blocks[blockIndex - 1] = protectedBlock;
-            return &m_frames[slotIndex].m_blocks[blockIndex - 1];
+            return &m_frames[slotIndex * m_frameSize + (blockIndex - 1) * m_blockSize];
         }
     }
 
-    inline ProtectedBlock& getOriginalBlock(int slotIndex, int blockIndex)
+    inline uint8_t* storeOriginalBlock(int slotIndex, int blockIndex, const uint8_t *protectedBlock)
     {
-        if (blockIndex == 0) {
-            // return m_decoderSlots[slotIndex].m_originalBlocks[0];
-            return m_decoderSlots[slotIndex].m_blockZero;
-        } else {
-            // return m_decoderSlots[slotIndex].m_originalBlocks[blockIndex];
-            return m_frames[slotIndex].m_blocks[blockIndex - 1];
+        uint8_t *block = getOriginalBlock(slotIndex, blockIndex);
+
+        if (block != protectedBlock) {
+            memcpy((void *) block, (const void *) protectedBlock, m_blockSize);
         }
+
+        return block;
+    }
+
+    inline uint8_t *getRecoveryBlock(int slotIndex, int recoveryIndex)
+    {
+        return &m_decoderSlots[slotIndex].m_recoveryBlocks[recoveryIndex * m_blockSize];
     }
 
     inline MetaDataFEC *getMetaData(int slotIndex)
     {
-        // return (MetaDataFEC *) &m_decoderSlots[slotIndex].m_originalBlocks[0];
-        return (MetaDataFEC *) &m_decoderSlots[slotIndex].m_blockZero;
+        return (MetaDataFEC *) m_decoderSlots[slotIndex].m_blockZero;
     }
 
     inline void resetOriginalBlocks(int slotIndex)
     {
-        // memset((void *) m_decoderSlots[slotIndex].m_originalBlocks, 0, m_nbOriginalBlocks * sizeof(ProtectedBlock));
-        memset((void *) &m_decoderSlots[slotIndex].m_blockZero, 0, sizeof(ProtectedBlock));
-        memset((void *) m_frames[slotIndex].m_blocks, 0, (m_nbOriginalBlocks - 1) * sizeof(ProtectedBlock));
+        memset((void *) m_decoderSlots[slotIndex].m_blockZero, 0, m_blockSize);
+        memset((void *) &m_frames[slotIndex * m_frameSize], 0, m_frameSize);
+
+        if (isCoded()) {
+            memset((void *) m_decoderSlots[slotIndex].m_codedBlocks, 0, (m_nbOriginalBlocks - 1) * m_blockSize);
+        }
     }
 
+    void resize(int udpSize, int sampleBits, bool compress); //!< (Re)allocate the buffers for a new UDP block size or coding and restart decoding
     void initDecodeAllSlots();
     void initReadIndex();
     void rwCorrectionEstimate(int slotIndex);
     void checkSlotData(int slotIndex);
     void initDecodeSlot(int slotIndex);
+    void skipUnsentBlocks(int slotIndex, int nbSentBlocks);
+    void convertSlot(int slotIndex);
 
     static void printMeta(const QString& header, MetaDataFEC *metaData);
 };
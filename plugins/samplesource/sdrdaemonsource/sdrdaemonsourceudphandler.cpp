@@ -14,9 +14,9 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#include <QUdpSocket>
 #include <QDebug>
 #include <QTimer>
+#include <QThread>
 #include <unistd.h>
 
 #include "dsp/dspcommands.h"
@@ -29,13 +29,15 @@
 SDRdaemonSourceUDPHandler::SDRdaemonSourceUDPHandler(SampleSinkFifo *sampleFifo, MessageQueue *outputMessageQueueToGUI, DeviceSourceAPI *devieAPI) :
     m_deviceAPI(devieAPI),
 	m_sdrDaemonBuffer(m_rateDivider),
-	m_dataSocket(0),
+	m_datagramFifo(SDRDAEMONSOURCE_RXFIFOBYTES, SDRdaemonSourceBuffer::m_udpPayloadSize),
+	m_receiver(0),
+	m_receiverThread(0),
+	m_decoder(0),
+	m_decoderThread(0),
 	m_dataAddress(QHostAddress::LocalHost),
 	m_remoteAddress(QHostAddress::LocalHost),
 	m_dataPort(9090),
 	m_dataConnected(false),
-	m_udpBuf(0),
-	m_udpReadBytes(0),
 	m_sampleFifo(sampleFifo),
 	m_samplerate(0),
 	m_centerFrequency(0),
@@ -52,13 +54,11 @@ SDRdaemonSourceUDPHandler::SDRdaemonSourceUDPHandler(SampleSinkFifo *sampleFifo,
     m_rateDivider(1000/SDRDAEMONSOURCE_THROTTLE_MS),
 	m_autoCorrBuffer(true)
 {
-    m_udpBuf = new char[SDRdaemonSourceBuffer::m_udpPayloadSize];
 }
 
 SDRdaemonSourceUDPHandler::~SDRdaemonSourceUDPHandler()
 {
 	stop();
-	delete[] m_udpBuf;
 #ifdef USE_INTERNAL_TIMER
     if (m_timer) {
         delete m_timer;
@@ -70,24 +70,37 @@ void SDRdaemonSourceUDPHandler::start()
 {
 	qDebug("SDRdaemonSourceUDPHandler::start");
 
-	if (!m_dataSocket)
-	{
-		m_dataSocket = new QUdpSocket(this);
-	}
-
     if (!m_dataConnected)
 	{
-        connect(m_dataSocket, SIGNAL(readyRead()), this, SLOT(dataReadyRead()), Qt::QueuedConnection); // , Qt::QueuedConnection
+        m_datagramFifo.resize(getDatagramSlotSize());
+        m_receiver = new SDRdaemonSourceUDPReceiver(&m_datagramFifo);
+        m_receiverThread = new QThread();
+        m_receiver->moveToThread(m_receiverThread);
 
-        if (m_dataSocket->bind(m_dataAddress, m_dataPort))
+        if (m_receiver->bind(m_dataAddress, m_dataPort))
 		{
 			qDebug("SDRdaemonSourceUDPHandler::start: bind data socket to %s:%d", m_dataAddress.toString().toStdString().c_str(),  m_dataPort);
+
+			m_decoder = new SDRdaemonSourceUDPDecoder(this, &m_datagramFifo);
+			m_decoderThread = new QThread();
+			m_decoder->moveToThread(m_decoderThread);
+
+	        connect(m_decoderThread, SIGNAL(started()), m_decoder, SLOT(process()));
+	        connect(m_decoder, SIGNAL(finished()), m_decoderThread, SLOT(quit()));
+	        connect(m_receiverThread, SIGNAL(started()), m_receiver, SLOT(process()));
+	        connect(m_receiver, SIGNAL(finished()), m_receiverThread, SLOT(quit()));
+
+	        m_decoderThread->start();
+	        m_receiverThread->start(QThread::HighPriority);
 			m_dataConnected = true;
 		}
 		else
 		{
 			qWarning("SDRdaemonSourceUDPHandler::start: cannot bind data port %d", m_dataPort);
-	        disconnect(m_dataSocket, SIGNAL(readyRead()), this, SLOT(dataReadyRead()));
+			delete m_receiver;
+			m_receiver = 0;
+			delete m_receiverThread;
+			m_receiverThread = 0;
 			m_dataConnected = false;
 		}
 	}
@@ -105,13 +118,29 @@ void SDRdaemonSourceUDPHandler::stop()
     if (m_dataConnected)
     {
 		m_dataConnected = false;
-	    disconnect(m_dataSocket, SIGNAL(readyRead()), this, SLOT(dataReadyRead()));
-	}
 
-	if (m_dataSocket)
-	{
-		delete m_dataSocket;
-		m_dataSocket = 0;
+		// receiver first so that nothing is left behind in the FIFO for a decoder that has gone.
+		// The finished() to quit() connections are queued to this thread and would not be delivered while waiting.
+		m_receiver->stop();
+		m_receiverThread->quit();
+		m_receiverThread->wait();
+		m_decoder->stop();
+		m_decoderThread->quit();
+		m_decoderThread->wait();
+
+		if (m_datagramFifo.getOverrunCount() > 0) {
+		    qWarning("SDRdaemonSourceUDPHandler::stop: %d datagrams dropped on FIFO overrun", m_datagramFifo.getOverrunCount());
+		}
+
+		m_remoteAddress = m_receiver->getRemoteAddress();
+		delete m_receiver;
+		m_receiver = 0;
+		delete m_receiverThread;
+		m_receiverThread = 0;
+		delete m_decoder;
+		m_decoder = 0;
+		delete m_decoderThread;
+		m_decoderThread = 0;
 	}
 }
 
@@ -131,25 +160,41 @@ void SDRdaemonSourceUDPHandler::configureUDPLink(const QString& address, quint16
 	start();
 }
 
-void SDRdaemonSourceUDPHandler::dataReadyRead()
+int SDRdaemonSourceUDPHandler::getDatagramSlotSize()
 {
-    m_udpReadBytes = 0;
+    int truncatedSize = m_datagramFifo.getTruncatedSize();
 
-	while (m_dataSocket->hasPendingDatagrams() && m_dataConnected)
-	{
-		qint64 pendingDataSize = m_dataSocket->pendingDatagramSize();
-		m_udpReadBytes += m_dataSocket->readDatagram(&m_udpBuf[m_udpReadBytes], pendingDataSize, &m_remoteAddress, 0);
+    if (SDRdaemonSourceBuffer::isValidUDPSize(truncatedSize)) { // larger blocks that do not fit in the slots
+        return truncatedSize;
+    }
 
-		if (m_udpReadBytes == SDRdaemonSourceBuffer::m_udpPayloadSize) {
-		    processData();
-		    m_udpReadBytes = 0;
-		}
-	}
+    QMutexLocker mutexLocker(&m_bufferMutex);
+    return m_sdrDaemonBuffer.getUDPSize();
+}
+
+void SDRdaemonSourceUDPHandler::decodeDatagrams()
+{
+    char *datagrams;
+    int *lengths;
+    int nbDatagrams;
+    int slotSize = m_datagramFifo.getSlotSize();
+
+    while ((nbDatagrams = m_datagramFifo.getReadSlots(datagrams, lengths, SDRDAEMONSOURCE_RXBATCH)) > 0)
+    {
+        QMutexLocker mutexLocker(&m_bufferMutex);
+
+        for (int i = 0; i < nbDatagrams; i++) {
+            processData(datagrams + i * slotSize, lengths[i]);
+        }
+
+        mutexLocker.unlock();
+        m_datagramFifo.commitRead(nbDatagrams);
+    }
 }
 
-void SDRdaemonSourceUDPHandler::processData()
+void SDRdaemonSourceUDPHandler::processData(char *datagram, int length)
 {
-    m_sdrDaemonBuffer.writeData(m_udpBuf);
+    m_sdrDaemonBuffer.writeData(datagram, length);
     const SDRdaemonSourceBuffer::MetaDataFEC& metaData =  m_sdrDaemonBuffer.getCurrentMeta();
 
     bool change = false;
@@ -202,6 +247,17 @@ void SDRdaemonSourceUDPHandler::connectTimer(const QTimer* timer)
 
 void SDRdaemonSourceUDPHandler::tick()
 {
+    // the FIFO is resized when the sender changes the block size. Done here as the threads must be stopped.
+    if (m_dataConnected && (getDatagramSlotSize() != m_datagramFifo.getSlotSize()))
+    {
+        qDebug("SDRdaemonSourceUDPHandler::tick: UDP block size changed from %d to %d: restart reception",
+                m_datagramFifo.getSlotSize(), getDatagramSlotSize());
+        stop();
+        start();
+    }
+
+    QMutexLocker mutexLocker(&m_bufferMutex);
+
     // auto throttling
     int throttlems = m_elapsedTimer.restart();
 
@@ -263,3 +319,27 @@ void SDRdaemonSourceUDPHandler::tick()
             m_outputMessageQueueToGUI->push(report);
 	}
 }
+
+SDRdaemonSourceUDPDecoder::SDRdaemonSourceUDPDecoder(SDRdaemonSourceUDPHandler *handler, SDRdaemonSourceDatagramFifo *fifo) :
+    m_handler(handler),
+    m_fifo(fifo),
+    m_running(1) // armed here so that a stop() before the thread has started is not lost
+{
+}
+
+void SDRdaemonSourceUDPDecoder::stop()
+{
+    m_running.storeRelease(0);
+}
+
+void SDRdaemonSourceUDPDecoder::process()
+{
+    while (m_running.loadAcquire())
+    {
+        if (m_fifo->waitForData(SDRDAEMONSOURCE_RXTIMEOUT_MS)) {
+            m_handler->decodeDatagrams();
+        }
+    }
+
+    emit finished();
+}
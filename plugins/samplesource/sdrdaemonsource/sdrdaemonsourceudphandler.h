@@ -18,12 +18,13 @@
 #define PLUGINS_SAMPLESOURCE_SDRDAEMONSOURCE_SDRDAEMONSOURCEUDPHANDLER_H_
 
 #include <QObject>
-#include <QUdpSocket>
 #include <QHostAddress>
 #include <QMutex>
+#include <QAtomicInt>
 #include <QElapsedTimer>
 
 #include "sdrdaemonsourcebuffer.h"
+#include "sdrdaemonsourceudpreceiver.h"
 
 #define SDRDAEMONSOURCE_THROTTLE_MS 50
 
@@ -31,6 +32,30 @@ class SampleSinkFifo;
 class MessageQueue;
 class QTimer;
 class DeviceSourceAPI;
+class QThread;
+class SDRdaemonSourceUDPHandler;
+
+/**
+ * Takes the received datagrams out of the FIFO and runs the FEC decoding in its own thread
+ */
+class SDRdaemonSourceUDPDecoder : public QObject
+{
+    Q_OBJECT
+public:
+    SDRdaemonSourceUDPDecoder(SDRdaemonSourceUDPHandler *handler, SDRdaemonSourceDatagramFifo *fifo);
+    void stop();
+
+signals:
+    void finished();
+
+public slots:
+    void process();
+
+private:
+    SDRdaemonSourceUDPHandler *m_handler;
+    SDRdaemonSourceDatagramFifo *m_fifo;
+    QAtomicInt m_running;
+};
 
 class SDRdaemonSourceUDPHandler : public QObject
 {
@@ -43,21 +68,24 @@ public:
 	void start();
 	void stop();
 	void configureUDPLink(const QString& address, quint16 port);
-	void getRemoteAddress(QString& s) const { s = m_remoteAddress.toString(); }
+	void getRemoteAddress(QString& s) const { s = m_receiver ? m_receiver->getRemoteAddress().toString() : m_remoteAddress.toString(); }
     int getNbOriginalBlocks() const { return SDRdaemonSourceBuffer::m_nbOriginalBlocks; }
-public slots:
-	void dataReadyRead();
+    void decodeDatagrams(); //!< Called from the decoder thread
 
 private:
+    int getDatagramSlotSize(); //!< Datagram FIFO slot size for the UDP block size in use
 	DeviceSourceAPI *m_deviceAPI;
 	SDRdaemonSourceBuffer m_sdrDaemonBuffer;
-	QUdpSocket *m_dataSocket;
+	QMutex m_bufferMutex; //!< serializes the decoder thread writes with the timer reads of the buffer
+	SDRdaemonSourceDatagramFifo m_datagramFifo;
+	SDRdaemonSourceUDPReceiver *m_receiver;
+	QThread *m_receiverThread;
+	SDRdaemonSourceUDPDecoder *m_decoder;
+	QThread *m_decoderThread;
 	QHostAddress m_dataAddress;
 	QHostAddress m_remoteAddress;
 	quint16 m_dataPort;
 	bool m_dataConnected;
-	char *m_udpBuf;
-	qint64 m_udpReadBytes;
 	SampleSinkFifo *m_sampleFifo;
 	uint32_t m_samplerate;
 	uint32_t m_centerFrequency;
@@ -76,7 +104,7 @@ private:
     uint32_t m_rateDivider;
     bool m_autoCorrBuffer;
 
-	void processData();
+	void processData(char *datagram, int length);
 
 private slots:
 	void tick();
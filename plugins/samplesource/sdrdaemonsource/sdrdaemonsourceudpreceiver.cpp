@@ -0,0 +1,388 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <string.h>
+#include <algorithm>
+
+#ifdef __linux__
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#else
+#include <QUdpSocket>
+#endif
+
+#include <QDebug>
+
+#include "sdrdaemonsourceudpreceiver.h"
+
+SDRdaemonSourceDatagramFifo::SDRdaemonSourceDatagramFifo(int nbBytes, int slotSize) :
+    m_buffer(0),
+    m_lengths(0),
+    m_nbBytes(nbBytes),
+    m_slotSize(0),
+    m_size(0),
+    m_head(0),
+    m_tail(0)
+{
+    resize(slotSize);
+}
+
+SDRdaemonSourceDatagramFifo::~SDRdaemonSourceDatagramFifo()
+{
+    delete[] m_lengths;
+    delete[] m_buffer;
+}
+
+void SDRdaemonSourceDatagramFifo::resize(int slotSize)
+{
+    // at least the byte size whatever the slot size and at least one receive batch
+    int nbSlots = std::max((m_nbBytes + slotSize - 1) / slotSize, SDRDAEMONSOURCE_RXBATCH);
+
+    if ((slotSize != m_slotSize) || (nbSlots != m_size))
+    {
+        delete[] m_lengths;
+        delete[] m_buffer;
+        m_slotSize = slotSize;
+        m_size = nbSlots;
+        m_buffer = new char[m_slotSize * m_size];
+        m_lengths = new int[m_size];
+
+        qDebug("SDRdaemonSourceDatagramFifo::resize: %d slots of %d bytes", m_size, m_slotSize);
+    }
+
+    reset();
+}
+
+void SDRdaemonSourceDatagramFifo::reset()
+{
+    m_head = 0;
+    m_tail = 0;
+    m_fill.storeRelease(0);
+    m_overrunCount.storeRelease(0);
+    m_truncatedSize.storeRelease(0);
+}
+
+int SDRdaemonSourceDatagramFifo::getWriteSlots(char*& datagrams, int*& lengths, int maxCount)
+{
+    int count = std::min(maxCount, m_size - m_fill.loadAcquire());
+    count = std::min(count, m_size - m_tail);
+    datagrams = m_buffer + m_tail * m_slotSize;
+    lengths = m_lengths + m_tail;
+    return count;
+}
+
+void SDRdaemonSourceDatagramFifo::commitWrite(int count)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    m_tail = (m_tail + count) % m_size;
+    m_fill.fetchAndAddRelease(count); // publish the datagrams to the reader
+
+    QMutexLocker mutexLocker(&m_waitMutex); // taken so that the wake up cannot fall between the reader's test and wait
+    m_dataAvailable.wakeOne();
+}
+
+int SDRdaemonSourceDatagramFifo::getReadSlots(char*& datagrams, int*& lengths, int maxCount)
+{
+    int count = std::min(maxCount, (int) m_fill.loadAcquire());
+    count = std::min(count, m_size - m_head);
+    datagrams = m_buffer + m_head * m_slotSize;
+    lengths = m_lengths + m_head;
+    return count;
+}
+
+void SDRdaemonSourceDatagramFifo::commitRead(int count)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    m_head = (m_head + count) % m_size;
+    m_fill.fetchAndAddRelease(-count); // give the datagrams back to the writer
+}
+
+bool SDRdaemonSourceDatagramFifo::waitForData(int timeoutMs)
+{
+    QMutexLocker mutexLocker(&m_waitMutex);
+
+    if (m_fill.loadAcquire() > 0) {
+        return true;
+    }
+
+    m_dataAvailable.wait(&m_waitMutex, timeoutMs);
+    return m_fill.loadAcquire() > 0;
+}
+
+SDRdaemonSourceUDPReceiver::SDRdaemonSourceUDPReceiver(SDRdaemonSourceDatagramFifo *fifo) :
+    m_fifo(fifo),
+    m_running(0),
+    m_remoteAddress((int) QHostAddress(QHostAddress::LocalHost).toIPv4Address()),
+    m_socketBufferSize(0),
+    m_socket(0)
+{
+    m_dropBuffer = new char[SDRDAEMONSOURCE_RXBATCH * m_fifo->getSlotSize()];
+    m_dropLengths = new int[SDRDAEMONSOURCE_RXBATCH];
+#ifdef __linux__
+    m_socket = -1;
+#endif
+}
+
+SDRdaemonSourceUDPReceiver::~SDRdaemonSourceUDPReceiver()
+{
+    closeSocket();
+    delete[] m_dropLengths;
+    delete[] m_dropBuffer;
+}
+
+void SDRdaemonSourceUDPReceiver::stop()
+{
+    m_running.storeRelease(0);
+}
+
+#ifdef __linux__
+
+bool SDRdaemonSourceUDPReceiver::bind(const QHostAddress& address, quint16 port)
+{
+    closeSocket();
+    m_socket = ::socket(AF_INET, SOCK_DGRAM, 0);
+
+    if (m_socket < 0)
+    {
+        qWarning("SDRdaemonSourceUDPReceiver::bind: cannot create socket: %s", strerror(errno));
+        return false;
+    }
+
+    // SO_RCVBUFFORCE ignores the rmem_max limit but needs CAP_NET_ADMIN
+    int bufferSize = SDRDAEMONSOURCE_SOCKETBUFSIZE;
+
+    if (setsockopt(m_socket, SOL_SOCKET, SO_RCVBUFFORCE, &bufferSize, sizeof(bufferSize)) < 0) {
+        setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+    }
+
+    socklen_t optionLength = sizeof(m_socketBufferSize);
+    getsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, &m_socketBufferSize, &optionLength);
+
+    struct timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = SDRDAEMONSOURCE_RXTIMEOUT_MS * 1000;
+    setsockopt(m_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    struct sockaddr_in localAddress;
+    memset(&localAddress, 0, sizeof(localAddress));
+    localAddress.sin_family = AF_INET;
+    localAddress.sin_port = htons(port);
+    localAddress.sin_addr.s_addr = htonl(address.toIPv4Address()); // non IPv4 addresses bind to any
+
+    if (::bind(m_socket, (struct sockaddr *) &localAddress, sizeof(localAddress)) < 0)
+    {
+        qWarning("SDRdaemonSourceUDPReceiver::bind: cannot bind to %s:%d: %s",
+                address.toString().toStdString().c_str(), port, strerror(errno));
+        closeSocket();
+        return false;
+    }
+
+    qDebug("SDRdaemonSourceUDPReceiver::bind: %s:%d receive buffer: %d bytes",
+            address.toString().toStdString().c_str(), port, m_socketBufferSize);
+    m_running.storeRelease(1); // armed here so that a stop() before the thread has started is not lost
+    return true;
+}
+
+void SDRdaemonSourceUDPReceiver::closeSocket()
+{
+    if (m_socket >= 0)
+    {
+        ::close(m_socket);
+        m_socket = -1;
+    }
+}
+
+void SDRdaemonSourceUDPReceiver::process()
+{
+    int slotSize = m_fifo->getSlotSize();
+    struct mmsghdr msgs[SDRDAEMONSOURCE_RXBATCH];
+    struct iovec iovecs[SDRDAEMONSOURCE_RXBATCH];
+    struct sockaddr_in senders[SDRDAEMONSOURCE_RXBATCH];
+
+    while (m_running.loadAcquire())
+    {
+        char *datagrams;
+        int *lengths;
+        int nbSlots = m_fifo->getWriteSlots(datagrams, lengths, SDRDAEMONSOURCE_RXBATCH);
+        bool dropping = (nbSlots == 0); // keep draining the socket so that the kernel buffer does not go stale
+
+        if (dropping)
+        {
+            datagrams = m_dropBuffer;
+            lengths = m_dropLengths;
+            nbSlots = SDRDAEMONSOURCE_RXBATCH;
+        }
+
+        for (int i = 0; i < nbSlots; i++)
+        {
+            iovecs[i].iov_base = datagrams + i * slotSize;
+            iovecs[i].iov_len = slotSize;
+            memset(&msgs[i].msg_hdr, 0, sizeof(struct msghdr));
+            msgs[i].msg_hdr.msg_name = &senders[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        // blocks until at least one datagram or the receive timeout then takes what is queued
+        // MSG_TRUNC gives the real length of the datagrams that do not fit
+        int nbReceived = recvmmsg(m_socket, msgs, nbSlots, MSG_WAITFORONE | MSG_TRUNC, 0);
+
+        if (nbReceived < 0)
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) {
+                continue;
+            }
+
+            qWarning("SDRdaemonSourceUDPReceiver::process: recvmmsg: %s", strerror(errno));
+            break;
+        }
+
+        // keep only whole datagrams packed at the start of the run. Sizes are checked by the decoder.
+        int nbValid = 0;
+
+        for (int i = 0; i < nbReceived; i++)
+        {
+            if (msgs[i].msg_len == 0) {
+                continue;
+            }
+
+            if ((msgs[i].msg_hdr.msg_flags & MSG_TRUNC) || ((int) msgs[i].msg_len > slotSize)) // the sender uses larger blocks
+            {
+                m_fifo->setTruncatedSize(msgs[i].msg_len);
+                continue;
+            }
+
+            if (i != nbValid) {
+                memmove(datagrams + nbValid * slotSize, datagrams + i * slotSize, msgs[i].msg_len);
+            }
+
+            lengths[nbValid] = msgs[i].msg_len;
+            nbValid++;
+        }
+
+        if (nbReceived > 0) {
+            m_remoteAddress.storeRelease((int) ntohl(senders[nbReceived - 1].sin_addr.s_addr));
+        }
+
+        if (dropping) {
+            m_fifo->addOverrun(nbValid);
+        } else {
+            m_fifo->commitWrite(nbValid);
+        }
+    }
+
+    emit finished();
+}
+
+#else // portable fallback with one datagram per read
+
+bool SDRdaemonSourceUDPReceiver::bind(const QHostAddress& address, quint16 port)
+{
+    closeSocket();
+    m_socket = new QUdpSocket();
+    m_socket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, SDRDAEMONSOURCE_SOCKETBUFSIZE);
+
+    if (!m_socket->bind(address, port))
+    {
+        qWarning("SDRdaemonSourceUDPReceiver::bind: cannot bind to %s:%d", address.toString().toStdString().c_str(), port);
+        closeSocket();
+        return false;
+    }
+
+    m_socketBufferSize = m_socket->socketOption(QAbstractSocket::ReceiveBufferSizeSocketOption).toInt();
+    m_socket->moveToThread(thread()); // the socket is used by the receiving thread only
+
+    qDebug("SDRdaemonSourceUDPReceiver::bind: %s:%d receive buffer: %d bytes",
+            address.toString().toStdString().c_str(), port, m_socketBufferSize);
+    m_running.storeRelease(1); // armed here so that a stop() before the thread has started is not lost
+    return true;
+}
+
+void SDRdaemonSourceUDPReceiver::closeSocket()
+{
+    if (m_socket)
+    {
+        delete m_socket;
+        m_socket = 0;
+    }
+}
+
+void SDRdaemonSourceUDPReceiver::process()
+{
+    int slotSize = m_fifo->getSlotSize();
+    QHostAddress sender;
+
+    while (m_running.loadAcquire())
+    {
+        if (!m_socket->waitForReadyRead(SDRDAEMONSOURCE_RXTIMEOUT_MS)) {
+            continue;
+        }
+
+        while (m_socket->hasPendingDatagrams())
+        {
+            char *slot;
+            int *length;
+            int nbSlots = m_fifo->getWriteSlots(slot, length, 1);
+
+            if (nbSlots == 0)
+            {
+                slot = m_dropBuffer;
+                length = m_dropLengths;
+            }
+
+            qint64 pendingSize = m_socket->pendingDatagramSize();
+
+            if (pendingSize > slotSize) // would be truncated: the sender uses larger blocks
+            {
+                m_fifo->setTruncatedSize(pendingSize);
+                m_socket->readDatagram(m_dropBuffer, 0);
+                continue;
+            }
+
+            qint64 readBytes = m_socket->readDatagram(slot, slotSize, &sender, 0);
+
+            if (readBytes <= 0) {
+                continue;
+            }
+
+            *length = readBytes;
+
+            m_remoteAddress.storeRelease((int) sender.toIPv4Address());
+
+            if (nbSlots == 0) {
+                m_fifo->addOverrun(1);
+            } else {
+                m_fifo->commitWrite(1);
+            }
+        }
+    }
+
+    emit finished();
+}
+
+#endif
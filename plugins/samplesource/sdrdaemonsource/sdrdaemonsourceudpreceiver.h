@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef PLUGINS_SAMPLESOURCE_SDRDAEMONSOURCE_SDRDAEMONSOURCEUDPRECEIVER_H_
+#define PLUGINS_SAMPLESOURCE_SDRDAEMONSOURCE_SDRDAEMONSOURCEUDPRECEIVER_H_
+
+#include <QObject>
+#include <QHostAddress>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QWaitCondition>
+
+#define SDRDAEMONSOURCE_RXBATCH 64                  // maximum number of datagrams fetched per system call
+#define SDRDAEMONSOURCE_RXFIFOBYTES (4*1024*1024)  // minimum size in bytes of the datagram FIFO between the receiver and the decoder
+#define SDRDAEMONSOURCE_SOCKETBUFSIZE (8*1024*1024) // requested socket receive buffer size in bytes
+#define SDRDAEMONSOURCE_RXTIMEOUT_MS 100            // receive wait timeout so that the loops can notice a stop request
+
+class QUdpSocket;
+
+/**
+ * Single producer single consumer FIFO of datagrams between the receiving thread
+ * and the decoding thread. Slots are sized for the current UDP block size and carry
+ * the actual length. Their number is derived from the size in bytes so that the
+ * buffering time does not depend on the block size. They are handed out in contiguous
+ * runs so that the receiver can have the kernel copy datagrams straight into them.
+ * Only the fill count is shared between the two sides.
+ */
+class SDRdaemonSourceDatagramFifo
+{
+public:
+    SDRdaemonSourceDatagramFifo(int nbBytes, int slotSize);
+    ~SDRdaemonSourceDatagramFifo();
+
+    int getSlotSize() const { return m_slotSize; }
+    int getNbSlots() const { return m_size; }
+    void resize(int slotSize); //!< Set the slot size and number of slots then reset. Only when neither side is running
+    void reset();              //!< Only when neither side is running
+
+    // writer side
+    int getWriteSlots(char*& datagrams, int*& lengths, int maxCount); //!< Get up to maxCount contiguous free slots and their lengths. Returns the number of slots.
+    void commitWrite(int count);                                      //!< Publish count datagrams written in the slots
+
+    // reader side
+    int getReadSlots(char*& datagrams, int*& lengths, int maxCount);  //!< Get up to maxCount contiguous filled slots and their lengths. Returns the number of slots.
+    void commitRead(int count);                                       //!< Release count slots
+    bool waitForData(int timeoutMs);                                  //!< Wait until some data is available or timeout. Returns true if data is available.
+
+    int getOverrunCount() const { return m_overrunCount.load(); }
+    void addOverrun(int count) { m_overrunCount.fetchAndAddRelaxed(count); }
+    int getTruncatedSize() const { return m_truncatedSize.load(); }
+    void setTruncatedSize(int size) { m_truncatedSize.storeRelease(size); } //!< Record the length of a datagram that did not fit in a slot
+
+private:
+    char *m_buffer;
+    int *m_lengths;          //!< length of the datagram in each slot
+    int m_nbBytes;           //!< minimum size of the slots buffer
+    int m_slotSize;
+    int m_size;              //!< number of slots
+    int m_head;              //!< next slot to read (reader only)
+    int m_tail;              //!< next slot to write (writer only)
+    QAtomicInt m_fill;       //!< number of filled slots
+    QAtomicInt m_overrunCount;
+    QAtomicInt m_truncatedSize; //!< length of the last datagram larger than the slots
+    QMutex m_waitMutex;
+    QWaitCondition m_dataAvailable;
+};
+
+/**
+ * Receives the SDRdaemon datagrams in a dedicated thread. On Linux datagrams are fetched
+ * in batches with recvmmsg directly into the FIFO slots. Elsewhere it falls back to a
+ * blocking QUdpSocket owned by the thread.
+ */
+class SDRdaemonSourceUDPReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    SDRdaemonSourceUDPReceiver(SDRdaemonSourceDatagramFifo *fifo);
+    ~SDRdaemonSourceUDPReceiver();
+
+    bool bind(const QHostAddress& address, quint16 port); //!< Open and bind the socket. To be done before the thread starts.
+    void stop();
+    QHostAddress getRemoteAddress() const { return QHostAddress((quint32) m_remoteAddress.load()); }
+    int getSocketBufferSize() const { return m_socketBufferSize; }
+
+signals:
+    void finished();
+
+public slots:
+    void process();
+
+private:
+    SDRdaemonSourceDatagramFifo *m_fifo;
+    QAtomicInt m_running;
+    QAtomicInt m_remoteAddress; //!< IPv4 address of the last sender in host order
+    int m_socketBufferSize;     //!< actual socket receive buffer size
+    char *m_dropBuffer;         //!< datagrams land here when the FIFO is full
+    int *m_dropLengths;
+#ifdef __linux__
+    int m_socket;
+#else
+    QUdpSocket *m_socket;
+#endif
+
+    void closeSocket();
+};
+
+#endif /* PLUGINS_SAMPLESOURCE_SDRDAEMONSOURCE_SDRDAEMONSOURCEUDPRECEIVER_H_ */
@@ -7,6 +7,7 @@
 TEMPLATE = subdirs
 SUBDIRS = sdrbase
 SUBDIRS += sdrgui
+SUBDIRS += sdrsrv
 SUBDIRS += devices
 SUBDIRS += fcdhid
 SUBDIRS += fcdlib
@@ -40,3 +41,4 @@ SUBDIRS += plugins/channeltx/udpsink
 # Main app must be last
 CONFIG += ordered
 SUBDIRS += app
+SUBDIRS += appsrv
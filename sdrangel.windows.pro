@@ -12,6 +12,7 @@ SUBDIRS += logging
 SUBDIRS += swagger
 SUBDIRS += sdrbase
 SUBDIRS += sdrgui
+SUBDIRS += sdrsrv
 CONFIG(MINGW64)SUBDIRS += nanomsg
 SUBDIRS += fcdhid
 SUBDIRS += fcdlib
@@ -61,3 +62,4 @@ SUBDIRS += plugins/channeltx/udpsink
 # Main app must be last
 CONFIG += ordered
 SUBDIRS += app
+SUBDIRS += appsrv
@@ -0,0 +1,273 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QAudioDeviceInfo>
+
+#include "audio/audiodevicemanager.h"
+#include "audio/audiofifo.h"
+
+const QString AudioDeviceManager::m_defaultDeviceName = "System default device";
+
+AudioDeviceManager::OutputThread::OutputThread(AudioOutput *audioOutput, int deviceIndex, uint rate) :
+    m_audioOutput(audioOutput),
+    m_deviceIndex(deviceIndex),
+    m_rate(rate),
+    m_opened(false),
+    m_startDone(false)
+{
+}
+
+bool AudioDeviceManager::OutputThread::startOutput()
+{
+    m_startMutex.lock();
+    m_startDone = false;
+    start(QThread::HighPriority);
+
+    while (!m_startDone) {
+        m_startCondition.wait(&m_startMutex);
+    }
+
+    bool opened = m_opened;
+    m_startMutex.unlock();
+
+    return opened;
+}
+
+void AudioDeviceManager::OutputThread::stopOutput()
+{
+    quit();
+    wait();
+}
+
+void AudioDeviceManager::OutputThread::run()
+{
+    // the device is created here so that its pull timer runs in this thread's event loop
+    bool opened = m_audioOutput->start(m_deviceIndex, m_rate);
+
+    m_startMutex.lock();
+    m_opened = opened;
+    m_startDone = true;
+    m_startCondition.wakeAll();
+    m_startMutex.unlock();
+
+    if (opened)
+    {
+        exec();
+        m_audioOutput->stop();
+    }
+}
+
+AudioDeviceManager::AudioDeviceManager() :
+    m_defaultOutputDeviceIndex(-1),
+    m_outputSampleRate(48000),
+    m_startCount(0),
+    m_onExit(false)
+{
+}
+
+AudioDeviceManager::~AudioDeviceManager()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (OutputDevices::iterator it = m_outputs.begin(); it != m_outputs.end(); ++it)
+    {
+        stopOutput(it->second);
+        delete it->second.m_audioOutput;
+    }
+
+    m_outputs.clear();
+}
+
+void AudioDeviceManager::setDefaultOutputDeviceIndex(int index)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_defaultOutputDeviceIndex = index;
+}
+
+void AudioDeviceManager::addAudioSink(AudioFifo* audioFifo, const QString& deviceName)
+{
+    qDebug("AudioDeviceManager::addAudioSink: %p to %s", audioFifo, qPrintable(deviceName));
+    QMutexLocker mutexLocker(&m_mutex);
+
+    m_sinkDeviceNames[audioFifo] = deviceName;
+    routeSink(audioFifo, resolveOutputDeviceIndex(deviceName));
+}
+
+void AudioDeviceManager::removeAudioSink(AudioFifo* audioFifo)
+{
+    qDebug("AudioDeviceManager::removeAudioSink: %p", audioFifo);
+    QMutexLocker mutexLocker(&m_mutex);
+
+    m_sinkDeviceNames.erase(audioFifo);
+    unrouteSink(audioFifo);
+}
+
+void AudioDeviceManager::startAudioOutputs()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    m_startCount++;
+
+    if (m_startCount > 1) {
+        return;
+    }
+
+    // the default device or the list of devices may have changed since the last start
+    for (SinkDeviceNames::const_iterator it = m_sinkDeviceNames.begin(); it != m_sinkDeviceNames.end(); ++it) {
+        routeSink(it->first, resolveOutputDeviceIndex(it->second));
+    }
+
+    for (OutputDevices::iterator it = m_outputs.begin(); it != m_outputs.end(); ++it)
+    {
+        if (it->second.m_thread == 0) {
+            startOutput(it->second, it->first);
+        }
+    }
+}
+
+void AudioDeviceManager::stopAudioOutputs()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_startCount == 0) {
+        return;
+    }
+
+    m_startCount--;
+
+    if (m_startCount == 0)
+    {
+        for (OutputDevices::iterator it = m_outputs.begin(); it != m_outputs.end(); ++it) {
+            stopOutput(it->second);
+        }
+    }
+}
+
+void AudioDeviceManager::getFifoStatus(std::vector<AudioOutput::FifoStatus>& fifoStatus)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    std::vector<AudioOutput::FifoStatus> outputFifoStatus;
+
+    fifoStatus.clear();
+
+    for (OutputDevices::iterator it = m_outputs.begin(); it != m_outputs.end(); ++it)
+    {
+        it->second.m_audioOutput->getFifoStatus(outputFifoStatus);
+        fifoStatus.insert(fifoStatus.end(), outputFifoStatus.begin(), outputFifoStatus.end());
+    }
+}
+
+int AudioDeviceManager::resolveOutputDeviceIndex(const QString& deviceName) const
+{
+    if (deviceName == m_defaultDeviceName) {
+        return m_defaultOutputDeviceIndex;
+    }
+
+    QList<QAudioDeviceInfo> devicesInfo = QAudioDeviceInfo::availableDevices(QAudio::AudioOutput);
+
+    for (int i = 0; i < devicesInfo.size(); i++)
+    {
+        if (devicesInfo[i].deviceName() == deviceName) {
+            return i;
+        }
+    }
+
+    qWarning("AudioDeviceManager::resolveOutputDeviceIndex: device %s not found. Using default device", qPrintable(deviceName));
+    return m_defaultOutputDeviceIndex;
+}
+
+void AudioDeviceManager::routeSink(AudioFifo* audioFifo, int deviceIndex)
+{
+    SinkOutputs::iterator sinkIt = m_sinkOutputs.find(audioFifo);
+
+    if (sinkIt != m_sinkOutputs.end())
+    {
+        if (sinkIt->second == deviceIndex) {
+            return;
+        }
+
+        unrouteSink(audioFifo);
+    }
+
+    OutputDevices::iterator outputIt = m_outputs.find(deviceIndex);
+
+    if (outputIt == m_outputs.end())
+    {
+        OutputDevice outputDevice;
+        outputDevice.m_audioOutput = new AudioOutput();
+        outputDevice.m_thread = 0;
+        outputDevice.m_nbFifos = 0;
+        outputIt = m_outputs.insert(OutputDevices::value_type(deviceIndex, outputDevice)).first;
+    }
+
+    outputIt->second.m_audioOutput->addFifo(audioFifo);
+    outputIt->second.m_nbFifos++;
+    m_sinkOutputs[audioFifo] = deviceIndex;
+
+    if ((m_startCount > 0) && (outputIt->second.m_thread == 0)) {
+        startOutput(outputIt->second, deviceIndex);
+    }
+}
+
+void AudioDeviceManager::unrouteSink(AudioFifo* audioFifo)
+{
+    SinkOutputs::iterator sinkIt = m_sinkOutputs.find(audioFifo);
+
+    if (sinkIt == m_sinkOutputs.end()) {
+        return;
+    }
+
+    OutputDevices::iterator outputIt = m_outputs.find(sinkIt->second);
+    m_sinkOutputs.erase(sinkIt);
+
+    if (outputIt == m_outputs.end()) {
+        return;
+    }
+
+    outputIt->second.m_audioOutput->removeFifo(audioFifo);
+    outputIt->second.m_nbFifos--;
+
+    if (outputIt->second.m_nbFifos == 0)
+    {
+        stopOutput(outputIt->second);
+        delete outputIt->second.m_audioOutput;
+        m_outputs.erase(outputIt);
+    }
+}
+
+void AudioDeviceManager::startOutput(OutputDevice& outputDevice, int deviceIndex)
+{
+    outputDevice.m_thread = new OutputThread(outputDevice.m_audioOutput, deviceIndex, m_outputSampleRate);
+
+    if (outputDevice.m_thread->startOutput()) {
+        m_outputSampleRate = outputDevice.m_audioOutput->getRate(); // update with actual rate
+    } else {
+        qWarning("AudioDeviceManager::startOutput: cannot start output device #%d", deviceIndex);
+    }
+}
+
+void AudioDeviceManager::stopOutput(OutputDevice& outputDevice)
+{
+    if (outputDevice.m_thread == 0) {
+        return;
+    }
+
+    outputDevice.m_audioOutput->setOnExit(m_onExit);
+    outputDevice.m_thread->stopOutput();
+    delete outputDevice.m_thread;
+    outputDevice.m_thread = 0;
+}
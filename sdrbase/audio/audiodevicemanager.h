@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_AUDIO_AUDIODEVICEMANAGER_H_
+#define SDRBASE_AUDIO_AUDIODEVICEMANAGER_H_
+
+#include <map>
+#include <vector>
+#include <QString>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThread>
+
+#include "audio/audiooutput.h"
+#include "util/export.h"
+
+class AudioFifo;
+
+/**
+ * Owns one AudioOutput per audio output device in use and routes the audio FIFOs of the channels
+ * to the device they select. Each output is pulled by its own thread so that devices do not share
+ * a mixer thread nor a clock. Outputs are created when the first FIFO is routed to them and deleted
+ * when the last one leaves.
+ */
+class SDRANGEL_API AudioDeviceManager
+{
+public:
+    AudioDeviceManager();
+    ~AudioDeviceManager();
+
+    static const QString m_defaultDeviceName; //!< name selecting the default output device set in the preferences
+
+    void setDefaultOutputDeviceIndex(int index); //!< -1 for the system default. Applies at next start.
+    void setOutputSampleRate(uint rate) { m_outputSampleRate = rate; } //!< requested rate for all outputs
+    uint getOutputSampleRate() const { return m_outputSampleRate; }    //!< actual rate of the last output started
+
+    void addAudioSink(AudioFifo* audioFifo, const QString& deviceName = m_defaultDeviceName); //!< Route FIFO to device. Moves it if already routed.
+    void removeAudioSink(AudioFifo* audioFifo);
+
+    void startAudioOutputs(); //!< Usage counted. Starts all outputs with at least one FIFO.
+    void stopAudioOutputs();
+    void setOnExit(bool onExit) { m_onExit = onExit; }
+
+    void getFifoStatus(std::vector<AudioOutput::FifoStatus>& fifoStatus); //!< FIFOs of all outputs
+
+private:
+    /** Runs the pull of one output device. The device is opened and closed in this thread. */
+    class OutputThread : public QThread
+    {
+    public:
+        OutputThread(AudioOutput *audioOutput, int deviceIndex, uint rate);
+        bool startOutput(); //!< start the thread and wait until the device is opened
+        void stopOutput();  //!< close the device and wait for the thread to finish
+
+    protected:
+        void run();
+
+    private:
+        AudioOutput *m_audioOutput;
+        int m_deviceIndex;
+        uint m_rate;
+        bool m_opened;
+        bool m_startDone;
+        QMutex m_startMutex;
+        QWaitCondition m_startCondition;
+    };
+
+    struct OutputDevice
+    {
+        AudioOutput *m_audioOutput;
+        OutputThread *m_thread; //!< 0 when stopped
+        unsigned int m_nbFifos;
+    };
+
+    typedef std::map<int, OutputDevice> OutputDevices;
+    typedef std::map<AudioFifo*, QString> SinkDeviceNames;
+    typedef std::map<AudioFifo*, int> SinkOutputs;
+
+    QMutex m_mutex;
+    int m_defaultOutputDeviceIndex;
+    uint m_outputSampleRate;
+    unsigned int m_startCount;
+    bool m_onExit;
+    OutputDevices m_outputs;         //!< by device index. -1 is the system default device.
+    SinkDeviceNames m_sinkDeviceNames; //!< device name selected for each FIFO
+    SinkOutputs m_sinkOutputs;       //!< device index each FIFO is mixed into
+
+    int resolveOutputDeviceIndex(const QString& deviceName) const;
+    void routeSink(AudioFifo* audioFifo, int deviceIndex); //!< call with mutex held
+    void unrouteSink(AudioFifo* audioFifo);                //!< call with mutex held
+    void startOutput(OutputDevice& outputDevice, int deviceIndex);
+    void stopOutput(OutputDevice& outputDevice);
+};
+
+#endif /* SDRBASE_AUDIO_AUDIODEVICEMANAGER_H_ */
@@ -17,10 +17,12 @@
 
 #include <string.h>
 #include <QTime>
+#include <QThread>
 #include "dsp/dsptypes.h"
 #include "audio/audiofifo.h"
 
 #define MIN(x, y) ((x) < (y) ? (x) : (y))
+#define AUDIOFIFO_POLL_US 250
 
 AudioFifo::AudioFifo() :
 	m_fifo(0),
@@ -29,7 +31,6 @@ AudioFifo::AudioFifo() :
 	m_copyToUDP(false)
 {
 	m_size = 0;
-	m_fill = 0;
 	m_head = 0;
 	m_tail = 0;
 }
@@ -40,39 +41,30 @@ AudioFifo::AudioFifo(uint32_t numSamples) :
     m_udpSink(0),
     m_copyToUDP(false)
 {
-	QMutexLocker mutexLocker(&m_mutex);
-
 	create(numSamples);
 }
 
 AudioFifo::~AudioFifo()
 {
-	QMutexLocker mutexLocker(&m_mutex);
-
 	if (m_fifo != 0)
 	{
 		delete[] m_fifo;
 		m_fifo = 0;
 	}
 
-	m_writeWaitCondition.wakeOne();
-	m_readWaitCondition.wakeOne();
-
 	m_size = 0;
 }
 
 bool AudioFifo::setSize(uint32_t numSamples)
 {
-	QMutexLocker mutexLocker(&m_mutex);
-
 	return create(numSamples);
 }
 
 uint AudioFifo::write(const quint8* data, uint32_t numSamples, int timeout_ms)
 {
 	QTime time;
-	uint32_t total;
 	uint32_t remaining;
+	uint32_t space;
 	uint32_t copyLen;
 
 	if (m_copyToUDP && m_udpSink)
@@ -85,177 +77,124 @@ uint AudioFifo::write(const quint8* data, uint32_t numSamples, int timeout_ms)
 		return 0;
 	}
 
-	time.start();
-	m_mutex.lock();
-
-	if(timeout_ms == 0)
-	{
-		total = MIN(numSamples, m_size - m_fill);
-	}
-	else
-	{
-		total = numSamples;
-	}
-
-	remaining = total;
+	remaining = numSamples;
 
 	while (remaining > 0)
 	{
-		if (isFull())
+		space = m_size - m_fill.loadAcquire();
+
+		if (space == 0)
 		{
-			if (time.elapsed() < timeout_ms)
-			{
-				m_writeWaitLock.lock();
-				m_mutex.unlock();
-				int ms = timeout_ms - time.elapsed();
-
-				if(ms < 1)
-				{
-					ms = 1;
-				}
-
-				bool ok = m_writeWaitCondition.wait(&m_writeWaitLock, ms);
-				m_writeWaitLock.unlock();
-
-				if(!ok)
-				{
-					return total - remaining;
-				}
-
-				m_mutex.lock();
-
-				if(m_fifo == 0)
-				{
-					m_mutex.unlock();
-					return 0;
-				}
+			if (timeout_ms == 0) {
+				break;
 			}
-			else
-			{
-				m_mutex.unlock();
-				return total - remaining;
+
+			if (!time.isValid()) { // start timing only when we have to wait
+				time.start();
+			} else if (time.elapsed() >= timeout_ms) {
+				break;
 			}
+
+			QThread::usleep(AUDIOFIFO_POLL_US);
+			continue;
 		}
 
-		copyLen = MIN(remaining, m_size - m_fill);
+		copyLen = MIN(remaining, space);
 		copyLen = MIN(copyLen, m_size - m_tail);
 		memcpy(m_fifo + (m_tail * m_sampleSize), data, copyLen * m_sampleSize);
 		m_tail += copyLen;
 		m_tail %= m_size;
-		m_fill += copyLen;
+		m_fill.fetchAndAddRelease(copyLen); // publish the samples to the reader
 		data += copyLen * m_sampleSize;
 		remaining -= copyLen;
-		m_readWaitCondition.wakeOne();
 	}
 
-	m_mutex.unlock();
-	return total;
+	if (remaining > 0) {
+		m_overrunCount.fetchAndAddRelaxed(1);
+	}
+
+	return numSamples - remaining;
 }
 
 uint AudioFifo::read(quint8* data, uint32_t numSamples, int timeout_ms)
 {
 	QTime time;
-	uint32_t total;
 	uint32_t remaining;
+	uint32_t available;
 	uint32_t copyLen;
+	int drop;
 
 	if(m_fifo == 0)
 	{
 		return 0;
 	}
 
-	time.start();
-	m_mutex.lock();
-
-	if(timeout_ms == 0)
-	{
-		total = MIN(numSamples, m_fill);
-	}
-	else
-	{
-		total = numSamples;
+	if ((drop = m_drop.fetchAndStoreAcquire(0)) > 0) {
+		drain(drop);
 	}
 
-	remaining = total;
+	remaining = numSamples;
 
-	while(remaining > 0)
+	while (remaining > 0)
 	{
-		if(isEmpty())
+		available = m_fill.loadAcquire();
+
+		if (available == 0)
 		{
-			if(time.elapsed() < timeout_ms)
-			{
-				m_readWaitLock.lock();
-				m_mutex.unlock();
-				int ms = timeout_ms - time.elapsed();
-
-				if(ms < 1)
-				{
-					ms = 1;
-				}
-
-				bool ok = m_readWaitCondition.wait(&m_readWaitLock, ms);
-				m_readWaitLock.unlock();
-
-				if(!ok)
-				{
-					return total - remaining;
-				}
-
-				m_mutex.lock();
-
-				if(m_fifo == 0)
-				{
-					m_mutex.unlock();
-					return 0;
-				}
+			if (timeout_ms == 0) {
+				break;
 			}
-			else
-			{
-				m_mutex.unlock();
-				return total - remaining;
+
+			if (!time.isValid()) { // start timing only when we have to wait
+				time.start();
+			} else if (time.elapsed() >= timeout_ms) {
+				break;
 			}
+
+			QThread::usleep(AUDIOFIFO_POLL_US);
+			continue;
 		}
 
-		copyLen = MIN(remaining, m_fill);
+		copyLen = MIN(remaining, available);
 		copyLen = MIN(copyLen, m_size - m_head);
 		memcpy(data, m_fifo + (m_head * m_sampleSize), copyLen * m_sampleSize);
 		m_head += copyLen;
 		m_head %= m_size;
-		m_fill -= copyLen;
+		m_fill.fetchAndAddRelease(-(int) copyLen); // give the room back to the writer
 		data += copyLen * m_sampleSize;
 		remaining -= copyLen;
-		m_writeWaitCondition.wakeOne();
 	}
 
-	m_mutex.unlock();
-	return total;
+	if (remaining > 0) {
+		m_underrunCount.fetchAndAddRelaxed(1);
+	}
+
+	return numSamples - remaining;
 }
 
 uint AudioFifo::drain(uint32_t numSamples)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	if (m_fifo == 0)
+	{
+		return 0;
+	}
+
+	uint32_t available = m_fill.loadAcquire();
 
-	if(numSamples > m_fill)
+	if (numSamples > available)
 	{
-		numSamples = m_fill;
+		numSamples = available;
 	}
 
 	m_head = (m_head + numSamples) % m_size;
-	m_fill -= numSamples;
+	m_fill.fetchAndAddRelease(-(int) numSamples);
 
-	m_writeWaitCondition.wakeOne();
 	return numSamples;
 }
 
 void AudioFifo::clear()
 {
-	QMutexLocker mutexLocker(&m_mutex);
-
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
-
-	m_writeWaitCondition.wakeOne();
+	m_drop.fetchAndStoreRelease(m_fill.loadAcquire());
 }
 
 bool AudioFifo::create(uint32_t numSamples)
@@ -267,7 +206,8 @@ bool AudioFifo::create(uint32_t numSamples)
 	}
 
 	m_size = 0;
-	m_fill = 0;
+	m_fill.storeRelease(0);
+	m_drop.storeRelease(0);
 	m_head = 0;
 	m_tail = 0;
 
@@ -19,13 +19,18 @@
 #define INCLUDE_AUDIOFIFO_H
 
 #include <QObject>
-#include <QMutex>
-#include <QWaitCondition>
+#include <QAtomicInt>
 
 #include "dsp/dsptypes.h"
 #include "util/export.h"
 #include "util/udpsink.h"
 
+/**
+ * Single producer single consumer audio FIFO. The writer (a demodulator or the audio input) and the
+ * reader (the audio output callback or a modulator) do not share any lock. Only the fill count is
+ * shared and it is accessed atomically. A call with a non zero timeout polls the FIFO until it can
+ * complete or the timeout expires. The audio output callback always reads with a zero timeout.
+ */
 class SDRANGEL_API AudioFifo : public QObject {
 	Q_OBJECT
 public:
@@ -33,39 +38,40 @@ public:
 	AudioFifo(uint32_t numSamples);
 	~AudioFifo();
 
-	bool setSize(uint32_t numSamples);
+	bool setSize(uint32_t numSamples); //!< not to be called while the FIFO is in use
 
 	uint32_t write(const quint8* data, uint32_t numSamples, int timeout_ms = INT_MAX);
 	uint32_t read(quint8* data, uint32_t numSamples, int timeout_ms = INT_MAX);
 
-	uint32_t drain(uint32_t numSamples);
-	void clear();
+	uint32_t drain(uint32_t numSamples); //!< reader side
+	void clear();                        //!< can be called from either side. Samples are dropped on the next read.
 
-	inline uint32_t flush() { return drain(m_fill); }
-	inline uint32_t fill() const { return m_fill; }
-	inline bool isEmpty() const { return m_fill == 0; }
-	inline bool isFull() const { return m_fill == m_size; }
+	inline uint32_t flush() { return drain(fill()); }
+	inline uint32_t fill() const { return m_fill.loadAcquire(); }
+	inline bool isEmpty() const { return fill() == 0; }
+	inline bool isFull() const { return fill() == m_size; }
 	inline uint32_t size() const { return m_size; }
 
+	uint32_t getUnderrunCount() const { return m_underrunCount.load(); } //!< reads that could not be fully served
+	uint32_t getOverrunCount() const { return m_overrunCount.load(); }   //!< writes that could not be fully stored
+	void resetCounters() { m_underrunCount.store(0); m_overrunCount.store(0); }
+
 	void setUDPSink(UDPSink<AudioSample> *udpSink) { m_udpSink = udpSink; }
 	void setCopyToUDP(bool copyToUDP) { m_copyToUDP = copyToUDP; }
 
 private:
-	QMutex m_mutex;
-
 	qint8* m_fifo;
 
 	const uint32_t m_sampleSize;
 
 	uint32_t m_size;
-	uint32_t m_fill;
-	uint32_t m_head;
-	uint32_t m_tail;
-
-	QMutex m_writeWaitLock;
-	QMutex m_readWaitLock;
-	QWaitCondition m_writeWaitCondition;
-	QWaitCondition m_readWaitCondition;
+	QAtomicInt m_fill;  //!< number of samples in the FIFO: the only state shared by reader and writer
+	uint32_t m_head;    //!< read index: reader side only
+	uint32_t m_tail;    //!< write index: writer side only
+	QAtomicInt m_drop;  //!< number of samples to drop on next read as requested by clear()
+
+	QAtomicInt m_underrunCount;
+	QAtomicInt m_overrunCount;
 
 	UDPSink<AudioSample> *m_udpSink;
 	bool m_copyToUDP;
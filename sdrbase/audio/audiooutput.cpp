@@ -16,6 +16,9 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <string.h>
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
 #include <QAudioFormat>
 #include <QAudioDeviceInfo>
 #include <QAudioOutput>
@@ -24,6 +27,7 @@
 
 AudioOutput::AudioOutput() :
 	m_mutex(),
+	m_fifoListMutex(),
 	m_audioOutput(0),
 	m_audioUsageCount(0),
 	m_onExit(false),
@@ -36,6 +40,7 @@ AudioOutput::~AudioOutput()
 	stop();
 
 	QMutexLocker mutexLocker(&m_mutex);
+	QMutexLocker fifoListMutexLocker(&m_fifoListMutex);
 
 	for (AudioFifos::iterator it = m_audioFifos.begin(); it != m_audioFifos.end(); ++it)
 	{
@@ -140,6 +145,7 @@ void AudioOutput::stop()
 void AudioOutput::addFifo(AudioFifo* audioFifo)
 {
 	QMutexLocker mutexLocker(&m_mutex);
+	QMutexLocker fifoListMutexLocker(&m_fifoListMutex);
 
 	m_audioFifos.push_back(audioFifo);
 }
@@ -147,10 +153,28 @@ void AudioOutput::addFifo(AudioFifo* audioFifo)
 void AudioOutput::removeFifo(AudioFifo* audioFifo)
 {
 	QMutexLocker mutexLocker(&m_mutex);
+	QMutexLocker fifoListMutexLocker(&m_fifoListMutex);
 
 	m_audioFifos.remove(audioFifo);
 }
 
+void AudioOutput::getFifoStatus(std::vector<FifoStatus>& fifoStatus)
+{
+	QMutexLocker mutexLocker(&m_fifoListMutex); // not m_mutex: this must never make the audio callback output silence
+
+	fifoStatus.clear();
+
+	for (AudioFifos::const_iterator it = m_audioFifos.begin(); it != m_audioFifos.end(); ++it)
+	{
+		FifoStatus status;
+		status.m_size = (*it)->size();
+		status.m_fill = (*it)->fill();
+		status.m_underrunCount = (*it)->getUnderrunCount();
+		status.m_overrunCount = (*it)->getOverrunCount();
+		fifoStatus.push_back(status);
+	}
+}
+
 /*
 bool AudioOutput::open(OpenMode mode)
 {
@@ -162,16 +186,19 @@ qint64 AudioOutput::readData(char* data, qint64 maxLen)
 {
     //qDebug("AudioOutput::readData: %lld", maxLen);
 
-    // Study this mutex on OSX, for now deadlocks possible
-    // Removed as it may indeed cause lockups and is in fact useless.
-//#ifndef __APPLE__
-//    QMutexLocker mutexLocker(&m_mutex);
-//#endif
+    // Never wait in the audio callback: if the FIFO list is being changed play silence this time.
+    // This also avoids the deadlocks seen on OSX when the callback is invoked with the mutex held.
+    if (!m_mutex.tryLock())
+    {
+        memset(data, 0, maxLen);
+        return maxLen;
+    }
 
 	unsigned int framesPerBuffer = maxLen / 4;
 
 	if (framesPerBuffer == 0)
 	{
+	    m_mutex.unlock();
 		return 0;
 	}
 
@@ -181,6 +208,7 @@ qint64 AudioOutput::readData(char* data, qint64 maxLen)
 
 		if (m_mixBuffer.size() != framesPerBuffer * 2)
 		{
+		    m_mutex.unlock();
 			return 0;
 		}
 	}
@@ -192,67 +220,57 @@ qint64 AudioOutput::readData(char* data, qint64 maxLen)
 	for (AudioFifos::iterator it = m_audioFifos.begin(); it != m_audioFifos.end(); ++it)
 	{
 		// use outputBuffer as temp - yes, one memcpy could be saved
-		uint samples = (*it)->read((quint8*) data, framesPerBuffer, 1);
-		const qint16* src = (const qint16*) data;
-		std::vector<qint32>::iterator dst = m_mixBuffer.begin();
-
-//		if (samples != framesPerBuffer)
-//		{
-//            qDebug("AudioOutput::readData: read %d samples vs %d requested", samples, framesPerBuffer);
-//		}
-
-		for (uint i = 0; i < samples; i++)
-		{
-			*dst += *src;
-			++src;
-			++dst;
-			*dst += *src;
-			++src;
-			++dst;
-		}
+		uint samples = (*it)->read((quint8*) data, framesPerBuffer, 0);
+		mixAdd(&m_mixBuffer[0], (const qint16*) data, 2 * samples);
     }
-	// convert to int16
 
-	//std::vector<qint32>::const_iterator src = m_mixBuffer.begin(); // Valgrind optim
-	qint16* dst = (qint16*) data;
-	qint32 s;
-
-	for (uint i = 0; i < framesPerBuffer; i++)
-	{
-		// left channel
+	m_mutex.unlock();
 
-		//s = *src++; // Valgrind optim
-		s = m_mixBuffer[2*i];
+	// convert to int16 with saturation
+	mixToInt16((qint16*) data, &m_mixBuffer[0], 2 * framesPerBuffer);
 
-		if(s < -32768)
-		{
-			s = -32768;
-		}
-		else if (s > 32767)
-		{
-			s = 32767;
-		}
+	return framesPerBuffer * 4;
+}
 
-		*dst++ = s;
+void AudioOutput::mixAdd(qint32 *mix, const qint16 *src, unsigned int nbValues)
+{
+    unsigned int i = 0;
 
-		// right channel
+#if defined(USE_SSE2)
+    for (; i + 8 <= nbValues; i += 8)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) &src[i]);
+        // sign extend 16 to 32 bits: interleave with itself then shift right arithmetically
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_si128((__m128i*) &mix[i],   _mm_add_epi32(_mm_loadu_si128((const __m128i*) &mix[i]), lo));
+        _mm_storeu_si128((__m128i*) &mix[i+4], _mm_add_epi32(_mm_loadu_si128((const __m128i*) &mix[i+4]), hi));
+    }
+#endif
 
-		//s = *src++; // Valgrind optim
-		s = m_mixBuffer[2*i + 1];
+    for (; i < nbValues; i++) {
+        mix[i] += src[i];
+    }
+}
 
-		if(s < -32768)
-		{
-			s = -32768;
-		}
-		else if (s > 32767)
-		{
-			s = 32767;
-		}
+void AudioOutput::mixToInt16(qint16 *dst, const qint32 *mix, unsigned int nbValues)
+{
+    unsigned int i = 0;
 
-		*dst++ = s;
-	}
+#if defined(USE_SSE2)
+    for (; i + 8 <= nbValues; i += 8)
+    {
+        __m128i lo = _mm_loadu_si128((const __m128i*) &mix[i]);
+        __m128i hi = _mm_loadu_si128((const __m128i*) &mix[i+4]);
+        _mm_storeu_si128((__m128i*) &dst[i], _mm_packs_epi32(lo, hi)); // saturating pack
+    }
+#endif
 
-	return framesPerBuffer * 4;
+    for (; i < nbValues; i++)
+    {
+        qint32 s = mix[i];
+        dst[i] = s < -32768 ? -32768 : s > 32767 ? 32767 : s;
+    }
 }
 
 qint64 AudioOutput::writeData(const char* data, qint64 len)
@@ -31,6 +31,14 @@ class AudioOutputPipe;
 
 class SDRANGEL_API AudioOutput : QIODevice {
 public:
+	struct FifoStatus
+	{
+		uint32_t m_size;
+		uint32_t m_fill;
+		uint32_t m_underrunCount;
+		uint32_t m_overrunCount;
+	};
+
 	AudioOutput();
 	virtual ~AudioOutput();
 
@@ -39,12 +47,14 @@ public:
 
 	void addFifo(AudioFifo* audioFifo);
 	void removeFifo(AudioFifo* audioFifo);
+	void getFifoStatus(std::vector<FifoStatus>& fifoStatus); //!< snapshot of the FIFOs being mixed
 
 	uint getRate() const { return m_audioFormat.sampleRate(); }
 	void setOnExit(bool onExit) { m_onExit = onExit; }
 
 private:
 	QMutex m_mutex;
+	QMutex m_fifoListMutex; //!< Also held when the FIFO list changes so that it can be read without m_mutex that the audio callback needs
 	QAudioOutput* m_audioOutput;
 	uint m_audioUsageCount;
 	bool m_onExit;
@@ -59,6 +69,9 @@ private:
 	virtual qint64 readData(char* data, qint64 maxLen);
 	virtual qint64 writeData(const char* data, qint64 len);
 
+	static void mixAdd(qint32 *mix, const qint16 *src, unsigned int nbValues);        //!< accumulate a block of 16 bit samples into the 32 bit mix
+	static void mixToInt16(qint16 *dst, const qint32 *mix, unsigned int nbValues);    //!< convert the 32 bit mix to 16 bit samples with saturation
+
 	friend class AudioOutputPipe;
 };
 
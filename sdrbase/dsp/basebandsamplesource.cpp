@@ -15,6 +15,8 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "dsp/basebandsamplesource.h"
 #include "util/message.h"
 
@@ -43,17 +45,29 @@ void BasebandSampleSource::handleInputMessages()
 	}
 }
 
-void BasebandSampleSource::handleWriteToFifo(int nbSamples)
+void BasebandSampleSource::pullBlock(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+        pull(*begin);
+    }
+}
+
+void BasebandSampleSource::feed(SampleSourceFifo* sampleFifo, int nbSamples)
 {
     SampleVector::iterator writeAt;
-    m_sampleFifo.getWriteIterator(writeAt);
     pullAudio(nbSamples); // Pre-fetch input audio samples this is mandatory to keep things running smoothly
 
-    for (int i = 0; i < nbSamples; i++)
+    while (nbSamples > 0)
     {
-        pull((*writeAt));
-        m_sampleFifo.bumpIndex(writeAt);
+        sampleFifo->getWriteIterator(writeAt);
+        unsigned int nbContiguous = std::min((unsigned int) nbSamples, sampleFifo->getWriteContiguous());
+        pullBlock(writeAt, nbContiguous);
+        sampleFifo->bumpIndex(writeAt, nbContiguous);
+        nbSamples -= nbContiguous;
     }
 }
 
-
+void BasebandSampleSource::handleWriteToFifo(int nbSamples)
+{
+    feed(&m_sampleFifo, nbSamples);
+}
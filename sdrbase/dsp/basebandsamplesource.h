@@ -35,21 +35,11 @@ public:
 	virtual void start() = 0;
 	virtual void stop() = 0;
 	virtual void pull(Sample& sample) = 0;
+	virtual void pullBlock(SampleVector::iterator begin, unsigned int nbSamples); //!< Pull a block of samples. Default calls pull() for each sample.
 	virtual void pullAudio(int nbSamples __attribute__((unused))) {}
 
     /** direct feeding of sample source FIFO */
-	void feed(SampleSourceFifo* sampleFifo, int nbSamples)
-	{
-	    SampleVector::iterator writeAt;
-	    sampleFifo->getWriteIterator(writeAt);
-	    pullAudio(nbSamples); // Pre-fetch input audio samples this is mandatory to keep things running smoothly
-
-	    for (int i = 0; i < nbSamples; i++)
-	    {
-	        pull((*writeAt));
-	        sampleFifo->bumpIndex(writeAt);
-	    }
-	}
+	void feed(SampleSourceFifo* sampleFifo, int nbSamples);
 
 	SampleSourceFifo& getSampleSourceFifo() { return m_sampleFifo; }
 
@@ -0,0 +1,317 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <QDebug>
+#include "dsp/channelworkerpool.h"
+
+ChannelWorkerTask::ChannelWorkerTask() :
+    m_state(TaskDisabled),
+    m_lastWorker(-1)
+{
+}
+
+ChannelWorkerTask::~ChannelWorkerTask()
+{
+}
+
+ChannelWorkerPool::Worker::Worker(ChannelWorkerPool *pool, int index, int cpu) :
+    m_pool(pool),
+    m_index(index),
+    m_cpu(cpu)
+{
+    setObjectName(QString("ChannelWorker%1").arg(index));
+}
+
+bool ChannelWorkerPool::Worker::push(ChannelWorkerTask *task)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    // state is set and the task queued atomically with respect to disable() sweeping the deques
+    if (task->m_state.testAndSetOrdered(ChannelWorkerTask::TaskIdle, ChannelWorkerTask::TaskScheduled))
+    {
+        m_tasks.push_back(task);
+        m_pool->m_queued.fetchAndAddOrdered(1);
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+ChannelWorkerTask *ChannelWorkerPool::Worker::popFront()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    while (!m_tasks.empty())
+    {
+        ChannelWorkerTask *task = m_tasks.front();
+        m_tasks.pop_front();
+        m_pool->m_queued.fetchAndAddOrdered(-1);
+
+        // under the lock so that a task disabled meanwhile is not referenced after disable() returns
+        if (task->m_state.testAndSetOrdered(ChannelWorkerTask::TaskScheduled, ChannelWorkerTask::TaskRunning)) {
+            return task;
+        }
+    }
+
+    return 0;
+}
+
+ChannelWorkerTask *ChannelWorkerPool::Worker::stealBack()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    while (!m_tasks.empty())
+    {
+        ChannelWorkerTask *task = m_tasks.back();
+        m_tasks.pop_back();
+        m_pool->m_queued.fetchAndAddOrdered(-1);
+
+        if (task->m_state.testAndSetOrdered(ChannelWorkerTask::TaskScheduled, ChannelWorkerTask::TaskRunning)) {
+            return task;
+        }
+    }
+
+    return 0;
+}
+
+void ChannelWorkerPool::Worker::remove(ChannelWorkerTask *task)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    std::deque<ChannelWorkerTask*>::iterator it = m_tasks.begin();
+
+    while (it != m_tasks.end())
+    {
+        if (*it == task)
+        {
+            it = m_tasks.erase(it);
+            m_pool->m_queued.fetchAndAddOrdered(-1);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void ChannelWorkerPool::Worker::run()
+{
+    if (m_cpu >= 0)
+    {
+#if defined(__linux__)
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(m_cpu, &cpuSet);
+
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) != 0) {
+            qWarning("ChannelWorkerPool::Worker::run: worker %d: cannot pin to CPU %d", m_index, m_cpu);
+        }
+#else
+        qWarning("ChannelWorkerPool::Worker::run: worker %d: CPU pinning not supported on this system", m_index);
+#endif
+    }
+
+    while (!m_pool->m_stopping.loadAcquire())
+    {
+        ChannelWorkerTask *task = m_pool->takeTask(m_index);
+
+        if (task)
+        {
+            m_pool->runTask(task, m_index);
+            continue;
+        }
+
+        QMutexLocker mutexLocker(&m_pool->m_waitMutex);
+
+        if ((m_pool->m_queued.loadAcquire() == 0) && !m_pool->m_stopping.loadAcquire())
+        {
+            m_pool->m_idle.fetchAndAddOrdered(1);
+            m_pool->m_waitCondition.wait(&m_pool->m_waitMutex, 100);
+            m_pool->m_idle.fetchAndAddOrdered(-1);
+        }
+    }
+}
+
+ChannelWorkerPool::ChannelWorkerPool() :
+    m_running(false),
+    m_stopping(0),
+    m_nbWorkersConfigured(0),
+    m_pinWorkers(false),
+    m_nextWorker(0),
+    m_queued(0),
+    m_idle(0)
+{
+}
+
+ChannelWorkerPool::~ChannelWorkerPool()
+{
+    stop();
+}
+
+void ChannelWorkerPool::configure(int nbWorkers, bool pinWorkers)
+{
+    QMutexLocker mutexLocker(&m_startMutex);
+    m_nbWorkersConfigured = nbWorkers < 0 ? 0 : nbWorkers;
+    m_pinWorkers = pinWorkers;
+}
+
+void ChannelWorkerPool::start()
+{
+    QMutexLocker mutexLocker(&m_startMutex);
+
+    if (m_running) {
+        return;
+    }
+
+    int nbCores = QThread::idealThreadCount() < 1 ? 1 : QThread::idealThreadCount();
+    int nbWorkers = m_nbWorkersConfigured > 0 ? m_nbWorkersConfigured : nbCores;
+
+    m_stopping.storeRelease(0);
+
+    for (int i = 0; i < nbWorkers; i++) {
+        m_workers.push_back(new Worker(this, i, m_pinWorkers ? i % nbCores : -1));
+    }
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it) {
+        (*it)->start(QThread::HighPriority);
+    }
+
+    m_running = true;
+    qInfo("ChannelWorkerPool::start: %d channel workers%s", nbWorkers, m_pinWorkers ? " pinned to cores" : "");
+}
+
+void ChannelWorkerPool::stop()
+{
+    QMutexLocker mutexLocker(&m_startMutex);
+
+    if (!m_running) {
+        return;
+    }
+
+    m_stopping.storeRelease(1);
+
+    m_waitMutex.lock();
+    m_waitCondition.wakeAll();
+    m_waitMutex.unlock();
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        (*it)->wait();
+        delete *it;
+    }
+
+    m_workers.clear();
+    m_queued.storeRelease(0);
+    m_running = false;
+}
+
+void ChannelWorkerPool::enable(ChannelWorkerTask *task)
+{
+    task->m_state.testAndSetOrdered(ChannelWorkerTask::TaskDisabled, ChannelWorkerTask::TaskIdle);
+}
+
+void ChannelWorkerPool::schedule(ChannelWorkerTask *task)
+{
+    if (!m_running) {
+        return;
+    }
+
+    for (;;)
+    {
+        int state = task->m_state.loadAcquire();
+
+        if (state == ChannelWorkerTask::TaskIdle)
+        {
+            int workerIndex = task->m_lastWorker < 0 ?
+                    (m_nextWorker.fetchAndAddOrdered(1) & 0x7fffffff) % m_workers.size() :
+                    task->m_lastWorker;
+
+            if (m_workers[workerIndex]->push(task)) {
+                break;
+            }
+        }
+        else if (state == ChannelWorkerTask::TaskRunning)
+        {
+            if (task->m_state.testAndSetOrdered(ChannelWorkerTask::TaskRunning, ChannelWorkerTask::TaskRerun)) {
+                return;
+            }
+        }
+        else // already scheduled or disabled
+        {
+            return;
+        }
+    }
+
+    QMutexLocker mutexLocker(&m_waitMutex);
+
+    if (m_idle.loadAcquire() > 0) {
+        m_waitCondition.wakeOne();
+    }
+}
+
+void ChannelWorkerPool::disable(ChannelWorkerTask *task)
+{
+    for (;;)
+    {
+        int state = task->m_state.loadAcquire();
+
+        if (state == ChannelWorkerTask::TaskDisabled) {
+            break;
+        } else if ((state == ChannelWorkerTask::TaskIdle) || (state == ChannelWorkerTask::TaskScheduled)) {
+            if (task->m_state.testAndSetOrdered(state, ChannelWorkerTask::TaskDisabled)) {
+                break;
+            }
+        } else { // let the worker finish
+            QThread::usleep(100);
+        }
+    }
+
+    for (std::vector<Worker*>::iterator it = m_workers.begin(); it != m_workers.end(); ++it) {
+        (*it)->remove(task);
+    }
+}
+
+ChannelWorkerTask *ChannelWorkerPool::takeTask(int workerIndex)
+{
+    ChannelWorkerTask *task = m_workers[workerIndex]->popFront();
+    int nbWorkers = m_workers.size();
+
+    for (int i = 1; (task == 0) && (i < nbWorkers); i++) {
+        task = m_workers[(workerIndex + i) % nbWorkers]->stealBack();
+    }
+
+    return task;
+}
+
+void ChannelWorkerPool::runTask(ChannelWorkerTask *task, int workerIndex)
+{
+    task->m_lastWorker = workerIndex;
+    task->run();
+
+    // scheduled again while running: only this worker can leave the rerun state
+    while (!task->m_state.testAndSetOrdered(ChannelWorkerTask::TaskRunning, ChannelWorkerTask::TaskIdle))
+    {
+        task->m_state.storeRelease(ChannelWorkerTask::TaskRunning);
+        task->run();
+    }
+}
@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_DSP_CHANNELWORKERPOOL_H_
+#define SDRBASE_DSP_CHANNELWORKERPOOL_H_
+
+#include <deque>
+#include <vector>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThread>
+
+#include "util/export.h"
+
+/**
+ * Unit of work run by the channel worker pool. A task is never run by two workers at the same time
+ * and scheduling it again while it runs makes it run once more when it completes.
+ */
+class SDRANGEL_API ChannelWorkerTask
+{
+public:
+    ChannelWorkerTask();
+    virtual ~ChannelWorkerTask();
+    virtual void run() = 0;
+
+private:
+    enum State
+    {
+        TaskIdle,       //!< not queued
+        TaskScheduled,  //!< queued in a worker deque
+        TaskRunning,    //!< being run by a worker
+        TaskRerun,      //!< scheduled again while running
+        TaskDisabled    //!< cannot be scheduled
+    };
+
+    QAtomicInt m_state;
+    int m_lastWorker;   //!< worker that last ran the task. It is queued there first to keep caches warm.
+
+    friend class ChannelWorkerPool;
+};
+
+/**
+ * Fixed size pool of threads running the baseband processing of the channels. Each worker has its own
+ * deque of scheduled tasks and steals from the others when it runs out.
+ */
+class SDRANGEL_API ChannelWorkerPool
+{
+public:
+    ChannelWorkerPool();
+    ~ChannelWorkerPool();
+
+    void configure(int nbWorkers, bool pinWorkers); //!< 0 workers means one per core. Applies at next start.
+    void start();
+    void stop();
+    bool isRunning() const { return m_running; }
+    int getNbWorkers() const { return m_workers.size(); }
+
+    void enable(ChannelWorkerTask *task);   //!< Allow task to be scheduled
+    void schedule(ChannelWorkerTask *task); //!< Queue task for a run. Called from any thread.
+    void disable(ChannelWorkerTask *task);  //!< Unqueue task and wait until it is not running. Task is not referenced by the pool on return.
+
+private:
+    class Worker : public QThread
+    {
+    public:
+        Worker(ChannelWorkerPool *pool, int index, int cpu);
+        bool push(ChannelWorkerTask *task); //!< Queue an idle task. False if it is not idle anymore.
+        ChannelWorkerTask *popFront();
+        ChannelWorkerTask *stealBack();
+        void remove(ChannelWorkerTask *task);
+
+    protected:
+        void run();
+
+    private:
+        ChannelWorkerPool *m_pool;
+        int m_index;
+        int m_cpu; //!< -1 if not pinned
+        QMutex m_mutex;
+        std::deque<ChannelWorkerTask*> m_tasks;
+    };
+
+    void runTask(ChannelWorkerTask *task, int workerIndex);
+    ChannelWorkerTask *takeTask(int workerIndex);
+
+    std::vector<Worker*> m_workers;
+    QMutex m_startMutex;
+    bool m_running;
+    QAtomicInt m_stopping;
+    int m_nbWorkersConfigured;
+    bool m_pinWorkers;
+    QAtomicInt m_nextWorker;  //!< round robin for tasks that never ran
+    QAtomicInt m_queued;      //!< number of tasks in all deques
+    QAtomicInt m_idle;        //!< number of workers waiting
+    QMutex m_waitMutex;
+    QWaitCondition m_waitCondition;
+};
+
+#endif /* SDRBASE_DSP_CHANNELWORKERPOOL_H_ */
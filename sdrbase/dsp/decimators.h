@@ -18,11 +18,15 @@
 #define INCLUDE_GPL_DSP_DECIMATORS_H_
 
 #include "dsp/dsptypes.h"
-#ifdef USE_SSE4_1
+#if defined(USE_SSE4_1) || defined(USE_SIMD_DISPATCH)
 #include "dsp/inthalfbandfiltereo1.h"
 #else
 #include "dsp/inthalfbandfilterdb.h"
 #endif
+#if defined(USE_SIMD_DISPATCH)
+#include <vector>
+#include "dsp/decimatorsavx2.h"
+#endif
 
 #define DECIMATORS_HB_FILTER_ORDER 64
 
@@ -102,6 +106,8 @@ template<typename T, uint SdrBits, uint InputBits>
 class Decimators
 {
 public:
+    Decimators();
+
     // interleaved I/Q input buffer
 	void decimate1(SampleVector::iterator* it, const T* buf, qint32 len);
 	void decimate2_u(SampleVector::iterator* it, const T* buf, qint32 len);
@@ -146,7 +152,7 @@ public:
     void decimate64_cen(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len);
 
 private:
-#ifdef USE_SSE4_1
+#if defined(USE_SSE4_1) || defined(USE_SIMD_DISPATCH)
     IntHalfbandFilterEO1<DECIMATORS_HB_FILTER_ORDER> m_decimator2;  // 1st stages
     IntHalfbandFilterEO1<DECIMATORS_HB_FILTER_ORDER> m_decimator4;  // 2nd stages
     IntHalfbandFilterEO1<DECIMATORS_HB_FILTER_ORDER> m_decimator8;  // 3rd stages
@@ -161,8 +167,84 @@ private:
 	IntHalfbandFilterDB<DECIMATORS_HB_FILTER_ORDER> m_decimator32; // 5th stages
 	IntHalfbandFilterDB<DECIMATORS_HB_FILTER_ORDER> m_decimator64; // 6th stages
 #endif
+#if defined(USE_SIMD_DISPATCH)
+    bool m_avx2;                    //!< AVX2 front end selected at runtime
+    std::vector<qint32> m_rotated;  //!< 4x rotated and decimated I/Q fed to the half band stages
+
+    template<int NbStages>
+    void decimateRotatedAVX2(SampleVector::iterator* it, const T* buf, qint32 len, bool sup, uint pre, uint post);
+#endif
 };
 
+template<typename T, uint SdrBits, uint InputBits>
+Decimators<T, SdrBits, InputBits>::Decimators()
+#if defined(USE_SIMD_DISPATCH)
+    : m_avx2(SIMDDispatch::hasAVX2())
+#endif
+{
+}
+
+#if defined(USE_SIMD_DISPATCH)
+/**
+ * Infradyne or supradyne decimation by 8 to 64 (nbStages 1 to 4 half band stages after the 4x rotation).
+ * The rotation of the whole buffer is done first with AVX2 then the half band stages are run in the
+ * same order as in the scalar versions.
+ */
+template<typename T, uint SdrBits, uint InputBits>
+template<int NbStages>
+void Decimators<T, SdrBits, InputBits>::decimateRotatedAVX2(SampleVector::iterator* it, const T* buf, qint32 len, bool sup, uint pre, uint post)
+{
+    IntHalfbandFilterEO1<DECIMATORS_HB_FILTER_ORDER> *stages[4] = {&m_decimator2, &m_decimator4, &m_decimator8, &m_decimator16};
+    const int blockSize = 1 << NbStages; // rotated samples per output sample
+    int count = len < 0 ? 0 : (len / (8*blockSize)) * (8*blockSize);
+
+    if (m_rotated.size() < (unsigned int) count / 4) {
+        m_rotated.resize(count / 4);
+    }
+
+    qint32 *rotated = m_rotated.data();
+    int pos = DecimatorsAVX2::rotate4(buf, count, sup, pre, rotated);
+
+    for (qint32 *r = &rotated[pos/4]; pos < count; pos += 8, r += 2)
+    {
+        if (sup)
+        {
+            r[0] = (buf[pos+1] - buf[pos+2] - buf[pos+5] + buf[pos+6]) << pre;
+            r[1] = (buf[pos+4] + buf[pos+7] - buf[pos+0] - buf[pos+3]) << pre;
+        }
+        else
+        {
+            r[0] = (buf[pos+0] - buf[pos+3] + buf[pos+7] - buf[pos+4]) << pre;
+            r[1] = (buf[pos+1] - buf[pos+5] + buf[pos+2] - buf[pos+6]) << pre;
+        }
+    }
+
+    qint32 xreal[16], yimag[16];
+
+    for (int i = 0; i < count / 4; i += 2*blockSize)
+    {
+        for (int j = 0; j < blockSize; j++)
+        {
+            xreal[j] = rotated[i + 2*j];
+            yimag[j] = rotated[i + 2*j + 1];
+        }
+
+        for (int stage = 0; stage < NbStages; stage++)
+        {
+            int step = 1 << stage;
+
+            for (int j = 0; j < blockSize; j += 2*step) {
+                stages[stage]->myDecimate(xreal[j+step-1], yimag[j+step-1], &xreal[j+2*step-1], &yimag[j+2*step-1]);
+            }
+        }
+
+        (**it).setReal(xreal[blockSize-1] >> post);
+        (**it).setImag(yimag[blockSize-1] >> post);
+        ++(*it);
+    }
+}
+#endif
+
 template<typename T, uint SdrBits, uint InputBits>
 void Decimators<T, SdrBits, InputBits>::decimate1(SampleVector::iterator* it, const T* buf, qint32 len)
 {
@@ -242,7 +324,15 @@ void Decimators<T, SdrBits, InputBits>::decimate2_inf(SampleVector::iterator* it
 {
 	qint32 xreal, yimag;
 
-	for (int pos = 0; pos < len - 7; pos += 8)
+	int pos = 0;
+
+#if defined(USE_SIMD_DISPATCH)
+	if (m_avx2) {
+		pos = DecimatorsAVX2::decimate2(it, buf, len, false, decimation_shifts<SdrBits, InputBits>::pre2, decimation_shifts<SdrBits, InputBits>::post2);
+	}
+#endif
+
+	for (; pos < len - 7; pos += 8)
 	{
 		xreal = (buf[pos+0] - buf[pos+3]) << decimation_shifts<SdrBits, InputBits>::pre2;
 		yimag = (buf[pos+1] + buf[pos+2]) << decimation_shifts<SdrBits, InputBits>::pre2;
@@ -286,7 +376,15 @@ void Decimators<T, SdrBits, InputBits>::decimate2_sup(SampleVector::iterator* it
 {
 	qint32 xreal, yimag;
 
-	for (int pos = 0; pos < len - 7; pos += 8)
+	int pos = 0;
+
+#if defined(USE_SIMD_DISPATCH)
+	if (m_avx2) {
+		pos = DecimatorsAVX2::decimate2(it, buf, len, true, decimation_shifts<SdrBits, InputBits>::pre2, decimation_shifts<SdrBits, InputBits>::post2);
+	}
+#endif
+
+	for (; pos < len - 7; pos += 8)
 	{
 		xreal = (buf[pos+1] - buf[pos+2]) << decimation_shifts<SdrBits, InputBits>::pre2;
 		yimag = (- buf[pos+0] - buf[pos+3]) << decimation_shifts<SdrBits, InputBits>::pre2;
@@ -330,7 +428,15 @@ void Decimators<T, SdrBits, InputBits>::decimate4_inf(SampleVector::iterator* it
 {
 	qint32 xreal, yimag;
 
-	for (int pos = 0; pos < len - 7; pos += 8)
+	int pos = 0;
+
+#if defined(USE_SIMD_DISPATCH)
+	if (m_avx2) {
+		pos = DecimatorsAVX2::decimate4(it, buf, len, false, decimation_shifts<SdrBits, InputBits>::pre4, decimation_shifts<SdrBits, InputBits>::post4);
+	}
+#endif
+
+	for (; pos < len - 7; pos += 8)
 	{
 		xreal = (buf[pos+0] - buf[pos+3] + buf[pos+7] - buf[pos+4]) << decimation_shifts<SdrBits, InputBits>::pre4;
 		yimag = (buf[pos+1] - buf[pos+5] + buf[pos+2] - buf[pos+6]) << decimation_shifts<SdrBits, InputBits>::pre4;
@@ -370,7 +476,15 @@ void Decimators<T, SdrBits, InputBits>::decimate4_sup(SampleVector::iterator* it
 	// [ rotate:  0, 1, -3, 2, -4, -5, 7, -6]
 	qint32 xreal, yimag;
 
-	for (int pos = 0; pos < len - 7; pos += 8)
+	int pos = 0;
+
+#if defined(USE_SIMD_DISPATCH)
+	if (m_avx2) {
+		pos = DecimatorsAVX2::decimate4(it, buf, len, true, decimation_shifts<SdrBits, InputBits>::pre4, decimation_shifts<SdrBits, InputBits>::post4);
+	}
+#endif
+
+	for (; pos < len - 7; pos += 8)
 	{
 		xreal = (buf[pos+1] - buf[pos+2] - buf[pos+5] + buf[pos+6]) << decimation_shifts<SdrBits, InputBits>::pre4;
 		yimag = (- buf[pos+0] - buf[pos+3] + buf[pos+4] + buf[pos+7]) << decimation_shifts<SdrBits, InputBits>::pre4;
@@ -402,6 +516,14 @@ void Decimators<T, SdrBits, InputBits>::decimate4_sup(SampleVector::iterator* it
 template<typename T, uint SdrBits, uint InputBits>
 void Decimators<T, SdrBits, InputBits>::decimate8_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#if defined(USE_SIMD_DISPATCH)
+	if (m_avx2)
+	{
+		decimateRotatedAVX2<1>(it, buf, len, false, decimation_shifts<SdrBits, InputBits>::pre8, decimation_shifts<SdrBits, InputBits>::post8);
+		return;
+	}
+#endif
+
 	qint32 xreal[2], yimag[2];
 
 	for (int pos = 0; pos < len - 15; pos += 8)
@@ -448,6 +570,14 @@ void Decimators<T, SdrBits, InputBits>::decimate8_inf(SampleVector::iterator* it
 template<typename T, uint SdrBits, uint InputBits>
 void Decimators<T, SdrBits, InputBits>::decimate8_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#if defined(USE_SIMD_DISPATCH)
+	if (m_avx2)
+	{
+		decimateRotatedAVX2<1>(it, buf, len, true, decimation_shifts<SdrBits, InputBits>::pre8, decimation_shifts<SdrBits, InputBits>::post8);
+		return;
+	}
+#endif
+
 	qint32 xreal[2], yimag[2];
 
 	for (int pos = 0; pos < len - 15; pos += 8)
@@ -494,6 +624,14 @@ void Decimators<T, SdrBits, InputBits>::decimate8_sup(SampleVector::iterator* it
 template<typename T, uint SdrBits, uint InputBits>
 void Decimators<T, SdrBits, InputBits>::decimate16_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#if defined(USE_SIMD_DISPATCH)
+	if (m_avx2)
+	{
+		decimateRotatedAVX2<2>(it, buf, len, false, decimation_shifts<SdrBits, InputBits>::pre16, decimation_shifts<SdrBits, InputBits>::post16);
+		return;
+	}
+#endif
+
 	// Offset tuning: 4x downsample and rotate, then
 	// downsample 4x more. [ rotate:  0, 1, -3, 2, -4, -5, 7, -6]
 	qint32 xreal[4], yimag[4];
@@ -550,6 +688,14 @@ void Decimators<T, SdrBits, InputBits>::decimate16_inf(SampleVector::iterator* i
 template<typename T, uint SdrBits, uint InputBits>
 void Decimators<T, SdrBits, InputBits>::decimate16_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#if defined(USE_SIMD_DISPATCH)
+	if (m_avx2)
+	{
+		decimateRotatedAVX2<2>(it, buf, len, true, decimation_shifts<SdrBits, InputBits>::pre16, decimation_shifts<SdrBits, InputBits>::post16);
+		return;
+	}
+#endif
+
 	// Offset tuning: 4x downsample and rotate, then
 	// downsample 4x more. [ rotate:  1, 0, -2, 3, -5, -4, 6, -7]
 	qint32 xreal[4], yimag[4];
@@ -606,6 +752,14 @@ void Decimators<T, SdrBits, InputBits>::decimate16_sup(SampleVector::iterator* i
 template<typename T, uint SdrBits, uint InputBits>
 void Decimators<T, SdrBits, InputBits>::decimate32_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#if defined(USE_SIMD_DISPATCH)
+	if (m_avx2)
+	{
+		decimateRotatedAVX2<3>(it, buf, len, false, decimation_shifts<SdrBits, InputBits>::pre32, decimation_shifts<SdrBits, InputBits>::post32);
+		return;
+	}
+#endif
+
 	qint32 xreal[8], yimag[8];
 
 	for (int pos = 0; pos < len - 63; )
@@ -668,6 +822,14 @@ void Decimators<T, SdrBits, InputBits>::decimate32_inf(SampleVector::iterator* i
 template<typename T, uint SdrBits, uint InputBits>
 void Decimators<T, SdrBits, InputBits>::decimate32_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#if defined(USE_SIMD_DISPATCH)
+	if (m_avx2)
+	{
+		decimateRotatedAVX2<3>(it, buf, len, true, decimation_shifts<SdrBits, InputBits>::pre32, decimation_shifts<SdrBits, InputBits>::post32);
+		return;
+	}
+#endif
+
 	qint32 xreal[8], yimag[8];
 
 	for (int pos = 0; pos < len - 63; )
@@ -730,6 +892,14 @@ void Decimators<T, SdrBits, InputBits>::decimate32_sup(SampleVector::iterator* i
 template<typename T, uint SdrBits, uint InputBits>
 void Decimators<T, SdrBits, InputBits>::decimate64_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#if defined(USE_SIMD_DISPATCH)
+	if (m_avx2)
+	{
+		decimateRotatedAVX2<4>(it, buf, len, false, decimation_shifts<SdrBits, InputBits>::pre64, decimation_shifts<SdrBits, InputBits>::post64);
+		return;
+	}
+#endif
+
 	qint32 xreal[16], yimag[16];
 
 	for (int pos = 0; pos < len - 127; )
@@ -810,6 +980,14 @@ void Decimators<T, SdrBits, InputBits>::decimate64_inf(SampleVector::iterator* i
 template<typename T, uint SdrBits, uint InputBits>
 void Decimators<T, SdrBits, InputBits>::decimate64_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+#if defined(USE_SIMD_DISPATCH)
+	if (m_avx2)
+	{
+		decimateRotatedAVX2<4>(it, buf, len, true, decimation_shifts<SdrBits, InputBits>::pre32, decimation_shifts<SdrBits, InputBits>::post64);
+		return;
+	}
+#endif
+
 	qint32 xreal[16], yimag[16];
 
 	for (int pos = 0; pos < len - 127; )
@@ -0,0 +1,172 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_DSP_DECIMATORSAVX2_H_
+#define SDRBASE_DSP_DECIMATORSAVX2_H_
+
+#if defined(USE_SIMD_DISPATCH)
+
+#include <immintrin.h>
+#include "dsp/dsptypes.h"
+#include "dsp/simddispatch.h"
+
+/**
+ * AVX2 front end of the Decimators infradyne and supradyne paths on interleaved I/Q buffers.
+ *
+ * Each group of 8 input values (4 complex samples) is rotated by Fs/4 and summed pairwise (2x) or
+ * completely (4x). The sums of several groups are done at once with horizontal adds. All arithmetic
+ * is done on 32 bit integers like the scalar code so the results are the same bit for bit. Functions
+ * process whole blocks of groups only and return the number of input values consumed so that the
+ * caller finishes the remainder with the scalar code.
+ */
+class DecimatorsAVX2
+{
+public:
+    /** 2x: two samples per group, 4 groups per step. Advances the output iterator. */
+    template<typename T>
+    SIMD_TARGET("avx2")
+    static int decimate2(SampleVector::iterator* it, const T* buf, int len, bool sup, int pre, int post)
+    {
+        const __m256i sign = signs(sup);
+        const __m256i perm = permutation(sup);
+        const __m128i preCount = _mm_cvtsi32_si128(pre);
+        const __m128i postCount = _mm_cvtsi32_si128(post);
+        Sample *out = &(**it);
+        int pos = 0;
+
+        for (; pos < len - 31; pos += 32)
+        {
+            __m256i h01 = _mm256_hadd_epi32(rotate(load8(&buf[pos]), sign, perm), rotate(load8(&buf[pos+8]), sign, perm));
+            __m256i h23 = _mm256_hadd_epi32(rotate(load8(&buf[pos+16]), sign, perm), rotate(load8(&buf[pos+24]), sign, perm));
+            store(out, h01, h23, preCount, postCount);
+            out += 8;
+        }
+
+        *it += pos / 4;
+        return pos;
+    }
+
+    /** 4x: one sample per group, 8 groups per step. Advances the output iterator. */
+    template<typename T>
+    SIMD_TARGET("avx2")
+    static int decimate4(SampleVector::iterator* it, const T* buf, int len, bool sup, int pre, int post)
+    {
+        const __m128i preCount = _mm_cvtsi32_si128(pre);
+        const __m128i postCount = _mm_cvtsi32_si128(post);
+        Sample *out = &(**it);
+        int pos = 0;
+
+        for (; pos < len - 63; pos += 64)
+        {
+            __m256i h0123, h4567;
+            sum4(&buf[pos], sup, h0123, h4567);
+            store(out, h0123, h4567, preCount, postCount);
+            out += 8;
+        }
+
+        *it += pos / 8;
+        return pos;
+    }
+
+    /** 4x for the following half band stages: writes shifted interleaved I/Q 32 bit values to out */
+    template<typename T>
+    SIMD_TARGET("avx2")
+    static int rotate4(const T* buf, int len, bool sup, int pre, qint32 *out)
+    {
+        const __m128i preCount = _mm_cvtsi32_si128(pre);
+        int pos = 0;
+
+        for (; pos < len - 63; pos += 64)
+        {
+            __m256i h0123, h4567;
+            sum4(&buf[pos], sup, h0123, h4567);
+            __m256i x = _mm256_sll_epi32(_mm256_permute2x128_si256(h0123, h4567, 0x20), preCount);
+            __m256i y = _mm256_sll_epi32(_mm256_permute2x128_si256(h0123, h4567, 0x31), preCount);
+            __m256i lo = _mm256_unpacklo_epi32(x, y); // x0 y0 x1 y1 | x4 y4 x5 y5
+            __m256i hi = _mm256_unpackhi_epi32(x, y); // x2 y2 x3 y3 | x6 y6 x7 y7
+            _mm256_storeu_si256((__m256i*) out, _mm256_permute2x128_si256(lo, hi, 0x20));
+            _mm256_storeu_si256((__m256i*) (out + 8), _mm256_permute2x128_si256(lo, hi, 0x31));
+            out += 16;
+        }
+
+        return pos;
+    }
+
+private:
+    SIMD_TARGET("avx2")
+    static inline __m256i load8(const qint8 *p) {
+        return _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*) p));
+    }
+
+    SIMD_TARGET("avx2")
+    static inline __m256i load8(const quint8 *p) {
+        return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*) p));
+    }
+
+    SIMD_TARGET("avx2")
+    static inline __m256i load8(const qint16 *p) {
+        return _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*) p));
+    }
+
+    // Inf: x -> 0,-3,-4,7 y -> 1,2,-5,-6 / Sup: x -> 1,-2,-5,6 y -> -0,-3,4,7
+    SIMD_TARGET("avx2")
+    static inline __m256i signs(bool sup)
+    {
+        return sup ? _mm256_setr_epi32(-1, 1, -1, -1, 1, -1, 1, 1) : _mm256_setr_epi32(1, 1, 1, -1, -1, -1, -1, 1);
+    }
+
+    // x terms of the two half band outputs in the low lane, y terms in the high lane
+    SIMD_TARGET("avx2")
+    static inline __m256i permutation(bool sup)
+    {
+        return sup ? _mm256_setr_epi32(1, 2, 6, 5, 0, 3, 4, 7) : _mm256_setr_epi32(0, 3, 7, 4, 1, 2, 5, 6);
+    }
+
+    SIMD_TARGET("avx2")
+    static inline __m256i rotate(__m256i group, __m256i sign, __m256i perm) {
+        return _mm256_permutevar8x32_epi32(_mm256_sign_epi32(group, sign), perm);
+    }
+
+    // 8 groups: x0..x3 | y0..y3 in h0123 and x4..x7 | y4..y7 in h4567
+    template<typename T>
+    SIMD_TARGET("avx2")
+    static inline void sum4(const T* buf, bool sup, __m256i& h0123, __m256i& h4567)
+    {
+        const __m256i sign = signs(sup);
+        const __m256i perm = permutation(sup);
+        __m256i h01 = _mm256_hadd_epi32(rotate(load8(&buf[0]), sign, perm), rotate(load8(&buf[8]), sign, perm));
+        __m256i h23 = _mm256_hadd_epi32(rotate(load8(&buf[16]), sign, perm), rotate(load8(&buf[24]), sign, perm));
+        __m256i h45 = _mm256_hadd_epi32(rotate(load8(&buf[32]), sign, perm), rotate(load8(&buf[40]), sign, perm));
+        __m256i h67 = _mm256_hadd_epi32(rotate(load8(&buf[48]), sign, perm), rotate(load8(&buf[56]), sign, perm));
+        h0123 = _mm256_hadd_epi32(h01, h23);
+        h4567 = _mm256_hadd_epi32(h45, h67);
+    }
+
+    // Shift and truncate to 16 bits the same way as setReal / setImag do then store 8 samples
+    SIMD_TARGET("avx2")
+    static inline void store(Sample *out, __m256i a, __m256i b, __m128i preCount, __m128i postCount)
+    {
+        __m256i x = _mm256_sra_epi32(_mm256_sll_epi32(_mm256_permute2x128_si256(a, b, 0x20), preCount), postCount);
+        __m256i y = _mm256_sra_epi32(_mm256_sll_epi32(_mm256_permute2x128_si256(a, b, 0x31), preCount), postCount);
+        __m256i s = _mm256_or_si256(_mm256_and_si256(x, _mm256_set1_epi32(0xFFFF)), _mm256_slli_epi32(y, 16));
+        _mm256_storeu_si256((__m256i*) out, s);
+    }
+};
+
+#endif // USE_SIMD_DISPATCH
+
+#endif /* SDRBASE_DSP_DECIMATORSAVX2_H_ */
@@ -25,6 +25,11 @@
 #include "util/messagequeue.h"
 #include "util/export.h"
 
+namespace Swagger
+{
+    class SWGDeviceReport;
+}
+
 class SDRANGEL_API DeviceSampleSource : public QObject {
 	Q_OBJECT
 public:
@@ -41,6 +46,12 @@ public:
 
 	virtual bool handleMessage(const Message& message) = 0;
 
+	/** Fill the web API run time report of the device. Returns the Http status code (default 501: not implemented) */
+	virtual int webapiReportGet(
+	        Swagger::SWGDeviceReport& response __attribute__((unused)),
+	        QString& errorMessage __attribute__((unused)))
+	{ return 501; }
+
 	MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; }
 	virtual void setMessageQueueToGUI(MessageQueue *queue) { m_guiMessageQueue = queue; }
 	MessageQueue *getMessageQueueToGUI() { return m_guiMessageQueue; }
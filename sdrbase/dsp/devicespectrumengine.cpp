@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QDebug>
+
+#include "dsp/spectrumengine.h"
+#include "dsp/threadedbasebandsamplesink.h"
+#include "dsp/dspdevicesourceengine.h"
+#include "devicespectrumengine.h"
+
+DeviceSpectrumEngine::DeviceSpectrumEngine(DSPDeviceSourceEngine *deviceSourceEngine, bool enabled) :
+    m_deviceSourceEngine(deviceSourceEngine),
+    m_threadedSpectrumEngine(0)
+{
+    SpectrumEngine::Settings settings;
+    settings.m_enabled = enabled;
+    m_spectrumEngine = new SpectrumEngine(settings);
+    updateAttachment();
+}
+
+DeviceSpectrumEngine::~DeviceSpectrumEngine()
+{
+    if (m_threadedSpectrumEngine)
+    {
+        m_deviceSourceEngine->removeThreadedSink(m_threadedSpectrumEngine);
+        delete m_threadedSpectrumEngine;
+    }
+
+    delete m_spectrumEngine;
+}
+
+int DeviceSpectrumEngine::webapiFrameGet(Swagger::SWGSpectrumFrame& response, QString& errorMessage)
+{
+    return m_spectrumEngine->webapiFrameGet(response, errorMessage);
+}
+
+int DeviceSpectrumEngine::webapiSettingsPatch(const QStringList& settingsKeys, Swagger::SWGSpectrumSettings& response, QString& errorMessage)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    int status = m_spectrumEngine->webapiSettingsPatch(settingsKeys, response, errorMessage);
+
+    if (status == 200) {
+        updateAttachment();
+    }
+
+    return status;
+}
+
+void DeviceSpectrumEngine::updateAttachment()
+{
+    bool enabled = m_spectrumEngine->getSettings().m_enabled;
+
+    if (enabled && !m_threadedSpectrumEngine)
+    {
+        qDebug("DeviceSpectrumEngine::updateAttachment: attach");
+        m_threadedSpectrumEngine = new ThreadedBasebandSampleSink(m_spectrumEngine);
+        m_deviceSourceEngine->addThreadedSink(m_threadedSpectrumEngine);
+    }
+    else if (!enabled && m_threadedSpectrumEngine)
+    {
+        qDebug("DeviceSpectrumEngine::updateAttachment: detach");
+        m_deviceSourceEngine->removeThreadedSink(m_threadedSpectrumEngine);
+        delete m_threadedSpectrumEngine;
+        m_threadedSpectrumEngine = 0;
+    }
+}
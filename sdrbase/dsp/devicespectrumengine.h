@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_DSP_DEVICESPECTRUMENGINE_H_
+#define SDRBASE_DSP_DEVICESPECTRUMENGINE_H_
+
+#include <QMutex>
+
+#include "util/export.h"
+
+class QString;
+class QStringList;
+class SpectrumEngine;
+class ThreadedBasebandSampleSink;
+class DSPDeviceSourceEngine;
+
+namespace Swagger {
+    class SWGSpectrumFrame;
+    class SWGSpectrumSettings;
+}
+
+/**
+ * Spectrum engine of an Rx device set as controlled by the web API. The engine only gets samples
+ * while it is enabled: its threaded sink is attached to the device engine when it is enabled and
+ * detached when it is disabled so that a disabled engine costs nothing to the baseband.
+ */
+class SDRANGEL_API DeviceSpectrumEngine
+{
+public:
+    DeviceSpectrumEngine(DSPDeviceSourceEngine *deviceSourceEngine, bool enabled);
+    ~DeviceSpectrumEngine(); //!< Detaches from the device engine that must still exist
+
+    int webapiFrameGet(Swagger::SWGSpectrumFrame& response, QString& errorMessage);
+    int webapiSettingsPatch(const QStringList& settingsKeys, Swagger::SWGSpectrumSettings& response, QString& errorMessage);
+
+private:
+    DSPDeviceSourceEngine *m_deviceSourceEngine;
+    SpectrumEngine *m_spectrumEngine;
+    ThreadedBasebandSampleSink *m_threadedSpectrumEngine; //!< only while the engine is enabled
+    QMutex m_mutex; //!< web API requests can be served concurrently
+
+    void updateAttachment(); //!< Attach or detach following the enabled setting
+};
+
+#endif /* SDRBASE_DSP_DEVICESPECTRUMENGINE_H_ */
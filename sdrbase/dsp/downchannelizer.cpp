@@ -25,6 +25,7 @@
 MESSAGE_CLASS_DEFINITION(DownChannelizer::MsgChannelizerNotification, Message)
 
 DownChannelizer::DownChannelizer(BasebandSampleSink* sampleSink) :
+	m_configPending(0),
 	m_sampleSink(sampleSink),
 	m_inputSampleRate(0),
 	m_requestedOutputSampleRate(0),
@@ -38,7 +39,8 @@ DownChannelizer::DownChannelizer(BasebandSampleSink* sampleSink) :
 
 DownChannelizer::~DownChannelizer()
 {
-	freeFilterChain();
+	freeFilterChain(m_filterStages);
+	freeFilterChain(m_pendingFilterStages);
 }
 
 void DownChannelizer::configure(MessageQueue* messageQueue, int sampleRate, int centerFrequency)
@@ -50,46 +52,60 @@ void DownChannelizer::configure(MessageQueue* messageQueue, int sampleRate, int
 void DownChannelizer::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly)
 {
 	if(m_sampleSink == 0) {
-		m_sampleBuffer.clear();
 		return;
 	}
 
+	if (m_configPending.loadAcquire()) {
+		applyPendingFilterChain();
+	}
+
 	if (m_filterStages.size() == 0) // optimization when no downsampling is done anyway
 	{
 		m_sampleSink->feed(begin, end, positiveOnly);
 	}
 	else
 	{
-		m_mutex.lock();
+		unsigned int count = end - begin;
 
-		for(SampleVector::const_iterator sample = begin; sample != end; ++sample)
-		{
-			Sample s(*sample);
-			FilterStages::iterator stage = m_filterStages.begin();
-
-			for (; stage != m_filterStages.end(); ++stage)
-			{
-				if(!(*stage)->work(&s))
-				{
-					break;
-				}
-			}
-
-			if(stage == m_filterStages.end())
-			{
-			    s.m_real /= (1<<(m_filterStages.size()));
-			    s.m_imag /= (1<<(m_filterStages.size()));
-				m_sampleBuffer.push_back(s);
-			}
+		if (count == 0) {
+			return;
 		}
 
-		m_mutex.unlock();
+		// first stage can output at most one sample more than half the input (odd count with pending sample)
+		if (m_sampleBuffer.size() < count / 2 + 1) {
+			m_sampleBuffer.resize(count / 2 + 1);
+		}
+
+		// run each stage over the whole block. Subsequent stages work in place.
+		Sample *buffer = &m_sampleBuffer[0];
+		FilterStages::iterator stage = m_filterStages.begin();
+		count = (*stage)->workBlock(&(*begin), count, buffer);
+
+		for (++stage; (stage != m_filterStages.end()) && (count > 0); ++stage) {
+			count = (*stage)->workBlock(buffer, count, buffer);
+		}
+
+		int divisor = 1 << m_filterStages.size();
+
+		for (unsigned int i = 0; i < count; i++)
+		{
+			buffer[i].m_real /= divisor;
+			buffer[i].m_imag /= divisor;
+		}
 
-		m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), positiveOnly);
-		m_sampleBuffer.clear();
+		m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.begin() + count, positiveOnly);
 	}
 }
 
+void DownChannelizer::applyPendingFilterChain()
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	freeFilterChain(m_filterStages);
+	m_filterStages.swap(m_pendingFilterStages);
+	m_configPending.storeRelease(0);
+}
+
 void DownChannelizer::start()
 {
 	if (m_sampleSink != 0)
@@ -164,20 +180,23 @@ void DownChannelizer::applyConfiguration()
 		return;
 	}
 
-	m_mutex.lock();
-
-	freeFilterChain();
+	// the new chain is built aside and picked up by feed() at the start of next block
+	FilterStages filterStages;
 
-	m_currentCenterFrequency = createFilterChain(
+	m_currentCenterFrequency = createFilterChain(filterStages,
 		m_inputSampleRate / -2, m_inputSampleRate / 2,
 		m_requestedCenterFrequency - m_requestedOutputSampleRate / 2, m_requestedCenterFrequency + m_requestedOutputSampleRate / 2);
 
+	m_currentOutputSampleRate = m_inputSampleRate / (1 << filterStages.size());
+
+	m_mutex.lock();
+	freeFilterChain(m_pendingFilterStages);
+	m_pendingFilterStages.swap(filterStages);
+	m_configPending.storeRelease(1);
 	m_mutex.unlock();
 
 	//debugFilterChain();
 
-	m_currentOutputSampleRate = m_inputSampleRate / (1 << m_filterStages.size());
-
 	qDebug() << "DownChannelizer::applyConfiguration in=" << m_inputSampleRate
 			<< ", req=" << m_requestedOutputSampleRate
 			<< ", out=" << m_currentOutputSampleRate
@@ -190,47 +209,19 @@ void DownChannelizer::applyConfiguration()
 	}
 }
 
-#ifdef USE_SSE4_1
+#if defined(USE_SSE4_1) || defined(USE_SIMD_DISPATCH)
 DownChannelizer::FilterStage::FilterStage(Mode mode) :
 	m_filter(new IntHalfbandFilterEO1<DOWNCHANNELIZER_HB_FILTER_ORDER>),
-	m_workFunction(0),
 	m_mode(mode),
 	m_sse(true)
 {
-	switch(mode) {
-		case ModeCenter:
-			m_workFunction = &IntHalfbandFilterEO1<DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateCenter;
-			break;
-
-		case ModeLowerHalf:
-			m_workFunction = &IntHalfbandFilterEO1<DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateLowerHalf;
-			break;
-
-		case ModeUpperHalf:
-			m_workFunction = &IntHalfbandFilterEO1<DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateUpperHalf;
-			break;
-	}
 }
 #else
 DownChannelizer::FilterStage::FilterStage(Mode mode) :
 	m_filter(new IntHalfbandFilterDB<DOWNCHANNELIZER_HB_FILTER_ORDER>),
-	m_workFunction(0),
 	m_mode(mode),
 	m_sse(false)
 {
-	switch(mode) {
-		case ModeCenter:
-			m_workFunction = &IntHalfbandFilterDB<DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateCenter;
-			break;
-
-		case ModeLowerHalf:
-			m_workFunction = &IntHalfbandFilterDB<DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateLowerHalf;
-			break;
-
-		case ModeUpperHalf:
-			m_workFunction = &IntHalfbandFilterDB<DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateUpperHalf;
-			break;
-	}
 }
 #endif
 
@@ -249,7 +240,7 @@ bool DownChannelizer::signalContainsChannel(Real sigStart, Real sigEnd, Real cha
 	return (sigStart <= chanStart) && (sigEnd >= chanEnd);
 }
 
-Real DownChannelizer::createFilterChain(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd)
+Real DownChannelizer::createFilterChain(FilterStages& filterStages, Real sigStart, Real sigEnd, Real chanStart, Real chanEnd)
 {
 	Real sigBw = sigEnd - sigStart;
 	Real safetyMargin = sigBw / 20;
@@ -263,24 +254,24 @@ Real DownChannelizer::createFilterChain(Real sigStart, Real sigEnd, Real chanSta
 	// check if it fits into the left half
 	if(signalContainsChannel(sigStart + safetyMargin, sigStart + sigBw / 2.0 - safetyMargin, chanStart, chanEnd)) {
 		//fprintf(stderr, "-> take left half (rotate by +1/4 and decimate by 2)\n");
-		m_filterStages.push_back(new FilterStage(FilterStage::ModeLowerHalf));
-		return createFilterChain(sigStart, sigStart + sigBw / 2.0, chanStart, chanEnd);
+		filterStages.push_back(new FilterStage(FilterStage::ModeLowerHalf));
+		return createFilterChain(filterStages, sigStart, sigStart + sigBw / 2.0, chanStart, chanEnd);
 	}
 
 	// check if it fits into the right half
 	if(signalContainsChannel(sigEnd - sigBw / 2.0f + safetyMargin, sigEnd - safetyMargin, chanStart, chanEnd)) {
 		//fprintf(stderr, "-> take right half (rotate by -1/4 and decimate by 2)\n");
-		m_filterStages.push_back(new FilterStage(FilterStage::ModeUpperHalf));
-		return createFilterChain(sigEnd - sigBw / 2.0f, sigEnd, chanStart, chanEnd);
+		filterStages.push_back(new FilterStage(FilterStage::ModeUpperHalf));
+		return createFilterChain(filterStages, sigEnd - sigBw / 2.0f, sigEnd, chanStart, chanEnd);
 	}
 
 	// check if it fits into the center
 	// Was: if(signalContainsChannel(sigStart + rot + safetyMargin, sigStart + rot + sigBw / 2.0f - safetyMargin, chanStart, chanEnd)) {
 	if(signalContainsChannel(sigStart + rot + safetyMargin, sigEnd - rot - safetyMargin, chanStart, chanEnd)) {
 		//fprintf(stderr, "-> take center half (decimate by 2)\n");
-		m_filterStages.push_back(new FilterStage(FilterStage::ModeCenter));
+		filterStages.push_back(new FilterStage(FilterStage::ModeCenter));
 		// Was: return createFilterChain(sigStart + rot, sigStart + sigBw / 2.0f + rot, chanStart, chanEnd);
-		return createFilterChain(sigStart + rot, sigEnd - rot, chanStart, chanEnd);
+		return createFilterChain(filterStages, sigStart + rot, sigEnd - rot, chanStart, chanEnd);
 	}
 #endif
 	Real ofs = ((chanEnd - chanStart) / 2.0 + chanStart) - ((sigEnd - sigStart) / 2.0 + sigStart);
@@ -288,11 +279,11 @@ Real DownChannelizer::createFilterChain(Real sigStart, Real sigEnd, Real chanSta
 	return ofs;
 }
 
-void DownChannelizer::freeFilterChain()
+void DownChannelizer::freeFilterChain(FilterStages& filterStages)
 {
-	for(FilterStages::iterator it = m_filterStages.begin(); it != m_filterStages.end(); ++it)
+	for(FilterStages::iterator it = filterStages.begin(); it != filterStages.end(); ++it)
 		delete *it;
-	m_filterStages.clear();
+	filterStages.clear();
 }
 
 void DownChannelizer::debugFilterChain()
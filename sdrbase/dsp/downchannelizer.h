@@ -19,11 +19,12 @@
 #define SDRBASE_DSP_DOWNCHANNELIZER_H
 
 #include <dsp/basebandsamplesink.h>
-#include <list>
+#include <vector>
 #include <QMutex>
+#include <QAtomicInt>
 #include "util/export.h"
 #include "util/message.h"
-#ifdef USE_SSE4_1
+#if defined(USE_SSE4_1) || defined(USE_SIMD_DISPATCH)
 #include "dsp/inthalfbandfiltereo1.h"
 #else
 #include "dsp/inthalfbandfilterdb.h"
@@ -73,40 +74,68 @@ protected:
 			ModeUpperHalf
 		};
 
-#ifdef USE_SSE4_1
-		typedef bool (IntHalfbandFilterEO1<DOWNCHANNELIZER_HB_FILTER_ORDER>::*WorkFunction)(Sample* s);
-		IntHalfbandFilterEO1<DOWNCHANNELIZER_HB_FILTER_ORDER>* m_filter;
+#if defined(USE_SSE4_1) || defined(USE_SIMD_DISPATCH)
+		typedef IntHalfbandFilterEO1<DOWNCHANNELIZER_HB_FILTER_ORDER> HBFilter;
 #else
-		typedef bool (IntHalfbandFilterDB<DOWNCHANNELIZER_HB_FILTER_ORDER>::*WorkFunction)(Sample* s);
-		IntHalfbandFilterDB<DOWNCHANNELIZER_HB_FILTER_ORDER>* m_filter;
+		typedef IntHalfbandFilterDB<DOWNCHANNELIZER_HB_FILTER_ORDER> HBFilter;
 #endif
-		WorkFunction m_workFunction;
+		HBFilter* m_filter;
 		Mode m_mode;
 		bool m_sse;
 
 		FilterStage(Mode mode);
 		~FilterStage();
 
-		bool work(Sample* sample)
+		/** Decimate a block of samples. Output may overwrite input (out <= in). Returns the number of output samples. */
+		unsigned int workBlock(const Sample* in, unsigned int count, Sample* out)
 		{
-			return (m_filter->*m_workFunction)(sample);
+			switch (m_mode)
+			{
+			case ModeLowerHalf:
+				return workBlockMode<&HBFilter::workDecimateLowerHalf>(in, count, out);
+			case ModeUpperHalf:
+				return workBlockMode<&HBFilter::workDecimateUpperHalf>(in, count, out);
+			case ModeCenter:
+			default:
+				return workBlockMode<&HBFilter::workDecimateCenter>(in, count, out);
+			}
+		}
+
+		template<bool (HBFilter::*WorkFunction)(Sample*)>
+		unsigned int workBlockMode(const Sample* in, unsigned int count, Sample* out)
+		{
+			unsigned int nbOut = 0;
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+				Sample s(in[i]);
+
+				if ((m_filter->*WorkFunction)(&s)) {
+					out[nbOut++] = s;
+				}
+			}
+
+			return nbOut;
 		}
 	};
-	typedef std::list<FilterStage*> FilterStages;
-	FilterStages m_filterStages;
+	typedef std::vector<FilterStage*> FilterStages;
+	FilterStages m_filterStages;        //!< Filter chain used by feed()
+	FilterStages m_pendingFilterStages; //!< New filter chain waiting to be picked up by feed() between blocks
+	QAtomicInt m_configPending;         //!< Set when m_pendingFilterStages holds a new chain
 	BasebandSampleSink* m_sampleSink; //!< Demodulator
 	int m_inputSampleRate;
 	int m_requestedOutputSampleRate;
 	int m_requestedCenterFrequency;
 	int m_currentOutputSampleRate;
 	int m_currentCenterFrequency;
-	SampleVector m_sampleBuffer;
-	QMutex m_mutex;
+	SampleVector m_sampleBuffer; //!< Work buffer grown to the largest block seen and reused in place by all stages
+	QMutex m_mutex;              //!< Protects m_pendingFilterStages
 
 	void applyConfiguration();
+	void applyPendingFilterChain();
 	bool signalContainsChannel(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd) const;
-	Real createFilterChain(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd);
-	void freeFilterChain();
+	Real createFilterChain(FilterStages& filterStages, Real sigStart, Real sigEnd, Real chanStart, Real chanEnd);
+	void freeFilterChain(FilterStages& filterStages);
 	void debugFilterChain();
 
 signals:
@@ -16,6 +16,10 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <stdio.h>
+#include <algorithm>
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
 #include <QDebug>
 #include <QThread>
 
@@ -38,7 +42,8 @@ DSPDeviceSinkEngine::DSPDeviceSinkEngine(uint32_t uid, QObject* parent) :
 	m_spectrumSink(0),
 	m_sampleRate(0),
 	m_centerFrequency(0),
-	m_multipleSourcesDivisionFactor(1)
+	m_multipleSourcesDivisionShift(0),
+	m_multipleSourcesMode(false)
 {
 	connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()), Qt::QueuedConnection);
 	connect(&m_syncMessenger, SIGNAL(messageSent()), this, SLOT(handleSynchronousMessages()), Qt::QueuedConnection);
@@ -171,6 +176,7 @@ QString DSPDeviceSinkEngine::sinkDeviceDescription()
 
 void DSPDeviceSinkEngine::work(int nbWriteSamples)
 {
+	QMutexLocker mutexLocker(&m_sourcesMutex);
 	SampleSourceFifo* sampleFifo = m_deviceSampleSink->getSampleFifo();
 	//unsigned int nbWriteSamples = sampleFifo->getChunkSize();
 
@@ -191,77 +197,13 @@ void DSPDeviceSinkEngine::work(int nbWriteSamples)
 	// multiple channel sources handling
 	else if ((m_threadedBasebandSampleSources.size() + m_basebandSampleSources.size()) > 1)
 	{
-//	    qDebug("DSPDeviceSinkEngine::work: multiple channel sources handling: %u", m_multipleSourcesDivisionFactor);
-
-//        SampleVector::iterator writeBegin;
-//        sampleFifo->getWriteIterator(writeBegin);
-//        SampleVector::iterator writeAt = writeBegin;
-//	    Sample s;
-//	    int sourceOccurence = 0;
-//
-//	    // Read a chunk of data from the sources
-//
-//	    for (ThreadedBasebandSampleSources::iterator it = m_threadedBasebandSampleSources.begin(); it != m_threadedBasebandSampleSources.end(); ++it)
-//	    {
-//	        ((*it)->getSampleSourceFifo()).readAdvance(m_threadedBasebandSampleSourcesIteratorMap[*it], nbWriteSamples);
-//	        m_threadedBasebandSampleSourcesIteratorMap[*it] -= nbWriteSamples;
-//	    }
-//
-//        for (BasebandSampleSources::iterator it = m_basebandSampleSources.begin(); it != m_basebandSampleSources.end(); ++it)
-//        {
-//            ((*it)->getSampleSourceFifo()).readAdvance(m_basebandSampleSourcesIteratorMap[*it], nbWriteSamples);
-//            m_basebandSampleSourcesIteratorMap[*it] -= nbWriteSamples;
-//        }
-//
-//        // Process sample by sample
-//
-//        for (int is = 0; is < nbWriteSamples; is++)
-//        {
-//            // pull data from threaded sources and merge them in the device sample FIFO
-//            for (ThreadedBasebandSampleSources::iterator it = m_threadedBasebandSampleSources.begin(); it != m_threadedBasebandSampleSources.end(); ++it)
-//            {
-//                s = *m_threadedBasebandSampleSourcesIteratorMap[*it];
-//                s /= (m_threadedBasebandSampleSources.size() + m_basebandSampleSources.size());
-//
-//                if (sourceOccurence == 0) {
-//                    (*writeAt) = s;
-//                } else {
-//                    (*writeAt) += s;
-//                }
-//
-//                sourceOccurence++;
-//                m_threadedBasebandSampleSourcesIteratorMap[*it]++;
-//            }
-//
-//            // pull data from direct sources and merge them in the device sample FIFO
-//            for (BasebandSampleSources::iterator it = m_basebandSampleSources.begin(); it != m_basebandSampleSources.end(); ++it)
-//            {
-//                s = *m_basebandSampleSourcesIteratorMap[*it];
-//                s /= (m_threadedBasebandSampleSources.size() + m_basebandSampleSources.size());
-//
-//                if (sourceOccurence == 0) {
-//                    (*writeAt) = s;
-//                } else {
-//                    (*writeAt) += s;
-//                }
-//
-//                sourceOccurence++;
-//                m_basebandSampleSourcesIteratorMap[*it]++;
-//            }
-//
-//            sampleFifo->bumpIndex(writeAt);
-//            sourceOccurence = 0;
-//        }
-
-	    SampleVector::iterator writeBegin;
-	    sampleFifo->getWriteIterator(writeBegin);
-	    SampleVector::iterator writeAt = writeBegin;
-	    Sample s;
-	    int sourceOccurence = 0;
+	    SampleVector::iterator writeAt;
+	    int nbRemaining = nbWriteSamples;
 
+	    // threaded sources have produced their blocks ahead in their own thread and pre-fetch their audio there
 	    for (ThreadedBasebandSampleSources::iterator it = m_threadedBasebandSampleSources.begin(); it != m_threadedBasebandSampleSources.end(); ++it)
 	    {
-	        (*it)->pullAudio(nbWriteSamples);
+	        (*it)->readBlock(m_threadedBasebandSampleSourcesIteratorMap[*it], nbWriteSamples);
 	    }
 
 	    for (BasebandSampleSources::iterator it = m_basebandSampleSources.begin(); it != m_basebandSampleSources.end(); ++it)
@@ -269,48 +211,123 @@ void DSPDeviceSinkEngine::work(int nbWriteSamples)
 	        (*it)->pullAudio(nbWriteSamples);
 	    }
 
-	    for (int is = 0; is < nbWriteSamples; is++)
-		{
-			// pull data from threaded sources and merge them in the device sample FIFO
-			for (ThreadedBasebandSampleSources::iterator it = m_threadedBasebandSampleSources.begin(); it != m_threadedBasebandSampleSources.end(); ++it)
-			{
-				(*it)->pull(s);
-				s /= m_multipleSourcesDivisionFactor;
-
-				if (sourceOccurence == 0) {
-				    (*writeAt) = s;
-				} else {
-	                (*writeAt) += s;
-				}
+	    if (m_sourceSampleBuffer.size() < (unsigned int) nbWriteSamples) {
+	        m_sourceSampleBuffer.resize(nbWriteSamples);
+	    }
 
-				sourceOccurence++;
-			}
+	    // merge the blocks in the device sample FIFO one contiguous segment at a time
+	    while (nbRemaining > 0)
+	    {
+	        sampleFifo->getWriteIterator(writeAt);
+	        unsigned int nbContiguous = std::min((unsigned int) nbRemaining, sampleFifo->getWriteContiguous());
+	        bool firstSource = true;
+
+	        for (ThreadedBasebandSampleSources::iterator it = m_threadedBasebandSampleSources.begin(); it != m_threadedBasebandSampleSources.end(); ++it)
+	        {
+	            SampleVector::iterator& readAt = m_threadedBasebandSampleSourcesIteratorMap[*it];
+	            mixSourceBlock(writeAt, readAt, nbContiguous, firstSource);
+	            readAt += nbContiguous;
+	            firstSource = false;
+	        }
+
+	        for (BasebandSampleSources::iterator it = m_basebandSampleSources.begin(); it != m_basebandSampleSources.end(); ++it)
+	        {
+	            if (firstSource) // pulled directly in the device FIFO and scaled in place
+	            {
+	                (*it)->pullBlock(writeAt, nbContiguous);
+	                mixSourceBlock(writeAt, writeAt, nbContiguous, true);
+	            }
+	            else
+	            {
+	                (*it)->pullBlock(m_sourceSampleBuffer.begin(), nbContiguous);
+	                mixSourceBlock(writeAt, m_sourceSampleBuffer.begin(), nbContiguous, false);
+	            }
+
+	            firstSource = false;
+	        }
+
+	        sampleFifo->bumpIndex(writeAt, nbContiguous);
+	        nbRemaining -= nbContiguous;
+	    }
+	}
+}
 
-			// pull data from direct sources and merge them in the device sample FIFO
-			for (BasebandSampleSources::iterator it = m_basebandSampleSources.begin(); it != m_basebandSampleSources.end(); ++it)
-			{
-				(*it)->pull(s);
-				s /= m_multipleSourcesDivisionFactor;
+void DSPDeviceSinkEngine::updateMultipleSources()
+{
+	uint32_t nbSources = m_basebandSampleSources.size() + m_threadedBasebandSampleSources.size();
+	bool multipleSourcesMode = nbSources > 1;
 
-                if (sourceOccurence == 0) {
-                    (*writeAt) = s;
-                } else {
-                    (*writeAt) += s;
-                }
+	if (nbSources < 2) {
+	    m_multipleSourcesDivisionShift = 0;
+	} else if (nbSources < 3) {
+	    m_multipleSourcesDivisionShift = 1;
+	} else {
+	    m_multipleSourcesDivisionShift = nbSources;
+	}
 
-                sourceOccurence++;
-			}
+	if ((multipleSourcesMode != m_multipleSourcesMode) && (m_state == StRunning))
+	{
+	    qDebug("DSPDeviceSinkEngine::updateMultipleSources: switch to %s source mode", multipleSourcesMode ? "multiple" : "single");
 
-			sampleFifo->bumpIndex(writeAt);
-            sourceOccurence = 0;
-		}
+	    // Stop the producers first so that no fill of the previous mode is pending when the engine pulls the
+	    // sources directly, then reset the FIFOs so that samples produced for the previous mode are not delivered.
+	    for (ThreadedBasebandSampleSources::const_iterator it = m_threadedBasebandSampleSources.begin(); it != m_threadedBasebandSampleSources.end(); ++it) {
+	        (*it)->stop();
+	    }
 
-		// feed the mix to the main spectrum sink
-//		if (m_spectrumSink)
-//		{
-//			m_spectrumSink->feed(writeBegin, writeBegin + nbWriteSamples, false);
-//		}
+	    for (ThreadedBasebandSampleSources::const_iterator it = m_threadedBasebandSampleSources.begin(); it != m_threadedBasebandSampleSources.end(); ++it)
+	    {
+	        (*it)->getSampleSourceFifo().init();
+	        (*it)->start();
+	    }
 	}
+
+	m_multipleSourcesMode = multipleSourcesMode;
+}
+
+void DSPDeviceSinkEngine::mixSourceBlock(SampleVector::iterator writeAt, SampleVector::const_iterator readAt, unsigned int nbSamples, bool firstSource)
+{
+    // Samples are handled as an array of I/Q interleaved 16 bit integers. Scaling is a shift as the division factor is a power of two.
+    qint16 *out = &writeAt->m_real;
+    const qint16 *in = &readAt->m_real;
+    unsigned int nbValues = 2*nbSamples;
+    unsigned int i = 0;
+
+#if defined(USE_SSE2)
+    __m128i shift = _mm_cvtsi32_si128(m_multipleSourcesDivisionShift);
+
+    if (firstSource)
+    {
+        for (; i + 8 <= nbValues; i += 8)
+        {
+            __m128i v = _mm_sra_epi16(_mm_loadu_si128((const __m128i*) &in[i]), shift);
+            _mm_storeu_si128((__m128i*) &out[i], v);
+        }
+    }
+    else
+    {
+        for (; i + 8 <= nbValues; i += 8)
+        {
+            __m128i v = _mm_sra_epi16(_mm_loadu_si128((const __m128i*) &in[i]), shift);
+            _mm_storeu_si128((__m128i*) &out[i], _mm_adds_epi16(_mm_loadu_si128((const __m128i*) &out[i]), v));
+        }
+    }
+#endif
+
+    if (firstSource)
+    {
+        for (; i < nbValues; i++) {
+            out[i] = in[i] >> m_multipleSourcesDivisionShift;
+        }
+    }
+    else
+    {
+        for (; i < nbValues; i++)
+        {
+            int v = out[i] + (in[i] >> m_multipleSourcesDivisionShift);
+            out[i] = v < -32768 ? -32768 : v > 32767 ? 32767 : v;
+        }
+    }
 }
 
 // notStarted -> idle -> init -> running -+
@@ -456,29 +473,20 @@ DSPDeviceSinkEngine::State DSPDeviceSinkEngine::gotoRunning()
 		return gotoError("DSPDeviceSinkEngine::gotoRunning: Could not start sample source");
 	}
 
-	uint32_t nbSources = m_basebandSampleSources.size() + m_threadedBasebandSampleSources.size();
-
-	if (nbSources == 0) {
-	    m_multipleSourcesDivisionFactor = 1;
-	} else if (nbSources < 3) {
-	    m_multipleSourcesDivisionFactor = nbSources;
-	} else {
-	    m_multipleSourcesDivisionFactor = 1<<nbSources;
-	}
+	m_sourcesMutex.lock();
+	updateMultipleSources(); // not running yet: only sets the mode
+	m_sourcesMutex.unlock();
 
 	for(BasebandSampleSources::const_iterator it = m_basebandSampleSources.begin(); it != m_basebandSampleSources.end(); it++)
 	{
         qDebug() << "DSPDeviceSinkEngine::gotoRunning: starting " << (*it)->objectName().toStdString().c_str();
-        // not used with sample by sample processing
-//        (*it)->getSampleSourceFifo().resize(2*m_deviceSampleSink->getSampleFifo()->size()); // Equalize channel source FIFO size with device sink FIFO size
 		(*it)->start();
 	}
 
 	for (ThreadedBasebandSampleSources::const_iterator it = m_threadedBasebandSampleSources.begin(); it != m_threadedBasebandSampleSources.end(); ++it)
 	{
 		qDebug() << "DSPDeviceSinkEngine::gotoRunning: starting ThreadedSampleSource(" << (*it)->getSampleSourceObjectName().toStdString().c_str() << ")";
-        // not used with sample by sample processing
-//		(*it)->getSampleSourceFifo().resize(2*m_deviceSampleSink->getSampleFifo()->size()); // Equalize channel source FIFO size with device sink FIFO size
+		(*it)->getSampleSourceFifo().resize(m_deviceSampleSink->getSampleFifo()->size()); // Equalize channel source FIFO size with device sink FIFO size
 		(*it)->start();
 	}
 
@@ -587,45 +595,47 @@ void DSPDeviceSinkEngine::handleSynchronousMessages()
 	else if (DSPAddSource::match(*message))
 	{
 		BasebandSampleSource* source = ((DSPAddSource*) message)->getSampleSource();
+		QMutexLocker mutexLocker(&m_sourcesMutex);
 		m_basebandSampleSources.push_back(source);
-        // not used with sample by sample processing
-//		BasebandSampleSourcesIteratorMapKV kv;
-//		kv.first = source;
-//		(source->getSampleSourceFifo()).getReadIterator(kv.second);
-//		m_basebandSampleSourcesIteratorMap.insert(kv);
+		updateMultipleSources();
 	}
 	else if (DSPRemoveSource::match(*message))
 	{
 		BasebandSampleSource* source = ((DSPRemoveSource*) message)->getSampleSource();
+		QMutexLocker mutexLocker(&m_sourcesMutex);
 
 		if(m_state == StRunning) {
 			source->stop();
 		}
 
-        // not used with sample by sample processing
-//		m_basebandSampleSourcesIteratorMap.erase(source);
 		m_basebandSampleSources.remove(source);
+		updateMultipleSources();
 	}
 	else if (DSPAddThreadedSampleSource::match(*message))
 	{
 		ThreadedBasebandSampleSource *threadedSource = ((DSPAddThreadedSampleSource*) message)->getThreadedSampleSource();
+		QMutexLocker mutexLocker(&m_sourcesMutex);
 		m_threadedBasebandSampleSources.push_back(threadedSource);
-        // not used with sample by sample processing
-//        ThreadedBasebandSampleSourcesIteratorMapKV kv;
-//        kv.first = threadedSource;
-//        (threadedSource->getSampleSourceFifo()).getReadIterator(kv.second);
-//        m_threadedBasebandSampleSourcesIteratorMap.insert(kv);
-//		threadedSource->start();
+		m_threadedBasebandSampleSourcesIteratorMap.insert(ThreadedBasebandSampleSourcesIteratorMapKV(threadedSource, SampleVector::iterator()));
+
+		if (m_state == StRunning)
+		{
+		    threadedSource->getSampleSourceFifo().resize(m_deviceSampleSink->getSampleFifo()->size());
+		    threadedSource->start();
+		}
+
+		updateMultipleSources();
 	}
 	else if (DSPRemoveThreadedSampleSource::match(*message))
 	{
 		ThreadedBasebandSampleSource* threadedSource = ((DSPRemoveThreadedSampleSource*) message)->getThreadedSampleSource();
+		QMutexLocker mutexLocker(&m_sourcesMutex);
 		if (m_state == StRunning) {
 		    threadedSource->stop();
 		}
-        // not used with sample by sample processing
-//		m_threadedBasebandSampleSourcesIteratorMap.erase(threadedSource);
+		m_threadedBasebandSampleSourcesIteratorMap.erase(threadedSource);
 		m_threadedBasebandSampleSources.remove(threadedSource);
+		updateMultipleSources();
 	}
 
 	m_syncMessenger.done(m_state);
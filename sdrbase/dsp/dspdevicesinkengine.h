@@ -114,10 +114,15 @@ private:
 
 	uint32_t m_sampleRate;
 	quint64 m_centerFrequency;
-	uint32_t m_multipleSourcesDivisionFactor;
+	uint32_t m_multipleSourcesDivisionShift; //!< sources are scaled by 2^shift before merge
+	bool m_multipleSourcesMode;              //!< threaded sources produce ahead in their FIFO and are merged
+	QMutex m_sourcesMutex;                   //!< serializes the sources work with the changes of sources and mode
+	SampleVector m_sourceSampleBuffer; //!< block pulled from the second and next sources before merge
 
 	void run();
 	void work(int nbWriteSamples); //!< transfer samples from beseband sources to sink if in running state
+	void updateMultipleSources(); //!< Update the division and switch the single or multiple sources mode. Sources mutex must be held.
+	void mixSourceBlock(SampleVector::iterator writeAt, SampleVector::const_iterator readAt, unsigned int nbSamples, bool firstSource); //!< scale and merge one source block in the FIFO segment
 
 	State gotoIdle();     //!< Go to the idle state
 	State gotoInit();     //!< Go to the acquisition init state from idle
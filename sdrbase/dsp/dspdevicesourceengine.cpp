@@ -33,15 +33,11 @@ DSPDeviceSourceEngine::DSPDeviceSourceEngine(uint uid, QObject* parent) :
 	m_deviceSampleSource(0),
 	m_sampleSourceSequence(0),
 	m_basebandSampleSinks(),
+	m_basebandFifo(1<<20),
 	m_sampleRate(0),
 	m_centerFrequency(0),
-	m_dcOffsetCorrection(false),
-	m_iqImbalanceCorrection(false),
-	m_iOffset(0),
-	m_qOffset(0),
-	m_iRange(1 << 16),
-	m_qRange(1 << 16),
-	m_imbalance(65536)
+	m_correctionInAcquisition(false),
+	m_correctionInFifo(false)
 {
 	connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()), Qt::QueuedConnection);
 	connect(&m_syncMessenger, SIGNAL(messageSent()), this, SLOT(handleSynchronousMessages()), Qt::QueuedConnection);
@@ -103,9 +99,9 @@ void DSPDeviceSourceEngine::stopAcquistion()
 	m_syncMessenger.storeMessage(cmd);
 	handleSynchronousMessages();
 
-	if(m_dcOffsetCorrection)
+	if(m_iqCorrection.isEnabled())
 	{
-		qDebug("DC offset:%f,%f", m_iOffset, m_qOffset);
+		qDebug("DC offset:%f,%f", m_iqCorrection.getIOffset(), m_iqCorrection.getQOffset());
 	}
 }
 
@@ -173,76 +169,6 @@ QString DSPDeviceSourceEngine::sourceDeviceDescription()
 	return cmd.getDeviceDescription();
 }
 
-void DSPDeviceSourceEngine::dcOffset(SampleVector::iterator begin, SampleVector::iterator end)
-{
-	double count;
-	int io = 0;
-	int qo = 0;
-	Sample corr((qint16)m_iOffset, (qint16)m_qOffset);
-
-	// sum and correct in one pass
-	for(SampleVector::iterator it = begin; it < end; it++)
-	{
-		io += it->real();
-		qo += it->imag();
-		*it -= corr;
-	}
-
-	// moving average
-	count = end - begin;
-	m_iOffset = (15.0 * m_iOffset + (double)io / count) / 16.0;
-	m_qOffset = (15.0 * m_qOffset + (double)qo / count) / 16.0;
-}
-
-void DSPDeviceSourceEngine::imbalance(SampleVector::iterator begin, SampleVector::iterator end)
-{
-	int iMin = 0;
-	int iMax = 0;
-	int qMin = 0;
-	int qMax = 0;
-
-	// find value ranges for both I and Q
-	// both intervals should be same same size (for a perfect circle)
-	for (SampleVector::iterator it = begin; it < end; it++)
-	{
-		if (it != begin)
-		{
-			if (it->real() < iMin) {
-				iMin = it->real();
-			} else if (it->real() > iMax) {
-				iMax = it->real();
-			}
-
-			if (it->imag() < qMin) {
-				qMin = it->imag();
-			} else if (it->imag() > qMax) {
-				qMax = it->imag();
-			}
-		}
-		else
-		{
-			iMin = it->real();
-			iMax = it->real();
-			qMin = it->imag();
-			qMax = it->imag();
-		}
-	}
-
-	// sliding average (el cheapo again)
-	m_iRange = (m_iRange * 15 + (iMax - iMin)) >> 4;
-	m_qRange = (m_qRange * 15 + (qMax - qMin)) >> 4;
-
-	// calculate imbalance as Q15.16
-	if(m_qRange != 0) {
-		m_imbalance = ((uint)m_iRange << 16) / (uint)m_qRange;
-	}
-
-	// correct imbalance and convert back to signed int 16
-	for(SampleVector::iterator it = begin; it < end; it++) {
-		it->m_imag = (it->m_imag * m_imbalance) >> 16;
-	}
-}
-
 void DSPDeviceSourceEngine::work()
 {
 	SampleSinkFifo* sampleFifo = m_deviceSampleSource->getSampleFifo();
@@ -261,15 +187,10 @@ void DSPDeviceSourceEngine::work()
 		// first part of FIFO data
 		if (part1begin != part1end)
 		{
-			// correct stuff
-			if (m_dcOffsetCorrection)
-			{
-				dcOffset(part1begin, part1end);
-			}
-
-			if (m_iqImbalanceCorrection)
+			// correct stuff unless already done by the source FIFO writer
+			if (!m_correctionInFifo)
 			{
-				imbalance(part1begin, part1end);
+				m_iqCorrection.process(part1begin, part1end);
 			}
 
 			// feed data to direct sinks
@@ -278,25 +199,20 @@ void DSPDeviceSourceEngine::work()
 				(*it)->feed(part1begin, part1end, positiveOnly);
 			}
 
-			// feed data to threaded sinks
-			for (ThreadedBasebandSampleSinks::const_iterator it = m_threadedBasebandSampleSinks.begin(); it != m_threadedBasebandSampleSinks.end(); ++it)
+			// write data once for all threaded sinks
+			if (m_threadedBasebandSampleSinks.size() > 0)
 			{
-				(*it)->feed(part1begin, part1end, positiveOnly);
+				m_basebandFifo.write(part1begin, part1end);
 			}
 		}
 
 		// second part of FIFO data (used when block wraps around)
 		if(part2begin != part2end)
 		{
-			// correct stuff
-			if (m_dcOffsetCorrection)
+			// correct stuff unless already done by the source FIFO writer
+			if (!m_correctionInFifo)
 			{
-				dcOffset(part2begin, part2end);
-			}
-
-			if (m_iqImbalanceCorrection)
-			{
-				imbalance(part2begin, part2end);
+				m_iqCorrection.process(part2begin, part2end);
 			}
 
 			// feed data to direct sinks
@@ -305,13 +221,19 @@ void DSPDeviceSourceEngine::work()
 				(*it)->feed(part2begin, part2end, positiveOnly);
 			}
 
-			// feed data to threaded sinks
-			for (ThreadedBasebandSampleSinks::const_iterator it = m_threadedBasebandSampleSinks.begin(); it != m_threadedBasebandSampleSinks.end(); ++it)
+			// write data once for all threaded sinks
+			if (m_threadedBasebandSampleSinks.size() > 0)
 			{
-				(*it)->feed(part2begin, part2end, positiveOnly);
+				m_basebandFifo.write(part2begin, part2end);
 			}
 		}
 
+		// notify threaded sinks
+		for (ThreadedBasebandSampleSinks::const_iterator it = m_threadedBasebandSampleSinks.begin(); it != m_threadedBasebandSampleSinks.end(); ++it)
+		{
+			(*it)->feed();
+		}
+
 		// adjust FIFO pointers
 		sampleFifo->readCommit((unsigned int) count);
 		samplesDone += count;
@@ -357,6 +279,8 @@ DSPDeviceSourceEngine::State DSPDeviceSourceEngine::gotoIdle()
     }
 
 	m_deviceSampleSource->stop();
+	m_deviceSampleSource->getSampleFifo()->setCorrection(0);
+	m_correctionInFifo = false;
 	m_deviceDescription.clear();
 	m_sampleRate = 0;
 
@@ -389,10 +313,7 @@ DSPDeviceSourceEngine::State DSPDeviceSourceEngine::gotoInit()
 
 	// init: pass sample rate and center frequency to all sample rate and/or center frequency dependent sinks and wait for completion
 
-	m_iOffset = 0;
-	m_qOffset = 0;
-	m_iRange = 1 << 16;
-	m_qRange = 1 << 16;
+	m_iqCorrection.reset();
 
 	m_deviceDescription = m_deviceSampleSource->getDeviceDescription();
 	m_centerFrequency = m_deviceSampleSource->getCenterFrequency();
@@ -454,6 +375,9 @@ DSPDeviceSourceEngine::State DSPDeviceSourceEngine::gotoRunning()
 
 	// Start everything
 
+	m_correctionInFifo = m_correctionInAcquisition;
+	m_deviceSampleSource->getSampleFifo()->setCorrection(m_correctionInFifo ? &m_iqCorrection : 0);
+
 	if(!m_deviceSampleSource->start())
 	{
 		return gotoError("Could not start sample source");
@@ -574,6 +498,7 @@ void DSPDeviceSourceEngine::handleSynchronousMessages()
 	else if (DSPAddThreadedSampleSink::match(*message))
 	{
 		ThreadedBasebandSampleSink *threadedSink = ((DSPAddThreadedSampleSink*) message)->getThreadedSampleSink();
+		threadedSink->attachFifo(&m_basebandFifo);
 		m_threadedBasebandSampleSinks.push_back(threadedSink);
 		// initialize sample rate and center frequency in the sink:
 		DSPSignalNotification msg(m_sampleRate, m_centerFrequency);
@@ -585,6 +510,7 @@ void DSPDeviceSourceEngine::handleSynchronousMessages()
 	{
 		ThreadedBasebandSampleSink* threadedSink = ((DSPRemoveThreadedSampleSink*) message)->getThreadedSampleSink();
 		threadedSink->stop();
+		threadedSink->detachFifo();
 		m_threadedBasebandSampleSinks.remove(threadedSink);
 	}
 
@@ -604,22 +530,7 @@ void DSPDeviceSourceEngine::handleInputMessages()
 		if (DSPConfigureCorrection::match(*message))
 		{
 			DSPConfigureCorrection* conf = (DSPConfigureCorrection*) message;
-			m_iqImbalanceCorrection = conf->getIQImbalanceCorrection();
-
-			if(m_dcOffsetCorrection != conf->getDCOffsetCorrection())
-			{
-				m_dcOffsetCorrection = conf->getDCOffsetCorrection();
-				m_iOffset = 0;
-				m_qOffset = 0;
-			}
-
-			if(m_iqImbalanceCorrection != conf->getIQImbalanceCorrection())
-			{
-				m_iqImbalanceCorrection = conf->getIQImbalanceCorrection();
-				m_iRange = 1 << 16;
-				m_qRange = 1 << 16;
-				m_imbalance = 65536;
-			}
+			m_iqCorrection.configure(conf->getDCOffsetCorrection(), conf->getIQImbalanceCorrection());
 
 			delete message;
 		}
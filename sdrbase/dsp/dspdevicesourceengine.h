@@ -24,6 +24,8 @@
 #include <QWaitCondition>
 #include "dsp/dsptypes.h"
 #include "dsp/fftwindow.h"
+#include "dsp/samplesinkfifoshared.h"
+#include "dsp/iqcorrection.h"
 #include "util/messagequeue.h"
 #include "util/syncmessenger.h"
 #include "util/export.h"
@@ -69,6 +71,7 @@ public:
 	void removeThreadedSink(ThreadedBasebandSampleSink* sink); //!< Remove a sample sink that runs on its own thread
 
 	void configureCorrections(bool dcOffsetCorrection, bool iqImbalanceCorrection); //!< Configure DSP corrections
+	void setCorrectionInAcquisition(bool correctionInAcquisition) { m_correctionInAcquisition = correctionInAcquisition; } //!< Apply corrections in the device thread from next start
 
 	State state() const { return m_state; } //!< Return DSP engine current state
 
@@ -94,21 +97,17 @@ private:
 
 	typedef std::list<ThreadedBasebandSampleSink*> ThreadedBasebandSampleSinks;
 	ThreadedBasebandSampleSinks m_threadedBasebandSampleSinks; //!< sample sinks on their own threads (usually channels)
+	SampleSinkFifoShared m_basebandFifo; //!< baseband samples written once and read in place by all threaded sinks
 
 	uint m_sampleRate;
 	quint64 m_centerFrequency;
 
-	bool m_dcOffsetCorrection;
-	bool m_iqImbalanceCorrection;
-	double m_iOffset, m_qOffset;
-	qint32 m_iRange;
-	qint32 m_qRange;
-	qint32 m_imbalance;
+	IQCorrection m_iqCorrection;       //!< DC offset and IQ imbalance correction
+	bool m_correctionInAcquisition;    //!< corrections requested in the device thread
+	bool m_correctionInFifo;           //!< corrections applied by the source FIFO writer for the current run
 
 	void run();
 
-	void dcOffset(SampleVector::iterator begin, SampleVector::iterator end);
-	void imbalance(SampleVector::iterator begin, SampleVector::iterator end);
 	void work(); //!< transfer samples from source to sinks if in running state
 
 	State gotoIdle();     //!< Go to the idle state
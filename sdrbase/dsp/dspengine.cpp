@@ -21,6 +21,7 @@
 #include "dsp/dspengine.h"
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
+#include "dsp/simddispatch.h"
 
 
 DSPEngine::DSPEngine() :
@@ -29,15 +30,16 @@ DSPEngine::DSPEngine() :
 	m_audioOutputSampleRate(48000), // Use default output device at 48 kHz
     m_audioInputSampleRate(48000),  // Use default input device at 48 kHz
     m_audioInputDeviceIndex(-1),    // default device
-    m_audioOutputDeviceIndex(-1)    // default device
+    m_correctionInAcquisition(false)
 {
 	m_dvSerialSupport = false;
     m_masterTimer.start(50);
+    qInfo("DSPEngine::DSPEngine: using %s DSP kernels", SIMDDispatch::getLevelName());
 }
 
 DSPEngine::~DSPEngine()
 {
-    m_audioOutput.setOnExit(true);
+    m_audioDeviceManager.setOnExit(true);
     m_audioInput.setOnExit(true);
 
     std::vector<DSPDeviceSourceEngine*>::iterator it = m_deviceSourceEngines.begin();
@@ -47,6 +49,8 @@ DSPEngine::~DSPEngine()
         delete *it;
         ++it;
     }
+
+    m_channelWorkerPool.stop();
 }
 
 Q_GLOBAL_STATIC(DSPEngine, dspEngine)
@@ -58,6 +62,7 @@ DSPEngine *DSPEngine::instance()
 DSPDeviceSourceEngine *DSPEngine::addDeviceSourceEngine()
 {
     m_deviceSourceEngines.push_back(new DSPDeviceSourceEngine(m_deviceSourceEnginesUIDSequence));
+    m_deviceSourceEngines.back()->setCorrectionInAcquisition(m_correctionInAcquisition);
     m_deviceSourceEnginesUIDSequence++;
     return m_deviceSourceEngines.back();
 }
@@ -93,24 +98,26 @@ void DSPEngine::removeLastDeviceSinkEngine()
 
 void DSPEngine::startAudioOutput()
 {
-    m_audioOutput.start(m_audioOutputDeviceIndex, m_audioOutputSampleRate);
-    m_audioOutputSampleRate = m_audioOutput.getRate(); // update with actual rate
+    m_audioDeviceManager.setOutputSampleRate(m_audioOutputSampleRate);
+    m_audioDeviceManager.startAudioOutputs();
+    m_audioOutputSampleRate = m_audioDeviceManager.getOutputSampleRate(); // update with actual rate
 }
 
 void DSPEngine::stopAudioOutput()
 {
-    m_audioOutput.stop();
+    m_audioDeviceManager.stopAudioOutputs();
 }
 
 void DSPEngine::startAudioOutputImmediate()
 {
-    m_audioOutput.start(m_audioOutputDeviceIndex, m_audioOutputSampleRate);
-    m_audioOutputSampleRate = m_audioOutput.getRate(); // update with actual rate
+    m_audioDeviceManager.setOutputSampleRate(m_audioOutputSampleRate);
+    m_audioDeviceManager.startAudioOutputs();
+    m_audioOutputSampleRate = m_audioDeviceManager.getOutputSampleRate(); // update with actual rate
 }
 
 void DSPEngine::stopAudioOutputImmediate()
 {
-    m_audioOutput.stop();
+    m_audioDeviceManager.stopAudioOutputs();
 }
 
 void DSPEngine::startAudioInput()
@@ -135,16 +142,16 @@ void DSPEngine::stopAudioInputImmediate()
     m_audioInput.stop();
 }
 
-void DSPEngine::addAudioSink(AudioFifo* audioFifo)
+void DSPEngine::addAudioSink(AudioFifo* audioFifo, const QString& deviceName)
 {
 	qDebug("DSPEngine::addAudioSink");
-	m_audioOutput.addFifo(audioFifo);
+	m_audioDeviceManager.addAudioSink(audioFifo, deviceName);
 }
 
 void DSPEngine::removeAudioSink(AudioFifo* audioFifo)
 {
 	qDebug("DSPEngine::removeAudioSink");
-	m_audioOutput.removeFifo(audioFifo);
+	m_audioDeviceManager.removeAudioSink(audioFifo);
 }
 
 void DSPEngine::addAudioSource(AudioFifo* audioFifo)
@@ -22,8 +22,9 @@
 #include <QTimer>
 
 #include <vector>
-#include "audio/audiooutput.h"
+#include "audio/audiodevicemanager.h"
 #include "audio/audioinput.h"
+#include "dsp/channelworkerpool.h"
 #include "util/export.h"
 #ifdef DSD_USE_SERIALDV
 #include "dsp/dvserialengine.h"
@@ -52,7 +53,8 @@ public:
 	void stopAudioOutput();
     void startAudioOutputImmediate();
     void stopAudioOutputImmediate();
-    void setAudioOutputDeviceIndex(int index) { m_audioOutputDeviceIndex = index; }
+    void setAudioOutputDeviceIndex(int index) { m_audioDeviceManager.setDefaultOutputDeviceIndex(index); } //!< device of the channels using the default device
+    AudioDeviceManager *getAudioDeviceManager() { return &m_audioDeviceManager; }
 
     void startAudioInput();
     void stopAudioInput();
@@ -67,7 +69,7 @@ public:
     DSPDeviceSinkEngine *getDeviceSinkEngineByIndex(uint deviceIndex) { return m_deviceSinkEngines[deviceIndex]; }
     DSPDeviceSinkEngine *getDeviceSinkEngineByUID(uint uid);
 
-    void addAudioSink(AudioFifo* audioFifo); //!< Add the audio sink
+    void addAudioSink(AudioFifo* audioFifo, const QString& deviceName = AudioDeviceManager::m_defaultDeviceName); //!< Add the audio sink or move it to another device
 	void removeAudioSink(AudioFifo* audioFifo); //!< Remove the audio sink
 
 	void addAudioSource(AudioFifo* audioFifo); //!< Add an audio source
@@ -82,18 +84,24 @@ public:
 
     const QTimer& getMasterTimer() const { return m_masterTimer; }
 
+    ChannelWorkerPool *getChannelWorkerPool() { return &m_channelWorkerPool; }
+    void configureChannelWorkers(int nbWorkers, bool pinWorkers) { m_channelWorkerPool.configure(nbWorkers, pinWorkers); } //!< Call before any channel is created
+
+    void setCorrectionInAcquisition(bool correctionInAcquisition) { m_correctionInAcquisition = correctionInAcquisition; } //!< DC/IQ corrections in device threads for engines added next
+
 private:
 	std::vector<DSPDeviceSourceEngine*> m_deviceSourceEngines;
 	uint m_deviceSourceEnginesUIDSequence;
 	std::vector<DSPDeviceSinkEngine*> m_deviceSinkEngines;
 	uint m_deviceSinkEnginesUIDSequence;
-	AudioOutput m_audioOutput;
+	AudioDeviceManager m_audioDeviceManager;
 	AudioInput m_audioInput;
 	uint m_audioOutputSampleRate;
     uint m_audioInputSampleRate;
     int m_audioInputDeviceIndex;
-    int m_audioOutputDeviceIndex;
     QTimer m_masterTimer;
+    ChannelWorkerPool m_channelWorkerPool;
+    bool m_correctionInAcquisition;
 	bool m_dvSerialSupport;
 #ifdef DSD_USE_SERIALDV
 	DVSerialEngine m_dvSerialEngine;
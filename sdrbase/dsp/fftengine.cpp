@@ -1,3 +1,6 @@
+#include <QSettings>
+#include <QFileInfo>
+#include <QDir>
 #include "dsp/fftengine.h"
 #ifdef USE_KISSFFT
 #include "dsp/kissengine.h"
@@ -24,3 +27,36 @@ FFTEngine* FFTEngine::create()
 	qCritical("FFTEngine::create: no engine built");
 	return NULL;
 }
+
+#ifdef USE_FFTW
+static QString getWisdomFileName()
+{
+	QSettings settings; // next to the application settings file
+	QFileInfo settingsFile(settings.fileName());
+	QDir().mkpath(settingsFile.absolutePath());
+	return settingsFile.absolutePath() + "/" + settingsFile.completeBaseName() + "-fftw-wisdom";
+}
+#endif
+
+void FFTEngine::setPlanningEffort(PlanningEffort effort)
+{
+#ifdef USE_FFTW
+	FFTWEngine::setPlanningEffort(effort);
+#else
+	(void) effort;
+#endif
+}
+
+void FFTEngine::loadWisdom()
+{
+#ifdef USE_FFTW
+	FFTWEngine::importWisdom(getWisdomFileName());
+#endif
+}
+
+void FFTEngine::saveWisdom()
+{
+#ifdef USE_FFTW
+	FFTWEngine::exportWisdom(getWisdomFileName());
+#endif
+}
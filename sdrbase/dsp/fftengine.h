@@ -4,8 +4,16 @@
 #include "dsp/dsptypes.h"
 #include "util/export.h"
 
+class QString;
+
 class SDRANGEL_API FFTEngine {
 public:
+	enum PlanningEffort {
+		PlanEstimate, //!< no planning measurements (fastest start)
+		PlanMeasure,  //!< measure a few algorithms
+		PlanPatient   //!< measure many algorithms (fastest transforms)
+	};
+
 	virtual ~FFTEngine();
 
 	virtual void configure(int n, bool inverse) = 0;
@@ -15,6 +23,10 @@ public:
 	virtual Complex* out() = 0;
 
 	static FFTEngine* create();
+
+	static void setPlanningEffort(PlanningEffort effort); //!< Effort put into planning new transforms
+	static void loadWisdom(); //!< Import planning results saved in the user configuration directory
+	static void saveWisdom(); //!< Save planning results to the user configuration directory
 };
 
 #endif // INCLUDE_FFTENGINE_H
@@ -1,7 +1,7 @@
 // ----------------------------------------------------------------------------
-//	fftfilt.cxx  --  Fast convolution Overlap-Add filter
+//	fftfilt.cxx  --  Fast convolution Overlap-Save filter
 //
-// Filter implemented using overlap-add FFT convolution method
+// Filter implemented using overlap-save FFT convolution method
 // h(t) characterized by Windowed-Sinc impulse response
 //
 // Reference:
@@ -33,6 +33,8 @@
 #include <cstdlib>
 #include <cmath>
 #include <typeinfo>
+#include <algorithm>
+#include <vector>
 
 #include <stdio.h>
 #include <sys/types.h>
@@ -47,27 +49,45 @@
 // create forward and reverse FFTs
 //------------------------------------------------------------------------------
 
-// Only need a single instance of g_fft, used for both forward and reverse
+// Filtering is done by overlap-save fast convolution on the FFT engine selected at build time
+// (FFTW or KissFFT). The filter taps span at most flen2 samples so the last flen2 samples of
+// each flen long circular convolution are the exact linear convolution of the input.
 void fftfilt::init_filter()
 {
 	flen2	= flen >> 1;
-	fft	= new g_fft<float>(flen);
+
+	fft = FFTEngine::create();
+	fft->configure(flen, false);
+	ift = FFTEngine::create();
+	ift->configure(flen, true);
 
 	filter		= new cmplx[flen];
     filterOpp   = new cmplx[flen];
-	data		= new cmplx[flen];
+	data		= fft->in();
 	output		= new cmplx[flen2];
-	ovlbuf		= new cmplx[flen2];
 
 	memset(filter, 0, flen * sizeof(cmplx));
     memset(filterOpp, 0, flen * sizeof(cmplx));
 	memset(data, 0, flen * sizeof(cmplx));
 	memset(output, 0, flen2 * sizeof(cmplx));
-	memset(ovlbuf, 0, flen2 * sizeof(cmplx));
 
 	inptr = 0;
 }
 
+// Forward transform of filter taps in place. The engines do not scale the inverse transform
+// so the 1/flen factor is folded into the filter that is normalized next.
+// The input window is kept so that the filter can be changed while running.
+void fftfilt::transform_filter(cmplx *buf)
+{
+	std::vector<cmplx> history(data, data + flen);
+
+	memcpy(data, buf, flen * sizeof(cmplx));
+	fft->transform();
+	memcpy(buf, fft->out(), flen * sizeof(cmplx));
+
+	memcpy(data, history.data(), flen * sizeof(cmplx));
+}
+
 //------------------------------------------------------------------------------
 // fft filter
 // f1 < f2 ==> band pass filter
@@ -92,12 +112,11 @@ fftfilt::fftfilt(float f2, int len)
 fftfilt::~fftfilt()
 {
 	if (fft) delete fft;
+	if (ift) delete ift;
 
 	if (filter) delete [] filter;
     if (filterOpp) delete [] filterOpp;
-	if (data) delete [] data;
 	if (output) delete [] output;
-	if (ovlbuf) delete [] ovlbuf;
 }
 
 void fftfilt::create_filter(float f1, float f2)
@@ -126,7 +145,7 @@ void fftfilt::create_filter(float f1, float f2)
 	for (int i = 0; i < flen2; i++)
 		filter[i] *= _blackman(i, flen2);
 
-	fft->ComplexFFT(filter);
+	transform_filter(filter);
 
 	// normalize the output filter for unity gain
 	float scale = 0, mag;
@@ -135,6 +154,7 @@ void fftfilt::create_filter(float f1, float f2)
 		if (mag > scale) scale = mag;
 	}
 	if (scale != 0) {
+		scale *= flen;
 		for (int i = 0; i < flen; i++)
 			filter[i] /= scale;
 	}
@@ -151,7 +171,7 @@ void fftfilt::create_dsb_filter(float f2)
 		filter[i] *= _blackman(i, flen2);
 	}
 
-	fft->ComplexFFT(filter);
+	transform_filter(filter);
 
 	// normalize the output filter for unity gain
 	float scale = 0, mag;
@@ -160,6 +180,7 @@ void fftfilt::create_dsb_filter(float f2)
 		if (mag > scale) scale = mag;
 	}
 	if (scale != 0) {
+		scale *= flen;
 		for (int i = 0; i < flen; i++)
 			filter[i] /= scale;
 	}
@@ -178,7 +199,7 @@ void fftfilt::create_asym_filter(float fopp, float fin)
         filter[i] *= _blackman(i, flen2);
     }
 
-    fft->ComplexFFT(filter);
+    transform_filter(filter);
 
     // normalize the output filter for unity gain
     float scale = 0, mag;
@@ -187,6 +208,7 @@ void fftfilt::create_asym_filter(float fopp, float fin)
         if (mag > scale) scale = mag;
     }
     if (scale != 0) {
+        scale *= flen;
         for (int i = 0; i < flen; i++)
             filter[i] /= scale;
     }
@@ -200,7 +222,7 @@ void fftfilt::create_asym_filter(float fopp, float fin)
         filterOpp[i] *= _blackman(i, flen2);
     }
 
-    fft->ComplexFFT(filterOpp);
+    transform_filter(filterOpp);
 
     // normalize the output filter for unity gain
     scale = 0;
@@ -209,43 +231,130 @@ void fftfilt::create_asym_filter(float fopp, float fin)
         if (mag > scale) scale = mag;
     }
     if (scale != 0) {
+        scale *= flen;
         for (int i = 0; i < flen; i++)
             filterOpp[i] /= scale;
     }
 }
 
+// Run one complete window: apply the filter in the frequency domain and write
+// the flen2 valid output samples to out. Then slide the window by flen2 samples.
+void fftfilt::filter_frame(FilterMode mode, bool usb, bool getDC, cmplx *out)
+{
+	if (mode == FILT_NONE)
+	{
+		memcpy(out, &data[flen2], flen2 * sizeof(cmplx));
+		memcpy(data, &data[flen2], flen2 * sizeof(cmplx));
+		return;
+	}
+
+	fft->transform();
+
+	const cmplx *spec = fft->out();
+	cmplx *fdata = ift->in();
+
+	switch (mode)
+	{
+	case FILT_SSB:
+		// get or reject DC component
+		fdata[0] = getDC ? spec[0]*filter[0] : 0;
+		fdata[flen2] = spec[flen2]*filter[flen2];
+
+		// Discard frequencies for ssb
+		if (usb)
+		{
+			for (int i = 1; i < flen2; i++) {
+				fdata[i] = spec[i]*filter[i];
+				fdata[flen2 + i] = 0;
+			}
+		}
+		else
+		{
+			for (int i = 1; i < flen2; i++) {
+				fdata[i] = 0;
+				fdata[flen2 + i] = spec[flen2 + i]*filter[flen2 + i];
+			}
+		}
+		break;
+	case FILT_ASYM:
+		fdata[0] = spec[0]*filter[0]; // always keep DC
+		fdata[flen2] = spec[flen2]*filter[flen2];
+
+		if (usb)
+		{
+			for (int i = 1; i < flen2; i++)
+			{
+				fdata[i] = spec[i]*filter[i]; // usb
+				fdata[flen2 + i] = spec[flen2 + i]*filterOpp[flen2 + i]; // lsb is the opposite
+			}
+		}
+		else
+		{
+			for (int i = 1; i < flen2; i++)
+			{
+				fdata[i] = spec[i]*filterOpp[i]; // usb is the opposite
+				fdata[flen2 + i] = spec[flen2 + i]*filter[flen2 + i]; // lsb
+			}
+		}
+		break;
+	default:
+		for (int i = 0; i < flen; i++)
+			fdata[i] = spec[i]*filter[i];
+		break;
+	}
+
+	ift->transform();
+
+	// overlap and save: the second half is the valid part of the circular convolution
+	memcpy(out, &ift->out()[flen2], flen2 * sizeof(cmplx));
+	memcpy(data, &data[flen2], flen2 * sizeof(cmplx));
+}
+
+int fftfilt::runBlock(const cmplx *in, int nbIn, cmplx *out, FilterMode mode, bool usb, bool getDC)
+{
+	int nbOut = 0;
+
+	while (nbIn > 0)
+	{
+		int chunk = std::min(nbIn, flen2 - inptr);
+		memcpy(&data[flen2 + inptr], in, chunk * sizeof(cmplx));
+		in += chunk;
+		nbIn -= chunk;
+		inptr += chunk;
+
+		if (inptr == flen2)
+		{
+			inptr = 0;
+			filter_frame(mode, usb, getDC, &out[nbOut]);
+			nbOut += flen2;
+		}
+	}
+
+	return nbOut;
+}
+
 // test bypass
 int fftfilt::noFilt(const cmplx & in, cmplx **out)
 {
-	data[inptr++] = in;
+	data[flen2 + inptr++] = in;
 	if (inptr < flen2)
 		return 0;
 	inptr = 0;
 
-	*out = data;
+	filter_frame(FILT_NONE, true, true, output);
+	*out = output;
 	return flen2;
 }
 
-// Filter with fast convolution (overlap-add algorithm).
+// Filter with fast convolution (overlap-save algorithm).
 int fftfilt::runFilt(const cmplx & in, cmplx **out)
 {
-	data[inptr++] = in;
+	data[flen2 + inptr++] = in;
 	if (inptr < flen2)
 		return 0;
 	inptr = 0;
 
-	fft->ComplexFFT(data);
-	for (int i = 0; i < flen; i++)
-		data[i] *= filter[i];
-
-	fft->InverseComplexFFT(data);
-
-	for (int i = 0; i < flen2; i++) {
-		output[i] = ovlbuf[i] + data[i];
-		ovlbuf[i] = data[flen2 + i];
-	}
-	memset (data, 0, flen * sizeof(cmplx));
-
+	filter_frame(FILT_FULL, true, true, output);
 	*out = output;
 	return flen2;
 }
@@ -253,42 +362,12 @@ int fftfilt::runFilt(const cmplx & in, cmplx **out)
 // Second version for single sideband
 int fftfilt::runSSB(const cmplx & in, cmplx **out, bool usb, bool getDC)
 {
-	data[inptr++] = in;
+	data[flen2 + inptr++] = in;
 	if (inptr < flen2)
 		return 0;
 	inptr = 0;
 
-	fft->ComplexFFT(data);
-
-	// get or reject DC component
-	data[0] = getDC ? data[0]*filter[0] : 0;
-
-	// Discard frequencies for ssb
-	if (usb)
-	{
-		for (int i = 1; i < flen2; i++) {
-			data[i] *= filter[i];
-			data[flen2 + i] = 0;
-		}
-	}
-	else
-	{
-		for (int i = 1; i < flen2; i++) {
-			data[i] = 0;
-			data[flen2 + i] *= filter[flen2 + i];
-		}
-	}
-
-	// in-place FFT: freqdata overwritten with filtered timedata
-	fft->InverseComplexFFT(data);
-
-	// overlap and add
-	for (int i = 0; i < flen2; i++) {
-		output[i] = ovlbuf[i] + data[i];
-		ovlbuf[i] = data[i+flen2];
-	}
-	memset (data, 0, flen * sizeof(cmplx));
-
+	filter_frame(FILT_SSB, usb, getDC, output);
 	*out = output;
 	return flen2;
 }
@@ -296,29 +375,12 @@ int fftfilt::runSSB(const cmplx & in, cmplx **out, bool usb, bool getDC)
 // Version for double sideband. You have to double the FFT size used for SSB.
 int fftfilt::runDSB(const cmplx & in, cmplx **out)
 {
-	data[inptr++] = in;
+	data[flen2 + inptr++] = in;
 	if (inptr < flen2)
 		return 0;
 	inptr = 0;
 
-	fft->ComplexFFT(data);
-
-	for (int i = 0; i < flen2; i++) {
-		data[i] *= filter[i];
-		data[flen2 + i] *= filter[flen2 + i];
-	}
-
-	// in-place FFT: freqdata overwritten with filtered timedata
-	fft->InverseComplexFFT(data);
-
-	// overlap and add
-	for (int i = 0; i < flen2; i++) {
-		output[i] = ovlbuf[i] + data[i];
-		ovlbuf[i] = data[i+flen2];
-	}
-
-	memset (data, 0, flen * sizeof(cmplx));
-
+	filter_frame(FILT_FULL, true, true, output);
 	*out = output;
 	return flen2;
 }
@@ -326,45 +388,34 @@ int fftfilt::runDSB(const cmplx & in, cmplx **out)
 // Version for asymmetrical sidebands. You have to double the FFT size used for SSB.
 int fftfilt::runAsym(const cmplx & in, cmplx **out, bool usb)
 {
-    data[inptr++] = in;
+    data[flen2 + inptr++] = in;
     if (inptr < flen2)
         return 0;
     inptr = 0;
 
-    fft->ComplexFFT(data);
-
-    data[0] *= filter[0]; // always keep DC
-
-    if (usb)
-    {
-        for (int i = 1; i < flen2; i++)
-        {
-            data[i] *= filter[i]; // usb
-            data[flen2 + i] *= filterOpp[flen2 + i]; // lsb is the opposite
-        }
-    }
-    else
-    {
-        for (int i = 1; i < flen2; i++)
-        {
-            data[i] *= filterOpp[i]; // usb is the opposite
-            data[flen2 + i] *= filter[flen2 + i]; // lsb
-        }
-    }
+    filter_frame(FILT_ASYM, usb, true, output);
+    *out = output;
+    return flen2;
+}
 
-    // in-place FFT: freqdata overwritten with filtered timedata
-    fft->InverseComplexFFT(data);
+int fftfilt::runFiltBlock(const cmplx *in, int nbIn, cmplx *out)
+{
+	return runBlock(in, nbIn, out, FILT_FULL, true, true);
+}
 
-    // overlap and add
-    for (int i = 0; i < flen2; i++) {
-        output[i] = ovlbuf[i] + data[i];
-        ovlbuf[i] = data[i+flen2];
-    }
+int fftfilt::runSSBBlock(const cmplx *in, int nbIn, cmplx *out, bool usb, bool getDC)
+{
+	return runBlock(in, nbIn, out, FILT_SSB, usb, getDC);
+}
 
-    memset (data, 0, flen * sizeof(cmplx));
+int fftfilt::runDSBBlock(const cmplx *in, int nbIn, cmplx *out)
+{
+	return runBlock(in, nbIn, out, FILT_FULL, true, true);
+}
 
-    *out = output;
-    return flen2;
+int fftfilt::runAsymBlock(const cmplx *in, int nbIn, cmplx *out, bool usb)
+{
+	return runBlock(in, nbIn, out, FILT_ASYM, usb, true);
 }
 
 /* Sliding FFT from Fldigi */
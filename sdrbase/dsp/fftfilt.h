@@ -6,7 +6,7 @@
 #define	_FFTFILT_H
 
 #include <complex>
-#include "gfft.h"
+#include "dsp/fftengine.h"
 
 #undef M_PI
 #define M_PI 3.14159265358979323846
@@ -34,15 +34,24 @@ public:
 	int runDSB(const cmplx& in, cmplx **out);
 	int runAsym(const cmplx & in, cmplx **out, bool usb); //!< Asymmetrical fitering can be used for vestigial sideband
 
+	// Block versions: consume nbIn samples and write the filtered samples to out
+	// that must have room for getBlockOutputSize(nbIn) samples. Return the number of samples written.
+	int getBlockOutputSize(int nbIn) const { return ((inptr + nbIn) / flen2) * flen2; }
+	int runFiltBlock(const cmplx *in, int nbIn, cmplx *out);
+	int runSSBBlock(const cmplx *in, int nbIn, cmplx *out, bool usb, bool getDC = true);
+	int runDSBBlock(const cmplx *in, int nbIn, cmplx *out);
+	int runAsymBlock(const cmplx *in, int nbIn, cmplx *out, bool usb);
+
 protected:
+	enum FilterMode {FILT_NONE, FILT_FULL, FILT_SSB, FILT_ASYM};
+
 	int flen;
 	int flen2;
-	g_fft<float> *fft;
-	g_fft<float> *ift;
+	FFTEngine *fft;   //!< forward transform. Its input buffer is the overlap-save window
+	FFTEngine *ift;   //!< inverse transform
 	cmplx *filter;
     cmplx *filterOpp;
-	cmplx *data;
-	cmplx *ovlbuf;
+	cmplx *data;      //!< flen2 previous samples followed by flen2 new samples
 	cmplx *output;
 	int inptr;
 	int pass;
@@ -61,6 +70,9 @@ protected:
 
 	void init_filter();
 	void init_dsb_filter();
+	void transform_filter(cmplx *buf);
+	void filter_frame(FilterMode mode, bool usb, bool getDC, cmplx *out);
+	int runBlock(const cmplx *in, int nbIn, cmplx *out, FilterMode mode, bool usb, bool getDC);
 };
 
 
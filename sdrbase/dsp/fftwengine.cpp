@@ -26,19 +26,14 @@ void FFTWEngine::configure(int n, bool inverse)
 	m_currentPlan->inverse = inverse;
 	m_currentPlan->in = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex) * n);
 	m_currentPlan->out = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex) * n);
-	QTime t;
-	t.start();
-	m_globalPlanMutex.lock();
-	m_currentPlan->plan = fftwf_plan_dft_1d(n, m_currentPlan->in, m_currentPlan->out, inverse ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_PATIENT);
-	m_globalPlanMutex.unlock();
-	qDebug("FFT: creating FFTW plan (n=%d,%s) took %dms", n, inverse ? "inverse" : "forward", t.elapsed());
+	m_currentPlan->shared = acquirePlan(n, inverse, m_currentPlan->in, m_currentPlan->out);
 	m_plans.push_back(m_currentPlan);
 }
 
 void FFTWEngine::transform()
 {
 	if(m_currentPlan != NULL)
-		fftwf_execute(m_currentPlan->plan);
+		fftwf_execute_dft(m_currentPlan->shared->plan, m_currentPlan->in, m_currentPlan->out);
 }
 
 Complex* FFTWEngine::in()
@@ -56,14 +51,104 @@ Complex* FFTWEngine::out()
 }
 
 QMutex FFTWEngine::m_globalPlanMutex;
+FFTWEngine::SharedPlans FFTWEngine::m_globalPlans;
+unsigned int FFTWEngine::m_planFlags = FFTW_PATIENT;
+bool FFTWEngine::m_wisdomChanged = false;
+
+FFTWEngine::SharedPlan* FFTWEngine::acquirePlan(int n, bool inverse, fftwf_complex* in, fftwf_complex* out)
+{
+	QMutexLocker mutexLocker(&m_globalPlanMutex);
+
+	for(SharedPlans::const_iterator it = m_globalPlans.begin(); it != m_globalPlans.end(); ++it) {
+		if(((*it)->n == n) && ((*it)->inverse == inverse)) {
+			(*it)->refCount++;
+			return *it;
+		}
+	}
+
+	// in and out are freshly allocated so planning may overwrite them. Other engines execute
+	// the plan on their own fftwf_malloc'ed buffers which have the same alignment.
+	SharedPlan* shared = new SharedPlan;
+	shared->n = n;
+	shared->inverse = inverse;
+	shared->refCount = 1;
+	QTime t;
+	t.start();
+	shared->plan = fftwf_plan_dft_1d(n, in, out, inverse ? FFTW_BACKWARD : FFTW_FORWARD, m_planFlags);
+	qDebug("FFT: creating FFTW plan (n=%d,%s) took %dms", n, inverse ? "inverse" : "forward", t.elapsed());
+	m_wisdomChanged = m_wisdomChanged || (m_planFlags != FFTW_ESTIMATE);
+	m_globalPlans.push_back(shared);
+
+	return shared;
+}
+
+void FFTWEngine::releasePlan(SharedPlan* shared)
+{
+	QMutexLocker mutexLocker(&m_globalPlanMutex);
+
+	if(--shared->refCount == 0) {
+		fftwf_destroy_plan(shared->plan);
+		m_globalPlans.remove(shared);
+		delete shared;
+	}
+}
 
 void FFTWEngine::freeAll()
 {
 	for(Plans::iterator it = m_plans.begin(); it != m_plans.end(); ++it) {
-		fftwf_destroy_plan((*it)->plan);
+		releasePlan((*it)->shared);
 		fftwf_free((*it)->in);
 		fftwf_free((*it)->out);
 		delete *it;
 	}
 	m_plans.clear();
 }
+
+void FFTWEngine::setPlanningEffort(PlanningEffort effort)
+{
+	QMutexLocker mutexLocker(&m_globalPlanMutex);
+
+	switch(effort) {
+		case PlanEstimate:
+			m_planFlags = FFTW_ESTIMATE;
+			break;
+		case PlanMeasure:
+			m_planFlags = FFTW_MEASURE;
+			break;
+		case PlanPatient:
+		default:
+			m_planFlags = FFTW_PATIENT;
+			break;
+	}
+}
+
+bool FFTWEngine::importWisdom(const QString& fileName)
+{
+	QMutexLocker mutexLocker(&m_globalPlanMutex);
+
+	if(fftwf_import_wisdom_from_filename(qPrintable(fileName)) == 0) {
+		qDebug("FFTWEngine::importWisdom: no wisdom read from %s", qPrintable(fileName));
+		return false;
+	}
+
+	qDebug("FFTWEngine::importWisdom: read wisdom from %s", qPrintable(fileName));
+	return true;
+}
+
+bool FFTWEngine::exportWisdom(const QString& fileName)
+{
+	QMutexLocker mutexLocker(&m_globalPlanMutex);
+
+	if(!m_wisdomChanged) {
+		return true;
+	}
+
+	if(fftwf_export_wisdom_to_filename(qPrintable(fileName)) == 0) {
+		qWarning("FFTWEngine::exportWisdom: cannot write wisdom to %s", qPrintable(fileName));
+		return false;
+	}
+
+	qDebug("FFTWEngine::exportWisdom: wrote wisdom to %s", qPrintable(fileName));
+	m_wisdomChanged = false;
+	return true;
+}
@@ -2,6 +2,7 @@
 #define INCLUDE_FFTWENGINE_H
 
 #include <QMutex>
+#include <QString>
 #include <fftw3.h>
 #include <list>
 #include "dsp/fftengine.h"
@@ -17,13 +18,29 @@ public:
 	Complex* in();
 	Complex* out();
 
+	static void setPlanningEffort(PlanningEffort effort);
+	static bool importWisdom(const QString& fileName);
+	static bool exportWisdom(const QString& fileName);
+
 protected:
-	static QMutex m_globalPlanMutex;
+	static QMutex m_globalPlanMutex; //!< FFTW planner is not thread safe
 
-	struct Plan {
+	// plans are shared process wide and executed on each engine's own buffers
+	struct SharedPlan {
 		int n;
 		bool inverse;
 		fftwf_plan plan;
+		int refCount;
+	};
+	typedef std::list<SharedPlan*> SharedPlans;
+	static SharedPlans m_globalPlans;   //!< under m_globalPlanMutex
+	static unsigned int m_planFlags;    //!< under m_globalPlanMutex
+	static bool m_wisdomChanged;        //!< under m_globalPlanMutex
+
+	struct Plan {
+		int n;
+		bool inverse;
+		SharedPlan* shared;
 		fftwf_complex* in;
 		fftwf_complex* out;
 	};
@@ -31,6 +48,8 @@ protected:
 	Plans m_plans;
 	Plan* m_currentPlan;
 
+	static SharedPlan* acquirePlan(int n, bool inverse, fftwf_complex* in, fftwf_complex* out);
+	static void releasePlan(SharedPlan* shared);
 	void freeAll();
 };
 
@@ -1,8 +1,13 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include <vector>
+#include <algorithm>
 #include "dsp/interpolator.h"
 
+#if defined(USE_SIMD_DISPATCH)
+#include <immintrin.h>
+#endif
+
 
 void Interpolator::createPolyphaseLowPass(
         std::vector<Real>& taps,
@@ -62,7 +67,12 @@ Interpolator::Interpolator() :
 	m_alignedTaps2(0),
     m_ptr(0),
 	m_phaseSteps(1),
-    m_nTaps(1)
+    m_nTaps(1),
+    m_avx(SIMDDispatch::hasAVX2()),
+    m_blockTaps(0),
+    m_alignedBlockTaps(0),
+    m_blockPosition(0),
+    m_blockStep(1LL<<32)
 {
 }
 
@@ -126,6 +136,20 @@ void Interpolator::create(int phaseSteps, double sampleRate, double cutoff, doub
 		m_alignedTaps2[2 * (i - 1) + 0] = polyphase[i];
 		m_alignedTaps2[2 * (i - 1) + 1] = polyphase[i];
 	}
+
+	// block resampler: each phase filter reversed so that it runs forward on a straight buffer
+	m_blockTaps = new float[2 * taps.size() + 8];
+	for(uint i = 0; i < 2 * taps.size() + 8; ++i)
+		m_blockTaps[i] = 0;
+	m_alignedBlockTaps = (float*)((((quint64)m_blockTaps) + 15) & ~15);
+	for(int phase = 0; phase < phaseSteps; phase++) {
+		for(int i = 0; i < m_nTaps; i++) {
+			m_alignedBlockTaps[2 * (phase * m_nTaps + i) + 0] = polyphase[phase * m_nTaps + m_nTaps - 1 - i];
+			m_alignedBlockTaps[2 * (phase * m_nTaps + i) + 1] = polyphase[phase * m_nTaps + m_nTaps - 1 - i];
+		}
+	}
+	m_blockSamples.assign(m_nTaps - 1, Complex(0, 0));
+	m_blockPosition = 0;
 }
 
 void Interpolator::free()
@@ -137,5 +161,159 @@ void Interpolator::free()
 		delete[] m_taps2;
 		m_taps2 = NULL;
 		m_alignedTaps2 = NULL;
+		delete[] m_blockTaps;
+		m_blockTaps = NULL;
+		m_alignedBlockTaps = NULL;
+	}
+}
+
+void Interpolator::setResampleRatio(Real distance)
+{
+	m_blockStep = (quint64) (distance * 4294967296.0 + 0.5);
+
+	if (m_blockStep == 0) {
+		m_blockStep = 1;
+	}
+}
+
+int Interpolator::resampleBlock(const Complex *in, int nbIn, Complex *out)
+{
+	const qint64 one = 1LL<<32;
+	int history = m_nTaps - 1;
+	int nbOut = 0;
+	int k = 0; // input samples consumed
+
+	m_blockSamples.resize(history + nbIn);
+	std::copy(in, in + nbIn, m_blockSamples.begin() + history);
+
+	while (k < nbIn)
+	{
+		m_blockPosition -= one;
+		k++;
+
+		if (m_blockPosition >= one) // skip the samples that do not produce an output
+		{
+			qint64 skip = m_blockPosition >> 32;
+
+			if (skip > nbIn - k) {
+				skip = nbIn - k;
+			}
+
+			m_blockPosition -= skip * one;
+			k += skip;
+
+			if (m_blockPosition >= one) {
+				break;
+			}
+		}
+
+		do // like decimate() only one output per input sample when decimating
+		{
+			int phase = m_blockPosition < 0 ? 0 : (int) ((m_blockPosition * m_phaseSteps) >> 32);
+			doBlockInterpolate(&m_blockSamples[k - 1], phase, &out[nbOut++]);
+			m_blockPosition += m_blockStep;
+		}
+		while ((m_blockStep < (quint64) one) && (m_blockPosition < one));
+	}
+
+	// keep the last samples as history for the next block
+	std::copy(m_blockSamples.begin() + nbIn, m_blockSamples.begin() + nbIn + history, m_blockSamples.begin());
+	m_blockSamples.resize(history);
+
+	return nbOut;
+}
+
+#if defined(USE_SIMD_DISPATCH)
+// Accumulate nbSamples complex samples times the I/Q duplicated coefficients four samples at a time
+SIMD_TARGET("avx")
+static inline void dotProductAVX(const float *src, const float *coeff, int nbSamples, __m256& sum8, __m128& sum4)
+{
+	int i = 0;
+
+	for (; i + 4 <= nbSamples; i += 4) {
+		sum8 = _mm256_add_ps(sum8, _mm256_mul_ps(_mm256_loadu_ps(src), _mm256_loadu_ps(coeff)));
+		src += 8;
+		coeff += 8;
+	}
+
+	if (i + 2 <= nbSamples) {
+		sum4 = _mm_add_ps(sum4, _mm_mul_ps(_mm_loadu_ps(src), _mm_loadu_ps(coeff)));
+		src += 4;
+		coeff += 4;
+		i += 2;
+	}
+
+	if (i < nbSamples) {
+		sum4 = _mm_add_ps(sum4, _mm_mul_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*) src), _mm_loadu_ps(coeff)));
+	}
+}
+
+SIMD_TARGET("avx")
+void Interpolator::doInterpolateAVX(int phase, Complex* result)
+{
+	// with unaligned loads the ring buffer is just two straight blocks and the second coefficient table is not needed
+	const float* coeff = &m_alignedTaps[phase * m_nTaps * 2];
+	__m256 sum8 = _mm256_setzero_ps();
+	__m128 sum4 = _mm_setzero_ps();
+	int block = m_nTaps - m_ptr;
+
+	dotProductAVX((const float*) &m_samples[m_ptr], coeff, block, sum8, sum4);
+	dotProductAVX((const float*) &m_samples[0], coeff + 2*block, m_ptr, sum8, sum4);
+
+	sum4 = _mm_add_ps(sum4, _mm_add_ps(_mm256_castps256_ps128(sum8), _mm256_extractf128_ps(sum8, 1)));
+	_mm_storel_pi((__m64*)result, _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4)));
+}
+#endif
+
+#if defined(USE_SIMD_DISPATCH)
+SIMD_TARGET("avx")
+static void blockDotProductAVX(const float *src, const float *coeff, int nbSamples, Complex *result)
+{
+	__m256 sum8 = _mm256_setzero_ps();
+	__m128 sum4 = _mm_setzero_ps();
+
+	dotProductAVX(src, coeff, nbSamples, sum8, sum4);
+
+	sum4 = _mm_add_ps(sum4, _mm_add_ps(_mm256_castps256_ps128(sum8), _mm256_extractf128_ps(sum8, 1)));
+	_mm_storel_pi((__m64*)result, _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4)));
+}
+#endif
+
+void Interpolator::doBlockInterpolate(const Complex *samples, int phase, Complex* result) const
+{
+	const float* src = (const float*) samples;
+	const float* coeff = &m_alignedBlockTaps[phase * m_nTaps * 2];
+
+#if defined(USE_SIMD_DISPATCH)
+	if (m_avx) {
+		blockDotProductAVX(src, coeff, m_nTaps, result);
+		return;
+	}
+#endif
+#if USE_SSE2
+	__m128 sum = _mm_setzero_ps();
+	int todo = m_nTaps / 2;
+
+	for(int i = 0; i < todo; i++) {
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src), _mm_loadu_ps(coeff)));
+		src += 4;
+		coeff += 4;
+	}
+	if(m_nTaps & 1) {
+		// one sample remaining
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)src), _mm_loadu_ps(coeff)));
+	}
+
+	// add upper half to lower half and store
+	_mm_storel_pi((__m64*)result, _mm_add_ps(sum, _mm_movehl_ps(sum, sum)));
+#else
+	Real rAcc = 0;
+	Real iAcc = 0;
+
+	for(int i = 0; i < m_nTaps; i++) {
+		rAcc += coeff[2*i] * samples[i].real();
+		iAcc += coeff[2*i] * samples[i].imag();
 	}
+	*result = Complex(rAcc, iAcc);
+#endif
 }
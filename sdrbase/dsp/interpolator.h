@@ -5,6 +5,7 @@
 #include <emmintrin.h>
 #endif
 #include "dsp/dsptypes.h"
+#include "dsp/simddispatch.h"
 #include "util/export.h"
 #include <stdio.h>
 #ifndef __WINDOWS__
@@ -75,6 +76,16 @@ public:
 		return true;
 	}
 
+	// Block resampler equivalent to calling decimate() on each input sample but with the distance kept inside
+	// in 32.32 fixed point and the filter run on a straight history buffer. Ratios below 1 upsample.
+	// Do not mix with the per sample methods above between two calls to create().
+	void setResampleRatio(Real distance); //!< input samples per output sample. Call after create().
+	int getResampleBlockSize(int nbIn) const //!< room needed in the output for a block of nbIn input samples
+	{
+		return (int) ((((quint64) nbIn + 1) << 32) / m_blockStep) + 2;
+	}
+	int resampleBlock(const Complex *in, int nbIn, Complex *out); //!< returns the number of samples written to out
+
 private:
 	float* m_taps;
 	float* m_alignedTaps;
@@ -84,6 +95,12 @@ private:
 	int m_ptr;
 	int m_phaseSteps;
 	int m_nTaps;
+	bool m_avx; //!< use the AVX dot product selected at runtime
+	float* m_blockTaps;
+	float* m_alignedBlockTaps;          //!< polyphase filters in time order (oldest sample first) for the block resampler
+	std::vector<Complex> m_blockSamples; //!< last m_nTaps - 1 samples followed by the current block
+	qint64 m_blockPosition;             //!< distance to the next output in 32.32 fixed point
+	quint64 m_blockStep;                //!< input samples per output sample in 32.32 fixed point
 
 	static void createPolyphaseLowPass(
 	    std::vector<Real>& taps,
@@ -121,10 +138,22 @@ private:
         m_samples[m_ptr].imag(0.0);
     }
 
+#if defined(USE_SIMD_DISPATCH)
+	void doInterpolateAVX(int phase, Complex* result);
+#endif
+
+	void doBlockInterpolate(const Complex *samples, int phase, Complex* result) const; //!< samples: oldest of the m_nTaps samples
+
 	void doInterpolate(int phase, Complex* result)
 	{
 		if (phase < 0)
 			phase = 0;
+#if defined(USE_SIMD_DISPATCH)
+		if (m_avx) {
+			doInterpolateAVX(phase, result);
+			return;
+		}
+#endif
 #if USE_SSE2
 		// beware of the ringbuffer
 		if(m_ptr == 0) {
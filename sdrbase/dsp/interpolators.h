@@ -18,7 +18,7 @@
 #define INCLUDE_GPL_DSP_INTERPOLATORS_H_
 
 #include "dsp/dsptypes.h"
-#ifdef USE_SSE4_1
+#if defined(USE_SSE4_1) || defined(USE_SIMD_DISPATCH)
 #include "dsp/inthalfbandfiltereo1.h"
 #else
 #include "dsp/inthalfbandfilterdb.h"
@@ -112,9 +112,27 @@ public:
 	void interpolate16_cen(SampleVector::iterator* it, T* buf, qint32 len);
 	void interpolate32_cen(SampleVector::iterator* it, T* buf, qint32 len);
 	void interpolate64_cen(SampleVector::iterator* it, T* buf, qint32 len);
+	void interpolate2_inf(SampleVector::iterator* it, T* buf, qint32 len);
+	void interpolate2_sup(SampleVector::iterator* it, T* buf, qint32 len);
+	void interpolate4_inf(SampleVector::iterator* it, T* buf, qint32 len);
+	void interpolate4_sup(SampleVector::iterator* it, T* buf, qint32 len);
+	void interpolate8_inf(SampleVector::iterator* it, T* buf, qint32 len);
+	void interpolate8_sup(SampleVector::iterator* it, T* buf, qint32 len);
+	void interpolate16_inf(SampleVector::iterator* it, T* buf, qint32 len);
+	void interpolate16_sup(SampleVector::iterator* it, T* buf, qint32 len);
+	void interpolate32_inf(SampleVector::iterator* it, T* buf, qint32 len);
+	void interpolate32_sup(SampleVector::iterator* it, T* buf, qint32 len);
+	void interpolate64_inf(SampleVector::iterator* it, T* buf, qint32 len);
+	void interpolate64_sup(SampleVector::iterator* it, T* buf, qint32 len);
 
 private:
-#ifdef USE_SSE4_1
+    static const T m_maxValue = (1<<(OutputBits-1)) - 1;
+
+    static T neg(T v) { return v < -m_maxValue ? m_maxValue : -v; } //!< saturated negation
+    static void shiftInf(T* buf, qint32 len); //!< rotate interleaved I/Q by -fs/4 in place (len multiple of 8)
+    static void shiftSup(T* buf, qint32 len); //!< rotate interleaved I/Q by +fs/4 in place (len multiple of 8)
+
+#if defined(USE_SSE4_1) || defined(USE_SIMD_DISPATCH)
     IntHalfbandFilterEO1<INTERPOLATORS_HB_FILTER_ORDER_FIRST> m_interpolator2;  // 1st stages
     IntHalfbandFilterEO1<INTERPOLATORS_HB_FILTER_ORDER_SECOND> m_interpolator4;  // 2nd stages
     IntHalfbandFilterEO1<INTERPOLATORS_HB_FILTER_ORDER_NEXT> m_interpolator8;  // 3rd stages
@@ -609,9 +627,155 @@ void Interpolators<T, SdrBits, OutputBits>::interpolate64_cen(SampleVector::iter
         buf[pos+107] = intbuf[107] >> interpolation_shifts<SdrBits, OutputBits>::post64;
         buf[pos+108] = intbuf[108] >> interpolation_shifts<SdrBits, OutputBits>::post64;
         buf[pos+109] = intbuf[109] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+110] = intbuf[110] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+111] = intbuf[111] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+112] = intbuf[112] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+113] = intbuf[113] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+114] = intbuf[114] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+115] = intbuf[115] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+116] = intbuf[116] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+117] = intbuf[117] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+118] = intbuf[118] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+119] = intbuf[119] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+120] = intbuf[120] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+121] = intbuf[121] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+122] = intbuf[122] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+123] = intbuf[123] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+124] = intbuf[124] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+125] = intbuf[125] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+126] = intbuf[126] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+127] = intbuf[127] >> interpolation_shifts<SdrBits, OutputBits>::post64;
 
         ++(*it);
 	}
 }
 
+template<typename T, uint SdrBits, uint OutputBits>
+void Interpolators<T, SdrBits, OutputBits>::shiftInf(T* buf, qint32 len)
+{
+    T x;
+
+    for (int pos = 0; pos < len - 7; pos += 8)
+    {
+        // n = 1: (x,y) * -j = (y,-x)
+        x = buf[pos+2];
+        buf[pos+2] = buf[pos+3];
+        buf[pos+3] = neg(x);
+        // n = 2: (x,y) * -1 = (-x,-y)
+        buf[pos+4] = neg(buf[pos+4]);
+        buf[pos+5] = neg(buf[pos+5]);
+        // n = 3: (x,y) * j = (-y,x)
+        x = buf[pos+6];
+        buf[pos+6] = neg(buf[pos+7]);
+        buf[pos+7] = x;
+    }
+}
+
+template<typename T, uint SdrBits, uint OutputBits>
+void Interpolators<T, SdrBits, OutputBits>::shiftSup(T* buf, qint32 len)
+{
+    T x;
+
+    for (int pos = 0; pos < len - 7; pos += 8)
+    {
+        // n = 1: (x,y) * j = (-y,x)
+        x = buf[pos+2];
+        buf[pos+2] = neg(buf[pos+3]);
+        buf[pos+3] = x;
+        // n = 2: (x,y) * -1 = (-x,-y)
+        buf[pos+4] = neg(buf[pos+4]);
+        buf[pos+5] = neg(buf[pos+5]);
+        // n = 3: (x,y) * -j = (y,-x)
+        x = buf[pos+6];
+        buf[pos+6] = buf[pos+7];
+        buf[pos+7] = neg(x);
+    }
+}
+
+template<typename T, uint SdrBits, uint OutputBits>
+void Interpolators<T, SdrBits, OutputBits>::interpolate2_inf(SampleVector::iterator* it, T* buf, qint32 len)
+{
+    // process whole fs/4 rotation periods (4 output samples) only
+    interpolate2_cen(it, buf, len - (len % 8));
+    shiftInf(buf, len - (len % 8));
+}
+
+template<typename T, uint SdrBits, uint OutputBits>
+void Interpolators<T, SdrBits, OutputBits>::interpolate2_sup(SampleVector::iterator* it, T* buf, qint32 len)
+{
+    // process whole fs/4 rotation periods (4 output samples) only
+    interpolate2_cen(it, buf, len - (len % 8));
+    shiftSup(buf, len - (len % 8));
+}
+
+template<typename T, uint SdrBits, uint OutputBits>
+void Interpolators<T, SdrBits, OutputBits>::interpolate4_inf(SampleVector::iterator* it, T* buf, qint32 len)
+{
+    interpolate4_cen(it, buf, len);
+    shiftInf(buf, len - (len % 8));
+}
+
+template<typename T, uint SdrBits, uint OutputBits>
+void Interpolators<T, SdrBits, OutputBits>::interpolate4_sup(SampleVector::iterator* it, T* buf, qint32 len)
+{
+    interpolate4_cen(it, buf, len);
+    shiftSup(buf, len - (len % 8));
+}
+
+template<typename T, uint SdrBits, uint OutputBits>
+void Interpolators<T, SdrBits, OutputBits>::interpolate8_inf(SampleVector::iterator* it, T* buf, qint32 len)
+{
+    interpolate8_cen(it, buf, len);
+    shiftInf(buf, len - (len % 16));
+}
+
+template<typename T, uint SdrBits, uint OutputBits>
+void Interpolators<T, SdrBits, OutputBits>::interpolate8_sup(SampleVector::iterator* it, T* buf, qint32 len)
+{
+    interpolate8_cen(it, buf, len);
+    shiftSup(buf, len - (len % 16));
+}
+
+template<typename T, uint SdrBits, uint OutputBits>
+void Interpolators<T, SdrBits, OutputBits>::interpolate16_inf(SampleVector::iterator* it, T* buf, qint32 len)
+{
+    interpolate16_cen(it, buf, len);
+    shiftInf(buf, len - (len % 32));
+}
+
+template<typename T, uint SdrBits, uint OutputBits>
+void Interpolators<T, SdrBits, OutputBits>::interpolate16_sup(SampleVector::iterator* it, T* buf, qint32 len)
+{
+    interpolate16_cen(it, buf, len);
+    shiftSup(buf, len - (len % 32));
+}
+
+template<typename T, uint SdrBits, uint OutputBits>
+void Interpolators<T, SdrBits, OutputBits>::interpolate32_inf(SampleVector::iterator* it, T* buf, qint32 len)
+{
+    interpolate32_cen(it, buf, len);
+    shiftInf(buf, len - (len % 64));
+}
+
+template<typename T, uint SdrBits, uint OutputBits>
+void Interpolators<T, SdrBits, OutputBits>::interpolate32_sup(SampleVector::iterator* it, T* buf, qint32 len)
+{
+    interpolate32_cen(it, buf, len);
+    shiftSup(buf, len - (len % 64));
+}
+
+template<typename T, uint SdrBits, uint OutputBits>
+void Interpolators<T, SdrBits, OutputBits>::interpolate64_inf(SampleVector::iterator* it, T* buf, qint32 len)
+{
+    interpolate64_cen(it, buf, len);
+    shiftInf(buf, len - (len % 128));
+}
+
+template<typename T, uint SdrBits, uint OutputBits>
+void Interpolators<T, SdrBits, OutputBits>::interpolate64_sup(SampleVector::iterator* it, T* buf, qint32 len)
+{
+    interpolate64_cen(it, buf, len);
+    shiftSup(buf, len - (len % 128));
+}
+
 #endif /* INCLUDE_GPL_DSP_INTERPOLATORS_H_ */
@@ -24,23 +24,70 @@
 
 #include <stdint.h>
 
-#if defined(USE_SSE4_1)
+#if defined(USE_SIMD_DISPATCH)
+#include <immintrin.h>
+#elif defined(USE_SSE4_1)
 #include <smmintrin.h>
 #endif
 
 #include "hbfiltertraits.h"
+#include "simddispatch.h"
 
 template<uint32_t HBFilterOrder>
 class IntHalfbandFilterEO1Intrisics
 {
 public:
+    typedef void (*WorkFunction)(int, int32_t[2][HBFilterOrder], int32_t[2][HBFilterOrder], int32_t&, int32_t&);
+
     static void work(
             int ptr,
             int32_t even[2][HBFilterOrder],
             int32_t odd[2][HBFilterOrder],
             int32_t& iAcc, int32_t& qAcc)
     {
-#if defined(USE_SSE4_1)
+#if defined(USE_SIMD_DISPATCH)
+        static const WorkFunction workFunction = selectWork();
+        workFunction(ptr, even, odd, iAcc, qAcc);
+#elif defined(USE_SSE4_1)
+        workSSE4_1(ptr, even, odd, iAcc, qAcc);
+#else
+        workScalar(ptr, even, odd, iAcc, qAcc);
+#endif
+    }
+
+    static void workScalar(
+            int ptr,
+            int32_t even[2][HBFilterOrder],
+            int32_t odd[2][HBFilterOrder],
+            int32_t& iAcc, int32_t& qAcc)
+    {
+        int32_t (*buf)[HBFilterOrder] = (ptr % 2) == 0 ? even : odd;
+        int a = ptr/2 + HBFIRFilterTraits<HBFilterOrder>::hbOrder/2; // tip pointer
+        int b = ptr/2 + 1; // tail pointer
+        int32_t sumI = 0;
+        int32_t sumQ = 0;
+
+        for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i++)
+        {
+            sumI += (buf[0][a] + buf[0][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+            sumQ += (buf[1][a] + buf[1][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+            a -= 1;
+            b += 1;
+        }
+
+        iAcc = sumI;
+        qAcc = sumQ;
+    }
+
+#if defined(USE_SSE4_1) || defined(USE_SIMD_DISPATCH)
+    SIMD_TARGET("sse4.1")
+    static void workSSE4_1(
+            int ptr,
+            int32_t even[2][HBFilterOrder],
+            int32_t odd[2][HBFilterOrder],
+            int32_t& iAcc, int32_t& qAcc)
+    {
+        int32_t (*buf)[HBFilterOrder] = (ptr % 2) == 0 ? even : odd;
         int a = ptr/2 + HBFIRFilterTraits<HBFilterOrder>::hbOrder/2; // tip pointer
         int b = ptr/2 + 1; // tail pointer
         const __m128i* h = (const __m128i*) HBFIRFilterTraits<HBFilterOrder>::hbCoeffs;
@@ -51,26 +98,13 @@ public:
 
         for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 16; i++)
         {
-            if ((ptr % 2) == 0)
-            {
-                sa = _mm_shuffle_epi32(_mm_loadu_si128((__m128i*) &(even[0][a])), _MM_SHUFFLE(0,1,2,3));
-                sb = _mm_loadu_si128((__m128i*) &(even[0][b]));
-                sumI = _mm_add_epi32(sumI, _mm_mullo_epi32(_mm_add_epi32(sa, sb), *h));
-
-                sa = _mm_shuffle_epi32(_mm_loadu_si128((__m128i*) &(even[1][a])), _MM_SHUFFLE(0,1,2,3));
-                sb = _mm_loadu_si128((__m128i*) &(even[1][b]));
-                sumQ = _mm_add_epi32(sumQ, _mm_mullo_epi32(_mm_add_epi32(sa, sb), *h));
-            }
-            else
-            {
-                sa = _mm_shuffle_epi32(_mm_loadu_si128((__m128i*) &(odd[0][a])), _MM_SHUFFLE(0,1,2,3));
-                sb = _mm_loadu_si128((__m128i*) &(odd[0][b]));
-                sumI = _mm_add_epi32(sumI, _mm_mullo_epi32(_mm_add_epi32(sa, sb), *h));
-
-                sa = _mm_shuffle_epi32(_mm_loadu_si128((__m128i*) &(odd[1][a])), _MM_SHUFFLE(0,1,2,3));
-                sb = _mm_loadu_si128((__m128i*) &(odd[1][b]));
-                sumQ = _mm_add_epi32(sumQ, _mm_mullo_epi32(_mm_add_epi32(sa, sb), *h));
-            }
+            sa = _mm_shuffle_epi32(_mm_loadu_si128((__m128i*) &(buf[0][a])), _MM_SHUFFLE(0,1,2,3));
+            sb = _mm_loadu_si128((__m128i*) &(buf[0][b]));
+            sumI = _mm_add_epi32(sumI, _mm_mullo_epi32(_mm_add_epi32(sa, sb), *h));
+
+            sa = _mm_shuffle_epi32(_mm_loadu_si128((__m128i*) &(buf[1][a])), _MM_SHUFFLE(0,1,2,3));
+            sb = _mm_loadu_si128((__m128i*) &(buf[1][b]));
+            sumQ = _mm_add_epi32(sumQ, _mm_mullo_epi32(_mm_add_epi32(sa, sb), *h));
 
             a -= 4;
             b += 4;
@@ -86,8 +120,84 @@ public:
         sumQ = _mm_add_epi32(sumQ, _mm_srli_si128(sumQ, 8));
         sumQ = _mm_add_epi32(sumQ, _mm_srli_si128(sumQ, 4));
         qAcc = _mm_cvtsi128_si32(sumQ);
+    }
 #endif
+
+#if defined(USE_SIMD_DISPATCH)
+    /**
+     * Same as workSSE4_1 but eight taps at a time. Integer additions wrap around the same way
+     * whatever the order they are done in so the result is bit exact with the other variants.
+     */
+    SIMD_TARGET("avx2")
+    static void workAVX2(
+            int ptr,
+            int32_t even[2][HBFilterOrder],
+            int32_t odd[2][HBFilterOrder],
+            int32_t& iAcc, int32_t& qAcc)
+    {
+        int32_t (*buf)[HBFilterOrder] = (ptr % 2) == 0 ? even : odd;
+        int a = ptr/2 + HBFIRFilterTraits<HBFilterOrder>::hbOrder/2; // tip pointer
+        int b = ptr/2 + 1; // tail pointer
+        const int32_t *h = HBFIRFilterTraits<HBFilterOrder>::hbCoeffs;
+        const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        __m256i sumI8 = _mm256_setzero_si256();
+        __m256i sumQ8 = _mm256_setzero_si256();
+        __m256i sa, sb, hv;
+
+        for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 32; i++)
+        {
+            hv = _mm256_loadu_si256((const __m256i*) h);
+
+            sa = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*) &(buf[0][a-7])), reverse);
+            sb = _mm256_loadu_si256((const __m256i*) &(buf[0][b]));
+            sumI8 = _mm256_add_epi32(sumI8, _mm256_mullo_epi32(_mm256_add_epi32(sa, sb), hv));
+
+            sa = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*) &(buf[1][a-7])), reverse);
+            sb = _mm256_loadu_si256((const __m256i*) &(buf[1][b]));
+            sumQ8 = _mm256_add_epi32(sumQ8, _mm256_mullo_epi32(_mm256_add_epi32(sa, sb), hv));
+
+            a -= 8;
+            b += 8;
+            h += 8;
+        }
+
+        __m128i sumI = _mm_add_epi32(_mm256_castsi256_si128(sumI8), _mm256_extracti128_si256(sumI8, 1));
+        __m128i sumQ = _mm_add_epi32(_mm256_castsi256_si128(sumQ8), _mm256_extracti128_si256(sumQ8, 1));
+
+        if ((HBFIRFilterTraits<HBFilterOrder>::hbOrder / 16) % 2 != 0) // remaining four taps
+        {
+            __m128i hv4 = _mm_loadu_si128((const __m128i*) h);
+            __m128i sa4, sb4;
+
+            sa4 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &(buf[0][a-3])), _MM_SHUFFLE(0,1,2,3));
+            sb4 = _mm_loadu_si128((const __m128i*) &(buf[0][b]));
+            sumI = _mm_add_epi32(sumI, _mm_mullo_epi32(_mm_add_epi32(sa4, sb4), hv4));
+
+            sa4 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &(buf[1][a-3])), _MM_SHUFFLE(0,1,2,3));
+            sb4 = _mm_loadu_si128((const __m128i*) &(buf[1][b]));
+            sumQ = _mm_add_epi32(sumQ, _mm_mullo_epi32(_mm_add_epi32(sa4, sb4), hv4));
+        }
+
+        sumI = _mm_add_epi32(sumI, _mm_srli_si128(sumI, 8));
+        sumI = _mm_add_epi32(sumI, _mm_srli_si128(sumI, 4));
+        iAcc = _mm_cvtsi128_si32(sumI);
+
+        sumQ = _mm_add_epi32(sumQ, _mm_srli_si128(sumQ, 8));
+        sumQ = _mm_add_epi32(sumQ, _mm_srli_si128(sumQ, 4));
+        qAcc = _mm_cvtsi128_si32(sumQ);
     }
+
+    static WorkFunction selectWork()
+    {
+        if (SIMDDispatch::hasAVX2()) {
+            return &workAVX2;
+        } else if (SIMDDispatch::hasSSE4_1()) {
+            return &workSSE4_1;
+        } else {
+            return &workScalar;
+        }
+    }
+#endif
 };
 
 #endif /* SDRBASE_DSP_INTHALFBANDFILTEREO1I_H_ */
@@ -0,0 +1,246 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <limits>
+
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
+
+#include "dsp/iqcorrection.h"
+
+IQCorrection::IQCorrection() :
+    m_config(0),
+    m_resetRequest(0),
+    m_iOffset(0),
+    m_qOffset(0),
+    m_iRange(1 << 16),
+    m_qRange(1 << 16),
+    m_imbalance(65536)
+{
+}
+
+void IQCorrection::configure(bool dcOffsetCorrection, bool iqImbalanceCorrection)
+{
+    int config = (dcOffsetCorrection ? DCOffset : 0) | (iqImbalanceCorrection ? IQImbalance : 0);
+    int previous = m_config.fetchAndStoreOrdered(config);
+    int changed = previous ^ config;
+
+    if (changed) {
+        m_resetRequest.fetchAndOrOrdered(changed);
+    }
+}
+
+void IQCorrection::reset()
+{
+    m_resetRequest.fetchAndOrOrdered(DCOffset | IQImbalance);
+}
+
+void IQCorrection::process(SampleVector::iterator begin, SampleVector::iterator end)
+{
+    if (begin == end) {
+        return;
+    }
+
+    Sample *first = &(*begin);
+    process(first, first + (end - begin));
+}
+
+void IQCorrection::process(Sample *begin, Sample *end)
+{
+    int resetRequest = m_resetRequest.fetchAndStoreOrdered(0);
+
+    if (resetRequest & DCOffset)
+    {
+        m_iOffset = 0;
+        m_qOffset = 0;
+    }
+
+    if (resetRequest & IQImbalance)
+    {
+        m_iRange = 1 << 16;
+        m_qRange = 1 << 16;
+        m_imbalance = 65536;
+    }
+
+    int config = m_config.loadAcquire();
+
+    if ((config == 0) || (begin == end)) {
+        return;
+    }
+
+    // corrections estimated from the previous blocks
+    FixReal iCorr = (config & DCOffset) ? (FixReal) m_iOffset : 0;
+    FixReal qCorr = (config & DCOffset) ? (FixReal) m_qOffset : 0;
+    qint32 imbalance = (config & IQImbalance) ? m_imbalance : 65536;
+
+    BlockStats stats;
+    stats.iSum = 0;
+    stats.qSum = 0;
+    stats.iMin = std::numeric_limits<FixReal>::max();
+    stats.iMax = std::numeric_limits<FixReal>::min();
+    stats.qMin = std::numeric_limits<FixReal>::max();
+    stats.qMax = std::numeric_limits<FixReal>::min();
+
+    Sample *it = begin;
+#if defined(USE_SSE2)
+    it = processSSE2(it, end, iCorr, qCorr, imbalance, stats);
+#endif
+
+    switch (config)
+    {
+    case DCOffset:
+        processScalar<true, false>(it, end, iCorr, qCorr, imbalance, stats);
+        break;
+    case IQImbalance:
+        processScalar<false, true>(it, end, iCorr, qCorr, imbalance, stats);
+        break;
+    default:
+        processScalar<true, true>(it, end, iCorr, qCorr, imbalance, stats);
+        break;
+    }
+
+    // moving averages over the last 16 blocks
+    if (config & DCOffset)
+    {
+        double count = end - begin;
+        m_iOffset = (15.0 * m_iOffset + (double) stats.iSum / count) / 16.0;
+        m_qOffset = (15.0 * m_qOffset + (double) stats.qSum / count) / 16.0;
+    }
+
+    if (config & IQImbalance)
+    {
+        m_iRange = (m_iRange * 15 + (stats.iMax - stats.iMin)) >> 4;
+        m_qRange = (m_qRange * 15 + (stats.qMax - stats.qMin)) >> 4;
+
+        // calculate imbalance as Q15.16
+        if (m_qRange != 0) {
+            m_imbalance = ((uint) m_iRange << 16) / (uint) m_qRange;
+        }
+    }
+}
+
+template<bool DCOffsetEnabled, bool IQImbalanceEnabled>
+void IQCorrection::processScalar(Sample *begin, Sample *end, FixReal iCorr, FixReal qCorr, qint32 imbalance, BlockStats& stats)
+{
+    // locals so that the stores to the samples do not force the statistics back to memory
+    qint64 iSum = 0, qSum = 0;
+    qint32 iMin = stats.iMin, iMax = stats.iMax;
+    qint32 qMin = stats.qMin, qMax = stats.qMax;
+
+    for (Sample *it = begin; it < end; ++it)
+    {
+        FixReal i = it->m_real;
+        FixReal q = it->m_imag;
+
+        if (DCOffsetEnabled)
+        {
+            iSum += i;
+            qSum += q;
+            i -= iCorr;
+            q -= qCorr;
+            it->m_real = i;
+        }
+
+        if (IQImbalanceEnabled)
+        {
+            iMin = std::min(iMin, (qint32) i);
+            iMax = std::max(iMax, (qint32) i);
+            qMin = std::min(qMin, (qint32) q);
+            qMax = std::max(qMax, (qint32) q);
+            q = (q * imbalance) >> 16;
+        }
+
+        it->m_imag = q;
+    }
+
+    stats.iSum += iSum;
+    stats.qSum += qSum;
+    stats.iMin = iMin;
+    stats.iMax = iMax;
+    stats.qMin = qMin;
+    stats.qMax = qMax;
+}
+
+#if defined(USE_SSE2)
+/**
+ * Four interleaved I/Q samples per vector. Even 16 bit lanes are I and odd lanes are Q.
+ * The Q15.16 imbalance multiply is split into a low multiply by the integer part and a high
+ * multiply by the fractional part so it stays in 16 bit lanes. I lanes are multiplied by 1.
+ * Sums are taken in 32 bit lanes and flushed often enough that they cannot overflow.
+ */
+Sample *IQCorrection::processSSE2(Sample *begin, Sample *end, FixReal iCorr, FixReal qCorr, qint32 imbalance, BlockStats& stats)
+{
+    static const int flushPeriod = 1 << 14; // 2^14 * 2^15 per 32 bit lane
+
+    qint32 imbInt = imbalance >> 16;
+    qint32 imbFrac = imbalance & 0xFFFF;
+
+    if (imbFrac >= 0x8000) // make the fraction fit the signed high multiply
+    {
+        imbInt += 1;
+        imbFrac -= 0x10000;
+    }
+
+    const __m128i corr = _mm_setr_epi16(iCorr, qCorr, iCorr, qCorr, iCorr, qCorr, iCorr, qCorr);
+    const __m128i mulInt = _mm_setr_epi16(1, imbInt, 1, imbInt, 1, imbInt, 1, imbInt);
+    const __m128i mulFrac = _mm_setr_epi16(0, imbFrac, 0, imbFrac, 0, imbFrac, 0, imbFrac);
+    __m128i vmin = _mm_set1_epi16(std::numeric_limits<FixReal>::max());
+    __m128i vmax = _mm_set1_epi16(std::numeric_limits<FixReal>::min());
+    Sample *it = begin;
+
+    while (end - it >= 4)
+    {
+        __m128i iSum = _mm_setzero_si128();
+        __m128i qSum = _mm_setzero_si128();
+        Sample *flushEnd = it + 4 * std::min<std::ptrdiff_t>((end - it) / 4, flushPeriod);
+
+        for (; it < flushEnd; it += 4)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i*) it);
+            iSum = _mm_add_epi32(iSum, _mm_srai_epi32(_mm_slli_epi32(v, 16), 16));
+            qSum = _mm_add_epi32(qSum, _mm_srai_epi32(v, 16));
+            v = _mm_sub_epi16(v, corr);
+            vmin = _mm_min_epi16(vmin, v);
+            vmax = _mm_max_epi16(vmax, v);
+            v = _mm_add_epi16(_mm_mullo_epi16(v, mulInt), _mm_mulhi_epi16(v, mulFrac));
+            _mm_storeu_si128((__m128i*) it, v);
+        }
+
+        qint32 iSums[4], qSums[4];
+        _mm_storeu_si128((__m128i*) iSums, iSum);
+        _mm_storeu_si128((__m128i*) qSums, qSum);
+        stats.iSum += (qint64) iSums[0] + iSums[1] + iSums[2] + iSums[3];
+        stats.qSum += (qint64) qSums[0] + qSums[1] + qSums[2] + qSums[3];
+    }
+
+    qint16 mins[8], maxs[8];
+    _mm_storeu_si128((__m128i*) mins, vmin);
+    _mm_storeu_si128((__m128i*) maxs, vmax);
+
+    for (int k = 0; k < 8; k += 2)
+    {
+        stats.iMin = std::min(stats.iMin, (qint32) mins[k]);
+        stats.iMax = std::max(stats.iMax, (qint32) maxs[k]);
+        stats.qMin = std::min(stats.qMin, (qint32) mins[k+1]);
+        stats.qMax = std::max(stats.qMax, (qint32) maxs[k+1]);
+    }
+
+    return it;
+}
+#endif
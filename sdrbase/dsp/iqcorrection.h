@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_DSP_IQCORRECTION_H_
+#define SDRBASE_DSP_IQCORRECTION_H_
+
+#include <QAtomicInt>
+#include "dsp/dsptypes.h"
+#include "util/export.h"
+
+/**
+ * DC offset and IQ imbalance correction of the baseband samples of a device.
+ *
+ * Estimation and correction are done in a single pass over each block. The DC offset estimate
+ * of the previous blocks is removed while the raw sums are taken, the I and Q ranges are measured
+ * on the DC corrected samples and Q is scaled by the imbalance ratio estimated from the previous
+ * blocks. Estimates are then updated with the block statistics as a 16 block moving average.
+ *
+ * process() must be called from one thread at a time (the DSP engine thread or, when the
+ * correction is done at acquisition, the device thread writing the sample FIFO).
+ * configure() and reset() may be called from any thread and take effect on the next block.
+ */
+class SDRANGEL_API IQCorrection
+{
+public:
+    IQCorrection();
+
+    void configure(bool dcOffsetCorrection, bool iqImbalanceCorrection); //!< Enable or disable each correction. Estimates of a changed correction are reset.
+    void reset(); //!< Reset all estimates
+    bool isEnabled() const { return m_config.load() != 0; }
+
+    void process(SampleVector::iterator begin, SampleVector::iterator end);
+    void process(Sample *begin, Sample *end);
+
+    double getIOffset() const { return m_iOffset; }
+    double getQOffset() const { return m_qOffset; }
+    qint32 getImbalance() const { return m_imbalance; }
+
+private:
+    enum
+    {
+        DCOffset = 1,
+        IQImbalance = 2
+    };
+
+    QAtomicInt m_config;       //!< enabled corrections
+    QAtomicInt m_resetRequest; //!< estimates to reset before the next block
+
+    double m_iOffset, m_qOffset;
+    qint32 m_iRange;
+    qint32 m_qRange;
+    qint32 m_imbalance; //!< Q/I ratio as Q15.16
+
+    struct BlockStats
+    {
+        qint64 iSum, qSum;
+        qint32 iMin, iMax;
+        qint32 qMin, qMax;
+    };
+
+    template<bool DCOffsetEnabled, bool IQImbalanceEnabled>
+    void processScalar(Sample *begin, Sample *end, FixReal iCorr, FixReal qCorr, qint32 imbalance, BlockStats& stats);
+#if defined(USE_SSE2)
+    Sample *processSSE2(Sample *begin, Sample *end, FixReal iCorr, FixReal qCorr, qint32 imbalance, BlockStats& stats);
+#endif
+};
+
+#endif /* SDRBASE_DSP_IQCORRECTION_H_ */
@@ -19,6 +19,9 @@
 #include <stdio.h>
 #define _USE_MATH_DEFINES
 #include <math.h>
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
 #include "dsp/nco.h"
 
 #undef M_PI
@@ -41,67 +44,230 @@ void NCO::initTable()
 NCO::NCO()
 {
 	initTable();
+	m_phaseIncrement = 0;
 	m_phase = 0;
 }
 
 void NCO::setFreq(Real freq, Real sampleRate)
 {
-	m_phaseIncrement = (freq * TableSize) / sampleRate;
-	qDebug("NCO freq: %f phase inc %d", freq, m_phaseIncrement);
+	// fraction of a turn per sample over the 32 bit accumulator, negative frequencies wrap around
+	m_phaseIncrement = (quint32) (qint64) llround(((double) freq / sampleRate) * 4294967296.0);
+	qDebug("NCO freq: %f phase inc %d", freq, (qint32) m_phaseIncrement);
+}
+
+void NCO::phasor(quint32 phase, Real& re, Real& im)
+{
+	int idx = phase >> PhaseShift;
+	Real residual = (phase & ((1U << PhaseShift) - 1)) * (Real) (2.0 * M_PI / 4294967296.0);
+	// exp(j*residual) to second order: residual is less than one table step
+	Real rr = 1.0f - 0.5f * residual * residual;
+	Real c0 = m_table[idx];
+	Real s0 = -m_table[(idx + TableSize / 4) & (TableSize - 1)];
+	re = c0 * rr - s0 * residual;
+	im = s0 * rr + c0 * residual;
 }
 
 float NCO::next()
 {
 	nextPhase();
-	return m_table[m_phase];
+	return cosAt(index());
 }
 
 Complex NCO::nextIQ()
 {
 	nextPhase();
-	return Complex(m_table[m_phase], -m_table[(m_phase + TableSize / 4) % TableSize]);
+	int idx = index();
+	return Complex(cosAt(idx), sinAt(idx));
 }
 
 Complex NCO::nextQI()
 {
 	nextPhase();
-	return Complex(-m_table[(m_phase + TableSize / 4) % TableSize], m_table[m_phase]);
+	int idx = index();
+	return Complex(sinAt(idx), cosAt(idx));
 }
 
 void NCO::nextIQMul(Real& i, Real& q)
 {
     nextPhase();
+    int idx = index();
     Real x = i;
     Real y = q;
-    const Real& u = m_table[m_phase];
-    const Real& v = -m_table[(m_phase + TableSize / 4) % TableSize];
+    const Real u = cosAt(idx);
+    const Real v = sinAt(idx);
     i = x*u - y*v;
     q = x*v + y*u;
 }
 
 float NCO::get()
 {
-	return m_table[m_phase];
+	return cosAt(index());
 }
 
 Complex NCO::getIQ()
 {
-	return Complex(m_table[m_phase], -m_table[(m_phase + TableSize / 4) % TableSize]);
+	int idx = index();
+	return Complex(cosAt(idx), sinAt(idx));
 }
 
 void NCO::getIQ(Complex& c)
 {
-	c.real(m_table[m_phase]);
-	c.imag(-m_table[(m_phase + TableSize / 4) % TableSize]);
+	int idx = index();
+	c.real(cosAt(idx));
+	c.imag(sinAt(idx));
 }
 
 Complex NCO::getQI()
 {
-	return Complex(-m_table[(m_phase + TableSize / 4) % TableSize], m_table[m_phase]);
+	int idx = index();
+	return Complex(sinAt(idx), cosAt(idx));
 }
 
 void NCO::getQI(Complex& c)
 {
-	c.imag(m_table[m_phase]);
-	c.real(-m_table[(m_phase + TableSize / 4) % TableSize]);
+	int idx = index();
+	c.imag(cosAt(idx));
+	c.real(sinAt(idx));
+}
+
+/**
+ * Block generation. Runs of BlockRun samples are seeded from the accumulator with phasor() so the
+ * phase never drifts from the per sample one, then four lanes are rotated by four phase increments
+ * at a time. The remainder of a run that does not fill the four lanes is computed with phasor().
+ */
+template<bool Mix>
+static inline void ncoRun(const Sample *in, Complex *out, int len, const Real *seedRe, const Real *seedIm, Real rotRe, Real rotIm)
+{
+#if defined(USE_SSE2)
+	__m128 pr = _mm_loadu_ps(seedRe);
+	__m128 pi = _mm_loadu_ps(seedIm);
+	const __m128 rr = _mm_set1_ps(rotRe);
+	const __m128 ri = _mm_set1_ps(rotIm);
+
+	for (int k = 0; k < len; k += 4)
+	{
+		__m128 re = pr;
+		__m128 im = pi;
+
+		if (Mix)
+		{
+			// 4 interleaved 16 bit I/Q samples to separate I and Q floats
+			__m128i v = _mm_loadu_si128((const __m128i*) (in + k));
+			__m128 lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+			__m128 hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+			__m128 sr = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2,0,2,0));
+			__m128 si = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3,1,3,1));
+			re = _mm_sub_ps(_mm_mul_ps(sr, pr), _mm_mul_ps(si, pi));
+			im = _mm_add_ps(_mm_mul_ps(sr, pi), _mm_mul_ps(si, pr));
+		}
+
+		_mm_storeu_ps((float*) (out + k), _mm_unpacklo_ps(re, im));
+		_mm_storeu_ps((float*) (out + k + 2), _mm_unpackhi_ps(re, im));
+
+		__m128 nr = _mm_sub_ps(_mm_mul_ps(pr, rr), _mm_mul_ps(pi, ri));
+		pi = _mm_add_ps(_mm_mul_ps(pr, ri), _mm_mul_ps(pi, rr));
+		pr = nr;
+	}
+#else
+	Real pr[4], pi[4];
+
+	for (int j = 0; j < 4; j++)
+	{
+		pr[j] = seedRe[j];
+		pi[j] = seedIm[j];
+	}
+
+	for (int k = 0; k < len; k += 4)
+	{
+		for (int j = 0; j < 4; j++)
+		{
+			if (Mix) {
+				Real sr = in[k+j].real();
+				Real si = in[k+j].imag();
+				out[k+j] = Complex(sr * pr[j] - si * pi[j], sr * pi[j] + si * pr[j]);
+			} else {
+				out[k+j] = Complex(pr[j], pi[j]);
+			}
+
+			Real nr = pr[j] * rotRe - pi[j] * rotIm;
+			pi[j] = pr[j] * rotIm + pi[j] * rotRe;
+			pr[j] = nr;
+		}
+	}
+#endif
+}
+
+void NCO::nextIQ(Complex *out, int count)
+{
+	Real seedRe[4], seedIm[4];
+	Real rotRe, rotIm;
+	phasor(4 * m_phaseIncrement, rotRe, rotIm);
+
+	while (count > 0)
+	{
+		int len = count < BlockRun ? count & ~3 : (int) BlockRun;
+
+		for (int j = 0; j < 4; j++) {
+			phasor(m_phase + (j + 1) * m_phaseIncrement, seedRe[j], seedIm[j]);
+		}
+
+		if (len > 0)
+		{
+			ncoRun<false>(0, out, len, seedRe, seedIm, rotRe, rotIm);
+			m_phase += len * m_phaseIncrement;
+		}
+		else
+		{
+			for (len = 0; len < count; len++)
+			{
+				nextPhase();
+				phasor(m_phase, seedRe[0], seedIm[0]);
+				out[len] = Complex(seedRe[0], seedIm[0]);
+			}
+		}
+
+		out += len;
+		count -= len;
+	}
+}
+
+void NCO::mix(SampleVector::const_iterator begin, SampleVector::const_iterator end, Complex *out)
+{
+	if (begin == end) {
+		return;
+	}
+
+	const Sample *in = &(*begin);
+	int count = end - begin;
+	Real seedRe[4], seedIm[4];
+	Real rotRe, rotIm;
+	phasor(4 * m_phaseIncrement, rotRe, rotIm);
+
+	while (count > 0)
+	{
+		int len = count < BlockRun ? count & ~3 : (int) BlockRun;
+
+		for (int j = 0; j < 4; j++) {
+			phasor(m_phase + (j + 1) * m_phaseIncrement, seedRe[j], seedIm[j]);
+		}
+
+		if (len > 0)
+		{
+			ncoRun<true>(in, out, len, seedRe, seedIm, rotRe, rotIm);
+			m_phase += len * m_phaseIncrement;
+		}
+		else
+		{
+			for (len = 0; len < count; len++)
+			{
+				nextPhase();
+				phasor(m_phase, seedRe[0], seedIm[0]);
+				out[len] = Complex(in[len].real(), in[len].imag()) * Complex(seedRe[0], seedIm[0]);
+			}
+		}
+
+		in += len;
+		out += len;
+		count -= len;
+	}
 }
@@ -21,32 +21,44 @@
 #include "dsp/dsptypes.h"
 #include "util/export.h"
 
+/**
+ * Table based numerically controlled oscillator.
+ *
+ * The phase is a 32 bit accumulator wrapping naturally over a full turn so the frequency
+ * resolution is sampleRate / 2^32. Per sample methods read the 4096 entry table at the nearest
+ * index. Block methods start each run of samples from the table entry corrected by the residual
+ * phase and rotate from there, which gives a much lower spurious level than table truncation.
+ */
 class SDRANGEL_API NCO {
 private:
 	enum {
-		TableSize = (1 << 12),
+		TableBits = 12,
+		TableSize = (1 << TableBits),
+		PhaseShift = 32 - TableBits, //!< accumulator bits below the table index
+		BlockRun = 32                //!< samples generated by rotation before re-seeding from the accumulator
 	};
 	static Real m_table[TableSize];
 	static bool m_tableInitialized;
 
 	static void initTable();
 
-	int m_phaseIncrement;
-	int m_phase;
+	quint32 m_phaseIncrement;
+	quint32 m_phase;
+
+	inline int index() const { return ((m_phase + (1U << (PhaseShift - 1))) >> PhaseShift) & (TableSize - 1); }
+	inline Real cosAt(int idx) const { return m_table[idx]; }
+	inline Real sinAt(int idx) const { return -m_table[(idx + TableSize / 4) & (TableSize - 1)]; }
+	static void phasor(quint32 phase, Real& re, Real& im); //!< exp(j*phase) from table and residual phase
 
 public:
 	NCO();
 
 	void setFreq(Real freq, Real sampleRate);
-	void setPhase(int phase) { m_phase = phase; }
+	void setPhase(int phase) { m_phase = (quint32) phase << PhaseShift; } //!< phase in table units
 
 	void nextPhase()        //!< Increment phase
 	{
 		m_phase += m_phaseIncrement;
-		while(m_phase >= TableSize)
-			m_phase -= TableSize;
-		while(m_phase < 0)
-			m_phase += TableSize;
 	}
 
 	Real next();            //!< Return next real sample
@@ -58,6 +70,9 @@ public:
 	void getIQ(Complex& c); //!< Sets to the current complex sample (no phase increment)
 	Complex getQI();        //!< Return current complex sample (no phase increment, reversed)
 	void getQI(Complex& c); //!< Sets to the current complex sample (no phase increment, reversed)
+
+	void nextIQ(Complex *out, int count); //!< Write the next count complex samples
+	void mix(SampleVector::const_iterator begin, SampleVector::const_iterator end, Complex *out); //!< Write input samples multiplied by the next complex samples
 };
 
 #endif // INCLUDE_NCO_H
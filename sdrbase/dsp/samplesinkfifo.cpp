@@ -16,15 +16,15 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include "samplesinkfifo.h"
+#include "iqcorrection.h"
 
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
 
 void SampleSinkFifo::create(uint s)
 {
 	m_size = 0;
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
+	m_head.storeRelease(0);
+	m_tail.storeRelease(0);
 
 	m_data.resize(s);
 	m_size = m_data.size();
@@ -35,18 +35,23 @@ void SampleSinkFifo::create(uint s)
 
 SampleSinkFifo::SampleSinkFifo(QObject* parent) :
 	QObject(parent),
-	m_data()
+	m_data(),
+	m_head(0),
+	m_tail(0),
+	m_dropped(0),
+	m_correction(0)
 {
 	m_suppressed = -1;
 	m_size = 0;
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
 }
 
 SampleSinkFifo::SampleSinkFifo(int size, QObject* parent) :
 	QObject(parent),
-	m_data()
+	m_data(),
+	m_head(0),
+	m_tail(0),
+	m_dropped(0),
+	m_correction(0)
 {
 	m_suppressed = -1;
 
@@ -55,8 +60,6 @@ SampleSinkFifo::SampleSinkFifo(int size, QObject* parent) :
 
 SampleSinkFifo::~SampleSinkFifo()
 {
-	QMutexLocker mutexLocker(&m_mutex);
-
 	m_size = 0;
 }
 
@@ -67,44 +70,57 @@ bool SampleSinkFifo::setSize(int size)
 	return m_data.size() == (uint)size;
 }
 
+void SampleSinkFifo::reportOverflow(uint count, uint total)
+{
+	m_dropped.fetchAndAddRelaxed(count - total);
+
+	if(m_suppressed < 0) {
+		m_suppressed = 0;
+		m_msgRateTimer.start();
+		qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
+	} else {
+		if(m_msgRateTimer.elapsed() > 2500) {
+			qCritical("SampleSinkFifo: %u messages dropped", m_suppressed);
+			qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
+			m_suppressed = -1;
+		} else {
+			m_suppressed++;
+		}
+	}
+}
+
 uint SampleSinkFifo::write(const quint8* data, uint count)
 {
-	QMutexLocker mutexLocker(&m_mutex);
-	uint total;
-	uint remaining;
-	uint len;
 	const Sample* begin = (const Sample*)data;
 	count /= 4;
 
-	total = MIN(count, m_size - m_fill);
+	int tail = m_tail.load(); // owned by this (producer) thread
+	uint space = m_size - distance(m_head.loadAcquire(), tail);
+	uint total = MIN(count, space);
+
 	if(total < count) {
-		if(m_suppressed < 0) {
-			m_suppressed = 0;
-			m_msgRateTimer.start();
-			qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
-		} else {
-			if(m_msgRateTimer.elapsed() > 2500) {
-				qCritical("SampleSinkFifo: %u messages dropped", m_suppressed);
-				qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
-				m_suppressed = -1;
-			} else {
-				m_suppressed++;
-			}
-		}
+		reportOverflow(count, total);
 	}
 
-	remaining = total;
+	uint remaining = total;
+	uint len;
+
 	while(remaining > 0) {
-		len = MIN(remaining, m_size - m_tail);
-		std::copy(begin, begin + len, m_data.begin() + m_tail);
-		m_tail += len;
-		m_tail %= m_size;
-		m_fill += len;
+		len = MIN(remaining, m_size - index(tail));
+		std::copy(begin, begin + len, m_data.begin() + index(tail));
+
+		if (m_correction) {
+			m_correction->process(m_data.begin() + index(tail), m_data.begin() + index(tail) + len);
+		}
+
+		tail = advance(tail, len);
 		begin += len;
 		remaining -= len;
 	}
 
-	if(m_fill > 0)
+	m_tail.storeRelease(tail); // publish samples to the consumer
+
+	if(fill() > 0)
 		emit dataReady();
 
 	return total;
@@ -112,41 +128,35 @@ uint SampleSinkFifo::write(const quint8* data, uint count)
 
 uint SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVector::const_iterator end)
 {
-	QMutexLocker mutexLocker(&m_mutex);
 	uint count = end - begin;
-	uint total;
-	uint remaining;
-	uint len;
 
-	total = MIN(count, m_size - m_fill);
+	int tail = m_tail.load(); // owned by this (producer) thread
+	uint space = m_size - distance(m_head.loadAcquire(), tail);
+	uint total = MIN(count, space);
+
 	if(total < count) {
-		if(m_suppressed < 0) {
-			m_suppressed = 0;
-			m_msgRateTimer.start();
-			qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
-		} else {
-			if(m_msgRateTimer.elapsed() > 2500) {
-				qCritical("SampleSinkFifo: %u messages dropped", m_suppressed);
-				qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
-				m_suppressed = -1;
-			} else {
-				m_suppressed++;
-			}
-		}
+		reportOverflow(count, total);
 	}
 
-	remaining = total;
+	uint remaining = total;
+	uint len;
+
 	while(remaining > 0) {
-		len = MIN(remaining, m_size - m_tail);
-		std::copy(begin, begin + len, m_data.begin() + m_tail);
-		m_tail += len;
-		m_tail %= m_size;
-		m_fill += len;
+		len = MIN(remaining, m_size - index(tail));
+		std::copy(begin, begin + len, m_data.begin() + index(tail));
+
+		if (m_correction) {
+			m_correction->process(m_data.begin() + index(tail), m_data.begin() + index(tail) + len);
+		}
+
+		tail = advance(tail, len);
 		begin += len;
 		remaining -= len;
 	}
 
-	if(m_fill > 0)
+	m_tail.storeRelease(tail); // publish samples to the consumer
+
+	if(fill() > 0)
 		emit dataReady();
 
 	return total;
@@ -154,27 +164,28 @@ uint SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVector::con
 
 uint SampleSinkFifo::read(SampleVector::iterator begin, SampleVector::iterator end)
 {
-	QMutexLocker mutexLocker(&m_mutex);
 	uint count = end - begin;
-	uint total;
-	uint remaining;
-	uint len;
 
-	total = MIN(count, m_fill);
+	int head = m_head.load(); // owned by this (consumer) thread
+	uint fill = distance(head, m_tail.loadAcquire());
+	uint total = MIN(count, fill);
+
 	if(total < count)
 		qCritical("SampleSinkFifo: underflow - missing %u samples", count - total);
 
-	remaining = total;
+	uint remaining = total;
+	uint len;
+
 	while(remaining > 0) {
-		len = MIN(remaining, m_size - m_head);
-		std::copy(m_data.begin() + m_head, m_data.begin() + m_head + len, begin);
-		m_head += len;
-		m_head %= m_size;
-		m_fill -= len;
+		len = MIN(remaining, m_size - index(head));
+		std::copy(m_data.begin() + index(head), m_data.begin() + index(head) + len, begin);
+		head = advance(head, len);
 		begin += len;
 		remaining -= len;
 	}
 
+	m_head.storeRelease(head); // give space back to the producer
+
 	return total;
 }
 
@@ -182,32 +193,31 @@ uint SampleSinkFifo::readBegin(uint count,
 	SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
 	SampleVector::iterator* part2Begin, SampleVector::iterator* part2End)
 {
-	QMutexLocker mutexLocker(&m_mutex);
 	uint total;
 	uint remaining;
 	uint len;
-	uint head = m_head;
+	int head = m_head.load(); // owned by this (consumer) thread
+	uint fill = distance(head, m_tail.loadAcquire());
 
-	total = MIN(count, m_fill);
+	total = MIN(count, fill);
 	if(total < count)
 		qCritical("SampleSinkFifo: underflow - missing %u samples", count - total);
 
 	remaining = total;
 	if(remaining > 0) {
-		len = MIN(remaining, m_size - head);
-		*part1Begin = m_data.begin() + head;
-		*part1End = m_data.begin() + head + len;
-		head += len;
-		head %= m_size;
+		len = MIN(remaining, m_size - index(head));
+		*part1Begin = m_data.begin() + index(head);
+		*part1End = m_data.begin() + index(head) + len;
+		head = advance(head, len);
 		remaining -= len;
 	} else {
 		*part1Begin = m_data.end();
 		*part1End = m_data.end();
 	}
 	if(remaining > 0) {
-		len = MIN(remaining, m_size - head);
-		*part2Begin = m_data.begin() + head;
-		*part2End = m_data.begin() + head + len;
+		len = MIN(remaining, m_size - index(head));
+		*part2Begin = m_data.begin() + index(head);
+		*part2End = m_data.begin() + index(head) + len;
 	} else {
 		*part2Begin = m_data.end();
 		*part2End = m_data.end();
@@ -218,14 +228,15 @@ uint SampleSinkFifo::readBegin(uint count,
 
 uint SampleSinkFifo::readCommit(uint count)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	int head = m_head.load(); // owned by this (consumer) thread
+	uint fill = distance(head, m_tail.loadAcquire());
 
-	if(count > m_fill) {
+	if(count > fill) {
 		qCritical("SampleSinkFifo: cannot commit more than available samples");
-		count = m_fill;
+		count = fill;
 	}
-	m_head = (m_head + count) % m_size;
-	m_fill -= count;
+
+	m_head.storeRelease(advance(head, count));
 
 	return count;
 }
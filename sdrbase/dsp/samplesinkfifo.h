@@ -19,27 +19,55 @@
 #define INCLUDE_SAMPLEFIFO_H
 
 #include <QObject>
-#include <QMutex>
+#include <QAtomicInt>
 #include <QTime>
 #include "dsp/dsptypes.h"
 #include "util/export.h"
 
+class IQCorrection;
+
+/**
+ * Lock-free single producer / single consumer sample FIFO.
+ *
+ * The producer (device acquisition thread or DSP engine) owns the tail index and the consumer
+ * (DSP engine or channel thread) owns the head index. Indexes run over twice the FIFO size so
+ * that a full FIFO can be told apart from an empty one without sacrificing a slot. Each index
+ * lives on its own cache line so that the two threads do not bounce the same line.
+ */
 class SDRANGEL_API SampleSinkFifo : public QObject {
 	Q_OBJECT
 
 private:
-	QMutex m_mutex;
+	static const int m_cacheLineSize = 64;
+
 	QTime m_msgRateTimer;
 	int m_suppressed;
 
 	SampleVector m_data;
-
 	uint m_size;
-	uint m_fill;
-	uint m_head;
-	uint m_tail;
+
+	char m_pad0[m_cacheLineSize];
+	QAtomicInt m_head; //!< read position in [0, 2*size[ written by consumer only
+	char m_pad1[m_cacheLineSize - sizeof(QAtomicInt)];
+	QAtomicInt m_tail; //!< write position in [0, 2*size[ written by producer only
+	char m_pad2[m_cacheLineSize - sizeof(QAtomicInt)];
+	QAtomicInt m_dropped; //!< total number of samples dropped on overflow
+
+	IQCorrection *m_correction; //!< applied by the producer to written samples when set
 
 	void create(uint s);
+	void reportOverflow(uint count, uint total);
+
+	inline uint index(int pos) const { return (uint) pos < m_size ? (uint) pos : (uint) pos - m_size; }
+	inline int advance(int pos, uint count) const
+	{
+		uint next = (uint) pos + count;
+		return (int) (next < 2*m_size ? next : next - 2*m_size);
+	}
+	inline uint distance(int head, int tail) const
+	{
+		return (uint) (tail >= head ? tail - head : tail - head + (int) (2*m_size));
+	}
 
 public:
 	SampleSinkFifo(QObject* parent = NULL);
@@ -48,7 +76,11 @@ public:
 
 	bool setSize(int size);
 	inline uint size() const { return m_size; }
-	inline uint fill() { QMutexLocker mutexLocker(&m_mutex); uint fill = m_fill; return fill; }
+	inline uint fill() const { return distance(m_head.loadAcquire(), m_tail.loadAcquire()); }
+	inline uint getDropped() const { return (uint) m_dropped.load(); }
+
+	/** Correct samples in the producer thread as they are written. Set while the producer is stopped. */
+	void setCorrection(IQCorrection *correction) { m_correction = correction; }
 
 	uint write(const quint8* data, uint count);
 	uint write(SampleVector::const_iterator begin, SampleVector::const_iterator end);
@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include "samplesinkfifoshared.h"
+
+SampleSinkFifoShared::SampleSinkFifoShared(uint size) :
+    m_data(size),
+    m_size(size),
+    m_suppressed(-1),
+    m_dropped(0),
+    m_tail(0)
+{
+}
+
+SampleSinkFifoShared::~SampleSinkFifoShared()
+{
+    for (std::vector<Reader*>::iterator it = m_readers.begin(); it != m_readers.end(); ++it) {
+        delete *it;
+    }
+}
+
+SampleSinkFifoShared::Reader *SampleSinkFifoShared::addReader()
+{
+    Reader *reader = new Reader(m_tail.load());
+    m_readers.push_back(reader);
+    return reader;
+}
+
+void SampleSinkFifoShared::removeReader(Reader *reader)
+{
+    std::vector<Reader*>::iterator it = std::find(m_readers.begin(), m_readers.end(), reader);
+
+    if (it != m_readers.end())
+    {
+        m_readers.erase(it);
+        delete reader;
+    }
+}
+
+uint SampleSinkFifoShared::write(SampleVector::const_iterator begin, SampleVector::const_iterator end)
+{
+    uint count = end - begin;
+    int tail = m_tail.load(); // owned by this (producer) thread
+    uint maxLag = 0;
+
+    // find how much space the slowest reader leaves and evict idle readers that would be overrun
+
+    for (std::vector<Reader*>::iterator it = m_readers.begin(); it != m_readers.end(); ++it)
+    {
+        Reader *reader = *it;
+        int state = reader->m_state.loadAcquire();
+
+        if ((state == Reader::ReaderEvicted) || (state == Reader::ReaderSyncing)) {
+            continue;
+        }
+
+        uint lag = distance(reader->m_cursor.loadAcquire(), tail);
+
+        if ((lag + count > m_size) && reader->m_state.testAndSetAcquire(Reader::ReaderIdle, Reader::ReaderSyncing))
+        {
+            reader->m_dropped.fetchAndAddRelaxed(lag);
+            reader->m_evictions.fetchAndAddRelaxed(1);
+            reader->m_cursor.store(tail);
+            reader->m_state.storeRelease(Reader::ReaderEvicted);
+            continue;
+        }
+
+        maxLag = std::max(maxLag, lag);
+    }
+
+    uint space = m_size - maxLag;
+    uint total = std::min(count, space);
+
+    if (total < count) // a busy reader is too slow to make room
+    {
+        m_dropped += count - total;
+
+        if (m_suppressed < 0)
+        {
+            m_suppressed = 0;
+            m_msgRateTimer.start();
+            qCritical("SampleSinkFifoShared: overflow - dropping %u samples", count - total);
+        }
+        else if (m_msgRateTimer.elapsed() > 2500)
+        {
+            qCritical("SampleSinkFifoShared: %u messages dropped", m_suppressed);
+            qCritical("SampleSinkFifoShared: overflow - dropping %u samples", count - total);
+            m_suppressed = -1;
+        }
+        else
+        {
+            m_suppressed++;
+        }
+    }
+
+    uint remaining = total;
+    uint len;
+
+    while (remaining > 0)
+    {
+        len = std::min(remaining, m_size - index(tail));
+        std::copy(begin, begin + len, m_data.begin() + index(tail));
+        tail = advance(tail, len);
+        begin += len;
+        remaining -= len;
+    }
+
+    m_tail.storeRelease(tail); // publish samples to the readers
+
+    // evicted readers skip what was just written and will resume from here
+
+    for (std::vector<Reader*>::iterator it = m_readers.begin(); it != m_readers.end(); ++it)
+    {
+        Reader *reader = *it;
+
+        if (reader->m_state.testAndSetAcquire(Reader::ReaderEvicted, Reader::ReaderSyncing))
+        {
+            reader->m_dropped.fetchAndAddRelaxed(distance(reader->m_cursor.load(), tail));
+            reader->m_cursor.store(tail);
+            reader->m_state.storeRelease(Reader::ReaderEvicted);
+        }
+    }
+
+    return total;
+}
+
+uint SampleSinkFifoShared::fill(const Reader *reader) const
+{
+    return distance(reader->m_cursor.loadAcquire(), m_tail.loadAcquire());
+}
+
+uint SampleSinkFifoShared::readBegin(Reader *reader, uint count,
+    SampleVector::const_iterator* part1Begin, SampleVector::const_iterator* part1End,
+    SampleVector::const_iterator* part2Begin, SampleVector::const_iterator* part2End)
+{
+    *part1Begin = m_data.end();
+    *part1End = m_data.end();
+    *part2Begin = m_data.end();
+    *part2End = m_data.end();
+
+    if (!reader->m_state.testAndSetAcquire(Reader::ReaderIdle, Reader::ReaderBusy)
+     && !reader->m_state.testAndSetAcquire(Reader::ReaderEvicted, Reader::ReaderBusy))
+    {
+        return 0; // writer is moving this reader's cursor
+    }
+
+    int head = reader->m_cursor.load();
+    uint fill = distance(head, m_tail.loadAcquire());
+    uint total = std::min(count, fill);
+
+    if (total == 0)
+    {
+        reader->m_state.storeRelease(Reader::ReaderIdle);
+        return 0;
+    }
+
+    uint len = std::min(total, m_size - index(head));
+    *part1Begin = m_data.begin() + index(head);
+    *part1End = m_data.begin() + index(head) + len;
+
+    if (len < total)
+    {
+        head = advance(head, len);
+        *part2Begin = m_data.begin() + index(head);
+        *part2End = m_data.begin() + index(head) + (total - len);
+    }
+
+    return total;
+}
+
+void SampleSinkFifoShared::readCommit(Reader *reader, uint count)
+{
+    int head = reader->m_cursor.load();
+    uint fill = distance(head, m_tail.loadAcquire());
+
+    if (count > fill)
+    {
+        qCritical("SampleSinkFifoShared: cannot commit more than available samples");
+        count = fill;
+    }
+
+    reader->m_cursor.storeRelease(advance(head, count));
+    reader->m_state.storeRelease(Reader::ReaderIdle); // give space back to the writer
+}
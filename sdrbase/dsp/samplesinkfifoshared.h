@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_DSP_SAMPLESINKFIFOSHARED_H_
+#define SDRBASE_DSP_SAMPLESINKFIFOSHARED_H_
+
+#include <vector>
+#include <QAtomicInt>
+#include <QTime>
+#include "dsp/dsptypes.h"
+#include "util/export.h"
+
+/**
+ * Single producer / multiple consumers baseband sample ring.
+ *
+ * The device source engine writes each baseband block once and every threaded channel sink
+ * reads it in place through its own Reader cursor. Ring space is only reused once all attached
+ * readers have moved past it. A reader that is too slow to keep up is evicted when it is idle:
+ * it loses the samples it was lagging behind and resumes at the most recent write position.
+ * Lost samples are accounted per reader so slow channels can be reported individually.
+ *
+ * addReader(), removeReader() and write() must be called from the producer thread only.
+ * readBegin(), readCommit() and fill() are called by the thread owning the Reader.
+ */
+class SDRANGEL_API SampleSinkFifoShared
+{
+public:
+    class Reader
+    {
+    public:
+        uint getDropped() const { return (uint) m_dropped.load(); }     //!< Samples lost by this reader
+        uint getEvictions() const { return (uint) m_evictions.load(); } //!< Number of times this reader was found too slow
+
+    private:
+        enum State
+        {
+            ReaderIdle,    //!< not reading, cursor owned by reader
+            ReaderBusy,    //!< reading between readBegin and readCommit, cursor owned by reader
+            ReaderEvicted, //!< too slow, cursor owned by writer
+            ReaderSyncing  //!< writer is moving the cursor of an evicted reader
+        };
+
+        Reader(int cursor) : m_cursor(cursor), m_state(ReaderIdle), m_dropped(0), m_evictions(0) {}
+
+        static const int m_cacheLineSize = 64;
+        QAtomicInt m_cursor; //!< read position in [0, 2*size[
+        QAtomicInt m_state;
+        QAtomicInt m_dropped;
+        QAtomicInt m_evictions;
+        char m_pad[m_cacheLineSize - 4*sizeof(QAtomicInt)]; //!< keep readers on separate cache lines
+
+        friend class SampleSinkFifoShared;
+    };
+
+    SampleSinkFifoShared(uint size);
+    ~SampleSinkFifoShared();
+
+    inline uint size() const { return m_size; }
+
+    Reader *addReader();                //!< Attach a new reader starting at the current write position
+    void removeReader(Reader *reader);  //!< Detach and delete a reader that is not reading anymore
+
+    uint write(SampleVector::const_iterator begin, SampleVector::const_iterator end);
+
+    uint fill(const Reader *reader) const;
+    /** Get samples available to this reader. Returns 0 if the reader cannot read now else readCommit() must follow */
+    uint readBegin(Reader *reader, uint count,
+        SampleVector::const_iterator* part1Begin, SampleVector::const_iterator* part1End,
+        SampleVector::const_iterator* part2Begin, SampleVector::const_iterator* part2End);
+    void readCommit(Reader *reader, uint count);
+
+private:
+    static const int m_cacheLineSize = 64;
+
+    SampleVector m_data;
+    uint m_size;
+    std::vector<Reader*> m_readers;
+    QTime m_msgRateTimer;
+    int m_suppressed;
+    uint m_dropped;
+
+    char m_pad0[m_cacheLineSize];
+    QAtomicInt m_tail; //!< write position in [0, 2*size[
+    char m_pad1[m_cacheLineSize - sizeof(QAtomicInt)];
+
+    inline uint index(int pos) const { return (uint) pos < m_size ? (uint) pos : (uint) pos - m_size; }
+    inline int advance(int pos, uint count) const
+    {
+        uint next = (uint) pos + count;
+        return (int) (next < 2*m_size ? next : next - 2*m_size);
+    }
+    inline uint distance(int head, int tail) const
+    {
+        return (uint) (tail >= head ? tail - head : tail - head + (int) (2*m_size));
+    }
+};
+
+#endif /* SDRBASE_DSP_SAMPLESINKFIFOSHARED_H_ */
@@ -15,11 +15,13 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <assert.h>
+#include <algorithm>
 #include "samplesourcefifo.h"
 
 SampleSourceFifo::SampleSourceFifo(uint32_t size) :
     m_size(size),
-    m_init(false)
+    m_init(false),
+    m_underrunCount(0)
 {
     m_data.resize(2*m_size);
     init();
@@ -40,9 +42,10 @@ void SampleSourceFifo::resize(uint32_t size)
 
 void SampleSourceFifo::init()
 {
-    memset(&m_data[0], 0, sizeof(2*m_size*sizeof(Sample)));
+    std::fill(m_data.begin(), m_data.end(), Sample()); // the first half FIFO is read as silence while the writer catches up
     m_ir = 0;
     m_iw = m_size/2;
+    m_fill.storeRelease(m_size/2);
     m_init = true;
 }
 
@@ -51,6 +54,10 @@ void SampleSourceFifo::readAdvance(SampleVector::iterator& readUntil, unsigned i
 //    QMutexLocker mutexLocker(&m_mutex);
     assert(nbSamples <= m_size/2);
 
+    if (m_fill.fetchAndAddAcquire(-((int) nbSamples)) < (int) nbSamples) {
+        m_underrunCount++;
+    }
+
     m_ir = (m_ir + nbSamples) % m_size;
     readUntil =  m_data.begin() + m_size + m_ir;
     emit dataRead(nbSamples);
@@ -66,6 +73,8 @@ void SampleSourceFifo::write(const Sample& sample)
 //        QMutexLocker mutexLocker(&m_mutex);
         m_iw = (m_iw+1) % m_size;
     }
+
+    m_fill.fetchAndAddRelease(1);
 }
 
 void SampleSourceFifo::getReadIterator(SampleVector::iterator& readUntil)
@@ -87,5 +96,20 @@ void SampleSourceFifo::bumpIndex(SampleVector::iterator& writeAt)
         m_iw = (m_iw+1) % m_size;
     }
 
+    m_fill.fetchAndAddRelease(1);
+    writeAt = m_data.begin() + m_iw;
+}
+
+void SampleSourceFifo::bumpIndex(SampleVector::iterator& writeAt, uint32_t nbSamples)
+{
+    assert(m_iw + nbSamples <= m_size);
+    std::copy(m_data.begin() + m_iw, m_data.begin() + m_iw + nbSamples, m_data.begin() + m_iw + m_size);
+
+    {
+//        QMutexLocker mutexLocker(&m_mutex);
+        m_iw = (m_iw + nbSamples) % m_size;
+    }
+
+    m_fill.fetchAndAddRelease(nbSamples);
     writeAt = m_data.begin() + m_iw;
 }
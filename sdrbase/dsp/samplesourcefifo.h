@@ -19,6 +19,7 @@
 
 #include <QObject>
 #include <QMutex>
+#include <QAtomicInt>
 #include <stdint.h>
 #include <assert.h>
 #include "util/export.h"
@@ -40,8 +41,11 @@ public:
     void getReadIterator(SampleVector::iterator& readUntil); //!< get iterator past the last sample of a read advance operation (i.e. current read iterator)
     void getWriteIterator(SampleVector::iterator& writeAt);  //!< get iterator to current item for update - write phase 1
     void bumpIndex(SampleVector::iterator& writeAt);         //!< copy current item to second buffer and bump write index - write phase 2
+    uint32_t getWriteContiguous() const { return m_size - m_iw; } //!< number of items that can be written from the write iterator without wrapping
+    void bumpIndex(SampleVector::iterator& writeAt, uint32_t nbSamples); //!< block version of bumpIndex - nbSamples must not exceed getWriteContiguous()
 
     void write(const Sample& sample);                        //!< write directly - phase 1 + phase 2
+    uint32_t getUnderrunCount() const { return m_underrunCount; } //!< number of read advances that found samples not written yet
 
 private:
     uint32_t m_size;
@@ -50,6 +54,8 @@ private:
     uint32_t m_ir;
     bool m_init;
     QMutex m_mutex;
+    QAtomicInt m_fill;          //!< samples written and not read yet. Orders writer and reader threads.
+    uint32_t m_underrunCount;
 
 signals:
     void dataWrite(int nbSamples); // signal data is read past a threshold and writing new samples to fill in is needed
@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include "simddispatch.h"
+
+SIMDDispatch::Level SIMDDispatch::getLevel()
+{
+    static const Level level = detect();
+    return level;
+}
+
+const char *SIMDDispatch::getLevelName()
+{
+    switch (getLevel())
+    {
+    case LevelAVX2:
+        return "AVX2";
+    case LevelSSE4_1:
+        return "SSE4.1";
+    case LevelSSE2:
+        return "SSE2";
+    case LevelGeneric:
+    default:
+        return "generic";
+    }
+}
+
+SIMDDispatch::Level SIMDDispatch::detect()
+{
+#if defined(USE_SIMD_DISPATCH) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        return LevelAVX2;
+    } else if (__builtin_cpu_supports("sse4.1")) {
+        return LevelSSE4_1;
+    } else if (__builtin_cpu_supports("sse2")) {
+        return LevelSSE2;
+    } else {
+        return LevelGeneric;
+    }
+#elif defined(USE_SSE4_1)
+    return LevelSSE4_1;
+#elif defined(USE_SSE2)
+    return LevelSSE2;
+#else
+    return LevelGeneric;
+#endif
+}
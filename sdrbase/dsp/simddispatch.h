@@ -0,0 +1,57 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_DSP_SIMDDISPATCH_H_
+#define SDRBASE_DSP_SIMDDISPATCH_H_
+
+#include "util/export.h"
+
+// Compile a single function for a given instruction set so it can be selected at runtime
+#if defined(__GNUC__)
+#define SIMD_TARGET(arch) __attribute__((target(arch)))
+#else
+#define SIMD_TARGET(arch)
+#endif
+
+/**
+ * Instruction set of the DSP kernels.
+ *
+ * When built with USE_SIMD_DISPATCH the code is compiled for the SSE2 baseline and the SSE4.1 or AVX2
+ * variants of the kernels are chosen once at startup from what the CPU reports with CPUID.
+ * Otherwise the level is the one fixed at compile time by USE_SSE2 / USE_SSE4_1.
+ */
+class SDRANGEL_API SIMDDispatch
+{
+public:
+    enum Level
+    {
+        LevelGeneric,
+        LevelSSE2,
+        LevelSSE4_1,
+        LevelAVX2
+    };
+
+    static Level getLevel();           //!< Best level usable by this build on this CPU
+    static const char *getLevelName(); //!< Name of the above for logs and reports
+    static bool hasSSE4_1() { return getLevel() >= LevelSSE4_1; }
+    static bool hasAVX2() { return getLevel() >= LevelAVX2; }
+
+private:
+    static Level detect();
+};
+
+#endif /* SDRBASE_DSP_SIMDDISPATCH_H_ */
@@ -0,0 +1,128 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <math.h>
+
+#include "spectrumaverager.h"
+
+SpectrumAverager::SpectrumAverager() :
+    m_avgMode(AvgModeNone),
+    m_avgNb(1),
+    m_avgCount(0),
+    m_size(0),
+    m_frameIntervalMs(0)
+{
+}
+
+void SpectrumAverager::configure(AvgMode avgMode, int avgNb, int maxFrameRate)
+{
+    m_avgMode = avgMode;
+    m_avgNb = std::max(1, avgNb);
+    m_avgCount = 0;
+    m_frameIntervalMs = maxFrameRate <= 0 ? 0 : 1000 / maxFrameRate;
+}
+
+void SpectrumAverager::resize(std::size_t size)
+{
+    m_size = size;
+    m_avgSpectrum.resize(size);
+    m_avgCount = 0;
+}
+
+bool SpectrumAverager::frameDue() const
+{
+    return (m_frameIntervalMs == 0) || !m_frameTimer.isValid() || (m_frameTimer.elapsed() >= m_frameIntervalMs);
+}
+
+const std::vector<Real> *SpectrumAverager::output(const std::vector<Real>& spectrum)
+{
+    if (!frameDue()) {
+        return 0;
+    }
+
+    m_frameTimer.start();
+    return &spectrum;
+}
+
+const std::vector<Real> *SpectrumAverager::feed(const std::vector<Real>& spectrum)
+{
+    switch (m_avgMode)
+    {
+    case AvgModeMoving:
+        if (m_avgCount == 0)
+        {
+            std::copy(spectrum.begin(), spectrum.begin() + m_size, m_avgSpectrum.begin());
+            m_avgCount = 1;
+        }
+        else
+        {
+            Real alpha = 1.0f / m_avgNb;
+
+            for (std::size_t i = 0; i < m_size; i++) {
+                m_avgSpectrum[i] += alpha * (spectrum[i] - m_avgSpectrum[i]);
+            }
+        }
+
+        return output(m_avgSpectrum);
+    case AvgModeFixed:
+    case AvgModeMax:
+        if (m_avgCount == 0)
+        {
+            std::copy(spectrum.begin(), spectrum.begin() + m_size, m_avgSpectrum.begin());
+        }
+        else if (m_avgMode == AvgModeFixed)
+        {
+            for (std::size_t i = 0; i < m_size; i++) {
+                m_avgSpectrum[i] += spectrum[i];
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < m_size; i++) {
+                m_avgSpectrum[i] = std::max(m_avgSpectrum[i], spectrum[i]);
+            }
+        }
+
+        if (++m_avgCount < m_avgNb) {
+            return 0;
+        }
+
+        if (m_avgMode == AvgModeFixed)
+        {
+            Real norm = 1.0f / m_avgCount;
+
+            for (std::size_t i = 0; i < m_size; i++) {
+                m_avgSpectrum[i] *= norm;
+            }
+        }
+
+        m_avgCount = 0;
+        return output(m_avgSpectrum);
+    default:
+        return output(spectrum);
+    }
+}
+
+void SpectrumAverager::powerToDB(const std::vector<Real>& power, std::vector<Real>& powerDB, std::size_t size, std::size_t fftSize)
+{
+    Real ofs = 20.0f * log10f(1.0f / fftSize);
+
+    for (std::size_t i = 0; i < size; i++) {
+        powerDB[i] = 10.0f * log10f(power[i] + 1e-20f) + ofs;
+    }
+}
@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_DSP_SPECTRUMAVERAGER_H_
+#define SDRBASE_DSP_SPECTRUMAVERAGER_H_
+
+#include <vector>
+#include <QElapsedTimer>
+
+#include "dsp/dsptypes.h"
+#include "util/export.h"
+
+/**
+ * Averaging or peak hold of successive power spectra with a limit on the output frame rate.
+ * Spectra can be in linear power or in dB. Averaging is done in the domain of the input.
+ */
+class SDRANGEL_API SpectrumAverager
+{
+public:
+    enum AvgMode
+    {
+        AvgModeNone,   //!< every spectrum is output
+        AvgModeMoving, //!< exponential moving average with a time constant of avgNb spectra
+        AvgModeFixed,  //!< average of avgNb spectra then start over
+        AvgModeMax     //!< peak hold of avgNb spectra then start over
+    };
+
+    SpectrumAverager();
+
+    void configure(AvgMode avgMode, int avgNb, int maxFrameRate); //!< Restarts averaging
+    void resize(std::size_t size);                                //!< Set the number of bins. Restarts averaging.
+    AvgMode getAvgMode() const { return m_avgMode; }
+    bool spectrumNeeded() const { return (m_avgMode != AvgModeNone) || frameDue(); } //!< False when the next spectrum would be neither averaged nor output
+
+    /**
+     * Add the spectrum of one FFT. The first size() bins are used. Returns the spectrum to output,
+     * either the input or the averaged one, or 0 if no frame is due. The frame rate limit restarts
+     * from each returned spectrum.
+     */
+    const std::vector<Real> *feed(const std::vector<Real>& spectrum);
+
+    static void powerToDB(const std::vector<Real>& power, std::vector<Real>& powerDB, std::size_t size, std::size_t fftSize); //!< Normalized log power. The floor keeps empty bins finite.
+
+private:
+    AvgMode m_avgMode;
+    int m_avgNb;
+    int m_avgCount;
+    std::size_t m_size;
+    std::vector<Real> m_avgSpectrum;
+    qint64 m_frameIntervalMs;
+    QElapsedTimer m_frameTimer;
+
+    bool frameDue() const;
+    const std::vector<Real> *output(const std::vector<Real>& spectrum);
+};
+
+#endif /* SDRBASE_DSP_SPECTRUMAVERAGER_H_ */
@@ -0,0 +1,343 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <QDateTime>
+#include <QStringList>
+#include <QDebug>
+
+#include "SWGSpectrumFrame.h"
+#include "SWGSpectrumSettings.h"
+
+#include "dsp/dspcommands.h"
+#include "util/messagequeue.h"
+#include "spectrumengine.h"
+
+#define SPECTRUMENGINE_MAX_FFT_SIZE 16384
+
+MESSAGE_CLASS_DEFINITION(SpectrumEngine::MsgConfigureSpectrumEngine, Message)
+
+SpectrumEngine::Settings::Settings() :
+    m_enabled(true),
+    m_fftSize(1024),
+    m_overlapPercent(0),
+    m_window(FFTWindow::BlackmanHarris),
+    m_avgMode(SpectrumAverager::AvgModeNone),
+    m_avgNb(1),
+    m_maxFrameRate(10)
+{}
+
+SpectrumEngine::Frame::Frame() :
+    m_fftSize(0),
+    m_sampleRate(0),
+    m_centerFrequency(0),
+    m_index(0),
+    m_timestampMs(0)
+{}
+
+SpectrumEngine::SpectrumEngine(const Settings& settings) :
+    BasebandSampleSink(),
+    m_fft(FFTEngine::create()),
+    m_overlapSize(0),
+    m_refillSize(0),
+    m_fftBufferFill(0),
+    m_sampleRate(0),
+    m_centerFrequency(0),
+    m_mutex(QMutex::Recursive),
+    m_frameIndex(0)
+{
+    setObjectName("SpectrumEngine");
+    m_settings.m_fftSize = 0; // force
+    applySettings(settings);
+}
+
+SpectrumEngine::~SpectrumEngine()
+{
+    delete m_fft;
+}
+
+void SpectrumEngine::configure(MessageQueue* msgQueue, const Settings& settings)
+{
+    MsgConfigureSpectrumEngine* cmd = MsgConfigureSpectrumEngine::create(settings);
+    msgQueue->push(cmd);
+}
+
+SpectrumEngine::Settings SpectrumEngine::getSettings()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_settings;
+}
+
+bool SpectrumEngine::getFrame(Frame& frame)
+{
+    QMutexLocker mutexLocker(&m_frameMutex);
+
+    if (m_frame.m_logPower.size() == 0) {
+        return false;
+    }
+
+    frame = m_frame;
+    return true;
+}
+
+int SpectrumEngine::webapiFrameGet(Swagger::SWGSpectrumFrame& response, QString& errorMessage)
+{
+    Frame frame;
+
+    if (!getFrame(frame))
+    {
+        errorMessage = "No spectrum frame published yet";
+        return 404;
+    }
+
+    response.setIndex(frame.m_index);
+    response.setTimestamp(frame.m_timestampMs);
+    response.setCenterFrequency(frame.m_centerFrequency);
+    response.setSampleRate(frame.m_sampleRate);
+    response.setFftSize(frame.m_fftSize);
+    // Real is float on all supported targets that are little endian
+    *response.getPower() = QByteArray((const char *) frame.m_logPower.data(), frame.m_logPower.size() * sizeof(Real));
+
+    return 200;
+}
+
+int SpectrumEngine::webapiSettingsPatch(const QStringList& settingsKeys, Swagger::SWGSpectrumSettings& response, QString& errorMessage)
+{
+    Settings settings = getSettings();
+
+    if (settingsKeys.contains("enabled")) {
+        settings.m_enabled = response.getEnabled();
+    }
+    if (settingsKeys.contains("fftSize")) {
+        settings.m_fftSize = response.getFftSize();
+    }
+    if (settingsKeys.contains("overlapPercent")) {
+        settings.m_overlapPercent = response.getOverlapPercent();
+    }
+    if (settingsKeys.contains("fftWindow"))
+    {
+        if ((response.getFftWindow() < (int) FFTWindow::Bartlett) || (response.getFftWindow() > (int) FFTWindow::Rectangle))
+        {
+            errorMessage = QString("Invalid FFT window %1").arg(response.getFftWindow());
+            return 400;
+        }
+
+        settings.m_window = (FFTWindow::Function) response.getFftWindow();
+    }
+    if (settingsKeys.contains("averagingMode"))
+    {
+        if ((response.getAveragingMode() < (int) SpectrumAverager::AvgModeNone) || (response.getAveragingMode() > (int) SpectrumAverager::AvgModeMax))
+        {
+            errorMessage = QString("Invalid averaging mode %1").arg(response.getAveragingMode());
+            return 400;
+        }
+
+        settings.m_avgMode = (AvgMode) response.getAveragingMode();
+    }
+    if (settingsKeys.contains("averagingNb")) {
+        settings.m_avgNb = response.getAveragingNb();
+    }
+    if (settingsKeys.contains("maxFrameRate")) {
+        settings.m_maxFrameRate = response.getMaxFrameRate();
+    }
+
+    applySettings(settings);
+    settings = getSettings(); // as adjusted
+
+    response.setEnabled(settings.m_enabled);
+    response.setFftSize(settings.m_fftSize);
+    response.setOverlapPercent(settings.m_overlapPercent);
+    response.setFftWindow((int) settings.m_window);
+    response.setAveragingMode((int) settings.m_avgMode);
+    response.setAveragingNb(settings.m_avgNb);
+    response.setMaxFrameRate(settings.m_maxFrameRate);
+
+    return 200;
+}
+
+void SpectrumEngine::feed(const SampleVector::const_iterator& cbegin, const SampleVector::const_iterator& end, bool positiveOnly)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!m_settings.m_enabled) {
+        return;
+    }
+
+    SampleVector::const_iterator begin(cbegin);
+
+    while (begin < end)
+    {
+        std::size_t todo = end - begin;
+        std::size_t samplesNeeded = m_settings.m_fftSize - m_fftBufferFill;
+        std::size_t count = std::min(todo, samplesNeeded);
+        std::vector<Complex>::iterator it = m_fftBuffer.begin() + m_fftBufferFill;
+
+        for (std::size_t i = 0; i < count; ++i, ++begin) {
+            *it++ = Complex(begin->real() / 32768.0f, begin->imag() / 32768.0f);
+        }
+
+        m_fftBufferFill += count;
+
+        if (m_fftBufferFill < (std::size_t) m_settings.m_fftSize) {
+            break; // not enough samples for FFT
+        }
+
+        // without averaging a transform that would not be published is not worth computing
+        if (m_averager.spectrumNeeded()) {
+            processFFT(positiveOnly);
+        }
+
+        // advance buffer respecting the fft overlap factor
+        std::copy(m_fftBuffer.begin() + m_refillSize, m_fftBuffer.end(), m_fftBuffer.begin());
+        m_fftBufferFill = m_overlapSize;
+    }
+}
+
+void SpectrumEngine::processFFT(bool positiveOnly)
+{
+    m_window.apply(&m_fftBuffer[0], m_fft->in());
+    m_fft->transform();
+
+    // extract power spectrum and reorder buckets
+    const Complex* fftOut = m_fft->out();
+    std::size_t fftSize = m_settings.m_fftSize;
+    std::size_t halfSize = fftSize / 2;
+
+    if (positiveOnly)
+    {
+        for (std::size_t i = 0; i < halfSize; i++)
+        {
+            Real v = fftOut[i].real() * fftOut[i].real() + fftOut[i].imag() * fftOut[i].imag();
+            m_powerSpectrum[i * 2] = v;
+            m_powerSpectrum[i * 2 + 1] = v;
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < halfSize; i++)
+        {
+            const Complex& cn = fftOut[i + halfSize];
+            const Complex& cp = fftOut[i];
+            m_powerSpectrum[i] = cn.real() * cn.real() + cn.imag() * cn.imag();
+            m_powerSpectrum[i + halfSize] = cp.real() * cp.real() + cp.imag() * cp.imag();
+        }
+    }
+
+    const std::vector<Real> *powerSpectrum = m_averager.feed(m_powerSpectrum);
+
+    if (powerSpectrum) {
+        publish(*powerSpectrum);
+    }
+}
+
+void SpectrumEngine::publish(const std::vector<Real>& powerSpectrum)
+{
+    std::size_t fftSize = m_settings.m_fftSize;
+
+    QMutexLocker mutexLocker(&m_frameMutex);
+
+    m_frame.m_logPower.resize(fftSize);
+    SpectrumAverager::powerToDB(powerSpectrum, m_frame.m_logPower, fftSize, fftSize);
+
+    m_frame.m_fftSize = fftSize;
+    m_frame.m_sampleRate = m_sampleRate;
+    m_frame.m_centerFrequency = m_centerFrequency;
+    m_frame.m_index = m_frameIndex++;
+    m_frame.m_timestampMs = QDateTime::currentMSecsSinceEpoch();
+}
+
+void SpectrumEngine::start()
+{
+}
+
+void SpectrumEngine::stop()
+{
+}
+
+bool SpectrumEngine::handleMessage(const Message& message)
+{
+    if (MsgConfigureSpectrumEngine::match(message))
+    {
+        MsgConfigureSpectrumEngine& cfg = (MsgConfigureSpectrumEngine&) message;
+        applySettings(cfg.getSettings());
+        return true;
+    }
+    else if (DSPSignalNotification::match(message))
+    {
+        DSPSignalNotification& notif = (DSPSignalNotification&) message;
+        QMutexLocker mutexLocker(&m_mutex);
+        m_sampleRate = notif.getSampleRate();
+        m_centerFrequency = notif.getCenterFrequency();
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+void SpectrumEngine::applySettings(const Settings& settings)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    Settings newSettings(settings);
+
+    // FFT size is rounded down to a power of two
+    int fftSize = 64;
+
+    while ((fftSize < SPECTRUMENGINE_MAX_FFT_SIZE) && (2*fftSize <= newSettings.m_fftSize)) {
+        fftSize *= 2;
+    }
+
+    newSettings.m_fftSize = fftSize;
+    newSettings.m_overlapPercent = std::max(0, std::min(newSettings.m_overlapPercent, 99));
+    newSettings.m_avgNb = std::max(1, newSettings.m_avgNb);
+    newSettings.m_maxFrameRate = std::max(0, newSettings.m_maxFrameRate);
+
+    qDebug() << "SpectrumEngine::applySettings:"
+            << " m_enabled: " << newSettings.m_enabled
+            << " m_fftSize: " << newSettings.m_fftSize
+            << " m_overlapPercent: " << newSettings.m_overlapPercent
+            << " m_window: " << (int) newSettings.m_window
+            << " m_avgMode: " << (int) newSettings.m_avgMode
+            << " m_avgNb: " << newSettings.m_avgNb
+            << " m_maxFrameRate: " << newSettings.m_maxFrameRate;
+
+    if ((newSettings.m_fftSize != m_settings.m_fftSize) || (newSettings.m_window != m_settings.m_window))
+    {
+        m_fft->configure(newSettings.m_fftSize, false);
+        m_window.create(newSettings.m_window, newSettings.m_fftSize);
+        m_fftBuffer.resize(newSettings.m_fftSize);
+        m_powerSpectrum.resize(newSettings.m_fftSize);
+        m_averager.resize(newSettings.m_fftSize);
+    }
+
+    if ((newSettings.m_fftSize != m_settings.m_fftSize)
+     || (newSettings.m_avgMode != m_settings.m_avgMode)
+     || (newSettings.m_avgNb != m_settings.m_avgNb)
+     || (newSettings.m_maxFrameRate != m_settings.m_maxFrameRate)) {
+        m_averager.configure(newSettings.m_avgMode, newSettings.m_avgNb, newSettings.m_maxFrameRate);
+    }
+
+    if ((newSettings.m_fftSize != m_settings.m_fftSize) || (newSettings.m_overlapPercent != m_settings.m_overlapPercent))
+    {
+        m_overlapSize = (newSettings.m_fftSize * newSettings.m_overlapPercent) / 100;
+        m_refillSize = newSettings.m_fftSize - m_overlapSize;
+        m_fftBufferFill = m_overlapSize;
+    }
+
+    m_settings = newSettings;
+}
@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_DSP_SPECTRUMENGINE_H_
+#define SDRBASE_DSP_SPECTRUMENGINE_H_
+
+#include <vector>
+#include <QMutex>
+
+#include "dsp/basebandsamplesink.h"
+#include "dsp/fftengine.h"
+#include "dsp/fftwindow.h"
+#include "dsp/spectrumaverager.h"
+#include "util/message.h"
+#include "util/export.h"
+
+class QStringList;
+
+namespace Swagger {
+    class SWGSpectrumFrame;
+    class SWGSpectrumSettings;
+}
+
+/**
+ * Spectrum analysis sink that does not depend on any GUI. It computes log power spectrum
+ * frames optionally averaged or peak held over a number of FFTs and publishes them at a
+ * limited rate. The last published frame can be collected from any thread (web API).
+ * It is normally run in the channel worker pool through a ThreadedBasebandSampleSink.
+ */
+class SDRANGEL_API SpectrumEngine : public BasebandSampleSink {
+    Q_OBJECT
+
+public:
+    typedef SpectrumAverager::AvgMode AvgMode; //!< power is averaged linearly
+
+    struct Settings
+    {
+        bool m_enabled;              //!< no processing at all when disabled
+        int m_fftSize;
+        int m_overlapPercent;
+        FFTWindow::Function m_window;
+        AvgMode m_avgMode;
+        int m_avgNb;                 //!< number of FFTs averaged
+        int m_maxFrameRate;          //!< maximum number of frames published per second. 0 for no limit
+
+        Settings();
+    };
+
+    struct Frame
+    {
+        std::vector<Real> m_logPower; //!< power in dB with DC at the center
+        int m_fftSize;
+        int m_sampleRate;
+        qint64 m_centerFrequency;
+        quint32 m_index;              //!< sequence number of published frames
+        qint64 m_timestampMs;         //!< publication time in milliseconds since epoch
+
+        Frame();
+    };
+
+    class SDRANGEL_API MsgConfigureSpectrumEngine : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        const Settings& getSettings() const { return m_settings; }
+
+        static MsgConfigureSpectrumEngine* create(const Settings& settings) {
+            return new MsgConfigureSpectrumEngine(settings);
+        }
+
+    private:
+        Settings m_settings;
+
+        MsgConfigureSpectrumEngine(const Settings& settings) :
+            Message(),
+            m_settings(settings)
+        { }
+    };
+
+    SpectrumEngine(const Settings& settings = Settings());
+    virtual ~SpectrumEngine();
+
+    void configure(MessageQueue* msgQueue, const Settings& settings);
+    Settings getSettings();
+    bool getFrame(Frame& frame); //!< Copy of the last published frame. Returns false if nothing was published yet.
+
+    int webapiFrameGet(Swagger::SWGSpectrumFrame& response, QString& errorMessage);
+    int webapiSettingsPatch(const QStringList& settingsKeys, Swagger::SWGSpectrumSettings& response, QString& errorMessage);
+
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly);
+    virtual void start();
+    virtual void stop();
+    virtual bool handleMessage(const Message& message);
+
+private:
+    FFTEngine* m_fft;
+    FFTWindow m_window;
+
+    std::vector<Complex> m_fftBuffer;
+    std::vector<Real> m_powerSpectrum; //!< linear power of the last FFT with DC at the center
+    SpectrumAverager m_averager;
+
+    std::size_t m_overlapSize;
+    std::size_t m_refillSize;
+    std::size_t m_fftBufferFill;
+
+    Settings m_settings;
+    int m_sampleRate;
+    qint64 m_centerFrequency;
+
+    QMutex m_mutex;      //!< processing against settings
+    QMutex m_frameMutex; //!< published frame against readers
+    Frame m_frame;
+    quint32 m_frameIndex;
+
+    void applySettings(const Settings& settings);
+    void processFFT(bool positiveOnly);
+    void publish(const std::vector<Real>& powerSpectrum);
+};
+
+#endif /* SDRBASE_DSP_SPECTRUMENGINE_H_ */
@@ -3,49 +3,56 @@
 #include <QThread>
 #include <QDebug>
 #include "dsp/dspcommands.h"
+#include "dsp/dspengine.h"
 #include "util/message.h"
 
-ThreadedBasebandSampleSinkFifo::ThreadedBasebandSampleSinkFifo(BasebandSampleSink *sampleSink, std::size_t size) :
-	m_sampleSink(sampleSink)
+ThreadedBasebandSampleSinkFifo::ThreadedBasebandSampleSinkFifo(BasebandSampleSink *sampleSink) :
+	m_sampleSink(sampleSink),
+	m_sampleFifo(0),
+	m_sampleReader(0),
+	m_droppedReported(0)
 {
-	connect(&m_sampleFifo, SIGNAL(dataReady()), this, SLOT(handleFifoData()));
-	m_sampleFifo.setSize(size);
+	m_msgRateTimer.start();
 }
 
 ThreadedBasebandSampleSinkFifo::~ThreadedBasebandSampleSinkFifo()
 {
-	m_sampleFifo.readCommit(m_sampleFifo.fill());
 }
 
-void ThreadedBasebandSampleSinkFifo::writeToFifo(SampleVector::const_iterator& begin, SampleVector::const_iterator& end)
-{
-	m_sampleFifo.write(begin, end);
-}
-
-void ThreadedBasebandSampleSinkFifo::handleFifoData() // FIXME: Fixed? Move it to the new threadable sink class
+void ThreadedBasebandSampleSinkFifo::run()
 {
 	bool positiveOnly = false;
 
-	while ((m_sampleFifo.fill() > 0) && (m_sampleSink->getInputMessageQueue()->size() == 0))
+	handleSinkMessages();
+
+	if (m_sampleReader == 0) {
+		return;
+	}
+
+	while (m_sampleFifo->fill(m_sampleReader) > 0)
 	{
-		SampleVector::iterator part1begin;
-		SampleVector::iterator part1end;
-		SampleVector::iterator part2begin;
-		SampleVector::iterator part2end;
+		SampleVector::const_iterator part1begin;
+		SampleVector::const_iterator part1end;
+		SampleVector::const_iterator part2begin;
+		SampleVector::const_iterator part2end;
+
+		std::size_t count = m_sampleFifo->readBegin(m_sampleReader, m_sampleFifo->fill(m_sampleReader), &part1begin, &part1end, &part2begin, &part2end);
 
-		std::size_t count = m_sampleFifo.readBegin(m_sampleFifo.fill(), &part1begin, &part1end, &part2begin, &part2end);
+		if (count == 0) {
+			break; // cursor is being moved by the producer. Will be notified again.
+		}
+
+		m_mutex.lock();
 
 		// first part of FIFO data
 
-		if (count > 0)
+		if (part1begin != part1end)
 		{
 			// handle data
 			if(m_sampleSink != NULL)
 			{
 				m_sampleSink->feed(part1begin, part1end, positiveOnly);
 			}
-
-			m_sampleFifo.readCommit(part1end - part1begin);
 		}
 
 		// second part of FIFO data (used when block wraps around)
@@ -57,13 +64,39 @@ void ThreadedBasebandSampleSinkFifo::handleFifoData() // FIXME: Fixed? Move it t
 			{
 				m_sampleSink->feed(part2begin, part2end, positiveOnly);
 			}
+		}
+
+		m_mutex.unlock();
+		m_sampleFifo->readCommit(m_sampleReader, count);
+		handleSinkMessages();
+	}
+
+	uint dropped = m_sampleReader->getDropped();
+
+	if ((dropped != m_droppedReported) && (m_msgRateTimer.elapsed() > 2500))
+	{
+		qWarning("ThreadedBasebandSampleSinkFifo::run: %s: too slow - dropped %u samples",
+				qPrintable(m_sampleSink->objectName()), dropped - m_droppedReported);
+		m_droppedReported = dropped;
+		m_msgRateTimer.restart();
+	}
+}
+
+void ThreadedBasebandSampleSinkFifo::handleSinkMessages()
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	Message* message;
 
-			m_sampleFifo.readCommit(part2end - part2begin);
+	while ((message = m_sampleSink->getInputMessageQueue()->pop()) != 0)
+	{
+		if (m_sampleSink->handleMessage(*message))
+		{
+			delete message;
 		}
 	}
 }
 
-ThreadedBasebandSampleSink::ThreadedBasebandSampleSink(BasebandSampleSink* sampleSink, QObject *parent) :
+ThreadedBasebandSampleSink::ThreadedBasebandSampleSink(BasebandSampleSink* sampleSink, QObject *parent __attribute__((unused))) :
 	m_basebandSampleSink(sampleSink)
 {
 	QString name = "ThreadedBasebandSampleSink(" + m_basebandSampleSink->objectName() + ")";
@@ -71,51 +104,78 @@ ThreadedBasebandSampleSink::ThreadedBasebandSampleSink(BasebandSampleSink* sampl
 
 	qDebug() << "ThreadedBasebandSampleSink::ThreadedBasebandSampleSink: " << name;
 
-	m_thread = new QThread(parent);
+	m_workerPool = DSPEngine::instance()->getChannelWorkerPool();
+	m_workerPool->start();
 	m_threadedBasebandSampleSinkFifo = new ThreadedBasebandSampleSinkFifo(m_basebandSampleSink);
-	//moveToThread(m_thread); // FIXME: Fixed? the intermediate FIFO should be handled within the sink. Define a new type of sink that is compatible with threading
-	m_basebandSampleSink->moveToThread(m_thread);
-	m_threadedBasebandSampleSinkFifo->moveToThread(m_thread);
-	//m_sampleFifo.moveToThread(m_thread);
-	//connect(&m_sampleFifo, SIGNAL(dataReady()), this, SLOT(handleData()));
-	//m_sampleFifo.setSize(262144);
-
-	qDebug() << "ThreadedBasebandSampleSink::ThreadedBasebandSampleSink: thread: " << thread() << " m_thread: " << m_thread;
+
+	// the sink messages are handled by the pool task in place of the sink own thread
+	disconnect(m_basebandSampleSink->getInputMessageQueue(), SIGNAL(messageEnqueued()), m_basebandSampleSink, SLOT(handleInputMessages()));
+	connect(m_basebandSampleSink->getInputMessageQueue(), SIGNAL(messageEnqueued()), this, SLOT(handleSinkInputMessages()), Qt::DirectConnection);
 }
 
 ThreadedBasebandSampleSink::~ThreadedBasebandSampleSink()
 {
+	m_workerPool->disable(m_threadedBasebandSampleSinkFifo);
 	delete m_threadedBasebandSampleSinkFifo; // Valgrind memcheck
-	delete m_thread;
 }
 
 void ThreadedBasebandSampleSink::start()
 {
 	qDebug() << "ThreadedBasebandSampleSink::start";
-	m_thread->start();
 	m_basebandSampleSink->start();
+	m_workerPool->enable(m_threadedBasebandSampleSinkFifo);
+	m_workerPool->schedule(m_threadedBasebandSampleSinkFifo); // messages queued while stopped
 }
 
 void ThreadedBasebandSampleSink::stop()
 {
 	qDebug() << "ThreadedBasebandSampleSink::stop";
+	m_workerPool->disable(m_threadedBasebandSampleSinkFifo);
 	m_basebandSampleSink->stop();
-	m_thread->exit();
-	m_thread->wait();
 }
 
-void ThreadedBasebandSampleSink::feed(SampleVector::const_iterator begin, SampleVector::const_iterator end, bool positiveOnly __attribute__((unused)))
+void ThreadedBasebandSampleSink::attachFifo(SampleSinkFifoShared *sampleFifo)
+{
+	detachFifo();
+	m_threadedBasebandSampleSinkFifo->m_sampleFifo = sampleFifo;
+	m_threadedBasebandSampleSinkFifo->m_sampleReader = sampleFifo->addReader();
+}
+
+void ThreadedBasebandSampleSink::detachFifo()
 {
-	//m_sampleSink->feed(begin, end, positiveOnly);
-	//m_sampleFifo.write(begin, end);
-	m_threadedBasebandSampleSinkFifo->writeToFifo(begin, end);
+	if (m_threadedBasebandSampleSinkFifo->m_sampleReader)
+	{
+		m_threadedBasebandSampleSinkFifo->m_sampleFifo->removeReader(m_threadedBasebandSampleSinkFifo->m_sampleReader);
+		m_threadedBasebandSampleSinkFifo->m_sampleReader = 0;
+		m_threadedBasebandSampleSinkFifo->m_sampleFifo = 0;
+	}
+}
+
+void ThreadedBasebandSampleSink::feed()
+{
+	m_workerPool->schedule(m_threadedBasebandSampleSinkFifo);
+}
+
+uint ThreadedBasebandSampleSink::getDroppedSamples() const
+{
+	if (m_threadedBasebandSampleSinkFifo->m_sampleReader) {
+		return m_threadedBasebandSampleSinkFifo->m_sampleReader->getDropped();
+	} else {
+		return 0;
+	}
 }
 
 bool ThreadedBasebandSampleSink::handleSinkMessage(const Message& cmd)
 {
+	QMutexLocker mutexLocker(&m_threadedBasebandSampleSinkFifo->m_mutex); // not during the sink feed
 	return m_basebandSampleSink->handleMessage(cmd);
 }
 
+void ThreadedBasebandSampleSink::handleSinkInputMessages()
+{
+	m_workerPool->schedule(m_threadedBasebandSampleSinkFifo);
+}
+
 QString ThreadedBasebandSampleSink::getSampleSinkObjectName() const
 {
 	return m_basebandSampleSink->objectName();
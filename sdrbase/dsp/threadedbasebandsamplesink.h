@@ -19,36 +19,40 @@
 #define INCLUDE_THREADEDSAMPLESINK_H
 
 #include <dsp/basebandsamplesink.h>
+#include <QObject>
+#include <QTime>
 #include <QMutex>
 
-#include "samplesinkfifo.h"
+#include "channelworkerpool.h"
+#include "samplesinkfifoshared.h"
 #include "util/messagequeue.h"
 #include "util/export.h"
 
 class BasebandSampleSink;
-class QThread;
 
 /**
- * Because Qt is a piece of shit this class cannot be a nested protected class of ThreadedSampleSink
- * So let's make everything public
+ * Work unit reading the shared baseband FIFO on behalf of a sink. It is run by the channel
+ * worker pool each time the device engine has written new samples or a message is queued to
+ * the sink. Messages are handled between FIFO reads so that they never run during the sink feed.
  */
-class ThreadedBasebandSampleSinkFifo : public QObject {
-	Q_OBJECT
-
+class ThreadedBasebandSampleSinkFifo : public ChannelWorkerTask {
 public:
-	ThreadedBasebandSampleSinkFifo(BasebandSampleSink* sampleSink, std::size_t size = 1<<18);
+	ThreadedBasebandSampleSinkFifo(BasebandSampleSink* sampleSink);
 	~ThreadedBasebandSampleSinkFifo();
-	void writeToFifo(SampleVector::const_iterator& begin, SampleVector::const_iterator& end);
+	virtual void run();
+	void handleSinkMessages();
 
 	BasebandSampleSink* m_sampleSink;
-	SampleSinkFifo m_sampleFifo;
-
-public slots:
-	void handleFifoData();
+	SampleSinkFifoShared* m_sampleFifo;            //!< Baseband FIFO shared with the other channels of the device
+	SampleSinkFifoShared::Reader* m_sampleReader;  //!< This channel read cursor in the shared FIFO
+	uint m_droppedReported;
+	QTime m_msgRateTimer;
+	QMutex m_mutex; //!< Serializes the sink feed and message handling
 };
 
 /**
- * This class is a wrapper for SampleSink that runs the SampleSink object in its own thread
+ * This class is a wrapper for SampleSink that runs the SampleSink processing in the channel worker pool.
+ * The sink input messages are handled by the same pool task as the samples.
  */
 class SDRANGEL_API ThreadedBasebandSampleSink : public QObject {
 	Q_OBJECT
@@ -59,19 +63,24 @@ public:
 
 	const BasebandSampleSink *getSink() const { return m_basebandSampleSink; }
 
-	void start(); //!< this thread start()
-	void stop();  //!< this thread exit() and wait()
+	void start(); //!< start scheduling the sink in the worker pool
+	void stop();  //!< stop scheduling and wait for the sink work in progress to complete
 
 	bool handleSinkMessage(const Message& cmd); //!< Send message to sink synchronously
-	void feed(SampleVector::const_iterator begin, SampleVector::const_iterator end, bool positiveOnly); //!< Feed sink with samples
+	void attachFifo(SampleSinkFifoShared *sampleFifo); //!< Start reading the device baseband FIFO. Call from FIFO producer thread with sink stopped.
+	void detachFifo();                                 //!< Stop reading the device baseband FIFO. Call from FIFO producer thread with sink stopped.
+	void feed(); //!< Notify sink that new samples are available in the attached FIFO
+	uint getDroppedSamples() const; //!< Samples lost because the sink could not keep up
 
 	QString getSampleSinkObjectName() const;
 
 protected:
-
-	QThread *m_thread; //!< The thead object
+	ChannelWorkerPool *m_workerPool;
 	ThreadedBasebandSampleSinkFifo *m_threadedBasebandSampleSinkFifo;
 	BasebandSampleSink* m_basebandSampleSink;
+
+private slots:
+	void handleSinkInputMessages(); //!< Runs in the thread that queued the message: only schedules the task
 };
 
 #endif // INCLUDE_THREADEDSAMPLESINK_H
@@ -17,6 +17,7 @@
 
 #include <QDebug>
 #include <QThread>
+#include <QCoreApplication>
 
 #include "dsp/threadedbasebandsamplesource.h"
 
@@ -52,6 +53,7 @@ void ThreadedBasebandSampleSource::stop()
     m_basebandSampleSource->stop();
     m_thread->exit();
     m_thread->wait();
+    QCoreApplication::removePostedEvents(m_basebandSampleSource, QEvent::MetaCall); // drop FIFO fill requests not served before stop
 }
 
 void ThreadedBasebandSampleSource::pull(Sample& sample)
@@ -59,6 +61,13 @@ void ThreadedBasebandSampleSource::pull(Sample& sample)
 	m_basebandSampleSource->pull(sample);
 }
 
+void ThreadedBasebandSampleSource::readBlock(SampleVector::iterator& readBegin, unsigned int nbSamples)
+{
+    SampleVector::iterator readUntil;
+    m_basebandSampleSource->getSampleSourceFifo().readAdvance(readUntil, nbSamples); // triggers the refill in the source thread
+    readBegin = readUntil - nbSamples;
+}
+
 void ThreadedBasebandSampleSource::feed(SampleSourceFifo* sampleFifo,
 	int nbSamples)
 {
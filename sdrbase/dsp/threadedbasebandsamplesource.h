@@ -44,8 +44,15 @@ public:
 
 	bool handleSourceMessage(const Message& cmd);  //!< Send message to source synchronously
 	void pull(Sample& sample);                     //!< Pull one sample from source
+	void pullBlock(SampleVector::iterator begin, unsigned int nbSamples) { m_basebandSampleSource->pullBlock(begin, nbSamples); } //!< Pull a block of samples from source
 	void pullAudio(int nbSamples) { if (m_basebandSampleSource) m_basebandSampleSource->pullAudio(nbSamples); }
 
+	/**
+	 * Get the next block produced ahead by the source in its own thread. The source FIFO is
+	 * then refilled asynchronously for the same amount in the source thread.
+	 */
+	void readBlock(SampleVector::iterator& readBegin, unsigned int nbSamples);
+
     /** direct feeding of sample source FIFO */
 	void feed(SampleSourceFifo* sampleFifo,
 		int nbSamples);
@@ -31,7 +31,8 @@ UpChannelizer::UpChannelizer(BasebandSampleSource* sampleSource) :
     m_requestedInputSampleRate(0),
     m_requestedCenterFrequency(0),
     m_currentInputSampleRate(0),
-    m_currentCenterFrequency(0)
+    m_currentCenterFrequency(0),
+    m_inputIndex(0)
 {
     QString name = "UpChannelizer(" + m_sampleSource->objectName() + ")";
     setObjectName(name);
@@ -62,43 +63,78 @@ void UpChannelizer::pull(Sample& sample)
     else
     {
         m_mutex.lock();
+        pullOne(sample, 1);
+        m_mutex.unlock();
+    }
+}
+
+void UpChannelizer::pullBlock(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    if(m_sampleSource == 0) {
+        m_sampleBuffer.clear();
+        return;
+    }
 
-        FilterStages::iterator stage = m_filterStages.begin();
-        std::vector<Sample>::iterator stageSample = m_stageSamples.begin();
+    if (m_filterStages.size() == 0) // optimization when no downsampling is done anyway
+    {
+        m_sampleSource->pullBlock(begin, nbSamples);
+    }
+    else
+    {
+        m_mutex.lock();
 
-        for (; stage != m_filterStages.end(); ++stage, ++stageSample)
+        for (unsigned int i = 0; i < nbSamples; i++, ++begin)
         {
-            if(stage == m_filterStages.end() - 1)
+            // the input rate is 2^stages lower: this is what is left to pull from the modulator for this block
+            pullOne(*begin, ((nbSamples - i) >> m_filterStages.size()) + 1);
+        }
+
+        m_mutex.unlock();
+    }
+}
+
+void UpChannelizer::pullOne(Sample& sample, unsigned int nbInputExpected)
+{
+    FilterStages::iterator stage = m_filterStages.begin();
+    std::vector<Sample>::iterator stageSample = m_stageSamples.begin();
+
+    for (; stage != m_filterStages.end(); ++stage, ++stageSample)
+    {
+        if(stage == m_filterStages.end() - 1)
+        {
+            if ((*stage)->work(&m_sampleIn, &(*stageSample)))
             {
-                if ((*stage)->work(&m_sampleIn, &(*stageSample)))
-                {
-                    m_sampleSource->pull(m_sampleIn); // get new input sample
-                }
+                nextInput(nbInputExpected); // get new input sample
             }
-            else
+        }
+        else
+        {
+            if (!(*stage)->work(&(*(stageSample+1)), &(*stageSample)))
             {
-                if (!(*stage)->work(&(*(stageSample+1)), &(*stageSample)))
-                {
-                    break;
-                }
+                break;
             }
         }
+    }
 
-        sample = *m_stageSamples.begin();
-
-//		for (; stage != m_filterStages.end(); ++stage)
-//		{
-//			// let's make it work for one stage only (96 kS/s < SR < 192 kS/s)
-//			if(stage == m_filterStages.end() - 1)
-//			{
-//				if ((*stage)->work(&m_sampleIn, &sample))
-//				{
-//					m_sampleSource->pull(m_sampleIn); // get new input sample
-//				}
-//			}
-//		}
+    sample = *m_stageSamples.begin();
+}
 
-        m_mutex.unlock();
+void UpChannelizer::nextInput(unsigned int nbInputExpected)
+{
+    if (m_inputIndex < m_inputBuffer.size())
+    {
+        m_sampleIn = m_inputBuffer[m_inputIndex++];
+    }
+    else if (nbInputExpected > 1)
+    {
+        m_inputBuffer.resize(nbInputExpected);
+        m_sampleSource->pullBlock(m_inputBuffer.begin(), nbInputExpected);
+        m_sampleIn = m_inputBuffer[0];
+        m_inputIndex = 1;
+    }
+    else
+    {
+        m_sampleSource->pull(m_sampleIn);
     }
 }
 
@@ -179,6 +215,8 @@ void UpChannelizer::applyConfiguration()
     m_mutex.lock();
 
     freeFilterChain();
+    m_inputBuffer.clear(); // samples pulled ahead at the previous input rate are dropped
+    m_inputIndex = 0;
 
     m_currentCenterFrequency = createFilterChain(
         m_outputSampleRate / -2, m_outputSampleRate / 2,
@@ -201,7 +239,7 @@ void UpChannelizer::applyConfiguration()
     }
 }
 
-#ifdef USE_SSE4_1
+#if defined(USE_SSE4_1) || defined(USE_SIMD_DISPATCH)
 UpChannelizer::FilterStage::FilterStage(Mode mode) :
     m_filter(new IntHalfbandFilterEO1<UPCHANNELIZER_HB_FILTER_ORDER>),
     m_workFunction(0)
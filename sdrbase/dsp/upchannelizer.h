@@ -23,7 +23,7 @@
 #include <QMutex>
 #include "util/export.h"
 #include "util/message.h"
-#ifdef USE_SSE4_1
+#if defined(USE_SSE4_1) || defined(USE_SIMD_DISPATCH)
 #include "dsp/inthalfbandfiltereo1.h"
 #else
 #include "dsp/inthalfbandfilterdb.h"
@@ -66,6 +66,7 @@ public:
     virtual void start();
     virtual void stop();
     virtual void pull(Sample& sample);
+    virtual void pullBlock(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples) { if (m_sampleSource) m_sampleSource->pullAudio(nbSamples); }
 
     virtual bool handleMessage(const Message& cmd);
@@ -78,7 +79,7 @@ protected:
             ModeUpperHalf
         };
 
-#ifdef USE_SSE4_1
+#if defined(USE_SSE4_1) || defined(USE_SIMD_DISPATCH)
         typedef bool (IntHalfbandFilterEO1<UPCHANNELIZER_HB_FILTER_ORDER>::*WorkFunction)(Sample* sIn, Sample *sOut);
         IntHalfbandFilterEO1<UPCHANNELIZER_HB_FILTER_ORDER>* m_filter;
 #else
@@ -106,8 +107,12 @@ protected:
     int m_currentCenterFrequency;
     SampleVector m_sampleBuffer;
     Sample m_sampleIn;
+    SampleVector m_inputBuffer;  //!< modulator samples pulled ahead by block
+    unsigned int m_inputIndex;   //!< next sample to use in m_inputBuffer
     QMutex m_mutex;
 
+    void pullOne(Sample& sample, unsigned int nbInputExpected); //!< run the interpolator chain for one output sample
+    void nextInput(unsigned int nbInputExpected);               //!< get next modulator sample in m_sampleIn
     void applyConfiguration();
     bool signalContainsChannel(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd) const;
     Real createFilterChain(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd);
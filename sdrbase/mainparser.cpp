@@ -29,10 +29,26 @@ MainParser::MainParser() :
     m_serverPortOption(QStringList() << "p" << "api-port",
         "Web API server port.",
         "port",
-        "8091")
+        "8091"),
+    m_channelThreadsOption(QStringList() << "channel-threads",
+        "Number of channel processing threads (0 for one per core).",
+        "threads",
+        "0"),
+    m_pinChannelThreadsOption(QStringList() << "pin-channel-threads",
+        "Pin each channel processing thread to a core."),
+    m_correctionInAcquisitionOption(QStringList() << "correction-in-acquisition",
+        "Apply DC offset and IQ imbalance corrections in the device acquisition threads."),
+    m_fftPlanningOption(QStringList() << "fft-planning",
+        "FFT planning effort: estimate, measure or patient.",
+        "effort",
+        "patient")
 {
     m_serverAddress = "127.0.0.1";
     m_serverPort = 8091;
+    m_channelThreads = 0;
+    m_pinChannelThreads = false;
+    m_correctionInAcquisition = false;
+    m_fftPlanningEffort = FFTEngine::PlanPatient;
 
     m_parser.setApplicationDescription("Software Defined Radio application");
     m_parser.addHelpOption();
@@ -40,6 +56,10 @@ MainParser::MainParser() :
 
     m_parser.addOption(m_serverAddressOption);
     m_parser.addOption(m_serverPortOption);
+    m_parser.addOption(m_channelThreadsOption);
+    m_parser.addOption(m_pinChannelThreadsOption);
+    m_parser.addOption(m_correctionInAcquisitionOption);
+    m_parser.addOption(m_fftPlanningOption);
 }
 
 MainParser::~MainParser()
@@ -79,4 +99,32 @@ void MainParser::parse(const QCoreApplication& app)
     } else {
         qWarning() << "MainParser::parse: server port invalid. Defaulting to " << m_serverPort;
     }
+
+    // channel processing threads
+
+    QString channelThreadsStr = m_parser.value(m_channelThreadsOption);
+    int channelThreads = channelThreadsStr.toInt(&ok);
+
+    if (ok && (channelThreads >= 0) && (channelThreads <= 256)) {
+        m_channelThreads = channelThreads;
+    } else {
+        qWarning() << "MainParser::parse: number of channel threads invalid. Defaulting to " << m_channelThreads;
+    }
+
+    m_pinChannelThreads = m_parser.isSet(m_pinChannelThreadsOption);
+    m_correctionInAcquisition = m_parser.isSet(m_correctionInAcquisitionOption);
+
+    // FFT planning effort
+
+    QString fftPlanning = m_parser.value(m_fftPlanningOption);
+
+    if (fftPlanning == "estimate") {
+        m_fftPlanningEffort = FFTEngine::PlanEstimate;
+    } else if (fftPlanning == "measure") {
+        m_fftPlanningEffort = FFTEngine::PlanMeasure;
+    } else if (fftPlanning == "patient") {
+        m_fftPlanningEffort = FFTEngine::PlanPatient;
+    } else {
+        qWarning() << "MainParser::parse: FFT planning effort invalid. Defaulting to patient";
+    }
 }
@@ -21,6 +21,8 @@
 #include <QCommandLineParser>
 #include <stdint.h>
 
+#include "dsp/fftengine.h"
+
 class MainParser
 {
 public:
@@ -31,14 +33,26 @@ public:
 
     const QString& getServerAddress() const { return m_serverAddress; }
     uint16_t getServerPort() const { return m_serverPort; }
+    int getChannelThreads() const { return m_channelThreads; }
+    bool getPinChannelThreads() const { return m_pinChannelThreads; }
+    bool getCorrectionInAcquisition() const { return m_correctionInAcquisition; }
+    FFTEngine::PlanningEffort getFFTPlanningEffort() const { return m_fftPlanningEffort; }
 
 private:
     QString  m_serverAddress;
     uint16_t m_serverPort;
+    int      m_channelThreads;
+    bool     m_pinChannelThreads;
+    bool     m_correctionInAcquisition;
+    FFTEngine::PlanningEffort m_fftPlanningEffort;
 
     QCommandLineParser m_parser;
     QCommandLineOption m_serverAddressOption;
     QCommandLineOption m_serverPortOption;
+    QCommandLineOption m_channelThreadsOption;
+    QCommandLineOption m_pinChannelThreadsOption;
+    QCommandLineOption m_correctionInAcquisitionOption;
+    QCommandLineOption m_fftPlanningOption;
 };
 
 
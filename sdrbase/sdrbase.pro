@@ -48,6 +48,7 @@ win32 {
 }
 
 SOURCES += audio/audiodeviceinfo.cpp\
+        audio/audiodevicemanager.cpp\
         audio/audiofifo.cpp\
         audio/audiooutput.cpp\
         audio/audioinput.cpp\
@@ -65,6 +66,7 @@ SOURCES += audio/audiodeviceinfo.cpp\
         dsp/cwkeyer.cpp\
         dsp/dspcommands.cpp\
         dsp/dspengine.cpp\
+        dsp/devicespectrumengine.cpp\
         dsp/dspdevicesourceengine.cpp\
         dsp/dspdevicesinkengine.cpp\
         dsp/fftengine.cpp\
@@ -83,6 +85,12 @@ SOURCES += audio/audiodeviceinfo.cpp\
         dsp/phaselock.cpp\
         dsp/recursivefilters.cpp\
         dsp/samplesinkfifo.cpp\
+        dsp/spectrumaverager.cpp\
+        dsp/spectrumengine.cpp\
+        dsp/samplesinkfifoshared.cpp\
+        dsp/channelworkerpool.cpp\
+        dsp/iqcorrection.cpp\
+        dsp/simddispatch.cpp\
         dsp/samplesourcefifo.cpp\
         dsp/samplesinkfifodoublebuffered.cpp\
         dsp/basebandsamplesink.cpp\
@@ -98,6 +106,7 @@ SOURCES += audio/audiodeviceinfo.cpp\
         settings/mainsettings.cpp\
         util/CRC64.cpp\
         util/db.cpp\
+        util/iqcodec.cpp\
         util/message.cpp\
         util/messagequeue.cpp\
         util/prettyprint.cpp\
@@ -108,12 +117,14 @@ SOURCES += audio/audiodeviceinfo.cpp\
         plugin/plugininterface.cpp\
         plugin/pluginapi.cpp\        
         plugin/pluginmanager.cpp\
+        webapi/webapiadapterbase.cpp\
         webapi/webapiadapterinterface.cpp\
         webapi/webapirequestmapper.cpp\
         webapi/webapiserver.cpp\
         mainparser.cpp
 
 HEADERS  += audio/audiodeviceinfo.h\
+        audio/audiodevicemanager.h\
         audio/audiofifo.h\
         audio/audiooutput.h\
         audio/audioinput.h\
@@ -129,9 +140,11 @@ HEADERS  += audio/audiodeviceinfo.h\
         dsp/cwkeyer.h\
         dsp/complex.h\
         dsp/decimators.h\
+        dsp/decimatorsavx2.h\
         dsp/interpolators.h\
         dsp/dspcommands.h\
         dsp/dspengine.h\
+        dsp/devicespectrumengine.h\
         dsp/dspdevicesourceengine.h\
         dsp/dspdevicesinkengine.h\
         dsp/dsptypes.h\
@@ -163,6 +176,12 @@ HEADERS  += audio/audiodeviceinfo.h\
         dsp/pidcontroller.h\
         dsp/recursivefilters.h\
         dsp/samplesinkfifo.h\
+        dsp/spectrumaverager.h\
+        dsp/spectrumengine.h\
+        dsp/samplesinkfifoshared.h\
+        dsp/channelworkerpool.h\
+        dsp/iqcorrection.h\
+        dsp/simddispatch.h\
         dsp/samplesourcefifo.h\
         dsp/samplesinkfifodoublebuffered.h\
         dsp/samplesinkfifodecimator.h\
@@ -184,6 +203,7 @@ HEADERS  += audio/audiodeviceinfo.h\
         util/CRC64.h\
         util/db.h\
         util/export.h\
+        util/iqcodec.h\
         util/message.h\
         util/messagequeue.h\
         util/prettyprint.h\
@@ -191,6 +211,7 @@ HEADERS  += audio/audiodeviceinfo.h\
         util/samplesourceserializer.h\
         util/simpleserializer.h\
         util/uid.h\
+        webapi/webapiadapterbase.h\
         webapi/webapiadapterinterface.h\
         webapi/webapirequestmapper.h\
         webapi/webapiserver.h\
@@ -0,0 +1,324 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <string.h>
+
+#include "iqcodec.h"
+
+namespace {
+
+class BitWriter
+{
+public:
+    BitWriter(uint8_t *buffer, int maxBytes) :
+        m_buffer(buffer),
+        m_maxBytes(maxBytes),
+        m_nbBytes(0),
+        m_acc(0),
+        m_nbBits(0),
+        m_overflow(false)
+    {}
+
+    /** Append the nbBits (at most 32) least significant bits of value MSB first */
+    void put(uint32_t value, int nbBits)
+    {
+        m_acc = (m_acc << nbBits) | (value & (nbBits == 32 ? 0xFFFFFFFFU : ((1U << nbBits) - 1)));
+        m_nbBits += nbBits;
+
+        while (m_nbBits >= 8)
+        {
+            m_nbBits -= 8;
+
+            if (m_nbBytes < m_maxBytes) {
+                m_buffer[m_nbBytes++] = (m_acc >> m_nbBits) & 0xFF;
+            } else {
+                m_overflow = true;
+            }
+        }
+
+        m_acc &= (1ULL << m_nbBits) - 1;
+    }
+
+    /** Pad the last byte with zeros and return the number of bytes or -1 if the buffer was too small */
+    int flush()
+    {
+        if (m_nbBits > 0) {
+            put(0, 8 - m_nbBits);
+        }
+
+        return m_overflow ? -1 : m_nbBytes;
+    }
+
+    bool overflow() const { return m_overflow; }
+
+private:
+    uint8_t *m_buffer;
+    int m_maxBytes;
+    int m_nbBytes;
+    uint64_t m_acc;
+    int m_nbBits;
+    bool m_overflow;
+};
+
+class BitReader
+{
+public:
+    BitReader(const uint8_t *buffer, int nbBytes) :
+        m_buffer(buffer),
+        m_nbBytes(nbBytes),
+        m_byteIndex(0),
+        m_acc(0),
+        m_nbBits(0),
+        m_underflow(false)
+    {}
+
+    /** Read nbBits (at most 32) MSB first. Reading past the end returns zeros and sets the underflow flag */
+    uint32_t get(int nbBits)
+    {
+        while (m_nbBits < nbBits)
+        {
+            if (m_byteIndex < m_nbBytes) {
+                m_acc = (m_acc << 8) | m_buffer[m_byteIndex++];
+            } else {
+                m_acc <<= 8;
+                m_underflow = true;
+            }
+
+            m_nbBits += 8;
+        }
+
+        m_nbBits -= nbBits;
+        uint32_t value = (m_acc >> m_nbBits) & (nbBits == 32 ? 0xFFFFFFFFU : ((1U << nbBits) - 1));
+        m_acc &= (1ULL << m_nbBits) - 1;
+        return value;
+    }
+
+    bool underflow() const { return m_underflow; }
+
+private:
+    const uint8_t *m_buffer;
+    int m_nbBytes;
+    int m_byteIndex;
+    uint64_t m_acc;
+    int m_nbBits;
+    bool m_underflow;
+};
+
+inline uint32_t zigzag(int32_t x)
+{
+    return ((uint32_t) x << 1) ^ (uint32_t) (x >> 31);
+}
+
+inline int32_t unzigzag(uint32_t u)
+{
+    return (int32_t) (u >> 1) ^ -(int32_t) (u & 1);
+}
+
+/** Rice parameter such that 2^k is about the mean of the values */
+inline int riceParameter(uint64_t sum, int count, int maxK)
+{
+    int k = 0;
+
+    while ((k < maxK) && (((uint64_t) count << (k + 1)) <= sum)) {
+        k++;
+    }
+
+    return k;
+}
+
+} // namespace
+
+void IQCodec::pack(const int16_t *iq, int nbSamples, int sampleBits, uint8_t *packed)
+{
+    if (sampleBits == 16)
+    {
+        memcpy((void *) packed, (const void *) iq, nbSamples * 4);
+    }
+    else if (sampleBits == 12)
+    {
+        for (int i = 0; i < nbSamples; i++, iq += 2, packed += 3)
+        {
+            uint16_t re = (uint16_t) iq[0] >> 4;
+            uint16_t im = (uint16_t) iq[1] >> 4;
+            packed[0] = re & 0xFF;
+            packed[1] = ((re >> 8) & 0x0F) | ((im & 0x0F) << 4);
+            packed[2] = (im >> 4) & 0xFF;
+        }
+    }
+    else // 8 bits
+    {
+        for (int i = 0; i < 2*nbSamples; i++) {
+            packed[i] = (uint16_t) iq[i] >> 8;
+        }
+    }
+}
+
+void IQCodec::unpack(const uint8_t *packed, int nbSamples, int sampleBits, int16_t *iq)
+{
+    if (sampleBits == 16)
+    {
+        memcpy((void *) iq, (const void *) packed, nbSamples * 4);
+    }
+    else if (sampleBits == 12)
+    {
+        for (int i = 0; i < nbSamples; i++, iq += 2, packed += 3)
+        {
+            iq[0] = (int16_t) (((packed[1] & 0x0F) << 12) | (packed[0] << 4));
+            iq[1] = (int16_t) ((packed[2] << 8) | (packed[1] & 0xF0));
+        }
+    }
+    else // 8 bits
+    {
+        for (int i = 0; i < 2*nbSamples; i++) {
+            iq[i] = (int16_t) (packed[i] << 8);
+        }
+    }
+}
+
+int IQCodec::compress(const int16_t *iq, int nbSamples, int sampleBits, uint8_t *compressed, int maxBytes)
+{
+    const int nbValues = 2 * nbSamples;
+    int wastedBits = 0;
+    uint32_t valuesOr = 0;
+
+    // low order bits that are zero in all values (e.g. 8 bit data in 16 bit samples) are not sent
+    for (int i = 0; i < nbValues; i++) {
+        valuesOr |= (uint32_t) (iq[i] >> (16 - sampleBits));
+    }
+
+    while ((wastedBits < sampleBits - 1) && valuesOr && !(valuesOr & (1U << wastedBits))) {
+        wastedBits++;
+    }
+
+    const int shift = 16 - sampleBits + wastedBits;
+    const int maxK = sampleBits - wastedBits + 1; // zigzag of a difference is below 2^(bits+2)
+    const int escapeBits = sampleBits - wastedBits + 2;
+    BitWriter writer(compressed, maxBytes);
+    int32_t prev[2] = {0, 0};
+    uint32_t direct[m_groupSize];
+    uint32_t delta[m_groupSize];
+
+    writer.put(wastedBits, 4);
+
+    for (int g = 0; g < nbValues; g += m_groupSize)
+    {
+        int count = nbValues - g < m_groupSize ? nbValues - g : m_groupSize;
+        uint64_t directSum = 0;
+        uint64_t deltaSum = 0;
+
+        for (int j = 0; j < count; j++)
+        {
+            int c = (g + j) & 1; // I or Q
+            int32_t v = iq[g + j] >> shift;
+            direct[j] = zigzag(v);
+            delta[j] = zigzag(v - prev[c]);
+            prev[c] = v;
+            directSum += direct[j];
+            deltaSum += delta[j];
+        }
+
+        bool useDelta = deltaSum < directSum;
+        const uint32_t *values = useDelta ? delta : direct;
+        int k = riceParameter(useDelta ? deltaSum : directSum, count, maxK);
+
+        writer.put(useDelta ? 1 : 0, 1);
+        writer.put(k, 5);
+
+        for (int j = 0; j < count; j++)
+        {
+            uint32_t q = values[j] >> k;
+
+            if (q < (uint32_t) m_escapeCount)
+            {
+                writer.put((1U << (q + 1)) - 2, q + 1); // q ones and a zero
+                writer.put(values[j], k);
+            }
+            else
+            {
+                writer.put((1U << m_escapeCount) - 1, m_escapeCount);
+                writer.put(values[j], escapeBits);
+            }
+        }
+
+        if (writer.overflow()) {
+            return -1;
+        }
+    }
+
+    return writer.flush();
+}
+
+bool IQCodec::decompress(const uint8_t *compressed, int nbBytes, int nbSamples, int sampleBits, int16_t *iq)
+{
+    BitReader reader(compressed, nbBytes);
+    const int wastedBits = reader.get(4);
+
+    if (wastedBits >= sampleBits) {
+        return false;
+    }
+
+    const int shift = 16 - sampleBits + wastedBits;
+    const int maxK = sampleBits - wastedBits + 1;
+    const int escapeBits = sampleBits - wastedBits + 2;
+    const int32_t vMin = -(1 << (sampleBits - wastedBits - 1));
+    const int32_t vMax = (1 << (sampleBits - wastedBits - 1)) - 1;
+    const int nbValues = 2 * nbSamples;
+    int32_t prev[2] = {0, 0};
+
+    for (int g = 0; g < nbValues; g += m_groupSize)
+    {
+        int count = nbValues - g < m_groupSize ? nbValues - g : m_groupSize;
+        bool useDelta = reader.get(1) != 0;
+        int k = reader.get(5);
+
+        if (k > maxK) {
+            return false;
+        }
+
+        for (int j = 0; j < count; j++)
+        {
+            int q = 0;
+            uint32_t u;
+
+            while ((q < m_escapeCount) && reader.get(1)) {
+                q++;
+            }
+
+            if (q == m_escapeCount) {
+                u = reader.get(escapeBits);
+            } else {
+                u = ((uint32_t) q << k) | reader.get(k);
+            }
+
+            int c = (g + j) & 1;
+            int32_t v = useDelta ? prev[c] + unzigzag(u) : unzigzag(u);
+
+            if ((v < vMin) || (v > vMax)) {
+                return false;
+            }
+
+            prev[c] = v;
+            iq[g + j] = (int16_t) (v * (1 << shift));
+        }
+
+        if (reader.underflow()) {
+            return false;
+        }
+    }
+
+    return true;
+}
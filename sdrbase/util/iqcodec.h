@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRBASE_UTIL_IQCODEC_H_
+#define SDRBASE_UTIL_IQCODEC_H_
+
+#include <stdint.h>
+
+#include "util/export.h"
+
+/**
+ * Compact transport coding of 16 bit I/Q samples given as interleaved I and Q values.
+ *
+ * Packing keeps the 16, 12 or 8 most significant bits of each value and stores a sample
+ * in 4, 3 or 2 bytes respectively. Unpacking restores the values left aligned on 16 bits.
+ *
+ * Compression is lossless on the packed values. Low order bits that are zero in all values
+ * are dropped. Then each group of 32 values is coded either as is or as differences with the
+ * previous value of the same component, whichever is smaller, with an adaptive Rice code.
+ */
+class SDRANGEL_API IQCodec
+{
+public:
+    static bool isValidBits(int sampleBits) { return (sampleBits == 8) || (sampleBits == 12) || (sampleBits == 16); }
+    static int getBytesPerSample(int sampleBits) { return (2 * sampleBits) / 8; }
+
+    static void pack(const int16_t *iq, int nbSamples, int sampleBits, uint8_t *packed);
+    static void unpack(const uint8_t *packed, int nbSamples, int sampleBits, int16_t *iq);
+
+    /**
+     * Compress nbSamples samples to at most maxBytes bytes.
+     * Returns the number of bytes written or -1 if the result would not fit.
+     */
+    static int compress(const int16_t *iq, int nbSamples, int sampleBits, uint8_t *compressed, int maxBytes);
+
+    /** Decompress exactly nbSamples samples. Returns false if the input is truncated or corrupt. */
+    static bool decompress(const uint8_t *compressed, int nbBytes, int nbSamples, int sampleBits, int16_t *iq);
+
+private:
+    static const int m_groupSize = 32;   //!< Number of values sharing a predictor and Rice parameter
+    static const int m_escapeCount = 15; //!< Unary quotient at which the value is sent verbatim
+};
+
+#endif /* SDRBASE_UTIL_IQCODEC_H_ */
@@ -0,0 +1,173 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Swagger server adapter common to the GUI and the headless server              //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QAudioDeviceInfo>
+
+#include "dsp/dspengine.h"
+#include "dsp/dspdevicesourceengine.h"
+#include "dsp/dspdevicesinkengine.h"
+#include "dsp/devicesamplesource.h"
+#include "dsp/devicesamplesink.h"
+#include "dsp/devicespectrumengine.h"
+#include "device/devicesourceapi.h"
+#include "device/devicesinkapi.h"
+#include "audio/audiooutput.h"
+
+#include "SWGAudioDevices.h"
+#include "SWGAudioFifoStatus.h"
+#include "SWGSpectrumFrame.h"
+#include "SWGSpectrumSettings.h"
+#include "SWGDeviceReport.h"
+#include "SWGErrorResponse.h"
+
+#include "webapiadapterbase.h"
+
+int WebAPIAdapterBase::instanceAudioGet(
+            Swagger::SWGAudioDevices& response,
+            Swagger::SWGErrorResponse& error __attribute__((unused)))
+{
+    QList<QAudioDeviceInfo> inputDevices = QAudioDeviceInfo::availableDevices(QAudio::AudioInput);
+    QList<QAudioDeviceInfo> outputDevices = QAudioDeviceInfo::availableDevices(QAudio::AudioOutput);
+
+    response.init();
+    response.setNbInputDevices(inputDevices.size());
+    QList<QString*> *inputDeviceNames = response.getInputDevices();
+
+    for (int i = 0; i < inputDevices.size(); i++) {
+        inputDeviceNames->append(new QString(inputDevices.at(i).deviceName()));
+    }
+
+    response.setNbOutputDevices(outputDevices.size());
+    QList<QString*> *outputDeviceNames = response.getOutputDevices();
+
+    for (int i = 0; i < outputDevices.size(); i++) {
+        outputDeviceNames->append(new QString(outputDevices.at(i).deviceName()));
+    }
+
+    std::vector<AudioOutput::FifoStatus> fifoStatus;
+    DSPEngine::instance()->getAudioDeviceManager()->getFifoStatus(fifoStatus);
+    response.setNbOutputFifos((int) fifoStatus.size());
+    QList<Swagger::SWGAudioFifoStatus*> *outputFifos = response.getOutputFifos();
+
+    for (std::vector<AudioOutput::FifoStatus>::const_iterator it = fifoStatus.begin(); it != fifoStatus.end(); ++it)
+    {
+        outputFifos->append(new Swagger::SWGAudioFifoStatus());
+        outputFifos->back()->setSize(it->m_size);
+        outputFifos->back()->setFill(it->m_fill);
+        outputFifos->back()->setUnderrunCount(it->m_underrunCount);
+        outputFifos->back()->setOverrunCount(it->m_overrunCount);
+    }
+
+    return 200;
+}
+
+int WebAPIAdapterBase::devicesetSpectrumGet(
+            int deviceSetIndex,
+            Swagger::SWGSpectrumFrame& response,
+            Swagger::SWGErrorResponse& error)
+{
+    DeviceSpectrumEngine *spectrumEngine = getSpectrumEngine(deviceSetIndex, error);
+
+    if (!spectrumEngine) {
+        return 404;
+    }
+
+    int status = spectrumEngine->webapiFrameGet(response, *error.getMessage());
+    return status;
+}
+
+int WebAPIAdapterBase::devicesetSpectrumPatch(
+            int deviceSetIndex,
+            const QStringList& spectrumSettingsKeys,
+            Swagger::SWGSpectrumSettings& response,
+            Swagger::SWGErrorResponse& error)
+{
+    DeviceSpectrumEngine *spectrumEngine = getSpectrumEngine(deviceSetIndex, error);
+
+    if (!spectrumEngine) {
+        return 404;
+    }
+
+    int status = spectrumEngine->webapiSettingsPatch(spectrumSettingsKeys, response, *error.getMessage());
+    return status;
+}
+
+int WebAPIAdapterBase::devicesetDeviceReportGet(
+            int deviceSetIndex,
+            Swagger::SWGDeviceReport& response,
+            Swagger::SWGErrorResponse& error)
+{
+    DeviceSetRef deviceSet;
+
+    if (!getDeviceSet(deviceSetIndex, deviceSet))
+    {
+        *error.getMessage() = QString("There is no device set at index %1").arg(deviceSetIndex);
+        return 404;
+    }
+
+    if (deviceSet.m_deviceSinkEngine) // Tx
+    {
+        DeviceSampleSink *sampleSink = deviceSet.m_deviceSinkEngine->getSink();
+
+        if (!sampleSink)
+        {
+            *error.getMessage() = QString("Device set %1 has no sampling device").arg(deviceSetIndex);
+            return 404;
+        }
+
+        *response.getDeviceHwType() = deviceSet.m_deviceSinkAPI->getHardwareId();
+        response.setTx(true);
+        return sampleSink->webapiReportGet(response, *error.getMessage());
+    }
+    else if (deviceSet.m_deviceSourceEngine) // Rx
+    {
+        DeviceSampleSource *sampleSource = deviceSet.m_deviceSourceEngine->getSource();
+
+        if (!sampleSource)
+        {
+            *error.getMessage() = QString("Device set %1 has no sampling device").arg(deviceSetIndex);
+            return 404;
+        }
+
+        *response.getDeviceHwType() = deviceSet.m_deviceSourceAPI->getHardwareId();
+        response.setTx(false);
+        return sampleSource->webapiReportGet(response, *error.getMessage());
+    }
+    else
+    {
+        *error.getMessage() = QString("Device set %1 has no sampling device").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
+DeviceSpectrumEngine *WebAPIAdapterBase::getSpectrumEngine(int deviceSetIndex, Swagger::SWGErrorResponse& error)
+{
+    DeviceSetRef deviceSet;
+
+    if (!getDeviceSet(deviceSetIndex, deviceSet))
+    {
+        *error.getMessage() = QString("There is no device set at index %1").arg(deviceSetIndex);
+        return 0;
+    }
+
+    if (!deviceSet.m_spectrumEngine) {
+        *error.getMessage() = QString("Device set %1 has no spectrum engine").arg(deviceSetIndex);
+    }
+
+    return deviceSet.m_spectrumEngine;
+}
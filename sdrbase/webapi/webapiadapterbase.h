@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Swagger server adapter common to the GUI and the headless server              //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_WEBAPI_WEBAPIADAPTERBASE_H_
+#define SDRBASE_WEBAPI_WEBAPIADAPTERBASE_H_
+
+#include "webapi/webapiadapterinterface.h"
+#include "util/export.h"
+
+class DSPDeviceSourceEngine;
+class DeviceSourceAPI;
+class DSPDeviceSinkEngine;
+class DeviceSinkAPI;
+class DeviceSpectrumEngine;
+
+/**
+ * Handlers that only depend on the device sets and not on the application hosting them.
+ * The GUI and headless server adapters derive from it and give access to their device sets.
+ */
+class SDRANGEL_API WebAPIAdapterBase : public WebAPIAdapterInterface
+{
+public:
+    virtual ~WebAPIAdapterBase() {}
+
+    virtual int instanceAudioGet(
+            Swagger::SWGAudioDevices& response,
+            Swagger::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumGet(
+            int deviceSetIndex,
+            Swagger::SWGSpectrumFrame& response,
+            Swagger::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumPatch(
+            int deviceSetIndex,
+            const QStringList& spectrumSettingsKeys,
+            Swagger::SWGSpectrumSettings& response,
+            Swagger::SWGErrorResponse& error);
+
+    virtual int devicesetDeviceReportGet(
+            int deviceSetIndex,
+            Swagger::SWGDeviceReport& response,
+            Swagger::SWGErrorResponse& error);
+
+protected:
+    /** Parts of a device set (DeviceUISet or DeviceSet) used by the handlers */
+    struct DeviceSetRef
+    {
+        DSPDeviceSourceEngine *m_deviceSourceEngine;
+        DeviceSourceAPI *m_deviceSourceAPI;
+        DSPDeviceSinkEngine *m_deviceSinkEngine;
+        DeviceSinkAPI *m_deviceSinkAPI;
+        DeviceSpectrumEngine *m_spectrumEngine;
+
+        DeviceSetRef() :
+            m_deviceSourceEngine(0),
+            m_deviceSourceAPI(0),
+            m_deviceSinkEngine(0),
+            m_deviceSinkAPI(0),
+            m_spectrumEngine(0)
+        {}
+    };
+
+    /** Fills deviceSet and returns true if there is a device set at this index */
+    virtual bool getDeviceSet(int deviceSetIndex, DeviceSetRef& deviceSet) = 0;
+
+private:
+    DeviceSpectrumEngine *getSpectrumEngine(int deviceSetIndex, Swagger::SWGErrorResponse& error);
+};
+
+#endif /* SDRBASE_WEBAPI_WEBAPIADAPTERBASE_H_ */
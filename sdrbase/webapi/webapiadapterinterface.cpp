@@ -19,4 +19,7 @@
 #include "webapiadapterinterface.h"
 
 QString WebAPIAdapterInterface::instanceSummaryURL = "/sdrangel";
+QString WebAPIAdapterInterface::instanceAudioURL = "/sdrangel/audio";
+std::regex WebAPIAdapterInterface::devicesetSpectrumURLRe("^/sdrangel/deviceset/([0-9]{1,2})/spectrum$");
+std::regex WebAPIAdapterInterface::devicesetDeviceReportURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/report$");
 
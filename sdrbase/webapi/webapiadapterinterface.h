@@ -20,10 +20,16 @@
 #define SDRBASE_WEBAPI_WEBAPIADAPTERINTERFACE_H_
 
 #include <QString>
+#include <QStringList>
+#include <regex>
 
 namespace Swagger
 {
     class SWGInstanceSummaryResponse;
+    class SWGAudioDevices;
+    class SWGSpectrumFrame;
+    class SWGSpectrumSettings;
+    class SWGDeviceReport;
     class SWGErrorResponse;
 }
 
@@ -41,7 +47,52 @@ public:
             Swagger::SWGErrorResponse& error __attribute__((unused)))
     { return 501; }
 
+    /**
+     * Handler of /sdrangel/audio (GET) swagger/sdrangel/code/html2/index.html#api-Default-instanceAudioGet
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int instanceAudioGet(
+            Swagger::SWGAudioDevices& response __attribute__((unused)),
+            Swagger::SWGErrorResponse& error __attribute__((unused)))
+    { return 501; }
+
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/spectrum (GET) swagger/sdrangel/code/html2/index.html#api-Default-devicesetSpectrumGet
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumGet(
+            int deviceSetIndex __attribute__((unused)),
+            Swagger::SWGSpectrumFrame& response __attribute__((unused)),
+            Swagger::SWGErrorResponse& error __attribute__((unused)))
+    { return 501; }
+
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/spectrum (PATCH) swagger/sdrangel/code/html2/index.html#api-Default-devicesetSpectrumPatch
+     * response holds the settings of the request on input. Only the fields listed in spectrumSettingsKeys are applied.
+     * On output it holds the resulting settings.
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumPatch(
+            int deviceSetIndex __attribute__((unused)),
+            const QStringList& spectrumSettingsKeys __attribute__((unused)),
+            Swagger::SWGSpectrumSettings& response __attribute__((unused)),
+            Swagger::SWGErrorResponse& error __attribute__((unused)))
+    { return 501; }
+
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/device/report (GET) swagger/sdrangel/code/html2/index.html#api-Default-devicesetDeviceReportGet
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetDeviceReportGet(
+            int deviceSetIndex __attribute__((unused)),
+            Swagger::SWGDeviceReport& response __attribute__((unused)),
+            Swagger::SWGErrorResponse& error __attribute__((unused)))
+    { return 501; }
+
     static QString instanceSummaryURL;
+    static QString instanceAudioURL;
+    static std::regex devicesetSpectrumURLRe;
+    static std::regex devicesetDeviceReportURLRe;
 };
 
 
@@ -16,8 +16,15 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <QJsonDocument>
+#include <QJsonObject>
+
 #include "webapirequestmapper.h"
 #include "SWGInstanceSummaryResponse.h"
+#include "SWGAudioDevices.h"
+#include "SWGSpectrumFrame.h"
+#include "SWGSpectrumSettings.h"
+#include "SWGDeviceReport.h"
 #include "SWGErrorResponse.h"
 
 WebAPIRequestMapper::WebAPIRequestMapper(QObject* parent) :
@@ -35,6 +42,8 @@ void WebAPIRequestMapper::service(qtwebapp::HttpRequest& request, qtwebapp::Http
     else // normal processing
     {
         QByteArray path=request.getPath();
+        std::string pathStr(path.constData(), path.length());
+        std::smatch desc_match;
 
         if (path == WebAPIAdapterInterface::instanceSummaryURL)
         {
@@ -59,9 +68,119 @@ void WebAPIRequestMapper::service(qtwebapp::HttpRequest& request, qtwebapp::Http
                 response.setStatus(405,"Invalid HTTP method");
             }
         }
+        else if (path == WebAPIAdapterInterface::instanceAudioURL)
+        {
+            if (request.getMethod() == "GET")
+            {
+                Swagger::SWGAudioDevices normalResponse;
+                Swagger::SWGErrorResponse errorResponse;
+
+                int status = m_adapter->instanceAudioGet(normalResponse, errorResponse);
+
+                if (status == 200) {
+                    response.write(normalResponse.asJson().toUtf8());
+                } else {
+                    response.write(errorResponse.asJson().toUtf8());
+                }
+
+                response.setStatus(status);
+            }
+            else
+            {
+                response.write("Invalid HTTP method");
+                response.setStatus(405,"Invalid HTTP method");
+            }
+        }
+        else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetSpectrumURLRe))
+        {
+            devicesetSpectrumService(std::string(desc_match[1]), request, response);
+        }
+        else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceReportURLRe))
+        {
+            devicesetDeviceReportService(std::string(desc_match[1]), request, response);
+        }
         else
         {
             response.setStatus(404,"Not found");
         }
     }
 }
+
+void WebAPIRequestMapper::devicesetSpectrumService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    Swagger::SWGErrorResponse errorResponse;
+    int deviceSetIndex = std::stoi(indexStr);
+
+    if (request.getMethod() == "GET")
+    {
+        Swagger::SWGSpectrumFrame normalResponse;
+
+        int status = m_adapter->devicesetSpectrumGet(deviceSetIndex, normalResponse, errorResponse);
+
+        if (status == 200) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
+        }
+
+        response.setStatus(status);
+    }
+    else if (request.getMethod() == "PATCH")
+    {
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(request.getBody(), &parseError);
+
+        if ((parseError.error != QJsonParseError::NoError) || !doc.isObject())
+        {
+            *errorResponse.getMessage() = QString("Invalid JSON request: %1").arg(parseError.errorString());
+            response.write(errorResponse.asJson().toUtf8());
+            response.setStatus(400,"Invalid JSON request");
+            return;
+        }
+
+        QJsonObject jsonObject = doc.object();
+        Swagger::SWGSpectrumSettings normalResponse;
+        normalResponse.fromJsonObject(jsonObject); // fields that are not present are ignored by the adapter
+
+        int status = m_adapter->devicesetSpectrumPatch(deviceSetIndex, jsonObject.keys(), normalResponse, errorResponse);
+
+        if (status == 200) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
+        }
+
+        response.setStatus(status);
+    }
+    else
+    {
+        response.write("Invalid HTTP method");
+        response.setStatus(405,"Invalid HTTP method");
+    }
+}
+
+void WebAPIRequestMapper::devicesetDeviceReportService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    Swagger::SWGErrorResponse errorResponse;
+    int deviceSetIndex = std::stoi(indexStr);
+
+    if (request.getMethod() == "GET")
+    {
+        Swagger::SWGDeviceReport normalResponse;
+
+        int status = m_adapter->devicesetDeviceReportGet(deviceSetIndex, normalResponse, errorResponse);
+
+        if (status == 200) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
+        }
+
+        response.setStatus(status);
+    }
+    else
+    {
+        response.write("Invalid HTTP method");
+        response.setStatus(405,"Invalid HTTP method");
+    }
+}
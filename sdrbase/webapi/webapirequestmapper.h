@@ -19,6 +19,8 @@
 #ifndef SDRBASE_WEBAPI_WEBAPIREQUESTMAPPER_H_
 #define SDRBASE_WEBAPI_WEBAPIREQUESTMAPPER_H_
 
+#include <string>
+
 #include "httprequesthandler.h"
 #include "httprequest.h"
 #include "httpresponse.h"
@@ -33,6 +35,9 @@ public:
 
 private:
     WebAPIAdapterInterface *m_adapter;
+
+    void devicesetSpectrumService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
+    void devicesetDeviceReportService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response);
 };
 
 #endif /* SDRBASE_WEBAPI_WEBAPIREQUESTMAPPER_H_ */
@@ -18,6 +18,7 @@
 
 #include "gui/glspectrum.h"
 #include "dsp/spectrumvis.h"
+#include "dsp/devicespectrumengine.h"
 #include "gui/glspectrumgui.h"
 #include "gui/channelwindow.h"
 #include "gui/samplingdevicecontrol.h"
@@ -36,6 +37,7 @@ DeviceUISet::DeviceUISet(int tabIndex, bool rxElseTx, QTimer& timer)
 {
     m_spectrum = new GLSpectrum;
     m_spectrumVis = new SpectrumVis(m_spectrum);
+    m_spectrumEngine = 0;
     m_spectrum->connectTimer(timer);
     m_spectrumGUI = new GLSpectrumGUI;
     m_spectrumGUI->setBuddies(m_spectrumVis->getInputMessageQueue(), m_spectrumVis, m_spectrum);
@@ -60,6 +62,7 @@ DeviceUISet::~DeviceUISet()
     delete m_samplingDeviceControl;
     delete m_channelWindow;
     delete m_spectrumGUI;
+    delete m_spectrumEngine;
     delete m_spectrumVis;
     delete m_spectrum;
 }
@@ -21,6 +21,7 @@
 #include <QByteArray>
 
 class SpectrumVis;
+class DeviceSpectrumEngine;
 class GLSpectrum;
 class GLSpectrumGUI;
 class ChannelWindow;
@@ -35,6 +36,7 @@ class PluginAPI;
 struct DeviceUISet
 {
     SpectrumVis *m_spectrumVis;
+    DeviceSpectrumEngine *m_spectrumEngine;               //!< Rx only: headless spectrum for the web API (disabled by default)
     GLSpectrum *m_spectrum;
     GLSpectrumGUI *m_spectrumGUI;
     ChannelWindow *m_channelWindow;
@@ -18,14 +18,16 @@ SpectrumVis::SpectrumVis(GLSpectrum* glSpectrum) :
 	BasebandSampleSink(),
 	m_fft(FFTEngine::create()),
 	m_fftBuffer(MAX_FFT_SIZE),
+	m_powerSpectrum(MAX_FFT_SIZE),
 	m_logPowerSpectrum(MAX_FFT_SIZE),
 	m_fftBufferFill(0),
 	m_needMoreSamples(false),
+	m_avgLinear(false),
 	m_glSpectrum(glSpectrum),
 	m_mutex(QMutex::Recursive)
 {
 	setObjectName("SpectrumVis");
-	handleConfigure(1024, 0, FFTWindow::BlackmanHarris);
+	handleConfigure(1024, 0, FFTWindow::BlackmanHarris, SpectrumAverager::AvgModeNone, 1, false, 0);
 }
 
 SpectrumVis::~SpectrumVis()
@@ -33,9 +35,16 @@ SpectrumVis::~SpectrumVis()
 	delete m_fft;
 }
 
-void SpectrumVis::configure(MessageQueue* msgQueue, int fftSize, int overlapPercent, FFTWindow::Function window)
+void SpectrumVis::configure(MessageQueue* msgQueue,
+		int fftSize,
+		int overlapPercent,
+		FFTWindow::Function window,
+		AvgMode avgMode,
+		int avgNb,
+		bool avgLinear,
+		int maxFrameRate)
 {
-	MsgConfigureSpectrumVis* cmd = new MsgConfigureSpectrumVis(fftSize, overlapPercent, window);
+	MsgConfigureSpectrumVis* cmd = new MsgConfigureSpectrumVis(fftSize, overlapPercent, window, avgMode, avgNb, avgLinear, maxFrameRate);
 	msgQueue->push(cmd);
 }
 
@@ -74,7 +83,7 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
 	while (begin < end)
 	{
 		std::size_t todo = end - begin;
-		std::size_t samplesNeeded = m_refillSize - m_fftBufferFill;
+		std::size_t samplesNeeded = m_fftSize - m_fftBufferFill;
 
 		if (todo >= samplesNeeded)
 		{
@@ -88,52 +97,14 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
 				*it++ = Complex(begin->real() / 32768.0f, begin->imag() / 32768.0f);
 			}
 
-			// apply fft window (and copy from m_fftBuffer to m_fftIn)
-			m_window.apply(&m_fftBuffer[0], m_fft->in());
-
-			// calculate FFT
-			m_fft->transform();
-
-			// extract power spectrum and reorder buckets
-			Real ofs = 20.0f * log10f(1.0f / m_fftSize);
-			Real mult = (10.0f / log2f(10.0f));
-			const Complex* fftOut = m_fft->out();
-			Complex c;
-			Real v;
-			std::size_t halfSize = m_fftSize / 2;
-
-			if ( positiveOnly )
-			{
-				for (std::size_t i = 0; i < halfSize; i++)
-				{
-					c = fftOut[i];
-					v = c.real() * c.real() + c.imag() * c.imag();
-					v = mult * log2f(v) + ofs;
-					m_logPowerSpectrum[i * 2] = v;
-					m_logPowerSpectrum[i * 2 + 1] = v;
-				}
-			}
-			else
+			// without averaging a frame that would not be displayed is not worth computing
+			if (m_averager.spectrumNeeded())
 			{
-				for (std::size_t i = 0; i < halfSize; i++)
-				{
-					c = fftOut[i + halfSize];
-					v = c.real() * c.real() + c.imag() * c.imag();
-					v = mult * log2f(v) + ofs;
-					m_logPowerSpectrum[i] = v;
-
-					c = fftOut[i];
-					v = c.real() * c.real() + c.imag() * c.imag();
-					v = mult * log2f(v) + ofs;
-					m_logPowerSpectrum[i + halfSize] = v;
-				}
+				processFFT(positiveOnly);
 			}
 
-			// send new data to visualisation
-			m_glSpectrum->newSpectrum(m_logPowerSpectrum, m_fftSize);
-
 			// advance buffer respecting the fft overlap factor
-			std::copy(m_fftBuffer.begin() + m_refillSize, m_fftBuffer.end(), m_fftBuffer.begin());
+			std::copy(m_fftBuffer.begin() + m_refillSize, m_fftBuffer.begin() + m_fftSize, m_fftBuffer.begin());
 
 			// start over
 			m_fftBufferFill = m_overlapSize;
@@ -153,6 +124,72 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
 	}
 }
 
+void SpectrumVis::processFFT(bool positiveOnly)
+{
+	// apply fft window (and copy from m_fftBuffer to m_fftIn)
+	m_window.apply(&m_fftBuffer[0], m_fft->in());
+
+	// calculate FFT
+	m_fft->transform();
+
+	// extract power spectrum and reorder buckets
+	// power stays linear only when it is averaged linearly
+	// in dB the floor keeps empty bins finite so that they can be averaged
+	bool linear = m_avgLinear && (m_averager.getAvgMode() != SpectrumAverager::AvgModeNone);
+	Real ofs = 20.0f * log10f(1.0f / m_fftSize);
+	Real mult = (10.0f / log2f(10.0f));
+	const Complex* fftOut = m_fft->out();
+	Complex c;
+	Real v;
+	std::size_t halfSize = m_fftSize / 2;
+
+	if ( positiveOnly )
+	{
+		for (std::size_t i = 0; i < halfSize; i++)
+		{
+			c = fftOut[i];
+			v = c.real() * c.real() + c.imag() * c.imag();
+			v = linear ? v : mult * log2f(v + 1e-20f) + ofs;
+			m_powerSpectrum[i * 2] = v;
+			m_powerSpectrum[i * 2 + 1] = v;
+		}
+	}
+	else
+	{
+		for (std::size_t i = 0; i < halfSize; i++)
+		{
+			c = fftOut[i + halfSize];
+			v = c.real() * c.real() + c.imag() * c.imag();
+			v = linear ? v : mult * log2f(v + 1e-20f) + ofs;
+			m_powerSpectrum[i] = v;
+
+			c = fftOut[i];
+			v = c.real() * c.real() + c.imag() * c.imag();
+			v = linear ? v : mult * log2f(v + 1e-20f) + ofs;
+			m_powerSpectrum[i + halfSize] = v;
+		}
+	}
+
+	const std::vector<Real> *spectrum = m_averager.feed(m_powerSpectrum);
+
+	if (spectrum) {
+		sendFrame(*spectrum, linear);
+	}
+}
+
+void SpectrumVis::sendFrame(const std::vector<Real>& spectrum, bool linear)
+{
+	if (linear)
+	{
+		SpectrumAverager::powerToDB(spectrum, m_logPowerSpectrum, m_fftSize, m_fftSize);
+		m_glSpectrum->newSpectrum(m_logPowerSpectrum, m_fftSize);
+	}
+	else
+	{
+		m_glSpectrum->newSpectrum(spectrum, m_fftSize);
+	}
+}
+
 void SpectrumVis::start()
 {
 }
@@ -166,7 +203,13 @@ bool SpectrumVis::handleMessage(const Message& message)
 	if (MsgConfigureSpectrumVis::match(message))
 	{
 		MsgConfigureSpectrumVis& conf = (MsgConfigureSpectrumVis&) message;
-		handleConfigure(conf.getFFTSize(), conf.getOverlapPercent(), conf.getWindow());
+		handleConfigure(conf.getFFTSize(),
+				conf.getOverlapPercent(),
+				conf.getWindow(),
+				conf.getAvgMode(),
+				conf.getAvgNb(),
+				conf.getAvgLinear(),
+				conf.getMaxFrameRate());
 		return true;
 	}
 	else
@@ -175,7 +218,8 @@ bool SpectrumVis::handleMessage(const Message& message)
 	}
 }
 
-void SpectrumVis::handleConfigure(int fftSize, int overlapPercent, FFTWindow::Function window)
+void SpectrumVis::handleConfigure(int fftSize, int overlapPercent, FFTWindow::Function window,
+		AvgMode avgMode, int avgNb, bool avgLinear, int maxFrameRate)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
@@ -188,13 +232,14 @@ void SpectrumVis::handleConfigure(int fftSize, int overlapPercent, FFTWindow::Fu
 		fftSize = 64;
 	}
 
-	if (overlapPercent > 100)
+	// at least one new sample per FFT
+	if (overlapPercent > 99)
 	{
-		m_overlapPercent = 100;
+		overlapPercent = 99;
 	}
 	else if (overlapPercent < 0)
 	{
-		m_overlapPercent = 0;
+		overlapPercent = 0;
 	}
 
 	m_fftSize = fftSize;
@@ -204,4 +249,8 @@ void SpectrumVis::handleConfigure(int fftSize, int overlapPercent, FFTWindow::Fu
 	m_overlapSize = (m_fftSize * m_overlapPercent) / 100;
 	m_refillSize = m_fftSize - m_overlapSize;
 	m_fftBufferFill = m_overlapSize;
+
+	m_avgLinear = avgLinear;
+	m_averager.resize(m_fftSize);
+	m_averager.configure(avgMode, avgNb, maxFrameRate); // restarts averaging
 }
@@ -5,6 +5,7 @@
 #include <QMutex>
 #include "dsp/fftengine.h"
 #include "dsp/fftwindow.h"
+#include "dsp/spectrumaverager.h"
 #include "util/export.h"
 #include "util/message.h"
 
@@ -14,31 +15,53 @@ class MessageQueue;
 class SDRANGEL_API SpectrumVis : public BasebandSampleSink {
 
 public:
+	typedef SpectrumAverager::AvgMode AvgMode;
+
 	class SDRANGEL_API MsgConfigureSpectrumVis : public Message {
 		MESSAGE_CLASS_DECLARATION
 
 	public:
-		MsgConfigureSpectrumVis(int fftSize, int overlapPercent, FFTWindow::Function window) :
+		MsgConfigureSpectrumVis(int fftSize, int overlapPercent, FFTWindow::Function window,
+				AvgMode avgMode, int avgNb, bool avgLinear, int maxFrameRate) :
 			Message(),
 			m_fftSize(fftSize),
 			m_overlapPercent(overlapPercent),
-			m_window(window)
+			m_window(window),
+			m_avgMode(avgMode),
+			m_avgNb(avgNb),
+			m_avgLinear(avgLinear),
+			m_maxFrameRate(maxFrameRate)
 		{ }
 
 		int getFFTSize() const { return m_fftSize; }
 		int getOverlapPercent() const { return m_overlapPercent; }
 		FFTWindow::Function getWindow() const { return m_window; }
+		AvgMode getAvgMode() const { return m_avgMode; }
+		int getAvgNb() const { return m_avgNb; }
+		bool getAvgLinear() const { return m_avgLinear; }
+		int getMaxFrameRate() const { return m_maxFrameRate; }
 
 	private:
 		int m_fftSize;
 		int m_overlapPercent;
 		FFTWindow::Function m_window;
+		AvgMode m_avgMode;
+		int m_avgNb;
+		bool m_avgLinear;    //!< average power (true) or dB values (false)
+		int m_maxFrameRate;  //!< frames per second sent to the display, 0 for no limit
 	};
 
 	SpectrumVis(GLSpectrum* glSpectrum = NULL);
 	virtual ~SpectrumVis();
 
-	void configure(MessageQueue* msgQueue, int fftSize, int overlapPercent, FFTWindow::Function window);
+	void configure(MessageQueue* msgQueue,
+			int fftSize,
+			int overlapPercent,
+			FFTWindow::Function window,
+			AvgMode avgMode = SpectrumAverager::AvgModeNone,
+			int avgNb = 1,
+			bool avgLinear = false,
+			int maxFrameRate = 0);
 
 	virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly);
 	void feedTriggered(const SampleVector::const_iterator& triggerPoint, const SampleVector::const_iterator& end, bool positiveOnly);
@@ -51,7 +74,9 @@ private:
 	FFTWindow m_window;
 
 	std::vector<Complex> m_fftBuffer;
-	std::vector<Real> m_logPowerSpectrum;
+	std::vector<Real> m_powerSpectrum;    //!< spectrum of the last FFT, linear or dB depending on averaging domain
+	std::vector<Real> m_logPowerSpectrum; //!< what is sent to the display
+	SpectrumAverager m_averager;
 
 	std::size_t m_fftSize;
 	std::size_t m_overlapPercent;
@@ -60,11 +85,16 @@ private:
 	std::size_t m_fftBufferFill;
 	bool m_needMoreSamples;
 
+	bool m_avgLinear;
+
 	GLSpectrum* m_glSpectrum;
 
 	QMutex m_mutex;
 
-	void handleConfigure(int fftSize, int overlapPercent, FFTWindow::Function window);
+	void handleConfigure(int fftSize, int overlapPercent, FFTWindow::Function window,
+			AvgMode avgMode, int avgNb, bool avgLinear, int maxFrameRate);
+	void processFFT(bool positiveOnly);
+	void sendFrame(const std::vector<Real>& spectrum, bool linear);
 };
 
 #endif // INCLUDE_SPECTRUMVIS_H
@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QAudioDeviceInfo>
+
+#include "audio/audiodevicemanager.h"
+
+#include "audioselectdialog.h"
+#include "ui_audioselectdialog.h"
+
+AudioSelectDialog::AudioSelectDialog(const QString& deviceName, QWidget *parent) :
+    QDialog(parent),
+    ui(new Ui::AudioSelectDialog),
+    m_deviceName(deviceName),
+    m_hasChanged(false)
+{
+    ui->setupUi(this);
+    ui->audioDevice->addItem(AudioDeviceManager::m_defaultDeviceName);
+
+    QList<QAudioDeviceInfo> devicesInfo = QAudioDeviceInfo::availableDevices(QAudio::AudioOutput);
+
+    for (int i = 0; i < devicesInfo.size(); i++) {
+        ui->audioDevice->addItem(devicesInfo[i].deviceName());
+    }
+
+    int index = ui->audioDevice->findText(m_deviceName);
+
+    if (index < 0) // device not present anymore: keep it selectable
+    {
+        ui->audioDevice->addItem(m_deviceName);
+        index = ui->audioDevice->count() - 1;
+    }
+
+    ui->audioDevice->setCurrentIndex(index);
+}
+
+AudioSelectDialog::~AudioSelectDialog()
+{
+    delete ui;
+}
+
+void AudioSelectDialog::accept()
+{
+    QString deviceName = ui->audioDevice->currentText();
+    m_hasChanged = (deviceName != m_deviceName);
+    m_deviceName = deviceName;
+    QDialog::accept();
+}
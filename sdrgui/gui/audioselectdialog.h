@@ -0,0 +1,49 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRGUI_GUI_AUDIOSELECTDIALOG_H_
+#define SDRGUI_GUI_AUDIOSELECTDIALOG_H_
+
+#include <QDialog>
+
+#include "util/export.h"
+
+namespace Ui {
+    class AudioSelectDialog;
+}
+
+/** Selects the audio output device of a channel. The device is identified by its name. */
+class SDRANGEL_API AudioSelectDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit AudioSelectDialog(const QString& deviceName, QWidget *parent = 0);
+    ~AudioSelectDialog();
+    const QString& getDeviceName() const { return m_deviceName; }
+    bool hasChanged() const { return m_hasChanged; }
+
+private slots:
+    void accept();
+
+private:
+    Ui::AudioSelectDialog *ui;
+    QString m_deviceName;
+    bool m_hasChanged;
+};
+
+#endif /* SDRGUI_GUI_AUDIOSELECTDIALOG_H_ */
@@ -15,11 +15,14 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #ifdef USE_SSE2
 #include <emmintrin.h>
 #endif
 
 #include <QMouseEvent>
+#include <QWheelEvent>
 #include <QOpenGLShaderProgram>
 #include <QOpenGLFunctions>
 #include <QPainter>
@@ -51,6 +54,9 @@ GLSpectrum::GLSpectrum(QWidget* parent) :
     m_waterfallTextureHeight(-1),
     m_waterfallTexturePos(0),
     m_displayWaterfall(true),
+    m_waterfallHistorySpill(false),
+    m_waterfallHistoryAge(0),
+    m_waterfallHistoryRedraw(false),
     m_ssbSpectrum(false),
     m_lsbDisplay(false),
     m_histogramBuffer(NULL),
@@ -276,6 +282,20 @@ void GLSpectrum::setDisplayTraceIntensity(int intensity)
 	update();
 }
 
+void GLSpectrum::setWaterfallHistorySpill(bool spill)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	if (spill != m_waterfallHistorySpill)
+	{
+		m_waterfallHistorySpill = spill;
+		m_waterfallHistory.configure(m_waterfallHistory.getLineSize(), m_waterfallHistorySpill);
+		m_waterfallHistoryRedraw = m_waterfallHistoryAge > 0;
+		m_waterfallHistoryAge = 0;
+		update();
+	}
+}
+
 void GLSpectrum::addChannelMarker(ChannelMarker* channelMarker)
 {
 	QMutexLocker mutexLocker(&m_mutex);
@@ -327,21 +347,53 @@ void GLSpectrum::newSpectrum(const std::vector<Real>& spectrum, int fftSize)
 
 void GLSpectrum::updateWaterfall(const std::vector<Real>& spectrum)
 {
+	m_waterfallHistory.addLine(spectrum);
+
+	if(m_waterfallHistoryAge > 0) {
+		m_waterfallHistoryAge++; // view scrolled back in history: keep it still
+		return;
+	}
+
 	if(m_waterfallBufferPos < m_waterfallBuffer->height()) {
 		quint32* pix = (quint32*)m_waterfallBuffer->scanLine(m_waterfallBufferPos);
+		paintWaterfallLine(pix, spectrum);
+		m_waterfallBufferPos++;
+	}
+}
 
-		for(int i = 0; i < m_fftSize; i++) {
-			int v = (int)((spectrum[i] - m_referenceLevel) * 2.4 * 100.0 / m_powerRange + 240.0);
-			if(v > 239)
-				v = 239;
-			else if(v < 0)
-				v = 0;
+void GLSpectrum::paintWaterfallLine(quint32* pix, const std::vector<Real>& spectrum)
+{
+	for(int i = 0; i < m_fftSize; i++) {
+		int v = (int)((spectrum[i] - m_referenceLevel) * 2.4 * 100.0 / m_powerRange + 240.0);
+		if(v > 239)
+			v = 239;
+		else if(v < 0)
+			v = 0;
+
+		*pix++ = m_waterfallPalette[(int)v];
+	}
+}
 
-			*pix++ = m_waterfallPalette[(int)v];
-		}
+void GLSpectrum::redrawWaterfallHistory()
+{
+	// the texture is rewritten from its first line which is the oldest one displayed
+	int height = m_waterfallBuffer->height();
+	m_waterfallHistoryLine.resize(m_fftSize);
 
-		m_waterfallBufferPos++;
+	for(int y = 0; y < height; y++) {
+		quint32* pix = (quint32*)m_waterfallBuffer->scanLine(y);
+
+		if(m_waterfallHistory.getLine(m_waterfallHistoryAge + height - 1 - y, m_waterfallHistoryLine)) {
+			paintWaterfallLine(pix, m_waterfallHistoryLine);
+		} else {
+			std::fill(pix, pix + m_fftSize, qRgb(0x00, 0x00, 0x00));
+		}
 	}
+
+	m_glShaderWaterfall.subTexture(0, 0, m_fftSize, height, m_waterfallBuffer->scanLine(0));
+	m_waterfallTexturePos = 0;
+	m_waterfallBufferPos = 0;
+	m_waterfallHistoryRedraw = false;
 }
 
 void GLSpectrum::updateHistogram(const std::vector<Real>& spectrum)
@@ -553,6 +605,10 @@ void GLSpectrum::paintGL()
 		    };
 
 
+			if (m_waterfallHistoryRedraw) {
+				redrawWaterfallHistory();
+			}
+
 			if (m_waterfallTexturePos + m_waterfallBufferPos < m_waterfallTextureHeight)
 			{
 				m_glShaderWaterfall.subTexture(0, m_waterfallTexturePos, m_fftSize, m_waterfallBufferPos,  m_waterfallBuffer->scanLine(0));
@@ -1507,6 +1563,8 @@ void GLSpectrum::applyChanges()
 		m_glShaderFrequencyScale.initTexture(m_frequencyPixmap.toImage());
 	}
 
+	m_waterfallRect = QRect(leftMargin, waterfallTop, width() - leftMargin - rightMargin, waterfallHeight);
+
 	bool fftSizeChanged = true;
 
 	if(m_waterfallBuffer != NULL) {
@@ -1572,11 +1630,22 @@ void GLSpectrum::applyChanges()
 		memset(m_histogramHoldoff, 0x07, 100 * m_fftSize);
 	}
 
+	if(fftSizeChanged)
+	{
+		m_waterfallHistory.configure(m_fftSize, m_waterfallHistorySpill);
+		m_waterfallHistoryAge = 0;
+	}
+
 	if(fftSizeChanged || windowSizeChanged)
 	{
 		m_waterfallTextureHeight = waterfallHeight;
 		m_waterfallTexturePos = 0;
 	}
+
+	// a view scrolled back is redrawn from history with the new layout and levels
+	if(m_waterfallHistoryAge > 0) {
+		m_waterfallHistoryRedraw = true;
+	}
 }
 
 void GLSpectrum::mouseMoveEvent(QMouseEvent* event)
@@ -1714,6 +1783,35 @@ void GLSpectrum::mouseReleaseEvent(QMouseEvent*)
 	}
 }
 
+void GLSpectrum::wheelEvent(QWheelEvent* event)
+{
+	if(!m_displayWaterfall || !m_waterfallRect.contains(event->pos())) {
+		event->ignore();
+		return;
+	}
+
+	QMutexLocker mutexLocker(&m_mutex);
+
+	if(m_waterfallBuffer == NULL) {
+		return;
+	}
+
+	// scroll by half a screen at the resolution of the history being looked at
+	int height = m_waterfallBuffer->height();
+	qint64 step = (height / 2) * m_waterfallHistory.getResolution(m_waterfallHistoryAge + height - 1);
+	qint64 maxAge = m_waterfallHistory.getDepth() - height;
+
+	if(event->delta() > 0) {
+		m_waterfallHistoryAge = std::min(m_waterfallHistoryAge + step, std::max(maxAge, (qint64) 0));
+	} else {
+		m_waterfallHistoryAge = std::max(m_waterfallHistoryAge - step, (qint64) 0);
+	}
+
+	// also redraw when back to live so that the recent history fills the view
+	m_waterfallHistoryRedraw = true;
+	update();
+}
+
 void GLSpectrum::enterEvent(QEvent* event)
 {
 	m_mouseInside = true;
@@ -31,6 +31,7 @@
 #include "gui/scaleengine.h"
 #include "gui/glshadersimple.h"
 #include "gui/glshadertextured.h"
+#include "gui/waterfallhistory.h"
 #include "dsp/channelmarker.h"
 #include "util/export.h"
 
@@ -60,6 +61,7 @@ public:
 	void setDisplayGrid(bool display);
 	void setDisplayGridIntensity(int intensity);
 	void setDisplayTraceIntensity(int intensity);
+	void setWaterfallHistorySpill(bool spill);
 
 	void addChannelMarker(ChannelMarker* channelMarker);
 	void removeChannelMarker(ChannelMarker* channelMarker);
@@ -140,6 +142,12 @@ private:
 	int m_waterfallTexturePos;
 	QMatrix4x4 m_glWaterfallBoxMatrix;
 	bool m_displayWaterfall;
+	QRect m_waterfallRect;
+	WaterfallHistory m_waterfallHistory;
+	bool m_waterfallHistorySpill;
+	qint64 m_waterfallHistoryAge; //!< age of the newest line displayed, 0 when live
+	bool m_waterfallHistoryRedraw;
+	std::vector<Real> m_waterfallHistoryLine;
 	bool m_ssbSpectrum;
 	bool m_lsbDisplay;
 
@@ -168,6 +176,8 @@ private:
 	static const int m_waterfallBufferHeight = 256;
 
 	void updateWaterfall(const std::vector<Real>& spectrum);
+	void paintWaterfallLine(quint32* pix, const std::vector<Real>& spectrum);
+	void redrawWaterfallHistory();
 	void updateHistogram(const std::vector<Real>& spectrum);
 
 	void initializeGL();
@@ -180,6 +190,7 @@ private:
 	void mouseMoveEvent(QMouseEvent* event);
 	void mousePressEvent(QMouseEvent* event);
 	void mouseReleaseEvent(QMouseEvent* event);
+	void wheelEvent(QWheelEvent* event);
 
 	void enterEvent(QEvent* event);
 	void leaveEvent(QEvent* event);
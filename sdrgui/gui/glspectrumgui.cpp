@@ -5,6 +5,11 @@
 #include "util/simpleserializer.h"
 #include "ui_glspectrumgui.h"
 
+static const int averagingNbs[] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000};
+static const int nbAveragingNbs = sizeof(averagingNbs) / sizeof(averagingNbs[0]);
+static const int maxFrameRates[] = {0, 5, 10, 15, 20, 25, 30, 50, 60}; // 0 is no limit
+static const int nbMaxFrameRates = sizeof(maxFrameRates) / sizeof(maxFrameRates[0]);
+
 GLSpectrumGUI::GLSpectrumGUI(QWidget* parent) :
 	QWidget(parent),
 	ui(new Ui::GLSpectrumGUI),
@@ -14,6 +19,10 @@ GLSpectrumGUI::GLSpectrumGUI(QWidget* parent) :
 	m_fftSize(1024),
 	m_fftOverlap(0),
 	m_fftWindow(FFTWindow::Hamming),
+	m_averagingMode(SpectrumAverager::AvgModeNone),
+	m_averagingNb(1),
+	m_linear(false),
+	m_maxFrameRate(0),
 	m_refLevel(0),
 	m_powerRange(100),
 	m_decay(0),
@@ -23,6 +32,7 @@ GLSpectrumGUI::GLSpectrumGUI(QWidget* parent) :
 	m_displayTraceIntensity(50),
 	m_displayWaterfall(true),
 	m_invertedWaterfall(false),
+	m_waterfallSpill(false),
 	m_displayMaxHold(false),
 	m_displayCurrent(false),
 	m_displayHistogram(false),
@@ -34,6 +44,10 @@ GLSpectrumGUI::GLSpectrumGUI(QWidget* parent) :
 		ui->refLevel->addItem(QString("%1").arg(ref));
 	for(int range = 100; range >= 5; range -= 5)
 		ui->levelRange->addItem(QString("%1").arg(range));
+	for(int i = 0; i < nbAveragingNbs; i++)
+		ui->averaging->addItem(QString("%1").arg(averagingNbs[i]));
+	for(int i = 0; i < nbMaxFrameRates; i++)
+		ui->maxFrameRate->addItem(maxFrameRates[i] == 0 ? QString("-") : QString("%1").arg(maxFrameRates[i]));
 }
 
 GLSpectrumGUI::~GLSpectrumGUI()
@@ -54,6 +68,10 @@ void GLSpectrumGUI::resetToDefaults()
 	m_fftSize = 1024;
 	m_fftOverlap = 0;
 	m_fftWindow = FFTWindow::Hamming;
+	m_averagingMode = SpectrumAverager::AvgModeNone;
+	m_averagingNb = 1;
+	m_linear = false;
+	m_maxFrameRate = 0;
 	m_refLevel = 0;
 	m_powerRange = 100;
 	m_decay = 0;
@@ -62,6 +80,7 @@ void GLSpectrumGUI::resetToDefaults()
 	m_displayGridIntensity = 5,
 	m_displayWaterfall = true;
 	m_invertedWaterfall = false;
+	m_waterfallSpill = false;
 	m_displayMaxHold = false;
 	m_displayHistogram = false;
 	m_displayGrid = false;
@@ -90,6 +109,11 @@ QByteArray GLSpectrumGUI::serialize() const
 	s.writeBool(16, m_displayCurrent);
 	s.writeS32(17, m_displayTraceIntensity);
 	s.writeReal(18, m_glSpectrum->getWaterfallShare());
+	s.writeS32(19, m_averagingMode);
+	s.writeS32(20, m_averagingNb);
+	s.writeBool(21, m_linear);
+	s.writeS32(22, m_maxFrameRate);
+	s.writeBool(23, m_waterfallSpill);
 	return s.final();
 }
 
@@ -123,6 +147,11 @@ bool GLSpectrumGUI::deserialize(const QByteArray& data)
 		Real waterfallShare;
 		d.readReal(18, &waterfallShare, 0.66);
 		m_glSpectrum->setWaterfallShare(waterfallShare);
+		d.readS32(19, &m_averagingMode, SpectrumAverager::AvgModeNone);
+		d.readS32(20, &m_averagingNb, 1);
+		d.readBool(21, &m_linear, false);
+		d.readS32(22, &m_maxFrameRate, 0);
+		d.readBool(23, &m_waterfallSpill, false);
 		applySettings();
 		return true;
 	} else {
@@ -140,12 +169,17 @@ void GLSpectrumGUI::applySettings()
 			break;
 		}
 	}
+	ui->averagingMode->setCurrentIndex(m_averagingMode);
+	ui->averaging->setCurrentIndex(getAveragingIndex(m_averagingNb));
+	ui->linscale->setChecked(m_linear);
+	ui->maxFrameRate->setCurrentIndex(getMaxFrameRateIndex(m_maxFrameRate));
 	ui->refLevel->setCurrentIndex(-m_refLevel / 5);
 	ui->levelRange->setCurrentIndex((100 - m_powerRange) / 5);
 	ui->decay->setSliderPosition(m_decay);
 	ui->holdoff->setSliderPosition(m_histogramLateHoldoff);
 	ui->stroke->setSliderPosition(m_histogramStroke);
 	ui->waterfall->setChecked(m_displayWaterfall);
+	ui->waterfallSpill->setChecked(m_waterfallSpill);
 	ui->maxHold->setChecked(m_displayMaxHold);
 	ui->current->setChecked(m_displayCurrent);
 	ui->histogram->setChecked(m_displayHistogram);
@@ -161,6 +195,7 @@ void GLSpectrumGUI::applySettings()
 
 	m_glSpectrum->setDisplayWaterfall(m_displayWaterfall);
 	m_glSpectrum->setInvertedWaterfall(m_invertedWaterfall);
+	m_glSpectrum->setWaterfallHistorySpill(m_waterfallSpill);
 	m_glSpectrum->setDisplayMaxHold(m_displayMaxHold);
 	m_glSpectrum->setDisplayCurrent(m_displayCurrent);
 	m_glSpectrum->setDisplayHistogram(m_displayHistogram);
@@ -171,7 +206,43 @@ void GLSpectrumGUI::applySettings()
 	m_glSpectrum->setDisplayGrid(m_displayGrid);
 	m_glSpectrum->setDisplayGridIntensity(m_displayGridIntensity);
 
-	m_spectrumVis->configure(m_messageQueue, m_fftSize, m_fftOverlap, (FFTWindow::Function)m_fftWindow);
+	applySpectrumVisSettings();
+}
+
+void GLSpectrumGUI::applySpectrumVisSettings()
+{
+	m_spectrumVis->configure(m_messageQueue,
+			m_fftSize,
+			m_fftOverlap,
+			(FFTWindow::Function) m_fftWindow,
+			(SpectrumVis::AvgMode) m_averagingMode,
+			m_averagingNb,
+			m_linear,
+			m_maxFrameRate);
+}
+
+int GLSpectrumGUI::getAveragingIndex(int averagingNb)
+{
+	for (int i = 0; i < nbAveragingNbs; i++)
+	{
+		if (averagingNb <= averagingNbs[i]) {
+			return i;
+		}
+	}
+
+	return nbAveragingNbs - 1;
+}
+
+int GLSpectrumGUI::getMaxFrameRateIndex(int maxFrameRate)
+{
+	for (int i = 0; i < nbMaxFrameRates; i++)
+	{
+		if (maxFrameRate <= maxFrameRates[i]) {
+			return i;
+		}
+	}
+
+	return nbMaxFrameRates - 1;
 }
 
 void GLSpectrumGUI::on_fftWindow_currentIndexChanged(int index)
@@ -179,14 +250,42 @@ void GLSpectrumGUI::on_fftWindow_currentIndexChanged(int index)
 	m_fftWindow = index;
 	if(m_spectrumVis == NULL)
 		return;
-	m_spectrumVis->configure(m_messageQueue, m_fftSize, m_fftOverlap, (FFTWindow::Function)m_fftWindow);
+	applySpectrumVisSettings();
 }
 
 void GLSpectrumGUI::on_fftSize_currentIndexChanged(int index)
 {
 	m_fftSize = 1 << (7 + index);
 	if(m_spectrumVis != NULL)
-		m_spectrumVis->configure(m_messageQueue, m_fftSize, m_fftOverlap, (FFTWindow::Function)m_fftWindow);
+		applySpectrumVisSettings();
+}
+
+void GLSpectrumGUI::on_averagingMode_currentIndexChanged(int index)
+{
+	m_averagingMode = index < 0 ? SpectrumAverager::AvgModeNone : index;
+	if(m_spectrumVis != NULL)
+		applySpectrumVisSettings();
+}
+
+void GLSpectrumGUI::on_averaging_currentIndexChanged(int index)
+{
+	m_averagingNb = index < 0 ? 1 : averagingNbs[index];
+	if(m_spectrumVis != NULL)
+		applySpectrumVisSettings();
+}
+
+void GLSpectrumGUI::on_linscale_toggled(bool checked)
+{
+	m_linear = checked;
+	if(m_spectrumVis != NULL)
+		applySpectrumVisSettings();
+}
+
+void GLSpectrumGUI::on_maxFrameRate_currentIndexChanged(int index)
+{
+	m_maxFrameRate = index < 0 ? 0 : maxFrameRates[index];
+	if(m_spectrumVis != NULL)
+		applySpectrumVisSettings();
 }
 
 void GLSpectrumGUI::on_refLevel_currentIndexChanged(int index)
@@ -242,6 +341,13 @@ void GLSpectrumGUI::on_waterfall_toggled(bool checked)
 		m_glSpectrum->setDisplayWaterfall(m_displayWaterfall);
 }
 
+void GLSpectrumGUI::on_waterfallSpill_toggled(bool checked)
+{
+	m_waterfallSpill = checked;
+	if(m_glSpectrum != NULL)
+		m_glSpectrum->setWaterfallHistorySpill(m_waterfallSpill);
+}
+
 void GLSpectrumGUI::on_histogram_toggled(bool checked)
 {
 	m_displayHistogram = checked;
@@ -37,6 +37,10 @@ private:
 	qint32 m_fftSize;
 	qint32 m_fftOverlap;
 	qint32 m_fftWindow;
+	qint32 m_averagingMode;
+	qint32 m_averagingNb;
+	bool m_linear;
+	qint32 m_maxFrameRate;
 	Real m_refLevel;
 	Real m_powerRange;
 	int m_decay;
@@ -46,6 +50,7 @@ private:
 	int m_displayTraceIntensity;
 	bool m_displayWaterfall;
 	bool m_invertedWaterfall;
+	bool m_waterfallSpill;
 	bool m_displayMaxHold;
 	bool m_displayCurrent;
 	bool m_displayHistogram;
@@ -53,10 +58,17 @@ private:
 	bool m_invert;
 
 	void applySettings();
+	void applySpectrumVisSettings();
+	static int getAveragingIndex(int averagingNb);
+	static int getMaxFrameRateIndex(int maxFrameRate);
 
 private slots:
 	void on_fftWindow_currentIndexChanged(int index);
 	void on_fftSize_currentIndexChanged(int index);
+	void on_averagingMode_currentIndexChanged(int index);
+	void on_averaging_currentIndexChanged(int index);
+	void on_linscale_toggled(bool checked);
+	void on_maxFrameRate_currentIndexChanged(int index);
 	void on_refLevel_currentIndexChanged(int index);
 	void on_levelRange_currentIndexChanged(int index);
 	void on_decay_valueChanged(int index);
@@ -66,6 +78,7 @@ private slots:
 	void on_traceIntensity_valueChanged(int index);
 
 	void on_waterfall_toggled(bool checked);
+	void on_waterfallSpill_toggled(bool checked);
 	void on_histogram_toggled(bool checked);
 	void on_maxHold_toggled(bool checked);
 	void on_current_toggled(bool checked);
@@ -0,0 +1,279 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <cstring>
+#include <QTemporaryFile>
+#include <QDir>
+#include <QDebug>
+
+#include "waterfallhistory.h"
+
+WaterfallHistory::WaterfallHistory() :
+	m_lineSize(0),
+	m_spillToDisk(false),
+	m_levelCapacity(0),
+	m_tick(0),
+	m_spillFile(0),
+	m_spillMap(0)
+{
+	for (int i = 0; i < m_nbLevels; i++)
+	{
+		m_levels[i].m_lines = 0;
+		m_levels[i].m_head = 0;
+		m_levels[i].m_count = 0;
+		m_levels[i].m_lastTick = 0;
+		m_levels[i].m_accCount = 0;
+	}
+}
+
+WaterfallHistory::~WaterfallHistory()
+{
+	release();
+}
+
+void WaterfallHistory::release()
+{
+	if (m_spillFile)
+	{
+		if (m_spillMap) {
+			m_spillFile->unmap(m_spillMap);
+		}
+
+		delete m_spillFile; // removes the file
+		m_spillFile = 0;
+		m_spillMap = 0;
+	}
+
+	std::vector<quint8>().swap(m_heap);
+
+	for (int i = 0; i < m_nbLevels; i++) {
+		m_levels[i].m_lines = 0;
+	}
+}
+
+void WaterfallHistory::configure(int lineSize, bool spillToDisk)
+{
+	if ((lineSize == m_lineSize) && (spillToDisk == m_spillToDisk))
+	{
+		clear();
+		return;
+	}
+
+	release();
+	m_lineSize = lineSize;
+	m_spillToDisk = spillToDisk;
+	m_levelCapacity = spillToDisk ? m_diskLevelCapacity : m_memLevelCapacity;
+	qint64 levelBytes = (qint64) m_levelCapacity * m_lineSize;
+	qint64 totalBytes = levelBytes * m_nbLevels;
+	quint8 *storage = 0;
+
+	if (m_lineSize <= 0)
+	{
+		m_levelCapacity = 0;
+	}
+	else if (spillToDisk)
+	{
+		m_spillFile = new QTemporaryFile(QDir::tempPath() + "/sdrangel_waterfall_XXXXXX");
+
+		if (m_spillFile->open() && m_spillFile->resize(totalBytes)) {
+			m_spillMap = m_spillFile->map(0, totalBytes);
+		}
+
+		if (m_spillMap)
+		{
+			storage = m_spillMap;
+			qDebug("WaterfallHistory::configure: %lld bytes mapped in %s", totalBytes, qPrintable(m_spillFile->fileName()));
+		}
+		else
+		{
+			qWarning("WaterfallHistory::configure: cannot map %s. Keep history in memory", qPrintable(m_spillFile->fileName()));
+			delete m_spillFile;
+			m_spillFile = 0;
+			m_spillToDisk = false;
+			m_levelCapacity = m_memLevelCapacity;
+			levelBytes = (qint64) m_levelCapacity * m_lineSize;
+			totalBytes = levelBytes * m_nbLevels;
+		}
+	}
+
+	if ((m_lineSize > 0) && !storage)
+	{
+		m_heap.resize(totalBytes);
+		storage = m_heap.data();
+	}
+
+	for (int i = 0; i < m_nbLevels; i++)
+	{
+		m_levels[i].m_lines = storage ? storage + i * levelBytes : 0;
+		m_levels[i].m_acc.resize(m_lineSize);
+	}
+
+	m_line.resize(m_lineSize);
+	clear();
+}
+
+void WaterfallHistory::clear()
+{
+	m_tick = 0;
+
+	for (int i = 0; i < m_nbLevels; i++)
+	{
+		m_levels[i].m_head = 0;
+		m_levels[i].m_count = 0;
+		m_levels[i].m_lastTick = 0;
+		m_levels[i].m_accCount = 0;
+	}
+}
+
+void WaterfallHistory::addLine(const std::vector<Real>& spectrum)
+{
+	if (m_levelCapacity == 0) {
+		return;
+	}
+
+	for (int i = 0; i < m_lineSize; i++) {
+		m_line[i] = toLevel(spectrum[i]);
+	}
+
+	m_tick++;
+	pushLine(0, m_line.data());
+}
+
+void WaterfallHistory::pushLine(int levelIndex, const quint8 *line)
+{
+	Level& level = m_levels[levelIndex];
+	std::memcpy(level.m_lines + (qint64) level.m_head * m_lineSize, line, m_lineSize);
+	level.m_head = (level.m_head + 1) % m_levelCapacity;
+	level.m_count = std::min(level.m_count + 1, m_levelCapacity);
+	level.m_lastTick = m_tick;
+
+	if (levelIndex == m_nbLevels - 1) {
+		return;
+	}
+
+	// peak hold keeps short bursts visible in the coarser levels
+	if (level.m_accCount == 0)
+	{
+		std::copy(line, line + m_lineSize, level.m_acc.begin());
+	}
+	else
+	{
+		for (int i = 0; i < m_lineSize; i++) {
+			level.m_acc[i] = std::max(level.m_acc[i], line[i]);
+		}
+	}
+
+	if (++level.m_accCount == m_decimation)
+	{
+		level.m_accCount = 0;
+		pushLine(levelIndex + 1, level.m_acc.data());
+	}
+}
+
+int WaterfallHistory::findLevel(qint64 age, int& lineIndex) const
+{
+	qint64 span = 1;
+
+	for (int i = 0; i < m_nbLevels; span *= m_decimation, i++)
+	{
+		const Level& level = m_levels[i];
+
+		if (level.m_count == 0) {
+			break; // coarser levels are empty as well
+		}
+
+		// newest line of this level covers ages [base, base + span)
+		qint64 base = m_tick - level.m_lastTick;
+
+		if (age < base) {
+			continue; // not merged yet at this level
+		}
+
+		qint64 index = (age - base) / span;
+
+		if (index < level.m_count)
+		{
+			lineIndex = (level.m_head - 1 - index + m_levelCapacity) % m_levelCapacity;
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+bool WaterfallHistory::getLine(qint64 age, std::vector<Real>& spectrum) const
+{
+	int lineIndex;
+	int levelIndex = findLevel(age, lineIndex);
+
+	if (levelIndex < 0) {
+		return false;
+	}
+
+	const quint8 *line = m_levels[levelIndex].m_lines + (qint64) lineIndex * m_lineSize;
+
+	for (int i = 0; i < m_lineSize; i++) {
+		spectrum[i] = fromLevel(line[i]);
+	}
+
+	return true;
+}
+
+qint64 WaterfallHistory::getDepth() const
+{
+	qint64 depth = 0;
+	qint64 span = 1;
+
+	for (int i = 0; i < m_nbLevels; span *= m_decimation, i++)
+	{
+		const Level& level = m_levels[i];
+
+		if (level.m_count == 0) {
+			break;
+		}
+
+		depth = std::max(depth, (m_tick - level.m_lastTick) + level.m_count * span);
+	}
+
+	return depth;
+}
+
+int WaterfallHistory::getResolution(qint64 age) const
+{
+	int lineIndex;
+	int levelIndex = findLevel(age, lineIndex);
+	int resolution = 1;
+
+	for (int i = 0; i < levelIndex; i++) {
+		resolution *= m_decimation;
+	}
+
+	return resolution;
+}
+
+// 0.75 dB steps from -180 dB
+quint8 WaterfallHistory::toLevel(Real db)
+{
+	int level = (int) ((db + 180.0f) / 0.75f + 0.5f);
+	return level < 0 ? 0 : level > 255 ? 255 : level;
+}
+
+Real WaterfallHistory::fromLevel(quint8 level)
+{
+	return level * 0.75f - 180.0f;
+}
@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRGUI_GUI_WATERFALLHISTORY_H_
+#define SDRGUI_GUI_WATERFALLHISTORY_H_
+
+#include <vector>
+#include <QtGlobal>
+#include <QString>
+#include "dsp/dsptypes.h"
+#include "util/export.h"
+
+class QTemporaryFile;
+
+/**
+ * Multi-resolution history of waterfall lines.
+ *
+ * Level 0 keeps the most recent lines at full rate. Every `decimation` lines of a level
+ * are merged (peak hold) into one line of the next level so each level covers `decimation`
+ * times the span of the previous one with the same number of lines. Memory is therefore
+ * bounded by nbLevels * levelCapacity * lineSize bytes whatever the FFT rate.
+ *
+ * Lines are stored as 8 bit power levels so they can be re-rendered with any reference
+ * level and range. Storage is on the heap or in a memory mapped temporary file when
+ * spill to disk is requested so that a much deeper history does not stay resident.
+ *
+ * Ages are counted in full rate lines back from the most recent one (age 0).
+ */
+class SDRANGEL_API WaterfallHistory
+{
+public:
+	WaterfallHistory();
+	~WaterfallHistory();
+
+	void configure(int lineSize, bool spillToDisk);
+	void clear();
+	void addLine(const std::vector<Real>& spectrum); //!< spectrum in dB of lineSize bins
+	bool getLine(qint64 age, std::vector<Real>& spectrum) const; //!< false if age is out of history
+	qint64 getDepth() const; //!< number of full rate lines reachable
+	int getResolution(qint64 age) const; //!< full rate lines merged in the line returned for this age
+	int getLineSize() const { return m_lineSize; }
+	bool getSpillToDisk() const { return m_spillToDisk; }
+
+	static const int m_nbLevels = 4;
+	static const int m_decimation = 4;
+	static const int m_memLevelCapacity = 1024;   //!< lines per level in memory
+	static const int m_diskLevelCapacity = 16384; //!< lines per level when spilling to disk
+
+private:
+	struct Level
+	{
+		quint8 *m_lines;      //!< ring of m_capacity lines
+		int m_head;           //!< next line written
+		int m_count;          //!< valid lines
+		qint64 m_lastTick;    //!< full rate line count when the newest line was written
+		std::vector<quint8> m_acc; //!< peak of lines pending merge into the next level
+		int m_accCount;
+	};
+
+	int m_lineSize;
+	bool m_spillToDisk;
+	int m_levelCapacity;
+	qint64 m_tick;            //!< full rate lines received
+	Level m_levels[m_nbLevels];
+	std::vector<quint8> m_heap;
+	QTemporaryFile *m_spillFile;
+	uchar *m_spillMap;
+	std::vector<quint8> m_line;
+
+	void release();
+	void pushLine(int levelIndex, const quint8 *line);
+	int findLevel(qint64 age, int& lineIndex) const;
+
+	static quint8 toLevel(Real db);
+	static Real fromLevel(quint8 level);
+};
+
+#endif /* SDRGUI_GUI_WATERFALLHISTORY_H_ */
@@ -45,6 +45,8 @@
 #include "gui/mypositiondialog.h"
 #include "dsp/dspengine.h"
 #include "dsp/spectrumvis.h"
+#include "dsp/devicespectrumengine.h"
+#include "dsp/fftengine.h"
 #include "dsp/dspcommands.h"
 #include "dsp/devicesamplesource.h"
 #include "dsp/devicesamplesink.h"
@@ -80,6 +82,10 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
 	qDebug() << "MainWindow::MainWindow: start";
 
     m_instance = this;
+    m_dspEngine->configureChannelWorkers(parser.getChannelThreads(), parser.getPinChannelThreads());
+    m_dspEngine->setCorrectionInAcquisition(parser.getCorrectionInAcquisition());
+    FFTEngine::setPlanningEffort(parser.getFFTPlanningEffort());
+    FFTEngine::loadWisdom();
 	m_settings.setAudioDeviceInfo(&m_audioDeviceInfo);
 
 	ui->setupUi(this);
@@ -221,6 +227,8 @@ MainWindow::~MainWindow()
 
 	delete ui;
 
+	FFTEngine::saveWisdom();
+
 	qDebug() << "MainWindow::~MainWindow: end";
 	delete m_logger;
 }
@@ -253,6 +261,7 @@ void MainWindow::addSourceDevice()
     connect(m_deviceUIs.back()->m_samplingDeviceControl->getAddChannelButton(), SIGNAL(clicked(bool)), this, SLOT(on_channel_addClicked(bool)));
 
     dspDeviceSourceEngine->addSink(m_deviceUIs.back()->m_spectrumVis);
+    m_deviceUIs.back()->m_spectrumEngine = new DeviceSpectrumEngine(dspDeviceSourceEngine, false); // the GUI has its own spectrum display
     ui->tabSpectra->addTab(m_deviceUIs.back()->m_spectrum, tabNameCStr);
     ui->tabSpectraGUI->addTab(m_deviceUIs.back()->m_spectrumGUI, tabNameCStr);
     ui->tabChannels->addTab(m_deviceUIs.back()->m_channelWindow, tabNameCStr);
@@ -371,6 +380,8 @@ void MainWindow::removeLastDevice()
 	    DSPDeviceSourceEngine *lastDeviceEngine = m_deviceUIs.back()->m_deviceSourceEngine;
 	    lastDeviceEngine->stopAcquistion();
 	    lastDeviceEngine->removeSink(m_deviceUIs.back()->m_spectrumVis);
+	    delete m_deviceUIs.back()->m_spectrumEngine; // detaches from the device engine
+	    m_deviceUIs.back()->m_spectrumEngine = 0;
 
 	    ui->tabSpectraGUI->removeTab(ui->tabSpectraGUI->count() - 1);
 	    ui->tabSpectra->removeTab(ui->tabSpectra->count() - 1);
@@ -45,6 +45,7 @@ SOURCES += mainwindow.cpp\
         dsp/spectrumvis.cpp\
         gui/aboutdialog.cpp\
         gui/addpresetdialog.cpp\
+        gui/audioselectdialog.cpp\
         gui/basicchannelsettingsdialog.cpp\
         gui/buttonswitch.cpp\
         gui/channelwindow.cpp\
@@ -77,6 +78,7 @@ SOURCES += mainwindow.cpp\
         gui/transverterdialog.cpp\
         gui/valuedial.cpp\
         gui/valuedialz.cpp\
+        gui/waterfallhistory.cpp\
         webapi/webapiadaptergui.cpp
 
 HEADERS  += mainwindow.h\
@@ -91,6 +93,7 @@ HEADERS  += mainwindow.h\
         gui/aboutdialog.h\
         gui/addpresetdialog.h\
         gui/audiodialog.h\
+        gui/audioselectdialog.h\
         gui/basicchannelsettingsdialog.h\
         gui/buttonswitch.h\
         gui/channelwindow.h\
@@ -123,11 +126,13 @@ HEADERS  += mainwindow.h\
         gui/transverterdialog.h\
         gui/valuedial.h\
         gui/valuedialz.h\
+        gui/waterfallhistory.h\
         webapi/webapiadaptergui.h
 
 FORMS    += mainwindow.ui\
         gui/scopewindow.ui\
         gui/addpresetdialog.ui\
+        gui/audioselectdialog.ui\
         gui/basicchannelsettingsdialog.ui\
         gui/cwkeyergui.ui\
         gui/externalclockdialog.ui\
@@ -25,6 +25,7 @@
 #include "device/deviceuiset.h"
 #include "dsp/devicesamplesource.h"
 #include "dsp/devicesamplesink.h"
+#include "dsp/simddispatch.h"
 #include "channel/channelsinkapi.h"
 #include "channel/channelsourceapi.h"
 
@@ -48,6 +49,7 @@ int WebAPIAdapterGUI::instanceSummary(
 {
 
     *response.getVersion() = qApp->applicationVersion();
+    *response.getSimd() = QString(SIMDDispatch::getLevelName());
 
     Swagger::SWGLoggingInfo *logging = response.getLogging();
     logging->init();
@@ -137,4 +139,16 @@ int WebAPIAdapterGUI::instanceSummary(
     return 200;
 }
 
+bool WebAPIAdapterGUI::getDeviceSet(int deviceSetIndex, DeviceSetRef& deviceSet)
+{
+    if ((deviceSetIndex < 0) || (deviceSetIndex >= (int) m_mainWindow.m_deviceUIs.size())) {
+        return false;
+    }
 
+    deviceSet.m_deviceSourceEngine = m_mainWindow.m_deviceUIs[deviceSetIndex]->m_deviceSourceEngine;
+    deviceSet.m_deviceSourceAPI = m_mainWindow.m_deviceUIs[deviceSetIndex]->m_deviceSourceAPI;
+    deviceSet.m_deviceSinkEngine = m_mainWindow.m_deviceUIs[deviceSetIndex]->m_deviceSinkEngine;
+    deviceSet.m_deviceSinkAPI = m_mainWindow.m_deviceUIs[deviceSetIndex]->m_deviceSinkAPI;
+    deviceSet.m_spectrumEngine = m_mainWindow.m_deviceUIs[deviceSetIndex]->m_spectrumEngine;
+    return true;
+}
@@ -19,11 +19,11 @@
 #ifndef SDRGUI_WEBAPI_WEBAPIADAPTERGUI_H_
 #define SDRGUI_WEBAPI_WEBAPIADAPTERGUI_H_
 
-#include "webapi/webapiadapterinterface.h"
+#include "webapi/webapiadapterbase.h"
 
 class MainWindow;
 
-class WebAPIAdapterGUI: public WebAPIAdapterInterface
+class WebAPIAdapterGUI: public WebAPIAdapterBase
 {
 public:
     WebAPIAdapterGUI(MainWindow& mainWindow);
@@ -33,6 +33,9 @@ public:
             Swagger::SWGInstanceSummaryResponse& response,
             Swagger::SWGErrorResponse& error);
 
+protected:
+    virtual bool getDeviceSet(int deviceSetIndex, DeviceSetRef& deviceSet);
+
 private:
     MainWindow& m_mainWindow;
 };
@@ -0,0 +1,49 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRSRV_DEVICE_DEVICESET_H_
+#define SDRSRV_DEVICE_DEVICESET_H_
+
+class DSPDeviceSourceEngine;
+class DeviceSourceAPI;
+class DSPDeviceSinkEngine;
+class DeviceSinkAPI;
+class DeviceSpectrumEngine;
+
+/**
+ * Headless counterpart of DeviceUISet: one device set is either a source (Rx)
+ * or a sink (Tx) engine together with its device API. There are no GUI objects.
+ * Rx sets have a spectrum engine in place of the GUI spectrum display.
+ */
+struct DeviceSet
+{
+    DSPDeviceSourceEngine *m_deviceSourceEngine;
+    DeviceSourceAPI *m_deviceSourceAPI;
+    DSPDeviceSinkEngine *m_deviceSinkEngine;
+    DeviceSinkAPI *m_deviceSinkAPI;
+    DeviceSpectrumEngine *m_spectrumEngine;
+
+    DeviceSet() :
+        m_deviceSourceEngine(0),
+        m_deviceSourceAPI(0),
+        m_deviceSinkEngine(0),
+        m_deviceSinkAPI(0),
+        m_spectrumEngine(0)
+    {}
+};
+
+#endif /* SDRSRV_DEVICE_DEVICESET_H_ */
@@ -0,0 +1,207 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#include <QDebug>
+
+#include "loggerwithfile.h"
+#include "dsp/dspengine.h"
+#include "dsp/dspdevicesourceengine.h"
+#include "dsp/dspdevicesinkengine.h"
+#include "dsp/devicesamplesource.h"
+#include "dsp/devicesamplesink.h"
+#include "dsp/fftengine.h"
+#include "dsp/devicespectrumengine.h"
+#include "device/devicesourceapi.h"
+#include "device/devicesinkapi.h"
+#include "device/deviceenumerator.h"
+#include "plugin/pluginmanager.h"
+#include "webapi/webapirequestmapper.h"
+#include "webapi/webapiserver.h"
+#include "webapi/webapiadaptersrv.h"
+#include "device/deviceset.h"
+
+#include "maincore.h"
+
+MainCore *MainCore::m_instance = 0;
+
+MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, QObject *parent) :
+    QObject(parent),
+    m_settings(),
+    m_dspEngine(DSPEngine::instance()),
+    m_logger(logger)
+{
+    qDebug() << "MainCore::MainCore: start";
+
+    m_instance = this;
+    m_dspEngine->configureChannelWorkers(parser.getChannelThreads(), parser.getPinChannelThreads());
+    m_dspEngine->setCorrectionInAcquisition(parser.getCorrectionInAcquisition());
+    FFTEngine::setPlanningEffort(parser.getFFTPlanningEffort());
+    FFTEngine::loadWisdom();
+    m_settings.setAudioDeviceInfo(&m_audioDeviceInfo);
+
+    m_pluginManager = new PluginManager(this);
+    m_pluginManager->loadPlugins();
+
+    qDebug() << "MainCore::MainCore: load settings...";
+
+    loadSettings();
+
+    qDebug() << "MainCore::MainCore: add the first device...";
+
+    int deviceIndex = DeviceEnumerator::instance()->getRxSamplingDeviceIndex(m_settings.getSourceDeviceId(), m_settings.getSourceIndex());
+
+    if (deviceIndex < 0) {
+        deviceIndex = DeviceEnumerator::instance()->getFileSourceDeviceIndex();
+    }
+
+    addSourceDevice(deviceIndex);
+    m_deviceSets.back()->m_deviceSourceAPI->setBuddyLeader(true); // the first device is always the leader
+
+    m_apiAdapter = new WebAPIAdapterSrv(*this);
+    m_requestMapper = new WebAPIRequestMapper(this);
+    m_requestMapper->setAdapter(m_apiAdapter);
+    m_apiServer = new WebAPIServer(parser.getServerAddress(), parser.getServerPort(), m_requestMapper);
+    m_apiServer->start();
+
+    qDebug() << "MainCore::MainCore: end";
+}
+
+MainCore::~MainCore()
+{
+    m_apiServer->stop();
+    delete m_apiServer;
+    delete m_requestMapper;
+    delete m_apiAdapter;
+
+    while (m_deviceSets.size() > 0) {
+        removeLastDevice();
+    }
+
+    delete m_pluginManager;
+
+    FFTEngine::saveWisdom();
+
+    qDebug() << "MainCore::~MainCore: end";
+    delete m_logger;
+}
+
+void MainCore::loadSettings()
+{
+    qDebug() << "MainCore::loadSettings";
+
+    m_settings.load();
+    m_settings.sortPresets();
+    setLoggingOptions();
+}
+
+void MainCore::setLoggingOptions()
+{
+    m_logger->setConsoleMinMessageLevel(m_settings.getConsoleMinLogLevel());
+
+    if (m_settings.getUseLogFile())
+    {
+        qtwebapp::FileLoggerSettings fileLoggerSettings; // default values
+
+        if (m_logger->hasFileLogger()) {
+            fileLoggerSettings = m_logger->getFileLoggerSettings(); // values from file logger if it exists
+        }
+
+        fileLoggerSettings.fileName = m_settings.getLogFileName(); // put new values
+        m_logger->createOrSetFileLogger(fileLoggerSettings, 2000); // create file logger if it does not exist and apply settings in any case
+    }
+
+    if (m_logger->hasFileLogger()) {
+        m_logger->setFileMinMessageLevel(m_settings.getFileMinLogLevel());
+    }
+
+    m_logger->setUseFileLogger(m_settings.getUseLogFile());
+}
+
+void MainCore::addSourceDevice(int deviceIndex)
+{
+    DSPDeviceSourceEngine *dspDeviceSourceEngine = m_dspEngine->addDeviceSourceEngine();
+    dspDeviceSourceEngine->start();
+
+    int deviceSetIndex = m_deviceSets.size();
+    m_deviceSets.push_back(new DeviceSet());
+    m_deviceSets.back()->m_deviceSourceEngine = dspDeviceSourceEngine;
+
+    DeviceSourceAPI *deviceSourceAPI = new DeviceSourceAPI(deviceSetIndex, dspDeviceSourceEngine);
+    m_deviceSets.back()->m_deviceSourceAPI = deviceSourceAPI;
+
+    m_deviceSets.back()->m_spectrumEngine = new DeviceSpectrumEngine(dspDeviceSourceEngine, true);
+
+    PluginInterface::SamplingDevice samplingDevice = DeviceEnumerator::instance()->getRxSamplingDevice(deviceIndex);
+    deviceSourceAPI->setSampleSourceSequence(samplingDevice.sequence);
+    deviceSourceAPI->setNbItems(samplingDevice.deviceNbItems);
+    deviceSourceAPI->setItemIndex(samplingDevice.deviceItemIndex);
+    deviceSourceAPI->setHardwareId(samplingDevice.hardwareId);
+    deviceSourceAPI->setSampleSourceId(samplingDevice.id);
+    deviceSourceAPI->setSampleSourceSerial(samplingDevice.serial);
+    deviceSourceAPI->setSampleSourceDisplayName(samplingDevice.displayedName);
+    deviceSourceAPI->setSampleSourcePluginInterface(DeviceEnumerator::instance()->getRxPluginInterface(deviceIndex));
+
+    DeviceEnumerator::instance()->changeRxSelection(deviceSetIndex, deviceIndex);
+
+    // only the input core is created: the source has no GUI to send its messages to
+    DeviceSampleSource *source = deviceSourceAPI->getPluginInterface()->createSampleSourcePluginInstanceInput(
+            deviceSourceAPI->getSampleSourceId(), deviceSourceAPI);
+    deviceSourceAPI->setSampleSource(source);
+
+    qInfo("MainCore::addSourceDevice: R%d: %s", deviceSetIndex, qPrintable(deviceSourceAPI->getSampleSourceDisplayName()));
+}
+
+void MainCore::removeLastDevice()
+{
+    int deviceSetIndex = m_deviceSets.size() - 1;
+
+    if (m_deviceSets.back()->m_deviceSourceEngine) // source set
+    {
+        DSPDeviceSourceEngine *lastDeviceEngine = m_deviceSets.back()->m_deviceSourceEngine;
+        DeviceSourceAPI *lastDeviceAPI = m_deviceSets.back()->m_deviceSourceAPI;
+        lastDeviceEngine->stopAcquistion();
+        delete m_deviceSets.back()->m_spectrumEngine; // detaches from the device engine
+        m_deviceSets.back()->m_spectrumEngine = 0;
+
+        lastDeviceAPI->resetSampleSourceId();
+        lastDeviceAPI->getPluginInterface()->deleteSampleSourcePluginInstanceInput(lastDeviceAPI->getSampleSource());
+        lastDeviceAPI->clearBuddiesLists(); // clear old API buddies lists
+        DeviceEnumerator::instance()->removeRxSelection(deviceSetIndex); // This releases the device in the device list
+        delete lastDeviceAPI;
+
+        lastDeviceEngine->stop();
+        m_dspEngine->removeLastDeviceSourceEngine();
+    }
+    else if (m_deviceSets.back()->m_deviceSinkEngine) // sink set
+    {
+        DSPDeviceSinkEngine *lastDeviceEngine = m_deviceSets.back()->m_deviceSinkEngine;
+        DeviceSinkAPI *lastDeviceAPI = m_deviceSets.back()->m_deviceSinkAPI;
+        lastDeviceEngine->stopGeneration();
+
+        lastDeviceAPI->resetSampleSinkId();
+        lastDeviceAPI->getPluginInterface()->deleteSampleSinkPluginInstanceOutput(lastDeviceAPI->getSampleSink());
+        lastDeviceAPI->clearBuddiesLists(); // clear old API buddies lists
+        DeviceEnumerator::instance()->removeTxSelection(deviceSetIndex); // This releases the device in the device list
+        delete lastDeviceAPI;
+
+        lastDeviceEngine->stop();
+        m_dspEngine->removeLastDeviceSinkEngine();
+    }
+
+    delete m_deviceSets.back();
+    m_deviceSets.pop_back();
+}
@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SDRSRV_MAINCORE_H_
+#define SDRSRV_MAINCORE_H_
+
+#include <QObject>
+#include <vector>
+
+#include "settings/mainsettings.h"
+#include "util/export.h"
+#include "mainparser.h"
+
+class DSPEngine;
+class PluginManager;
+class WebAPIRequestMapper;
+class WebAPIServer;
+class WebAPIAdapterSrv;
+struct DeviceSet;
+
+namespace qtwebapp {
+    class LoggerWithFile;
+}
+
+/**
+ * Core of the headless server. Runs the DSP engine, loads the plugins and serves
+ * the web API without any widget. Plugin GUIs are never instantiated: only the
+ * core (device input and channel) factories of the plugins are used.
+ */
+class SDRANGEL_API MainCore : public QObject {
+    Q_OBJECT
+
+public:
+    explicit MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, QObject *parent = 0);
+    ~MainCore();
+    static MainCore *getInstance() { return m_instance; } // Main Core is de facto a singleton so this just returns its reference
+
+    friend class WebAPIAdapterSrv;
+
+private:
+    static MainCore *m_instance;
+    MainSettings m_settings;
+    DSPEngine* m_dspEngine;
+    std::vector<DeviceSet*> m_deviceSets;
+    PluginManager* m_pluginManager;
+    AudioDeviceInfo m_audioDeviceInfo;
+    qtwebapp::LoggerWithFile *m_logger;
+
+    WebAPIRequestMapper *m_requestMapper;
+    WebAPIServer *m_apiServer;
+    WebAPIAdapterSrv *m_apiAdapter;
+
+    void loadSettings();
+    void setLoggingOptions();
+    void addSourceDevice(int deviceIndex);
+    void removeLastDevice();
+};
+
+#endif /* SDRSRV_MAINCORE_H_ */
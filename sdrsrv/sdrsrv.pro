@@ -0,0 +1,50 @@
+#--------------------------------------------------------
+#
+# Pro file for Android and Windows builds with Qt Creator
+#
+#--------------------------------------------------------
+
+QT += core multimedia
+
+TEMPLATE = lib
+TARGET = sdrsrv
+INCLUDEPATH += $$PWD
+INCLUDEPATH += ../sdrbase
+INCLUDEPATH += ../logging
+INCLUDEPATH += ../httpserver
+INCLUDEPATH += ../swagger/sdrangel/code/qt5/client
+
+DEFINES += USE_KISSFFT=1
+win32 {
+    DEFINES += __WINDOWS__=1
+}
+DEFINES += USE_SSE2=1
+QMAKE_CXXFLAGS += -msse2
+DEFINES += USE_SSE4_1=1
+QMAKE_CXXFLAGS += -msse4.1
+
+QMAKE_CXXFLAGS += -std=c++11
+
+CONFIG(Release):build_subdir = release
+CONFIG(Debug):build_subdir = debug
+
+CONFIG(ANDROID):INCLUDEPATH += /opt/softs/boost_1_60_0
+
+CONFIG(MINGW32):INCLUDEPATH += "D:\boost_1_58_0"
+CONFIG(MINGW64):INCLUDEPATH += "D:\boost_1_58_0"
+
+CONFIG(macx):INCLUDEPATH += "../../../boost_1_64_0"
+
+SOURCES += maincore.cpp\
+        webapi/webapiadaptersrv.cpp
+
+HEADERS  += maincore.h\
+        device/deviceset.h\
+        webapi/webapiadaptersrv.h
+
+LIBS += -L../sdrbase/$${build_subdir} -lsdrbase
+LIBS += -L../logging/$${build_subdir} -llogging
+LIBS += -L../swagger/$${build_subdir} -lswagger
+
+CONFIG(ANDROID):CONFIG += mobility
+CONFIG(ANDROID):MOBILITY =
@@ -0,0 +1,43 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2017 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Swagger server adapter for the headless server                                //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRSRV_WEBAPI_WEBAPIADAPTERSRV_H_
+#define SDRSRV_WEBAPI_WEBAPIADAPTERSRV_H_
+
+#include "webapi/webapiadapterbase.h"
+
+class MainCore;
+
+class WebAPIAdapterSrv: public WebAPIAdapterBase
+{
+public:
+    WebAPIAdapterSrv(MainCore& mainCore);
+    virtual ~WebAPIAdapterSrv();
+
+    virtual int instanceSummary(
+            Swagger::SWGInstanceSummaryResponse& response,
+            Swagger::SWGErrorResponse& error);
+
+protected:
+    virtual bool getDeviceSet(int deviceSetIndex, DeviceSetRef& deviceSet);
+
+private:
+    MainCore& m_mainCore;
+};
+
+#endif /* SDRSRV_WEBAPI_WEBAPIADAPTERSRV_H_ */
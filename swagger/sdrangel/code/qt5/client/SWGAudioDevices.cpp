@@ -41,6 +41,8 @@ SWGAudioDevices::init() {
     input_devices = new QList<QString*>();
     nb_output_devices = 0;
     output_devices = new QList<QString*>();
+    nb_output_fifos = 0;
+    output_fifos = new QList<SWGAudioFifoStatus*>();
 }
 
 void
@@ -63,6 +65,15 @@ SWGAudioDevices::cleanup() {
         }
         delete output_devices;
     }
+
+
+    if(output_fifos != nullptr) {
+        QList<SWGAudioFifoStatus*>* arr = output_fifos;
+        foreach(SWGAudioFifoStatus* o, *arr) {
+            delete o;
+        }
+        delete output_fifos;
+    }
 }
 
 SWGAudioDevices*
@@ -84,6 +95,10 @@ SWGAudioDevices::fromJsonObject(QJsonObject &pJson) {
     
     ::Swagger::setValue(&output_devices, pJson["outputDevices"], "QList", "QString");
     
+    ::Swagger::setValue(&nb_output_fifos, pJson["nbOutputFifos"], "qint32", "");
+    
+    ::Swagger::setValue(&output_fifos, pJson["outputFifos"], "QList", "SWGAudioFifoStatus");
+    
 }
 
 QString
@@ -112,6 +127,12 @@ SWGAudioDevices::asJsonObject() {
     toJsonArray((QList<void*>*)output_devices, &output_devicesJsonArray, "output_devices", "QString");
     obj->insert("outputDevices", output_devicesJsonArray);
 
+    obj->insert("nbOutputFifos", QJsonValue(nb_output_fifos));
+
+    QJsonArray output_fifosJsonArray;
+    toJsonArray((QList<void*>*)output_fifos, &output_fifosJsonArray, "output_fifos", "SWGAudioFifoStatus");
+    obj->insert("outputFifos", output_fifosJsonArray);
+
     return obj;
 }
 
@@ -151,6 +172,24 @@ SWGAudioDevices::setOutputDevices(QList<QString*>* output_devices) {
     this->output_devices = output_devices;
 }
 
+qint32
+SWGAudioDevices::getNbOutputFifos() {
+    return nb_output_fifos;
+}
+void
+SWGAudioDevices::setNbOutputFifos(qint32 nb_output_fifos) {
+    this->nb_output_fifos = nb_output_fifos;
+}
+
+QList<SWGAudioFifoStatus*>*
+SWGAudioDevices::getOutputFifos() {
+    return output_fifos;
+}
+void
+SWGAudioDevices::setOutputFifos(QList<SWGAudioFifoStatus*>* output_fifos) {
+    this->output_fifos = output_fifos;
+}
+
 
 }
 
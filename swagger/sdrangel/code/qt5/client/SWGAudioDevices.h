@@ -22,6 +22,7 @@
 #include <QJsonObject>
 
 
+#include "SWGAudioFifoStatus.h"
 #include <QList>
 #include <QString>
 
@@ -55,12 +56,20 @@ public:
     QList<QString*>* getOutputDevices();
     void setOutputDevices(QList<QString*>* output_devices);
 
+    qint32 getNbOutputFifos();
+    void setNbOutputFifos(qint32 nb_output_fifos);
+
+    QList<SWGAudioFifoStatus*>* getOutputFifos();
+    void setOutputFifos(QList<SWGAudioFifoStatus*>* output_fifos);
+
 
 private:
     qint32 nb_input_devices;
     QList<QString*>* input_devices;
     qint32 nb_output_devices;
     QList<QString*>* output_devices;
+    qint32 nb_output_fifos;
+    QList<SWGAudioFifoStatus*>* output_fifos;
 };
 
 }
@@ -0,0 +1,134 @@
+/**
+ * SDRangel
+ * This is the web API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube
+ *
+ * OpenAPI spec version: 4.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGAudioFifoStatus.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace Swagger {
+
+SWGAudioFifoStatus::SWGAudioFifoStatus(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGAudioFifoStatus::SWGAudioFifoStatus() {
+    init();
+}
+
+SWGAudioFifoStatus::~SWGAudioFifoStatus() {
+    this->cleanup();
+}
+
+void
+SWGAudioFifoStatus::init() {
+    size = 0;
+    fill = 0;
+    underrun_count = 0;
+    overrun_count = 0;
+}
+
+void
+SWGAudioFifoStatus::cleanup() {
+    
+
+
+
+}
+
+SWGAudioFifoStatus*
+SWGAudioFifoStatus::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGAudioFifoStatus::fromJsonObject(QJsonObject &pJson) {
+    ::Swagger::setValue(&size, pJson["size"], "qint32", "");
+    ::Swagger::setValue(&fill, pJson["fill"], "qint32", "");
+    ::Swagger::setValue(&underrun_count, pJson["underrunCount"], "qint32", "");
+    ::Swagger::setValue(&overrun_count, pJson["overrunCount"], "qint32", "");
+}
+
+QString
+SWGAudioFifoStatus::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+    
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGAudioFifoStatus::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    
+    obj->insert("size", QJsonValue(size));
+
+    obj->insert("fill", QJsonValue(fill));
+
+    obj->insert("underrunCount", QJsonValue(underrun_count));
+
+    obj->insert("overrunCount", QJsonValue(overrun_count));
+
+    return obj;
+}
+
+qint32
+SWGAudioFifoStatus::getSize() {
+    return size;
+}
+void
+SWGAudioFifoStatus::setSize(qint32 size) {
+    this->size = size;
+}
+
+qint32
+SWGAudioFifoStatus::getFill() {
+    return fill;
+}
+void
+SWGAudioFifoStatus::setFill(qint32 fill) {
+    this->fill = fill;
+}
+
+qint32
+SWGAudioFifoStatus::getUnderrunCount() {
+    return underrun_count;
+}
+void
+SWGAudioFifoStatus::setUnderrunCount(qint32 underrun_count) {
+    this->underrun_count = underrun_count;
+}
+
+qint32
+SWGAudioFifoStatus::getOverrunCount() {
+    return overrun_count;
+}
+void
+SWGAudioFifoStatus::setOverrunCount(qint32 overrun_count) {
+    this->overrun_count = overrun_count;
+}
+
+
+}
+
@@ -0,0 +1,66 @@
+/**
+ * SDRangel
+ * This is the web API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube
+ *
+ * OpenAPI spec version: 4.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGAudioFifoStatus.h
+ * 
+ * Status of an audio FIFO feeding an audio device
+ */
+
+#ifndef SWGAudioFifoStatus_H_
+#define SWGAudioFifoStatus_H_
+
+#include <QJsonObject>
+
+
+
+#include "SWGObject.h"
+
+
+namespace Swagger {
+
+class SWGAudioFifoStatus: public SWGObject {
+public:
+    SWGAudioFifoStatus();
+    SWGAudioFifoStatus(QString* json);
+    virtual ~SWGAudioFifoStatus();
+    void init();
+    void cleanup();
+
+    QString asJson ();
+    QJsonObject* asJsonObject();
+    void fromJsonObject(QJsonObject &json);
+    SWGAudioFifoStatus* fromJson(QString &jsonString);
+
+    qint32 getSize();
+    void setSize(qint32 size);
+
+    qint32 getFill();
+    void setFill(qint32 fill);
+
+    qint32 getUnderrunCount();
+    void setUnderrunCount(qint32 underrun_count);
+
+    qint32 getOverrunCount();
+    void setOverrunCount(qint32 overrun_count);
+
+
+private:
+    qint32 size;
+    qint32 fill;
+    qint32 underrun_count;
+    qint32 overrun_count;
+};
+
+}
+
+#endif /* SWGAudioFifoStatus_H_ */
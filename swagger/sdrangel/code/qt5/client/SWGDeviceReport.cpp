@@ -0,0 +1,126 @@
+/**
+ * SDRangel
+ * This is the web API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube
+ *
+ * OpenAPI spec version: 4.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGDeviceReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace Swagger {
+
+SWGDeviceReport::SWGDeviceReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGDeviceReport::SWGDeviceReport() {
+    init();
+}
+
+SWGDeviceReport::~SWGDeviceReport() {
+    this->cleanup();
+}
+
+void
+SWGDeviceReport::init() {
+    device_hw_type = new QString("");
+    tx = false;
+    sdr_daemon_sink_report = new SWGSDRdaemonSinkReport();
+}
+
+void
+SWGDeviceReport::cleanup() {
+    
+    if(device_hw_type != nullptr) {
+        delete device_hw_type;
+    }
+
+    
+    if(sdr_daemon_sink_report != nullptr) {
+        delete sdr_daemon_sink_report;
+    }
+}
+
+SWGDeviceReport*
+SWGDeviceReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGDeviceReport::fromJsonObject(QJsonObject &pJson) {
+    ::Swagger::setValue(&device_hw_type, pJson["deviceHwType"], "QString", "QString");
+    ::Swagger::setValue(&tx, pJson["tx"], "bool", "");
+    ::Swagger::setValue(&sdr_daemon_sink_report, pJson["sdrDaemonSinkReport"], "SWGSDRdaemonSinkReport", "SWGSDRdaemonSinkReport");
+}
+
+QString
+SWGDeviceReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+    
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGDeviceReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    
+    toJsonValue(QString("deviceHwType"), device_hw_type, obj, QString("QString"));
+
+    obj->insert("tx", QJsonValue(tx));
+
+    toJsonValue(QString("sdrDaemonSinkReport"), sdr_daemon_sink_report, obj, QString("SWGSDRdaemonSinkReport"));
+
+    return obj;
+}
+
+QString*
+SWGDeviceReport::getDeviceHwType() {
+    return device_hw_type;
+}
+void
+SWGDeviceReport::setDeviceHwType(QString* device_hw_type) {
+    this->device_hw_type = device_hw_type;
+}
+
+bool
+SWGDeviceReport::getTx() {
+    return tx;
+}
+void
+SWGDeviceReport::setTx(bool tx) {
+    this->tx = tx;
+}
+
+SWGSDRdaemonSinkReport*
+SWGDeviceReport::getSdrDaemonSinkReport() {
+    return sdr_daemon_sink_report;
+}
+void
+SWGDeviceReport::setSdrDaemonSinkReport(SWGSDRdaemonSinkReport* sdr_daemon_sink_report) {
+    this->sdr_daemon_sink_report = sdr_daemon_sink_report;
+}
+
+
+}
+
@@ -0,0 +1,64 @@
+/**
+ * SDRangel
+ * This is the web API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube
+ *
+ * OpenAPI spec version: 4.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGDeviceReport.h
+ * 
+ * Base device report. Only the report of the device type is present
+ */
+
+#ifndef SWGDeviceReport_H_
+#define SWGDeviceReport_H_
+
+#include <QJsonObject>
+
+
+#include "SWGSDRdaemonSinkReport.h"
+#include <QString>
+
+#include "SWGObject.h"
+
+
+namespace Swagger {
+
+class SWGDeviceReport: public SWGObject {
+public:
+    SWGDeviceReport();
+    SWGDeviceReport(QString* json);
+    virtual ~SWGDeviceReport();
+    void init();
+    void cleanup();
+
+    QString asJson ();
+    QJsonObject* asJsonObject();
+    void fromJsonObject(QJsonObject &json);
+    SWGDeviceReport* fromJson(QString &jsonString);
+
+    QString* getDeviceHwType();
+    void setDeviceHwType(QString* device_hw_type);
+
+    bool getTx();
+    void setTx(bool tx);
+
+    SWGSDRdaemonSinkReport* getSdrDaemonSinkReport();
+    void setSdrDaemonSinkReport(SWGSDRdaemonSinkReport* sdr_daemon_sink_report);
+
+
+private:
+    QString* device_hw_type;
+    bool tx;
+    SWGSDRdaemonSinkReport* sdr_daemon_sink_report;
+};
+
+}
+
+#endif /* SWGDeviceReport_H_ */
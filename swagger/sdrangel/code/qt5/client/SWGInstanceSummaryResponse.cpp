@@ -38,6 +38,7 @@ SWGInstanceSummaryResponse::~SWGInstanceSummaryResponse() {
 void
 SWGInstanceSummaryResponse::init() {
     version = new QString("");
+    simd = new QString("");
     logging = new SWGLoggingInfo();
     devicesetlist = new SWGDeviceSetList();
     user = new SWGUser();
@@ -50,6 +51,10 @@ SWGInstanceSummaryResponse::cleanup() {
         delete version;
     }
 
+    if(simd != nullptr) {
+        delete simd;
+    }
+
     if(logging != nullptr) {
         delete logging;
     }
@@ -75,6 +80,7 @@ SWGInstanceSummaryResponse::fromJson(QString &json) {
 void
 SWGInstanceSummaryResponse::fromJsonObject(QJsonObject &pJson) {
     ::Swagger::setValue(&version, pJson["version"], "QString", "QString");
+    ::Swagger::setValue(&simd, pJson["simd"], "QString", "QString");
     ::Swagger::setValue(&logging, pJson["logging"], "SWGLoggingInfo", "SWGLoggingInfo");
     ::Swagger::setValue(&devicesetlist, pJson["devicesetlist"], "SWGDeviceSetList", "SWGDeviceSetList");
     ::Swagger::setValue(&user, pJson["user"], "SWGUser", "SWGUser");
@@ -96,6 +102,8 @@ SWGInstanceSummaryResponse::asJsonObject() {
     
     toJsonValue(QString("version"), version, obj, QString("QString"));
 
+    toJsonValue(QString("simd"), simd, obj, QString("QString"));
+
     toJsonValue(QString("logging"), logging, obj, QString("SWGLoggingInfo"));
 
     toJsonValue(QString("devicesetlist"), devicesetlist, obj, QString("SWGDeviceSetList"));
@@ -114,6 +122,15 @@ SWGInstanceSummaryResponse::setVersion(QString* version) {
     this->version = version;
 }
 
+QString*
+SWGInstanceSummaryResponse::getSimd() {
+    return simd;
+}
+void
+SWGInstanceSummaryResponse::setSimd(QString* simd) {
+    this->simd = simd;
+}
+
 SWGLoggingInfo*
 SWGInstanceSummaryResponse::getLogging() {
     return logging;
@@ -48,6 +48,9 @@ public:
     QString* getVersion();
     void setVersion(QString* version);
 
+    QString* getSimd();
+    void setSimd(QString* simd);
+
     SWGLoggingInfo* getLogging();
     void setLogging(SWGLoggingInfo* logging);
 
@@ -60,6 +63,7 @@ public:
 
 private:
     QString* version;
+    QString* simd;
     SWGLoggingInfo* logging;
     SWGDeviceSetList* devicesetlist;
     SWGUser* user;
@@ -16,10 +16,12 @@
 
 #include "SWGAudioDevices.h"
 #include "SWGAudioDevicesSelect.h"
+#include "SWGAudioFifoStatus.h"
 #include "SWGChannel.h"
 #include "SWGChannelListItem.h"
 #include "SWGDVSeralDevices.h"
 #include "SWGDeviceListItem.h"
+#include "SWGDeviceReport.h"
 #include "SWGDeviceSet.h"
 #include "SWGDeviceSetList.h"
 #include "SWGErrorResponse.h"
@@ -33,7 +35,10 @@
 #include "SWGPresetItem.h"
 #include "SWGPresetTransfer.h"
 #include "SWGPresets.h"
+#include "SWGSDRdaemonSinkReport.h"
 #include "SWGSamplingDevice.h"
+#include "SWGSpectrumFrame.h"
+#include "SWGSpectrumSettings.h"
 #include "SWGUser.h"
 
 namespace Swagger {
@@ -45,6 +50,9 @@ namespace Swagger {
     if(QString("SWGAudioDevicesSelect").compare(type) == 0) {
       return new SWGAudioDevicesSelect();
     }
+    if(QString("SWGAudioFifoStatus").compare(type) == 0) {
+      return new SWGAudioFifoStatus();
+    }
     if(QString("SWGChannel").compare(type) == 0) {
       return new SWGChannel();
     }
@@ -57,6 +65,9 @@ namespace Swagger {
     if(QString("SWGDeviceListItem").compare(type) == 0) {
       return new SWGDeviceListItem();
     }
+    if(QString("SWGDeviceReport").compare(type) == 0) {
+      return new SWGDeviceReport();
+    }
     if(QString("SWGDeviceSet").compare(type) == 0) {
       return new SWGDeviceSet();
     }
@@ -96,9 +107,18 @@ namespace Swagger {
     if(QString("SWGPresets").compare(type) == 0) {
       return new SWGPresets();
     }
+    if(QString("SWGSDRdaemonSinkReport").compare(type) == 0) {
+      return new SWGSDRdaemonSinkReport();
+    }
     if(QString("SWGSamplingDevice").compare(type) == 0) {
       return new SWGSamplingDevice();
     }
+    if(QString("SWGSpectrumFrame").compare(type) == 0) {
+      return new SWGSpectrumFrame();
+    }
+    if(QString("SWGSpectrumSettings").compare(type) == 0) {
+      return new SWGSpectrumSettings();
+    }
     if(QString("SWGUser").compare(type) == 0) {
       return new SWGUser();
     }
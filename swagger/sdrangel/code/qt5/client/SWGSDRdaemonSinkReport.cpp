@@ -0,0 +1,134 @@
+/**
+ * SDRangel
+ * This is the web API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube
+ *
+ * OpenAPI spec version: 4.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGSDRdaemonSinkReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace Swagger {
+
+SWGSDRdaemonSinkReport::SWGSDRdaemonSinkReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGSDRdaemonSinkReport::SWGSDRdaemonSinkReport() {
+    init();
+}
+
+SWGSDRdaemonSinkReport::~SWGSDRdaemonSinkReport() {
+    this->cleanup();
+}
+
+void
+SWGSDRdaemonSinkReport::init() {
+    send_rate = 0;
+    queue_depth = 0;
+    queue_size = 0;
+    udp_size = 0;
+}
+
+void
+SWGSDRdaemonSinkReport::cleanup() {
+
+
+
+
+}
+
+SWGSDRdaemonSinkReport*
+SWGSDRdaemonSinkReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGSDRdaemonSinkReport::fromJsonObject(QJsonObject &pJson) {
+    ::Swagger::setValue(&send_rate, pJson["sendRate"], "qint32", "");
+    ::Swagger::setValue(&queue_depth, pJson["queueDepth"], "qint32", "");
+    ::Swagger::setValue(&queue_size, pJson["queueSize"], "qint32", "");
+    ::Swagger::setValue(&udp_size, pJson["udpSize"], "qint32", "");
+}
+
+QString
+SWGSDRdaemonSinkReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+    
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGSDRdaemonSinkReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    
+    obj->insert("sendRate", QJsonValue(send_rate));
+
+    obj->insert("queueDepth", QJsonValue(queue_depth));
+
+    obj->insert("queueSize", QJsonValue(queue_size));
+
+    obj->insert("udpSize", QJsonValue(udp_size));
+
+    return obj;
+}
+
+qint32
+SWGSDRdaemonSinkReport::getSendRate() {
+    return send_rate;
+}
+void
+SWGSDRdaemonSinkReport::setSendRate(qint32 send_rate) {
+    this->send_rate = send_rate;
+}
+
+qint32
+SWGSDRdaemonSinkReport::getQueueDepth() {
+    return queue_depth;
+}
+void
+SWGSDRdaemonSinkReport::setQueueDepth(qint32 queue_depth) {
+    this->queue_depth = queue_depth;
+}
+
+qint32
+SWGSDRdaemonSinkReport::getQueueSize() {
+    return queue_size;
+}
+void
+SWGSDRdaemonSinkReport::setQueueSize(qint32 queue_size) {
+    this->queue_size = queue_size;
+}
+
+qint32
+SWGSDRdaemonSinkReport::getUdpSize() {
+    return udp_size;
+}
+void
+SWGSDRdaemonSinkReport::setUdpSize(qint32 udp_size) {
+    this->udp_size = udp_size;
+}
+
+
+}
+
@@ -0,0 +1,66 @@
+/**
+ * SDRangel
+ * This is the web API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube
+ *
+ * OpenAPI spec version: 4.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGSDRdaemonSinkReport.h
+ * 
+ * SDRdaemon sink device transmission status
+ */
+
+#ifndef SWGSDRdaemonSinkReport_H_
+#define SWGSDRdaemonSinkReport_H_
+
+#include <QJsonObject>
+
+
+
+#include "SWGObject.h"
+
+
+namespace Swagger {
+
+class SWGSDRdaemonSinkReport: public SWGObject {
+public:
+    SWGSDRdaemonSinkReport();
+    SWGSDRdaemonSinkReport(QString* json);
+    virtual ~SWGSDRdaemonSinkReport();
+    void init();
+    void cleanup();
+
+    QString asJson ();
+    QJsonObject* asJsonObject();
+    void fromJsonObject(QJsonObject &json);
+    SWGSDRdaemonSinkReport* fromJson(QString &jsonString);
+
+    qint32 getSendRate();
+    void setSendRate(qint32 send_rate);
+
+    qint32 getQueueDepth();
+    void setQueueDepth(qint32 queue_depth);
+
+    qint32 getQueueSize();
+    void setQueueSize(qint32 queue_size);
+
+    qint32 getUdpSize();
+    void setUdpSize(qint32 udp_size);
+
+
+private:
+    qint32 send_rate;
+    qint32 queue_depth;
+    qint32 queue_size;
+    qint32 udp_size;
+};
+
+}
+
+#endif /* SWGSDRdaemonSinkReport_H_ */
@@ -0,0 +1,165 @@
+/**
+ * SDRangel
+ * This is the web API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube
+ *
+ * OpenAPI spec version: 4.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGSpectrumFrame.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace Swagger {
+
+SWGSpectrumFrame::SWGSpectrumFrame(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGSpectrumFrame::SWGSpectrumFrame() {
+    init();
+}
+
+SWGSpectrumFrame::~SWGSpectrumFrame() {
+    this->cleanup();
+}
+
+void
+SWGSpectrumFrame::init() {
+    index = 0;
+    timestamp = 0L;
+    center_frequency = 0L;
+    sample_rate = 0;
+    fft_size = 0;
+    power = new QByteArray();
+}
+
+void
+SWGSpectrumFrame::cleanup() {
+    
+
+
+
+
+
+    if(power != nullptr) {
+        delete power;
+    }
+}
+
+SWGSpectrumFrame*
+SWGSpectrumFrame::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGSpectrumFrame::fromJsonObject(QJsonObject &pJson) {
+    ::Swagger::setValue(&index, pJson["index"], "qint32", "");
+    ::Swagger::setValue(&timestamp, pJson["timestamp"], "qint64", "");
+    ::Swagger::setValue(&center_frequency, pJson["centerFrequency"], "qint64", "");
+    ::Swagger::setValue(&sample_rate, pJson["sampleRate"], "qint32", "");
+    ::Swagger::setValue(&fft_size, pJson["fftSize"], "qint32", "");
+    ::Swagger::setValue(&power, pJson["power"], "QByteArray", "QByteArray");
+}
+
+QString
+SWGSpectrumFrame::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+    
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGSpectrumFrame::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    
+    obj->insert("index", QJsonValue(index));
+
+    obj->insert("timestamp", QJsonValue(timestamp));
+
+    obj->insert("centerFrequency", QJsonValue(center_frequency));
+
+    obj->insert("sampleRate", QJsonValue(sample_rate));
+
+    obj->insert("fftSize", QJsonValue(fft_size));
+
+    toJsonValue(QString("power"), power, obj, QString("QByteArray"));
+
+    return obj;
+}
+
+qint32
+SWGSpectrumFrame::getIndex() {
+    return index;
+}
+void
+SWGSpectrumFrame::setIndex(qint32 index) {
+    this->index = index;
+}
+
+qint64
+SWGSpectrumFrame::getTimestamp() {
+    return timestamp;
+}
+void
+SWGSpectrumFrame::setTimestamp(qint64 timestamp) {
+    this->timestamp = timestamp;
+}
+
+qint64
+SWGSpectrumFrame::getCenterFrequency() {
+    return center_frequency;
+}
+void
+SWGSpectrumFrame::setCenterFrequency(qint64 center_frequency) {
+    this->center_frequency = center_frequency;
+}
+
+qint32
+SWGSpectrumFrame::getSampleRate() {
+    return sample_rate;
+}
+void
+SWGSpectrumFrame::setSampleRate(qint32 sample_rate) {
+    this->sample_rate = sample_rate;
+}
+
+qint32
+SWGSpectrumFrame::getFftSize() {
+    return fft_size;
+}
+void
+SWGSpectrumFrame::setFftSize(qint32 fft_size) {
+    this->fft_size = fft_size;
+}
+
+QByteArray*
+SWGSpectrumFrame::getPower() {
+    return power;
+}
+void
+SWGSpectrumFrame::setPower(QByteArray* power) {
+    this->power = power;
+}
+
+
+}
+
@@ -0,0 +1,75 @@
+/**
+ * SDRangel
+ * This is the web API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube
+ *
+ * OpenAPI spec version: 4.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGSpectrumFrame.h
+ * 
+ * Spectrum frame computed by the headless spectrum engine of a device set
+ */
+
+#ifndef SWGSpectrumFrame_H_
+#define SWGSpectrumFrame_H_
+
+#include <QJsonObject>
+
+
+#include <QByteArray>
+
+#include "SWGObject.h"
+
+
+namespace Swagger {
+
+class SWGSpectrumFrame: public SWGObject {
+public:
+    SWGSpectrumFrame();
+    SWGSpectrumFrame(QString* json);
+    virtual ~SWGSpectrumFrame();
+    void init();
+    void cleanup();
+
+    QString asJson ();
+    QJsonObject* asJsonObject();
+    void fromJsonObject(QJsonObject &json);
+    SWGSpectrumFrame* fromJson(QString &jsonString);
+
+    qint32 getIndex();
+    void setIndex(qint32 index);
+
+    qint64 getTimestamp();
+    void setTimestamp(qint64 timestamp);
+
+    qint64 getCenterFrequency();
+    void setCenterFrequency(qint64 center_frequency);
+
+    qint32 getSampleRate();
+    void setSampleRate(qint32 sample_rate);
+
+    qint32 getFftSize();
+    void setFftSize(qint32 fft_size);
+
+    QByteArray* getPower();
+    void setPower(QByteArray* power);
+
+
+private:
+    qint32 index;
+    qint64 timestamp;
+    qint64 center_frequency;
+    qint32 sample_rate;
+    qint32 fft_size;
+    QByteArray* power;
+};
+
+}
+
+#endif /* SWGSpectrumFrame_H_ */
@@ -0,0 +1,176 @@
+/**
+ * SDRangel
+ * This is the web API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube
+ *
+ * OpenAPI spec version: 4.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGSpectrumSettings.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace Swagger {
+
+SWGSpectrumSettings::SWGSpectrumSettings(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGSpectrumSettings::SWGSpectrumSettings() {
+    init();
+}
+
+SWGSpectrumSettings::~SWGSpectrumSettings() {
+    this->cleanup();
+}
+
+void
+SWGSpectrumSettings::init() {
+    enabled = false;
+    fft_size = 0;
+    overlap_percent = 0;
+    fft_window = 0;
+    averaging_mode = 0;
+    averaging_nb = 0;
+    max_frame_rate = 0;
+}
+
+void
+SWGSpectrumSettings::cleanup() {
+    
+
+
+
+
+
+
+}
+
+SWGSpectrumSettings*
+SWGSpectrumSettings::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGSpectrumSettings::fromJsonObject(QJsonObject &pJson) {
+    ::Swagger::setValue(&enabled, pJson["enabled"], "bool", "");
+    ::Swagger::setValue(&fft_size, pJson["fftSize"], "qint32", "");
+    ::Swagger::setValue(&overlap_percent, pJson["overlapPercent"], "qint32", "");
+    ::Swagger::setValue(&fft_window, pJson["fftWindow"], "qint32", "");
+    ::Swagger::setValue(&averaging_mode, pJson["averagingMode"], "qint32", "");
+    ::Swagger::setValue(&averaging_nb, pJson["averagingNb"], "qint32", "");
+    ::Swagger::setValue(&max_frame_rate, pJson["maxFrameRate"], "qint32", "");
+}
+
+QString
+SWGSpectrumSettings::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+    
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGSpectrumSettings::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    
+    obj->insert("enabled", QJsonValue(enabled));
+
+    obj->insert("fftSize", QJsonValue(fft_size));
+
+    obj->insert("overlapPercent", QJsonValue(overlap_percent));
+
+    obj->insert("fftWindow", QJsonValue(fft_window));
+
+    obj->insert("averagingMode", QJsonValue(averaging_mode));
+
+    obj->insert("averagingNb", QJsonValue(averaging_nb));
+
+    obj->insert("maxFrameRate", QJsonValue(max_frame_rate));
+
+    return obj;
+}
+
+bool
+SWGSpectrumSettings::getEnabled() {
+    return enabled;
+}
+void
+SWGSpectrumSettings::setEnabled(bool enabled) {
+    this->enabled = enabled;
+}
+
+qint32
+SWGSpectrumSettings::getFftSize() {
+    return fft_size;
+}
+void
+SWGSpectrumSettings::setFftSize(qint32 fft_size) {
+    this->fft_size = fft_size;
+}
+
+qint32
+SWGSpectrumSettings::getOverlapPercent() {
+    return overlap_percent;
+}
+void
+SWGSpectrumSettings::setOverlapPercent(qint32 overlap_percent) {
+    this->overlap_percent = overlap_percent;
+}
+
+qint32
+SWGSpectrumSettings::getFftWindow() {
+    return fft_window;
+}
+void
+SWGSpectrumSettings::setFftWindow(qint32 fft_window) {
+    this->fft_window = fft_window;
+}
+
+qint32
+SWGSpectrumSettings::getAveragingMode() {
+    return averaging_mode;
+}
+void
+SWGSpectrumSettings::setAveragingMode(qint32 averaging_mode) {
+    this->averaging_mode = averaging_mode;
+}
+
+qint32
+SWGSpectrumSettings::getAveragingNb() {
+    return averaging_nb;
+}
+void
+SWGSpectrumSettings::setAveragingNb(qint32 averaging_nb) {
+    this->averaging_nb = averaging_nb;
+}
+
+qint32
+SWGSpectrumSettings::getMaxFrameRate() {
+    return max_frame_rate;
+}
+void
+SWGSpectrumSettings::setMaxFrameRate(qint32 max_frame_rate) {
+    this->max_frame_rate = max_frame_rate;
+}
+
+
+}
+
@@ -0,0 +1,78 @@
+/**
+ * SDRangel
+ * This is the web API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube
+ *
+ * OpenAPI spec version: 4.0.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGSpectrumSettings.h
+ * 
+ * Settings of the headless spectrum engine of a device set
+ */
+
+#ifndef SWGSpectrumSettings_H_
+#define SWGSpectrumSettings_H_
+
+#include <QJsonObject>
+
+
+
+#include "SWGObject.h"
+
+
+namespace Swagger {
+
+class SWGSpectrumSettings: public SWGObject {
+public:
+    SWGSpectrumSettings();
+    SWGSpectrumSettings(QString* json);
+    virtual ~SWGSpectrumSettings();
+    void init();
+    void cleanup();
+
+    QString asJson ();
+    QJsonObject* asJsonObject();
+    void fromJsonObject(QJsonObject &json);
+    SWGSpectrumSettings* fromJson(QString &jsonString);
+
+    bool getEnabled();
+    void setEnabled(bool enabled);
+
+    qint32 getFftSize();
+    void setFftSize(qint32 fft_size);
+
+    qint32 getOverlapPercent();
+    void setOverlapPercent(qint32 overlap_percent);
+
+    qint32 getFftWindow();
+    void setFftWindow(qint32 fft_window);
+
+    qint32 getAveragingMode();
+    void setAveragingMode(qint32 averaging_mode);
+
+    qint32 getAveragingNb();
+    void setAveragingNb(qint32 averaging_nb);
+
+    qint32 getMaxFrameRate();
+    void setMaxFrameRate(qint32 max_frame_rate);
+
+
+private:
+    bool enabled;
+    qint32 fft_size;
+    qint32 overlap_percent;
+    qint32 fft_window;
+    qint32 averaging_mode;
+    qint32 averaging_nb;
+    qint32 max_frame_rate;
+};
+
+}
+
+#endif /* SWGSpectrumSettings_H_ */